@@ -0,0 +1,84 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#include "benchmark.h"
+
+// Replaces the global operator new of the benchmark executable, so every heap allocation of the SDK is counted.
+// The array and nothrow forms call these by default.
+
+namespace
+{
+
+std::atomic<uint64_t> g_allocation_count{ 0u };
+
+void* allocate(std::size_t size, std::size_t alignment)
+{
+    g_allocation_count.fetch_add(1u, std::memory_order_relaxed);
+
+    size = size > 0u ? size : 1u;
+
+#if defined(_WIN32)
+    void* memory = _aligned_malloc(size, alignment);
+#else
+    void* memory = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1u) / alignment * alignment) : std::malloc(size);
+#endif
+    if (!memory)
+    {
+        throw std::bad_alloc{};
+    }
+
+    return memory;
+}
+
+void deallocate(void* memory)
+{
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+} // namespace
+
+uint64_t getAllocationCount()
+{
+    return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, (std::size_t)alignment);
+}
+
+void operator delete(void* memory) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(memory);
+}
@@ -0,0 +1,67 @@
+#ifndef BENCH_BENCHMARK_H_
+#define BENCH_BENCHMARK_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+struct BenchmarkOptions
+{
+    // Runs before the timed ones, to warm caches, pools and lazily created state.
+    uint32_t warmup{ 1u };
+    uint32_t repetitions{ 10u };
+
+    // Work done by one run, used for the throughput. 0 if not applicable.
+    uint64_t items{ 0u };
+    uint64_t bytes{ 0u };
+};
+
+struct BenchmarkResult
+{
+    std::string name{};
+
+    uint32_t warmup{ 0u };
+    uint32_t repetitions{ 0u };
+
+    double median_ms{ 0.0 };
+    double min_ms{ 0.0 };
+    double p99_ms{ 0.0 };
+
+    // Based on the median, 0 if not applicable.
+    double items_per_second{ 0.0 };
+    double bytes_per_second{ 0.0 };
+};
+
+bool registerBenchmark(const char* name, void (*function)());
+
+// Runs the function repeatedly, prints and returns the timings.
+// The result is also recorded for the JSON output and the baseline comparison.
+BenchmarkResult measure(const std::string& name, const BenchmarkOptions& options, const std::function<void()>& function);
+
+// Without warmup and throughput.
+BenchmarkResult measure(const std::string& name, uint32_t repetitions, const std::function<void()>& function);
+
+// Heap allocations through operator new since the start of the process.
+uint64_t getAllocationCount();
+
+// Lets the run fail, e.g. if a benchmark finds that a guarantee does not hold.
+void failBenchmark(const std::string& message);
+
+// Keeps the compiler from removing a computation whose result is otherwise unused.
+template<class T>
+void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink{ nullptr };
+    sink = &value;
+#endif
+}
+
+#define BENCHMARK(benchmark_name) \
+    static void benchmark_name(); \
+    static const bool benchmark_name##_registered = registerBenchmark(#benchmark_name, benchmark_name); \
+    static void benchmark_name()
+
+#endif /* BENCH_BENCHMARK_H_ */
@@ -0,0 +1,57 @@
+#include <vector>
+
+#include "core/core.h"
+
+#include "benchmark.h"
+
+BENCHMARK(ColorTransfer)
+{
+    // One 1024x1024 image worth of colors, covering the full range of every curve
+    const std::size_t count{ 1024u * 1024u };
+
+    std::vector<float3> colors(count);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const float value = (float)(i % 4096u) / 4095.0f;
+
+        colors[i] = float3{ value, 1.0f - value, value * 0.5f };
+    }
+
+    std::vector<float3> results(count);
+
+    struct TransferCase
+    {
+        const char* name;
+        float3 (*function)(const float3&);
+    };
+
+    for (const TransferCase& transfer_case : { TransferCase{ "srgbToLinear709", srgbToLinear709 },
+                                               TransferCase{ "linear709ToSrgb", linear709ToSrgb },
+                                               TransferCase{ "gamma22ToLinear709", gamma22ToLinear709 },
+                                               TransferCase{ "linear709ToGamma22", linear709ToGamma22 },
+                                               TransferCase{ "bt709ToLinear709", bt709ToLinear709 },
+                                               TransferCase{ "linear709ToBt709", linear709ToBt709 },
+                                               TransferCase{ "pqToLinear2020", pqToLinear2020 },
+                                               TransferCase{ "linear2020ToPq", linear2020ToPq },
+                                               TransferCase{ "hlgToLinear2020", hlgToLinear2020 },
+                                               TransferCase{ "linear2020ToHlg", linear2020ToHlg } })
+    {
+        measure(transfer_case.name, { .warmup = 1u, .repetitions = 10u, .items = count, .bytes = count * sizeof(float3) }, [&]() {
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                results[i] = transfer_case.function(colors[i]);
+            }
+            doNotOptimize(results);
+        });
+    }
+
+    const float3x3 rgb_to_xyz = rgbToXYZ(COLOR_PRIMARY_REC709);
+
+    measure("linear709 to XYZ", { .warmup = 1u, .repetitions = 10u, .items = count, .bytes = count * sizeof(float3) }, [&]() {
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            results[i] = rgb_to_xyz * colors[i];
+        }
+        doNotOptimize(results);
+    });
+}
@@ -0,0 +1,245 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <OpenImageIO/imagebuf.h>
+#include <OpenImageIO/imagebufalgo.h>
+
+#include "core/core.h"
+
+#include "benchmark.h"
+
+std::vector<std::string> createTextures(uint32_t count, uint32_t size)
+{
+    std::filesystem::create_directories("../bin/bench_textures");
+
+    std::vector<std::string> filenames{};
+    filenames.reserve(count);
+
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        std::string filename = "../bin/bench_textures/texture_" + std::to_string(i) + ".png";
+
+        if (!std::filesystem::exists(filename))
+        {
+            ImageData image_data{};
+            image_data.width = size;
+            image_data.height = size;
+            image_data.channels = 3u;
+            image_data.channel_format = ChannelFormat::UNORM;
+            image_data.primaries = ColorPrimaries::REC709;
+            image_data.transfer = TransferFunction::SRGB;
+            image_data.image_state = ImageState::SCENE;
+            image_data.pixels.resize(size * size * 3u);
+
+            for (uint32_t y = 0u; y < size; y++)
+            {
+                for (uint32_t x = 0u; x < size; x++)
+                {
+                    uint8_t* pixel = &image_data.pixels[(y * size + x) * 3u];
+                    pixel[0] = (uint8_t)(x + i);
+                    pixel[1] = (uint8_t)(y * 3u);
+                    pixel[2] = (uint8_t)((x ^ y) + i * 7u);
+                }
+            }
+
+            saveImageData(filename.c_str(), image_data);
+        }
+
+        filenames.push_back(filename);
+    }
+
+    return filenames;
+}
+
+BENCHMARK(ImageLoadBatch)
+{
+    const std::vector<std::string> filenames = createTextures(128u, 512u);
+
+    ImageLoadStages stages{};
+    stages.channels = 4u;
+    stages.generate_mip_maps = true;
+
+    printf("%zu textures, %u threads\n", filenames.size(), (uint32_t)getThreadPool().getNumberThreads());
+
+    measure("serial loadImageData + stages", 3u, [&]() {
+        for (const std::string& filename : filenames)
+        {
+            auto image_data = loadImageData(filename.c_str());
+            if (image_data.has_value())
+            {
+                auto converted_image_data = convertImageDataChannels(stages.channels, *image_data);
+                auto mip_levels = generateMipMaps(*converted_image_data);
+            }
+        }
+    });
+
+    for (uint32_t max_io_concurrency : { 1u, 4u, 16u })
+    {
+        measure("loadImageDataBatch io=" + std::to_string(max_io_concurrency), 3u, [&]() {
+            auto images = loadImageDataBatch(filenames, stages, max_io_concurrency);
+        });
+    }
+}
+
+BENCHMARK(ImageResize)
+{
+    const uint32_t size{ 2048u };
+
+    ImageData image_data{};
+    image_data.width = size;
+    image_data.height = size;
+    image_data.channels = 4u;
+    image_data.channel_format = ChannelFormat::UNORM;
+    image_data.primaries = ColorPrimaries::REC709;
+    image_data.transfer = TransferFunction::SRGB;
+    image_data.image_state = ImageState::SCENE;
+    image_data.pixels.resize(size * size * 4u);
+    for (std::size_t i = 0u; i < image_data.pixels.size(); i++)
+    {
+        image_data.pixels[i] = (uint8_t)((i * 2654435761u) >> 24);
+    }
+
+    OIIO::ImageSpec image_spec{ (int)size, (int)size, 4, OIIO::TypeDesc::UINT8 };
+    OIIO::ImageBuf image_buf(image_spec, (void*)image_data.pixels.data());
+
+    struct Case
+    {
+        FilterKernel kernel;
+        const char* oiio_name;
+    };
+
+    for (const Case& resize_case : { Case{ FilterKernel::BOX, "box" }, Case{ FilterKernel::MITCHELL, "mitchell" }, Case{ FilterKernel::LANCZOS3, "lanczos3" } })
+    {
+        for (uint32_t target : { 1024u, 333u })
+        {
+            const std::string suffix = std::string(resize_case.oiio_name) + " 2048->" + std::to_string(target);
+
+            measure("resizeImageData " + suffix, 5u, [&]() {
+                auto resized = resizeImageData(target, target, resize_case.kernel, image_data);
+            });
+
+            measure("OIIO resize " + suffix, 5u, [&]() {
+                OIIO::ROI roi{ 0, (int)target, 0, (int)target };
+                OIIO::ImageBuf resized = OIIO::ImageBufAlgo::resize(image_buf, resize_case.oiio_name, 0.0f, roi);
+            });
+        }
+    }
+
+    measure("generateMipMaps 2048", 3u, [&]() {
+        auto mip_levels = generateMipMaps(image_data);
+    });
+
+    measure("blurImageData sigma 4", 3u, [&]() {
+        auto blurred = blurImageData(4.0f, image_data);
+    });
+}
+
+BENCHMARK(ImageLoadConvert)
+{
+    const uint32_t size{ 4096u };
+    const std::string filename = "../bin/bench_textures/large.exr";
+
+    std::filesystem::create_directories("../bin/bench_textures");
+    if (!std::filesystem::exists(filename))
+    {
+        ImageData image_data{};
+        image_data.width = size;
+        image_data.height = size;
+        image_data.channels = 3u;
+        image_data.channel_format = ChannelFormat::SFLOAT;
+        image_data.primaries = ColorPrimaries::REC709;
+        image_data.transfer = TransferFunction::LINEAR;
+        image_data.image_state = ImageState::SCENE;
+        image_data.pixels.resize((std::size_t)size * size * 3u * sizeof(float));
+
+        float* pixels = (float*)image_data.pixels.data();
+        for (std::size_t i = 0u; i < (std::size_t)size * size * 3u; i++)
+        {
+            pixels[i] = (float)(i % 1021u) / 1021.0f;
+        }
+
+        saveImageData(filename.c_str(), image_data);
+    }
+
+    const std::size_t pixel_bytes = (std::size_t)size * size * 4u * sizeof(float);
+
+    printf("%ux%u RGB float, %.0f MiB after conversion\n", size, size, (double)pixel_bytes / (1024.0 * 1024.0));
+
+    // The part of every load the old std::vector storage paid on top
+    measure("std::vector resize + fill", 5u, [&]() {
+        std::vector<uint8_t> pixels{};
+        pixels.resize(pixel_bytes);
+        std::memset(pixels.data(), 1, pixels.size());
+    });
+
+    measure("AlignedBuffer resize + fill", 5u, [&]() {
+        AlignedBuffer<uint8_t> pixels{};
+        pixels.resize(pixel_bytes);
+        std::memset(pixels.data(), 1, pixels.size());
+    });
+
+    for (std::size_t pool_limit : { (std::size_t)0u, (std::size_t)1024u * 1024u * 1024u })
+    {
+        setAlignedMemoryPoolLimit(pool_limit);
+
+        measure(std::string("loadImageData + convert, pool ") + (pool_limit > 0u ? "on" : "off"), 5u, [&]() {
+            auto image_data = loadImageData(filename.c_str());
+            if (image_data.has_value())
+            {
+                auto converted_image_data = convertImageDataChannels(4u, std::move(*image_data));
+                if (converted_image_data.has_value())
+                {
+                    converted_image_data = convertImageDataColorSpace(ColorPrimaries::REC709, TransferFunction::SRGB, ImageState::DISPLAY, std::move(*converted_image_data));
+                }
+            }
+        });
+    }
+
+    setAlignedMemoryPoolLimit(0u);
+}
+
+BENCHMARK(ImageConvert)
+{
+    const uint32_t size{ 2048u };
+    const std::size_t pixel_count = (std::size_t)size * size;
+
+    ImageData image_data{};
+    image_data.width = size;
+    image_data.height = size;
+    image_data.channels = 3u;
+    image_data.channel_format = ChannelFormat::UNORM;
+    image_data.primaries = ColorPrimaries::REC709;
+    image_data.transfer = TransferFunction::SRGB;
+    image_data.image_state = ImageState::SCENE;
+    image_data.pixels.resize(pixel_count * 3u);
+    for (std::size_t i = 0u; i < image_data.pixels.size(); i++)
+    {
+        image_data.pixels[i] = (uint8_t)((i * 2654435761u) >> 24);
+    }
+
+    measure("convertImageDataChannels RGB8 -> RGBA8", { .warmup = 1u, .repetitions = 10u, .items = pixel_count, .bytes = image_data.pixels.size() }, [&]() {
+        auto converted_image_data = convertImageDataChannels(4u, image_data);
+        doNotOptimize(converted_image_data);
+    });
+
+    const ImageData rgba_image_data = *convertImageDataChannels(4u, image_data);
+
+    measure("convertImageDataColorSpace sRGB -> linear RGBA8", { .warmup = 1u, .repetitions = 10u, .items = pixel_count, .bytes = rgba_image_data.pixels.size() }, [&]() {
+        auto converted_image_data = convertImageDataColorSpace(ColorPrimaries::REC709, TransferFunction::LINEAR, ImageState::SCENE, rgba_image_data);
+        doNotOptimize(converted_image_data);
+    });
+
+    measure("convertImageDataColorSpace Rec.709 -> Rec.2020 PQ RGBA8", { .warmup = 1u, .repetitions = 10u, .items = pixel_count, .bytes = rgba_image_data.pixels.size() }, [&]() {
+        auto converted_image_data = convertImageDataColorSpace(ColorPrimaries::REC2020, TransferFunction::ST2084_PQ, ImageState::DISPLAY, rgba_image_data);
+        doNotOptimize(converted_image_data);
+    });
+
+    // A full chain has a third more pixels than the base level
+    measure("generateMipMaps RGBA8 2048", { .warmup = 1u, .repetitions = 5u, .items = pixel_count, .bytes = rgba_image_data.pixels.size() }, [&]() {
+        auto mip_levels = generateMipMaps(rgba_image_data);
+        doNotOptimize(mip_levels);
+    });
+}
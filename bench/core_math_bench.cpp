@@ -0,0 +1,177 @@
+#include <cstdio>
+#include <vector>
+
+#include "core/core.h"
+
+#include "benchmark.h"
+
+// Typical world matrices: rotation, scale and translation.
+std::vector<float4x4> createMatrices(std::size_t count)
+{
+    UniformRandomGenerator random(-10.0f, 10.0f, 1234u);
+
+    std::vector<float4x4> matrices(count);
+    for (float4x4& matrix : matrices)
+    {
+        matrix = translationMatrix(float3{ random.generate(), random.generate(), random.generate() }) * rotateRyMatrix(random.generate() * 18.0f) * rotateRxMatrix(random.generate() * 18.0f) * scaleMatrix(float3{ 1.5f, 1.5f, 1.5f });
+    }
+
+    return matrices;
+}
+
+BENCHMARK(MatrixMultiply)
+{
+    const std::size_t count{ 1024u };
+    const uint32_t rounds{ 64u };
+
+    const std::vector<float4x4> matrices = createMatrices(count);
+    const float4x4 view_projection = perspective(60.0f, 16.0f / 9.0f, 0.1f, 100.0f) * lookAt(float3{ 0.0f, 2.0f, 10.0f }, float3{}, float3{ 0.0f, 1.0f, 0.0f });
+
+    std::vector<float4x4> results(count);
+    std::vector<float4> points(count);
+
+    measure("float4x4 * float4x4", { .warmup = 1u, .repetitions = 20u, .items = (uint64_t)count * rounds }, [&]() {
+        for (uint32_t round = 0u; round < rounds; round++)
+        {
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                results[i] = view_projection * matrices[i];
+            }
+            doNotOptimize(results);
+        }
+    });
+
+    measure("float4x4 * float4", { .warmup = 1u, .repetitions = 20u, .items = (uint64_t)count * rounds }, [&]() {
+        for (uint32_t round = 0u; round < rounds; round++)
+        {
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                points[i] = matrices[i] * float4{ 1.0f, 2.0f, 3.0f, 1.0f };
+            }
+            doNotOptimize(points);
+        }
+    });
+}
+
+BENCHMARK(MatrixInverse)
+{
+    const std::size_t count{ 1024u };
+    const uint32_t rounds{ 16u };
+
+    const std::vector<float4x4> matrices = createMatrices(count);
+
+    std::vector<float4x4> results(count);
+
+    measure("inverse float4x4", { .warmup = 1u, .repetitions = 20u, .items = (uint64_t)count * rounds }, [&]() {
+        for (uint32_t round = 0u; round < rounds; round++)
+        {
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                results[i] = inverse(matrices[i]);
+            }
+            doNotOptimize(results);
+        }
+    });
+
+    std::vector<float3x3> normal_matrices(count);
+
+    measure("inverse float3x3", { .warmup = 1u, .repetitions = 20u, .items = (uint64_t)count * rounds }, [&]() {
+        for (uint32_t round = 0u; round < rounds; round++)
+        {
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                normal_matrices[i] = inverse(float3x3(matrices[i]));
+            }
+            doNotOptimize(normal_matrices);
+        }
+    });
+}
+
+BENCHMARK(FrustumCulling)
+{
+    // Objects of a large scene, about a third of them in view
+    const std::size_t count{ 256u * 1024u };
+
+    UniformRandomGenerator random(-50.0f, 50.0f, 42u);
+
+    std::vector<AABB> aabbs(count);
+    std::vector<Sphere> spheres(count);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const float3 center{ random.generate(), random.generate() * 0.1f, random.generate() };
+
+        aabbs[i] = createAABB(center, float3{ 0.5f, 1.0f, 0.5f });
+        spheres[i] = Sphere(center, 1.0f);
+    }
+
+    const Frustum frustum(lookAt(float3{ 0.0f, 2.0f, 0.0f }, float3{ 0.0f, 2.0f, -1.0f }, float3{ 0.0f, 1.0f, 0.0f }), perspective(90.0f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+    std::size_t visible{ 0u };
+
+    measure("isVisible AABB", { .warmup = 1u, .repetitions = 20u, .items = count }, [&]() {
+        visible = 0u;
+        for (const AABB& aabb : aabbs)
+        {
+            visible += isVisible(frustum, aabb) ? 1u : 0u;
+        }
+        doNotOptimize(visible);
+    });
+    printf("    %zu of %zu visible\n", visible, count);
+
+    measure("isVisible Sphere", { .warmup = 1u, .repetitions = 20u, .items = count }, [&]() {
+        visible = 0u;
+        for (const Sphere& sphere : spheres)
+        {
+            visible += isVisible(frustum, sphere) ? 1u : 0u;
+        }
+        doNotOptimize(visible);
+    });
+}
+
+BENCHMARK(RayIntersect)
+{
+    const std::size_t count{ 256u * 1024u };
+
+    UniformRandomGenerator random(-1.0f, 1.0f, 7u);
+
+    std::vector<Ray> rays(count);
+    for (Ray& ray : rays)
+    {
+        ray = Ray(float3{ random.generate(), random.generate(), 5.0f }, normalize(float3{ random.generate() * 0.2f, random.generate() * 0.2f, -1.0f }));
+    }
+
+    const AABB aabb = createAABB(float3{}, float3{ 0.5f, 0.5f, 0.5f });
+    const Sphere sphere(float3{}, 0.75f);
+    const float3 v0{ -1.0f, -1.0f, 0.0f };
+    const float3 v1{ 1.0f, -1.0f, 0.0f };
+    const float3 v2{ 0.0f, 1.0f, 0.0f };
+
+    std::size_t hits{ 0u };
+
+    measure("intersect Ray AABB", { .warmup = 1u, .repetitions = 20u, .items = count }, [&]() {
+        hits = 0u;
+        for (const Ray& ray : rays)
+        {
+            hits += intersect(ray, aabb).has_value() ? 1u : 0u;
+        }
+        doNotOptimize(hits);
+    });
+
+    measure("intersect Ray Sphere", { .warmup = 1u, .repetitions = 20u, .items = count }, [&]() {
+        hits = 0u;
+        for (const Ray& ray : rays)
+        {
+            hits += intersect(ray, sphere).has_value() ? 1u : 0u;
+        }
+        doNotOptimize(hits);
+    });
+
+    measure("intersect Ray triangle", { .warmup = 1u, .repetitions = 20u, .items = count }, [&]() {
+        hits = 0u;
+        for (const Ray& ray : rays)
+        {
+            hits += intersect(ray, v0, v1, v2).has_value() ? 1u : 0u;
+        }
+        doNotOptimize(hits);
+    });
+}
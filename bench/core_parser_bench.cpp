@@ -0,0 +1,501 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "core/core.h"
+
+#include "benchmark.h"
+
+// Configuration file grammar:
+// document   = { line } ;
+// line       = comment | assignment ;
+// comment    = "#", text, "\n" ;
+// assignment = identifier, spaces, "=", spaces, ( number | identifier ), ";", "\n" ;
+// identifier = letters, { letters | digits | "_" } ;
+// number     = digits, [ ".", digits ] ;
+std::shared_ptr<ebnf::ASymbol> createConfigGrammar()
+{
+    auto letters = std::make_shared<ebnf::IntervalCharacterRule>('a', 'z');
+    auto digits = std::make_shared<ebnf::IntervalCharacterRule>('0', '9');
+    auto spaces = std::make_shared<ebnf::ZeroManyFactor>(std::make_shared<ebnf::Terminal>(' '));
+    auto line_feed = std::make_shared<ebnf::Terminal>('\n');
+
+    auto identifier_tail = std::make_shared<ebnf::Alternation>();
+    identifier_tail->append(letters);
+    identifier_tail->append(digits);
+    identifier_tail->append(std::make_shared<ebnf::Terminal>('_'));
+
+    auto identifier = std::make_shared<ebnf::Concatenation>();
+    identifier->append(letters);
+    identifier->append(std::make_shared<ebnf::ZeroManyFactor>(identifier_tail));
+
+    auto fraction = std::make_shared<ebnf::Concatenation>();
+    fraction->append(std::make_shared<ebnf::Terminal>('.'));
+    fraction->append(digits);
+
+    auto number = std::make_shared<ebnf::Concatenation>();
+    number->append(digits);
+    number->append(std::make_shared<ebnf::ZeroOneFactor>(fraction));
+
+    auto value = std::make_shared<ebnf::Alternation>();
+    value->append(number);
+    value->append(identifier);
+
+    auto assignment = std::make_shared<ebnf::Concatenation>();
+    assignment->append(identifier);
+    assignment->append(spaces);
+    assignment->append(std::make_shared<ebnf::Terminal>('='));
+    assignment->append(spaces);
+    assignment->append(value);
+    assignment->append(std::make_shared<ebnf::Terminal>(';'));
+    assignment->append(line_feed);
+
+    auto text = std::make_shared<ebnf::AnyCharacterRule>();
+    text->addIgnoredCharacter('\n');
+
+    auto comment = std::make_shared<ebnf::Concatenation>();
+    comment->append(std::make_shared<ebnf::Terminal>('#'));
+    comment->append(text);
+    comment->append(line_feed);
+
+    auto line = std::make_shared<ebnf::Alternation>();
+    line->append(comment);
+    line->append(assignment);
+
+    return std::make_shared<ebnf::ZeroManyFactor>(line);
+}
+
+std::string createConfigText(std::size_t size)
+{
+    std::string text{};
+    text.reserve(size + 64u);
+
+    for (std::size_t i = 0u; text.size() < size; i++)
+    {
+        if (i % 8u == 0u)
+        {
+            text += "# section " + std::to_string(i / 8u) + "\n";
+        }
+        else if (i % 2u == 0u)
+        {
+            text += "value_" + std::to_string(i) + " = " + std::to_string(i * 7u) + "." + std::to_string(i % 100u) + ";\n";
+        }
+        else
+        {
+            text += "name" + std::to_string(i) + "=enabled;\n";
+        }
+    }
+
+    return text;
+}
+
+// Shader preprocessor subset:
+// source     = { line } ;
+// line       = directive | code, "\n" | "\n" ;
+// directive  = "#", spaces, ( define | include | ifdef | ifndef | "else" | "endif" ), spaces, "\n" ;
+// define     = "define", blanks, identifier, [ blanks, code ] ;
+// include    = "include", spaces, '"', path, '"' ;
+// ifdef      = "ifdef", blanks, identifier ;
+// ifndef     = "ifndef", blanks, identifier ;
+// code       = text - "#" ;
+std::shared_ptr<ebnf::ASymbol> createPreprocessorGrammar()
+{
+    auto line_feed = std::make_shared<ebnf::Terminal>('\n');
+
+    auto blank = std::make_shared<ebnf::Alternation>();
+    blank->append(std::make_shared<ebnf::Terminal>(' '));
+    blank->append(std::make_shared<ebnf::Terminal>('\t'));
+
+    auto spaces = std::make_shared<ebnf::ZeroManyFactor>(blank);
+    auto blanks = std::make_shared<ebnf::OneManyFactor>(blank);
+
+    auto identifier_head = std::make_shared<ebnf::Alternation>();
+    identifier_head->append(std::make_shared<ebnf::IntervalCharacterRule>('A', 'Z'));
+    identifier_head->append(std::make_shared<ebnf::IntervalCharacterRule>('a', 'z'));
+    identifier_head->append(std::make_shared<ebnf::Terminal>('_'));
+
+    auto identifier_tail = std::make_shared<ebnf::Alternation>();
+    identifier_tail->append(identifier_head);
+    identifier_tail->append(std::make_shared<ebnf::IntervalCharacterRule>('0', '9'));
+
+    auto identifier = std::make_shared<ebnf::Concatenation>();
+    identifier->append(identifier_head);
+    identifier->append(std::make_shared<ebnf::ZeroManyFactor>(identifier_tail));
+
+    auto text = std::make_shared<ebnf::AnyCharacterRule>();
+    text->addIgnoredCharacter('\n');
+
+    auto code = std::make_shared<ebnf::Exclude>(text, std::make_shared<ebnf::Terminal>('#'));
+
+    auto define_value = std::make_shared<ebnf::Concatenation>();
+    define_value->append(blanks);
+    define_value->append(code);
+
+    auto define = std::make_shared<ebnf::Concatenation>();
+    define->append(std::make_shared<ebnf::Terminal>("define"));
+    define->append(blanks);
+    define->append(identifier);
+    define->append(std::make_shared<ebnf::ZeroOneFactor>(define_value));
+
+    auto path = std::make_shared<ebnf::AnyCharacterRule>();
+    path->addIgnoredCharacter('"');
+    path->addIgnoredCharacter('\n');
+
+    auto include = std::make_shared<ebnf::Concatenation>();
+    include->append(std::make_shared<ebnf::Terminal>("include"));
+    include->append(spaces);
+    include->append(std::make_shared<ebnf::Terminal>('"'));
+    include->append(path);
+    include->append(std::make_shared<ebnf::Terminal>('"'));
+
+    auto ifdef = std::make_shared<ebnf::Concatenation>();
+    ifdef->append(std::make_shared<ebnf::Terminal>("ifdef"));
+    ifdef->append(blanks);
+    ifdef->append(identifier);
+
+    auto ifndef = std::make_shared<ebnf::Concatenation>();
+    ifndef->append(std::make_shared<ebnf::Terminal>("ifndef"));
+    ifndef->append(blanks);
+    ifndef->append(identifier);
+
+    auto command = std::make_shared<ebnf::Alternation>();
+    command->append(define);
+    command->append(include);
+    command->append(ifdef);
+    command->append(ifndef);
+    command->append(std::make_shared<ebnf::Terminal>("else"));
+    command->append(std::make_shared<ebnf::Terminal>("endif"));
+
+    auto directive = std::make_shared<ebnf::Concatenation>();
+    directive->append(std::make_shared<ebnf::Terminal>('#'));
+    directive->append(spaces);
+    directive->append(command);
+    directive->append(spaces);
+    directive->append(line_feed);
+
+    auto code_line = std::make_shared<ebnf::Concatenation>();
+    code_line->append(code);
+    code_line->append(line_feed);
+
+    auto line = std::make_shared<ebnf::Alternation>();
+    line->append(directive);
+    line->append(code_line);
+    line->append(line_feed);
+
+    return std::make_shared<ebnf::ZeroManyFactor>(line);
+}
+
+std::string createPreprocessorText(std::size_t size)
+{
+    std::string text{};
+    text.reserve(size + 256u);
+
+    for (std::size_t i = 0u; text.size() < size; i++)
+    {
+        const std::string index = std::to_string(i);
+
+        text += "#include \"common" + index + ".slang\"\n";
+        text += "#define LIGHT_COUNT_" + index + " " + std::to_string(i % 16u) + "\n";
+        text += "#ifdef USE_SHADOWS_" + index + "\n";
+        text += "    float shadow" + index + " = shadowMap.SampleCmp(shadowSampler, uv, depth);\n";
+        text += "#else\n";
+        text += "    float shadow" + index + " = 1.0;\n";
+        text += "#endif\n";
+        text += "\n";
+        text += "float4 shade" + index + "(float3 normal, float3 light) { return saturate(dot(normal, light)) * color; }\n";
+    }
+
+    return text;
+}
+
+// Pathological grammar with shared prefixes:
+// nested = "(", nested, ")", "+" | "(", nested, ")" | "a" ;
+// Without memo the time doubles with every level.
+std::shared_ptr<ebnf::ASymbol> createNestedGrammar(uint32_t depth)
+{
+    std::shared_ptr<ebnf::ASymbol> nested = std::make_shared<ebnf::Terminal>('a');
+
+    for (uint32_t i = 0u; i < depth; i++)
+    {
+        auto prefix = std::make_shared<ebnf::Concatenation>();
+        prefix->append(std::make_shared<ebnf::Terminal>('('));
+        prefix->append(nested);
+        prefix->append(std::make_shared<ebnf::Terminal>(')'));
+
+        auto sum = std::make_shared<ebnf::Concatenation>();
+        sum->append(prefix);
+        sum->append(std::make_shared<ebnf::Terminal>('+'));
+
+        auto alternation = std::make_shared<ebnf::Alternation>();
+        alternation->append(sum);
+        alternation->append(prefix);
+
+        nested = alternation;
+    }
+
+    return nested;
+}
+
+BENCHMARK(EbnfParse)
+{
+    const std::shared_ptr<ebnf::ASymbol> grammar = createConfigGrammar();
+
+    for (std::size_t size : { 4u * 1024u, 1024u * 1024u })
+    {
+        const std::string text = createConfigText(size);
+
+        ebnf::ParseResult result{};
+
+        measure("parse config " + std::to_string(size / 1024u) + " KiB", { .warmup = 1u, .repetitions = 10u, .bytes = text.size() }, [&]() {
+            result = grammar->parse(text, 0u);
+            doNotOptimize(result);
+        });
+
+        if (!result.success || result.next_position != text.size())
+        {
+            printf("    parse stopped at %zu of %zu\n", result.next_position, text.size());
+        }
+
+        // Values are views of the text, so nothing is copied.
+        const uint64_t allocation_count = getAllocationCount();
+        result = grammar->parse(text, 0u);
+        doNotOptimize(result);
+        const uint64_t allocations = getAllocationCount() - allocation_count;
+
+        printf("    %llu heap allocations per parse\n", (unsigned long long)allocations);
+
+        if (allocations > 0u)
+        {
+            failBenchmark("parsing allocates from the heap");
+        }
+    }
+}
+
+BENCHMARK(EbnfPackrat)
+{
+    for (uint32_t depth : { 12u, 16u, 20u })
+    {
+        const std::shared_ptr<ebnf::ASymbol> grammar = createNestedGrammar(depth);
+        const std::string text = std::string(depth, '(') + "a" + std::string(depth, ')');
+
+        ebnf::ParseResult result{};
+
+        measure("nested depth " + std::to_string(depth), { .warmup = 1u, .repetitions = 10u }, [&]() {
+            result = grammar->parse(text, 0u);
+            doNotOptimize(result);
+        });
+
+        measure("nested depth " + std::to_string(depth) + " packrat", { .warmup = 1u, .repetitions = 10u }, [&]() {
+            result = grammar->parsePackrat(text, 0u);
+            doNotOptimize(result);
+        });
+
+        if (!result.success || result.next_position != text.size())
+        {
+            printf("    parse stopped at %zu of %zu\n", result.next_position, text.size());
+        }
+    }
+
+    // Overhead of the memo on a grammar without much backtracking.
+    const std::shared_ptr<ebnf::ASymbol> grammar = createConfigGrammar();
+    const std::string text = createConfigText(1024u * 1024u);
+
+    ebnf::ParseMemo memo{ text.size() };
+    ebnf::ParseResult result{};
+
+    measure("parse config 1024 KiB packrat", { .warmup = 1u, .repetitions = 10u, .bytes = text.size() }, [&]() {
+        memo.reset(text.size());
+
+        ebnf::ParseContext context{ &memo };
+        result = grammar->parse(text, 0u, context);
+        doNotOptimize(result);
+    });
+
+    if (!result.success || result.next_position != text.size())
+    {
+        printf("    parse stopped at %zu of %zu\n", result.next_position, text.size());
+    }
+}
+
+BENCHMARK(EbnfCompiled)
+{
+    struct Grammar
+    {
+        const char* name;
+        std::shared_ptr<ebnf::ASymbol> symbol;
+        std::string text;
+    };
+
+    const std::size_t size{ 1024u * 1024u };
+
+    for (const Grammar& grammar : { Grammar{ "config", createConfigGrammar(), createConfigText(size) }, Grammar{ "preprocessor", createPreprocessorGrammar(), createPreprocessorText(size) } })
+    {
+        const std::optional<ebnf::CompiledGrammar> compiled = ebnf::CompiledGrammar::compile(grammar.symbol);
+        if (!compiled.has_value())
+        {
+            failBenchmark(std::string("could not compile the ") + grammar.name + " grammar");
+
+            continue;
+        }
+
+        ebnf::ParseResult result{};
+        ebnf::ParseResult compiled_result{};
+
+        measure(std::string("parse ") + grammar.name + " 1024 KiB", { .warmup = 1u, .repetitions = 10u, .bytes = grammar.text.size() }, [&]() {
+            result = grammar.symbol->parse(grammar.text, 0u);
+            doNotOptimize(result);
+        });
+
+        measure(std::string("parse ") + grammar.name + " 1024 KiB compiled", { .warmup = 1u, .repetitions = 10u, .bytes = grammar.text.size() }, [&]() {
+            compiled_result = compiled->parse(grammar.text, 0u);
+            doNotOptimize(compiled_result);
+        });
+
+        printf("    %zu instructions\n", compiled->getInstructions().size());
+
+        if (!result.success || result.next_position != grammar.text.size())
+        {
+            printf("    parse stopped at %zu of %zu\n", result.next_position, grammar.text.size());
+        }
+
+        if (compiled_result != result)
+        {
+            failBenchmark(std::string("the compiled ") + grammar.name + " grammar parses differently");
+        }
+    }
+}
+
+BENCHMARK(EbnfCharacterClass)
+{
+    const std::size_t size{ 1024u * 1024u };
+
+    // Long identifiers and indentation, as in generated shader sources.
+    std::string identifiers{};
+    std::string whitespace{};
+    for (std::size_t i = 0u; identifiers.size() < size; i++)
+    {
+        identifiers += "g_material_parameters_" + std::to_string(i) + "_base_color_texture_coordinate_set ";
+        whitespace += std::string(64u + i % 64u, ' ') + "\t\n";
+    }
+
+    auto identifier_head = std::make_shared<ebnf::ListCharacterRule>("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz_0123456789");
+    auto blank = std::make_shared<ebnf::ListCharacterRule>(" \t\n");
+
+    // identifiers = { identifier_character, { identifier_character }, blank } ;
+    auto identifier = std::make_shared<ebnf::Concatenation>();
+    identifier->append(std::make_shared<ebnf::OneManyFactor>(identifier_head));
+    identifier->append(blank);
+    auto identifier_list = std::make_shared<ebnf::ZeroManyFactor>(identifier);
+
+    auto blanks = std::make_shared<ebnf::ZeroManyFactor>(blank);
+
+    ebnf::CharacterClass identifier_class = identifier_head->getCharacterClass();
+
+    std::size_t end_position{ 0u };
+
+    measure("scan identifier class 1024 KiB", { .warmup = 1u, .repetitions = 20u, .bytes = identifiers.size() }, [&]() {
+        std::size_t position{ 0u };
+        while (position < identifiers.size())
+        {
+            position = identifier_class.scan(identifiers, position) + 1u;
+        }
+        end_position = position;
+        doNotOptimize(end_position);
+    });
+
+    measure("scan identifier class 1024 KiB scalar", { .warmup = 1u, .repetitions = 20u, .bytes = identifiers.size() }, [&]() {
+        std::size_t position{ 0u };
+        while (position < identifiers.size())
+        {
+            while (position < identifiers.size() && identifier_class.contains(identifiers[position]))
+            {
+                position++;
+            }
+            position++;
+        }
+        end_position = position;
+        doNotOptimize(end_position);
+    });
+
+    ebnf::ParseResult result{};
+
+    measure("parse identifiers 1024 KiB", { .warmup = 1u, .repetitions = 20u, .bytes = identifiers.size() }, [&]() {
+        result = identifier_list->parse(identifiers, 0u);
+        doNotOptimize(result);
+    });
+
+    if (result.next_position != identifiers.size())
+    {
+        failBenchmark("the identifiers were not parsed completely");
+    }
+
+    measure("parse whitespace 1024 KiB", { .warmup = 1u, .repetitions = 20u, .bytes = whitespace.size() }, [&]() {
+        result = blanks->parse(whitespace, 0u);
+        doNotOptimize(result);
+    });
+
+    if (result.next_position != whitespace.size())
+    {
+        failBenchmark("the whitespace was not parsed completely");
+    }
+
+    measure("memchr 1024 KiB", { .warmup = 1u, .repetitions = 20u, .bytes = whitespace.size() }, [&]() {
+        const void* found = memchr(whitespace.data(), 'x', whitespace.size());
+        doNotOptimize(found);
+    });
+}
+
+BENCHMARK(EbnfIncremental)
+{
+    auto grammar = createConfigGrammar();
+    const std::string text = createConfigText(1024u * 1024u);
+
+    ebnf::IncrementalParser parser{ grammar, text };
+
+    ebnf::ParseResult result{};
+
+    measure("parse config 1024 KiB full", { .warmup = 0u, .repetitions = 10u, .bytes = text.size() }, [&]() {
+        parser.setText(text);
+        result = parser.parse();
+        doNotOptimize(result);
+    });
+
+    // Edits a value in the middle and at the end, alternating so the text stays the same.
+    const std::size_t middle = text.find(" = ", text.size() / 2u) + 3u;
+    const std::size_t end = text.rfind(" = ") + 3u;
+
+    uint32_t edit_count{ 0u };
+
+    for (const auto& [name, offset] : { std::pair{ "replace", middle }, std::pair{ "replace at end", end } })
+    {
+        measure(std::string("parse config 1024 KiB after ") + name, 100u, [&]() {
+            parser.edit(offset, 1u, edit_count++ % 2u == 0u ? "9" : std::string_view(text).substr(offset, 1u));
+            result = parser.parse();
+            doNotOptimize(result);
+        });
+    }
+
+    measure("parse config 1024 KiB after insert and remove", 100u, [&]() {
+        if (edit_count++ % 2u == 0u)
+        {
+            parser.edit(middle, 0u, "7");
+        }
+        else
+        {
+            parser.edit(middle, 1u, "");
+        }
+        result = parser.parse();
+        doNotOptimize(result);
+    });
+
+    if (parser.getText() != text || result.next_position != text.size())
+    {
+        failBenchmark("the incremental parse differs from the full one");
+    }
+}
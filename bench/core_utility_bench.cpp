@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "core/core.h"
+#include "cpu/cpu.h"
+
+#include "benchmark.h"
+
+// Compressible like typical baked assets: repeating structure with some noise.
+std::vector<std::uint8_t> createCompressibleData(std::size_t size)
+{
+    std::vector<std::uint8_t> data(size);
+
+    std::uint32_t state{ 12345u };
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (std::uint8_t)((i % 64u) * 3u + ((state >> 28u) & 0x3u));
+    }
+
+    return data;
+}
+
+// The previous gzipDecompress, growing the result by 16 KiB inserts, kept as the reference.
+std::vector<std::uint8_t> gzipDecompressChunked(const std::vector<std::uint8_t>& data)
+{
+    z_stream stream{};
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+
+    if (inflateInit2(&stream, 15 + 16) != Z_OK)
+    {
+        return {};
+    }
+
+    std::vector<std::uint8_t> decompressed{};
+    decompressed.reserve(data.size() * 2);
+
+    std::uint8_t buffer[16384]{};
+
+    int result{ Z_OK };
+    do
+    {
+        stream.next_out = buffer;
+        stream.avail_out = sizeof(buffer);
+
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result == Z_STREAM_ERROR || result == Z_DATA_ERROR || result == Z_MEM_ERROR)
+        {
+            inflateEnd(&stream);
+            return {};
+        }
+
+        decompressed.insert(decompressed.end(), buffer, buffer + sizeof(buffer) - stream.avail_out);
+    } while (stream.avail_out == 0);
+
+    inflateEnd(&stream);
+
+    return decompressed;
+}
+
+BENCHMARK(Gzip)
+{
+    const std::size_t size{ 64u * 1024u * 1024u };
+    const std::vector<std::uint8_t> data = createCompressibleData(size);
+    const double size_mb = (double)size / (1024.0 * 1024.0);
+
+    std::vector<std::uint8_t> compressed{};
+
+    BenchmarkResult result = measure("gzipCompress", 3u, [&]() {
+        compressed = gzipCompress(data);
+    });
+    printf("    %.1f MB/s, ratio %.3f\n", size_mb / (result.median_ms / 1000.0), (double)compressed.size() / (double)size);
+
+    result = measure("GzipCompressor 1 MB pushes", 3u, [&]() {
+        std::size_t compressed_size{ 0u };
+        GzipCompressor compressor([&compressed_size](std::span<const std::uint8_t> output) {
+            compressed_size += output.size();
+            return true;
+        });
+
+        for (std::size_t offset = 0u; offset < size; offset += 1024u * 1024u)
+        {
+            compressor.push(std::span<const std::uint8_t>(data).subspan(offset, 1024u * 1024u));
+        }
+        compressor.finish();
+    });
+    printf("    %.1f MB/s\n", size_mb / (result.median_ms / 1000.0));
+
+    // The calling thread takes part as well, so a pool of N workers compresses on up to N + 1 threads.
+    for (std::size_t number_threads : { 1u, 4u, 16u })
+    {
+        ThreadPool thread_pool(number_threads);
+
+        result = measure("gzipCompressParallel " + std::to_string(number_threads) + " workers", 3u, [&]() {
+            compressed = gzipCompressParallel(data.data(), data.size(), -1, 128u * 1024u, thread_pool);
+        });
+        printf("    %.1f MB/s, ratio %.3f\n", size_mb / (result.median_ms / 1000.0), (double)compressed.size() / (double)size);
+    }
+
+    result = measure("gzipDecompress", 3u, [&]() {
+        auto decompressed = gzipDecompress(compressed);
+    });
+    printf("    %.1f MB/s\n", size_mb / (result.median_ms / 1000.0));
+
+    result = measure("GzipDecompressor 1 MB pushes", 3u, [&]() {
+        std::size_t decompressed_size{ 0u };
+        GzipDecompressor decompressor([&decompressed_size](std::span<const std::uint8_t> output) {
+            decompressed_size += output.size();
+            return true;
+        });
+
+        for (std::size_t offset = 0u; offset < compressed.size(); offset += 1024u * 1024u)
+        {
+            decompressor.push(std::span<const std::uint8_t>(compressed).subspan(offset, std::min<std::size_t>(1024u * 1024u, compressed.size() - offset)));
+        }
+    });
+    printf("    %.1f MB/s\n", size_mb / (result.median_ms / 1000.0));
+}
+
+BENCHMARK(GzipDecompressInto)
+{
+    for (std::size_t size_mb : { 1u, 16u, 256u, 1024u })
+    {
+        const std::size_t size = size_mb * 1024u * 1024u;
+
+        std::vector<std::uint8_t> compressed{};
+        {
+            const std::vector<std::uint8_t> data = createCompressibleData(size);
+            compressed = gzipCompressParallel(data.data(), data.size(), 1);
+        }
+
+        const uint32_t repetitions = size_mb >= 256u ? 3u : 10u;
+        const std::string suffix = " " + std::to_string(size_mb) + " MB";
+
+        BenchmarkResult result = measure("chunked inserts" + suffix, repetitions, [&]() {
+            auto decompressed = gzipDecompressChunked(compressed);
+        });
+        printf("    %.1f MB/s\n", (double)size_mb / (result.median_ms / 1000.0));
+
+        result = measure("gzipDecompress" + suffix, repetitions, [&]() {
+            auto decompressed = gzipDecompress(compressed);
+        });
+        printf("    %.1f MB/s\n", (double)size_mb / (result.median_ms / 1000.0));
+
+        // Destination allocated once, like mapped staging memory
+        AlignedBuffer<std::uint8_t> destination(gzipDecompressedSize(compressed).value_or(0u));
+
+        result = measure("gzipDecompressInto" + suffix, repetitions, [&]() {
+            gzipDecompressInto(compressed, { destination.data(), destination.size() });
+        });
+        printf("    %.1f MB/s\n", (double)size_mb / (result.median_ms / 1000.0));
+    }
+}
+
+BENCHMARK(Base64)
+{
+    // Size of a large embedded glTF buffer
+    const std::size_t size{ 64u * 1024u * 1024u };
+    const double size_mb = (double)size / (1024.0 * 1024.0);
+
+    std::vector<std::uint8_t> data(size);
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        data[i] = (std::uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    std::string encoded(base64EncodedSize(size), '\0');
+
+    BenchmarkResult result = measure("base64EncodeInto", 10u, [&]() {
+        base64EncodeInto(data, encoded);
+    });
+    printf("    %.2f GB/s input\n", size_mb / 1024.0 / (result.median_ms / 1000.0));
+
+    result = measure("base64Encode", 10u, [&]() {
+        std::string output = base64Encode(data);
+    });
+    printf("    %.2f GB/s input\n", size_mb / 1024.0 / (result.median_ms / 1000.0));
+
+    std::vector<std::uint8_t> decoded(base64DecodedSize(encoded));
+
+    result = measure("base64DecodeInto", 10u, [&]() {
+        base64DecodeInto(encoded, decoded);
+    });
+    printf("    %.2f GB/s output, %.2f GB/s input\n", size_mb / 1024.0 / (result.median_ms / 1000.0), (double)encoded.size() / (1024.0 * 1024.0 * 1024.0) / (result.median_ms / 1000.0));
+
+    result = measure("base64Decode", 10u, [&]() {
+        std::vector<std::uint8_t> output = base64Decode(encoded);
+    });
+    printf("    %.2f GB/s output\n", size_mb / 1024.0 / (result.median_ms / 1000.0));
+}
+
+// The previous interleaveData, one memcpy per attribute and vertex, kept as the reference.
+void interleaveDataPerElement(const std::vector<RawData>& raw_data, std::uint8_t* destination)
+{
+    const std::size_t elements = raw_data[0].length / raw_data[0].stride;
+
+    std::size_t offset{ 0u };
+    for (std::size_t i = 0u; i < elements; i++)
+    {
+        for (std::size_t j = 0u; j < raw_data.size(); j++)
+        {
+            memcpy(destination + offset, raw_data[j].data + (raw_data[j].stride * i), raw_data[j].stride);
+
+            offset += raw_data[j].stride;
+        }
+    }
+}
+
+BENCHMARK(Interleave)
+{
+    // Positions, normals, tangents and uvs of a large scanned mesh
+    const std::size_t count{ 10u * 1000u * 1000u };
+
+    std::vector<float> positions(count * 3u, 1.0f);
+    std::vector<float> normals(count * 3u, 0.0f);
+    std::vector<float> tangents(count * 3u, 0.5f);
+    std::vector<float> uvs(count * 2u, 0.25f);
+
+    std::vector<RawData> raw_data{
+        { (const std::uint8_t*)positions.data(), positions.size() * sizeof(float), 3u * sizeof(float) },
+        { (const std::uint8_t*)normals.data(), normals.size() * sizeof(float), 3u * sizeof(float) },
+        { (const std::uint8_t*)tangents.data(), tangents.size() * sizeof(float), 3u * sizeof(float) },
+        { (const std::uint8_t*)uvs.data(), uvs.size() * sizeof(float), 2u * sizeof(float) }
+    };
+
+    const std::size_t stride{ 11u * sizeof(float) };
+    std::vector<std::uint8_t> interleaved(count * stride);
+    const double size_gb = (double)interleaved.size() / (1024.0 * 1024.0 * 1024.0);
+
+    BenchmarkResult result = measure("interleaveDataPerElement", 5u, [&]() {
+        interleaveDataPerElement(raw_data, interleaved.data());
+    });
+    printf("    %.2f GB/s output\n", size_gb / (result.median_ms / 1000.0));
+
+    result = measure("interleaveDataInto", 5u, [&]() {
+        interleaveDataInto(raw_data, interleaved.data(), interleaved.size());
+    });
+    printf("    %.2f GB/s output\n", size_gb / (result.median_ms / 1000.0));
+
+    std::vector<MutableRawData> mutable_raw_data{
+        { (std::uint8_t*)positions.data(), positions.size() * sizeof(float), 3u * sizeof(float) },
+        { (std::uint8_t*)normals.data(), normals.size() * sizeof(float), 3u * sizeof(float) },
+        { (std::uint8_t*)tangents.data(), tangents.size() * sizeof(float), 3u * sizeof(float) },
+        { (std::uint8_t*)uvs.data(), uvs.size() * sizeof(float), 2u * sizeof(float) }
+    };
+
+    result = measure("deinterleaveData", 5u, [&]() {
+        deinterleaveData(interleaved.data(), interleaved.size(), mutable_raw_data);
+    });
+    printf("    %.2f GB/s input\n", size_gb / (result.median_ms / 1000.0));
+}
+
+BENCHMARK(Scheduler)
+{
+    ThreadPool& thread_pool = getThreadPool();
+
+    printf("%u threads\n", (uint32_t)thread_pool.getNumberThreads());
+
+    std::vector<float> values(16u * 1024u * 1024u, 1.0f);
+
+    // Small grains stress the scheduler rather than the memory bandwidth.
+    for (std::size_t grain_size : { 1024u, 65536u })
+    {
+        thread_pool.resetWorkerStatistics();
+
+        BenchmarkResult result = measure("parallelReduce grain " + std::to_string(grain_size), 10u, [&]() {
+            float sum = thread_pool.parallelReduce(
+                values.size(), grain_size, 0.0f,
+                [&values](std::size_t begin, std::size_t end) {
+                    float partial{ 0.0f };
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        partial += values[i];
+                    }
+                    return partial;
+                },
+                [](float a, float b) { return a + b; });
+            (void)sum;
+        });
+        printf("    %.2f GB/s\n", (double)(values.size() * sizeof(float)) / (1024.0 * 1024.0 * 1024.0) / (result.median_ms / 1000.0));
+    }
+
+    thread_pool.resetWorkerStatistics();
+
+    measure("TaskGroup 10000 chained pairs", 10u, [&]() {
+        TaskGroup task_group(thread_pool);
+        for (std::size_t i = 0u; i < 10000u; i++)
+        {
+            TaskGroup::TaskId first = task_group.add([]() {});
+            task_group.add([]() {}, { first });
+        }
+    });
+
+    std::vector<ThreadPoolWorkerStatistics> statistics = thread_pool.getWorkerStatistics();
+    for (std::size_t i = 0u; i < statistics.size(); i++)
+    {
+        printf("    worker %zu: %llu tasks, %llu stolen, %.1f%% busy\n", i, (unsigned long long)statistics[i].executed_tasks, (unsigned long long)statistics[i].stolen_tasks, statistics[i].utilisation * 100.0);
+    }
+}
+
+BENCHMARK(FrameAllocations)
+{
+    // Transient CPU work of a frame: parsing a short command string and evaluating a small network
+    auto number = std::make_shared<ebnf::IntervalCharacterRule>('0', '9');
+
+    auto next_number = std::make_shared<ebnf::Concatenation>();
+    next_number->append(std::make_shared<ebnf::Terminal>(','));
+    next_number->append(number);
+
+    ebnf::Concatenation number_list{};
+    number_list.append(number);
+    number_list.append(std::make_shared<ebnf::ZeroManyFactor>(next_number));
+
+    std::string text = "0";
+    for (uint32_t i = 1u; i < 256u; i++)
+    {
+        text += "," + std::to_string(i * 7919u);
+    }
+
+    const ActivationFunction relu{ rectifiedLinearUnit, rectifiedLinearUnitDerivative };
+
+    MultiLayerPerceptron mlp(16u, true);
+    mlp.addLayer(32u, relu);
+    mlp.addLayer(4u, relu);
+    mlp.reset(InitializationMethod::KAIMING, 0.0f, 1u);
+
+    const std::vector<float> inputs(16u, 0.5f);
+
+    auto frame = [&](std::pmr::memory_resource* memory_resource) {
+        ebnf::ParseResult result = number_list.parse(text, 0u);
+        doNotOptimize(result);
+
+        std::pmr::vector<float> outputs = mlp.forwardPropagation(inputs, memory_resource);
+        doNotOptimize(outputs);
+    };
+
+    FrameArena frame_arena{};
+
+    struct Case
+    {
+        const char* name;
+        std::pmr::memory_resource* memory_resource;
+    };
+
+    for (const Case& frame_case : { Case{ "default resource", std::pmr::get_default_resource() }, Case{ "frame arena", &frame_arena } })
+    {
+        auto run_frame = [&]() {
+            frame_arena.reset();
+            frame(frame_case.memory_resource);
+        };
+
+        measure(std::string("frame, ") + frame_case.name, { .warmup = 10u, .repetitions = 1000u }, run_frame);
+
+        // Steady state, after the arena has grown to the size of a frame
+        const uint32_t frames{ 100u };
+
+        const uint64_t allocation_count = getAllocationCount();
+        for (uint32_t i = 0u; i < frames; i++)
+        {
+            run_frame();
+        }
+        const double allocations_per_frame = (double)(getAllocationCount() - allocation_count) / (double)frames;
+
+        printf("    %.1f heap allocations per frame\n", allocations_per_frame);
+
+        if (frame_case.memory_resource == &frame_arena)
+        {
+            printf("    %zu bytes per frame, %zu bytes capacity\n", frame_arena.getPeakBytes(), frame_arena.getCapacity());
+
+            if (allocations_per_frame > 0.0)
+            {
+                failBenchmark("frames using the frame arena allocate from the heap");
+            }
+        }
+    }
+}
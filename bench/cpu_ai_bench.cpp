@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "core/core.h"
+#include "cpu/cpu.h"
+
+#include "benchmark.h"
+
+BENCHMARK(MlpPropagation)
+{
+    // Small regression network, e.g. a learned material or radiance approximation
+    const std::size_t number_inputs{ 64u };
+    const std::size_t number_samples{ 256u };
+
+    const ActivationFunction relu{ rectifiedLinearUnit, rectifiedLinearUnitDerivative };
+    const ActivationFunction linear{ identity, identityDerivative };
+
+    MultiLayerPerceptron mlp(number_inputs, true);
+    mlp.addLayer(128u, relu);
+    mlp.addLayer(128u, relu);
+    mlp.addLayer(8u, linear);
+    mlp.reset(InitializationMethod::KAIMING, 0.0f, 123u);
+
+    const uint64_t parameters = 64u * 128u + 128u * 128u + 128u * 8u;
+
+    UniformRandomGenerator random(-1.0f, 1.0f, 99u);
+
+    std::vector<std::vector<float>> inputs(number_samples, std::vector<float>(number_inputs));
+    std::vector<std::vector<float>> targets(number_samples, std::vector<float>(8u));
+    for (std::size_t i = 0u; i < number_samples; i++)
+    {
+        for (float& input : inputs[i])
+        {
+            input = random.generate();
+        }
+        for (float& target : targets[i])
+        {
+            target = random.generate();
+        }
+    }
+
+    BenchmarkResult result = measure("forwardPropagation 64-128-128-8", { .warmup = 1u, .repetitions = 20u, .items = number_samples }, [&]() {
+        for (const std::vector<float>& input : inputs)
+        {
+            std::vector<float> output = mlp.forwardPropagation(input);
+            doNotOptimize(output);
+        }
+    });
+    printf("    %.2f GFLOP/s\n", 2.0 * (double)parameters * result.items_per_second / 1e9);
+
+    result = measure("backwardPropagation 64-128-128-8", { .warmup = 1u, .repetitions = 10u, .items = number_samples }, [&]() {
+        for (std::size_t i = 0u; i < number_samples; i++)
+        {
+            auto error = mlp.backwardPropagation(inputs[i], targets[i], 0.001f);
+            doNotOptimize(error);
+        }
+    });
+    // Forward, backward and the weight update, roughly three times the forward work
+    printf("    %.2f GFLOP/s\n", 6.0 * (double)parameters * result.items_per_second / 1e9);
+}
+
+BENCHMARK(MlpPropagation256)
+{
+    // Wide network, where the matrix kernels and not the per-neuron overhead dominate
+    const std::size_t width{ 256u };
+    const std::size_t number_samples{ 64u };
+
+    const ActivationFunction relu{ rectifiedLinearUnit, rectifiedLinearUnitDerivative };
+    const ActivationFunction linear{ identity, identityDerivative };
+
+    MultiLayerPerceptron mlp(width, true);
+    mlp.addLayer(width, relu);
+    mlp.addLayer(width, relu);
+    mlp.addLayer(width, linear);
+    mlp.reset(InitializationMethod::KAIMING, 0.0f, 123u);
+
+    const uint64_t parameters = 3u * width * width;
+
+    UniformRandomGenerator random(-1.0f, 1.0f, 99u);
+
+    std::vector<std::vector<float>> inputs(number_samples, std::vector<float>(width));
+    std::vector<std::vector<float>> targets(number_samples, std::vector<float>(width));
+    for (std::size_t i = 0u; i < number_samples; i++)
+    {
+        for (float& input : inputs[i])
+        {
+            input = random.generate();
+        }
+        for (float& target : targets[i])
+        {
+            target = random.generate();
+        }
+    }
+
+    BenchmarkResult result = measure("forwardPropagation 256-256-256-256", { .warmup = 1u, .repetitions = 20u, .items = number_samples }, [&]() {
+        for (const std::vector<float>& input : inputs)
+        {
+            std::vector<float> output = mlp.forwardPropagation(input);
+            doNotOptimize(output);
+        }
+    });
+    printf("    %.2f GFLOP/s\n", 2.0 * (double)parameters * result.items_per_second / 1e9);
+
+    result = measure("backwardPropagation 256-256-256-256", { .warmup = 1u, .repetitions = 10u, .items = number_samples }, [&]() {
+        for (std::size_t i = 0u; i < number_samples; i++)
+        {
+            auto error = mlp.backwardPropagation(inputs[i], targets[i], 0.0001f);
+            doNotOptimize(error);
+        }
+    });
+    printf("    %.2f GFLOP/s\n", 6.0 * (double)parameters * result.items_per_second / 1e9);
+}
+
+BENCHMARK(MlpTrainBatch)
+{
+    // Same wide network, trained per sample and in mini-batches
+    const std::size_t width{ 256u };
+    const std::size_t number_samples{ 256u };
+
+    const ActivationFunction relu{ rectifiedLinearUnit, rectifiedLinearUnitDerivative };
+    const ActivationFunction linear{ identity, identityDerivative };
+
+    MultiLayerPerceptron mlp(width, true);
+    mlp.addLayer(width, relu);
+    mlp.addLayer(width, relu);
+    mlp.addLayer(width, linear);
+    mlp.reset(InitializationMethod::KAIMING, 0.0f, 123u);
+
+    const uint64_t parameters = 3u * width * width;
+
+    UniformRandomGenerator random(-1.0f, 1.0f, 99u);
+
+    std::vector<float> inputs(number_samples * width);
+    std::vector<float> targets(number_samples * width);
+    for (float& input : inputs)
+    {
+        input = random.generate();
+    }
+    for (float& target : targets)
+    {
+        target = random.generate();
+    }
+
+    std::vector<float> input(width);
+    std::vector<float> target(width);
+    BenchmarkResult result = measure("backwardPropagation 256-256-256-256", { .warmup = 1u, .repetitions = 5u, .items = number_samples }, [&]() {
+        for (std::size_t i = 0u; i < number_samples; i++)
+        {
+            std::copy_n(inputs.data() + i * width, width, input.data());
+            std::copy_n(targets.data() + i * width, width, target.data());
+
+            auto error = mlp.backwardPropagation(input, target, 0.0001f);
+            doNotOptimize(error);
+        }
+    });
+    printf("    %.2f GFLOP/s\n", 6.0 * (double)parameters * result.items_per_second / 1e9);
+
+    for (std::size_t batch_size : { 16u, 64u, 256u })
+    {
+        std::uint32_t seed{ 0u };
+        result = measure("trainEpoch batch " + std::to_string(batch_size), { .warmup = 1u, .repetitions = 5u, .items = number_samples }, [&]() {
+            auto error = mlp.trainEpoch(inputs, targets, batch_size, 0.0001f, seed++);
+            doNotOptimize(error);
+        });
+        printf("    %.2f GFLOP/s\n", 6.0 * (double)parameters * result.items_per_second / 1e9);
+    }
+}
+
+BENCHMARK(MlpActivation)
+{
+    // One span call against the std::function per value, which layers with CUSTOM activations still use
+    const std::size_t count{ 1u << 16u };
+
+    UniformRandomGenerator random(-4.0f, 4.0f, 7u);
+
+    std::vector<float> inputs(count);
+    for (float& input : inputs)
+    {
+        input = random.generate();
+    }
+    std::vector<float> values(count);
+
+    const std::pair<Activation, std::string> activations[]{
+        { Activation::RECTIFIED_LINEAR_UNIT, "ReLU" },
+        { Activation::SIGMOID, "sigmoid" },
+        { Activation::HYPERBOLIC_TANGENT, "tanh" },
+        { Activation::GAUSSIAN_ERROR_LINEAR_UNIT, "GELU" }
+    };
+
+    for (const auto& [activation, name] : activations)
+    {
+        const ActivationFunction activation_function = createActivationFunction(activation);
+
+        measure("activate " + name, { .warmup = 1u, .repetitions = 20u, .items = count }, [&]() {
+            values = inputs;
+            activate(activation, values);
+            doNotOptimize(values);
+        });
+
+        measure("std::function " + name, { .warmup = 1u, .repetitions = 20u, .items = count }, [&]() {
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                values[i] = activation_function.function(inputs[i]);
+            }
+            doNotOptimize(values);
+        });
+    }
+}
+
+BENCHMARK(MlpTrainThreads)
+{
+    // Synthetic regression, a smooth function of the inputs, trained data-parallel on 1 to all threads of the pool
+    const std::size_t number_inputs{ 64u };
+    const std::size_t number_outputs{ 16u };
+    const std::size_t number_samples{ 4096u };
+
+    UniformRandomGenerator random(-1.0f, 1.0f, 5u);
+
+    std::vector<float> inputs(number_samples * number_inputs);
+    std::vector<float> targets(number_samples * number_outputs);
+    for (std::size_t i = 0u; i < number_samples; i++)
+    {
+        float sum{ 0.0f };
+        for (std::size_t j = 0u; j < number_inputs; j++)
+        {
+            inputs[i * number_inputs + j] = random.generate();
+            sum += inputs[i * number_inputs + j] * (float)(j % 7u);
+        }
+        for (std::size_t j = 0u; j < number_outputs; j++)
+        {
+            targets[i * number_outputs + j] = std::sin(sum * 0.05f + (float)j);
+        }
+    }
+
+    const uint64_t parameters = number_inputs * 256u + 256u * 256u + 256u * number_outputs;
+
+    std::vector<std::size_t> thread_counts{};
+    for (std::size_t number_threads = 1u; number_threads < getThreadPool().getNumberThreads(); number_threads *= 2u)
+    {
+        thread_counts.push_back(number_threads);
+    }
+    thread_counts.push_back(getThreadPool().getNumberThreads());
+
+    for (std::size_t number_threads : thread_counts)
+    {
+        MultiLayerPerceptron mlp(number_inputs, true);
+        mlp.addLayer(256u, createActivationFunction(Activation::GAUSSIAN_ERROR_LINEAR_UNIT));
+        mlp.addLayer(256u, createActivationFunction(Activation::GAUSSIAN_ERROR_LINEAR_UNIT));
+        mlp.addLayer(number_outputs, createActivationFunction(Activation::IDENTITY));
+        mlp.reset(InitializationMethod::KAIMING, 0.0f, 123u);
+        mlp.setNumberThreads(number_threads);
+
+        float error{ 0.0f };
+        std::uint32_t seed{ 0u };
+        BenchmarkResult result = measure("trainEpoch batch 256, " + std::to_string(number_threads) + " threads", { .warmup = 1u, .repetitions = 5u, .items = number_samples }, [&]() {
+            error = mlp.trainEpoch(inputs, targets, 256u, 0.01f, seed++).value_or(0.0f);
+        });
+        printf("    %.2f GFLOP/s, error %.5f\n", 6.0 * (double)parameters * result.items_per_second / 1e9, error);
+    }
+}
+
+BENCHMARK(MlpOptimizers)
+{
+    // Learning rates of the convergence runs below, plain gradient descent at its largest stable one
+    const std::tuple<std::string, std::function<std::shared_ptr<AOptimizer>()>, float> optimizers[]{
+        { "SGD", []() { return std::make_shared<SgdOptimizer>(); }, 0.1f },
+        { "momentum", []() { return std::make_shared<SgdOptimizer>(0.9f); }, 0.01f },
+        { "RMSProp", []() { return std::make_shared<RmsPropOptimizer>(); }, 0.001f },
+        { "Adam", []() { return std::make_shared<AdamOptimizer>(); }, 0.002f },
+        { "AdamW", []() { return std::make_shared<AdamWOptimizer>(); }, 0.002f }
+    };
+
+    // One fused update pass over a million parameters, against the axpy of the inline gradient descent
+    const std::size_t number_parameters{ 1u << 20u };
+
+    AlignedBuffer<float> parameters(number_parameters, 0.5f);
+    AlignedBuffer<float> gradients(number_parameters, 0.25f);
+
+    measure("axpy", { .warmup = 1u, .repetitions = 20u, .items = number_parameters }, [&]() {
+        axpy(number_parameters, -0.001f, gradients.data(), parameters.data());
+        doNotOptimize(parameters);
+    });
+
+    for (const auto& [name, create, learning_rate] : optimizers)
+    {
+        std::shared_ptr<AOptimizer> optimizer = create();
+        OptimizerState state{};
+
+        measure(name + " update", { .warmup = 1u, .repetitions = 20u, .items = number_parameters }, [&]() {
+            optimizer->beginStep();
+            optimizer->update({ parameters.data(), number_parameters }, { gradients.data(), number_parameters }, 1.0f, 0.001f, state);
+            doNotOptimize(parameters);
+        });
+    }
+
+    // Epochs and wall time until a synthetic regression reaches the target error
+    const std::size_t number_inputs{ 8u };
+    const std::size_t number_samples{ 1024u };
+    const std::uint32_t maximum_epochs{ 1000u };
+    const float target_error{ 0.0005f };
+
+    UniformRandomGenerator random(-1.0f, 1.0f, 11u);
+
+    std::vector<float> inputs(number_samples * number_inputs);
+    std::vector<float> targets(number_samples);
+    for (std::size_t i = 0u; i < number_samples; i++)
+    {
+        float sum{ 0.0f };
+        for (std::size_t j = 0u; j < number_inputs; j++)
+        {
+            inputs[i * number_inputs + j] = random.generate();
+            sum += inputs[i * number_inputs + j] * (float)(j % 3u + 1u);
+        }
+        targets[i] = 0.5f * std::sin(sum * 0.5f);
+    }
+
+    for (const auto& [name, create, learning_rate] : optimizers)
+    {
+        std::uint32_t epochs{ 0u };
+        float error{ 0.0f };
+        measure(name + " until converged, batch 32", { .warmup = 0u, .repetitions = 3u }, [&]() {
+            MultiLayerPerceptron mlp(number_inputs, true);
+            mlp.addLayer(64u, createActivationFunction(Activation::HYPERBOLIC_TANGENT));
+            mlp.addLayer(64u, createActivationFunction(Activation::HYPERBOLIC_TANGENT));
+            mlp.addLayer(1u, createActivationFunction(Activation::IDENTITY));
+            mlp.reset(InitializationMethod::UNIFORM_XAVIER, 0.0f, 123u);
+            if (name != "SGD")
+            {
+                mlp.setOptimizer(create());
+            }
+
+            for (epochs = 1u; epochs <= maximum_epochs; epochs++)
+            {
+                error = mlp.trainEpoch(inputs, targets, 32u, learning_rate, epochs).value_or(0.0f);
+                if (error < target_error)
+                {
+                    break;
+                }
+            }
+        });
+        printf("    %u epochs, error %.5f\n", std::min(epochs, maximum_epochs), error);
+    }
+}
@@ -0,0 +1,37 @@
+#include <vector>
+
+#include "cpu/cpu.h"
+
+#include "benchmark.h"
+
+BENCHMARK(MeshGenerator)
+{
+    std::size_t vertices{ 0u };
+
+    measure("createSphere 256x512", { .warmup = 1u, .repetitions = 10u, .items = 257u * 513u }, [&]() {
+        MeshData mesh_data = createSphere(1.0f, 256u, 512u);
+        vertices = mesh_data.positions.size();
+        doNotOptimize(vertices);
+    });
+
+    measure("createTorus 512x256", { .warmup = 1u, .repetitions = 10u, .items = 513u * 257u }, [&]() {
+        MeshData mesh_data = createTorus(1.0f, 0.25f, 512u, 256u);
+        vertices = mesh_data.positions.size();
+        doNotOptimize(vertices);
+    });
+
+    measure("createPlane 512x512", { .warmup = 1u, .repetitions = 10u, .items = 513u * 513u }, [&]() {
+        MeshData mesh_data = createPlane(1.0f, 1.0f, 512u, 512u);
+        vertices = mesh_data.positions.size();
+        doNotOptimize(vertices);
+    });
+
+    // Many small meshes, dominated by allocations
+    measure("createCube x10000", { .warmup = 1u, .repetitions = 10u, .items = 10000u }, [&]() {
+        for (uint32_t i = 0u; i < 10000u; i++)
+        {
+            MeshData mesh_data = createCube(1.0f);
+            doNotOptimize(mesh_data);
+        }
+    });
+}
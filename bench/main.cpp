@@ -0,0 +1,287 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace
+{
+
+struct RecordedResult
+{
+    std::string benchmark{};
+
+    BenchmarkResult result{};
+};
+
+const char* g_current_benchmark{ "" };
+
+std::vector<RecordedResult> g_results{};
+
+bool g_failed{ false };
+
+std::string getKey(const std::string& benchmark, const std::string& name)
+{
+    return benchmark + "/" + name;
+}
+
+bool saveResults(const std::string& filename)
+{
+    nlohmann::json benchmarks = nlohmann::json::array();
+
+    for (const RecordedResult& recorded : g_results)
+    {
+        const BenchmarkResult& result = recorded.result;
+
+        benchmarks.push_back({ { "benchmark", recorded.benchmark },
+                               { "name", result.name },
+                               { "warmup", result.warmup },
+                               { "repetitions", result.repetitions },
+                               { "median_ms", result.median_ms },
+                               { "min_ms", result.min_ms },
+                               { "p99_ms", result.p99_ms },
+                               { "items_per_second", result.items_per_second },
+                               { "bytes_per_second", result.bytes_per_second } });
+    }
+
+    nlohmann::json json{};
+    json["benchmarks"] = std::move(benchmarks);
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << json.dump(4) << "\n";
+
+    return file.good();
+}
+
+// Compares the medians of the measurements present in both runs. Returns the number of regressions, -1 on error.
+int32_t compareResults(const std::string& filename, double threshold)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return -1;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.contains("benchmarks") || !json["benchmarks"].is_array())
+    {
+        return -1;
+    }
+
+    std::map<std::string, double> baseline{};
+    for (const nlohmann::json& entry : json["benchmarks"])
+    {
+        if (entry.value("benchmark", nlohmann::json()).is_string() && entry.value("name", nlohmann::json()).is_string() && entry.value("median_ms", nlohmann::json()).is_number())
+        {
+            baseline[getKey(entry["benchmark"].get<std::string>(), entry["name"].get<std::string>())] = entry["median_ms"].get<double>();
+        }
+    }
+
+    printf("\nBaseline %s, threshold %+.1f%%\n", filename.c_str(), threshold * 100.0);
+
+    int32_t regressions{ 0 };
+    for (const RecordedResult& recorded : g_results)
+    {
+        const std::string key = getKey(recorded.benchmark, recorded.result.name);
+
+        auto it = baseline.find(key);
+        if (it == baseline.end() || it->second <= 0.0)
+        {
+            printf("  %-64s new\n", key.c_str());
+
+            continue;
+        }
+
+        const double change = recorded.result.median_ms / it->second - 1.0;
+        const bool regressed = change > threshold;
+        if (regressed)
+        {
+            regressions++;
+        }
+
+        printf("  %-64s %10.3f ms -> %10.3f ms  %+7.1f%%%s\n", key.c_str(), it->second, recorded.result.median_ms, change * 100.0, regressed ? "  REGRESSION" : "");
+    }
+
+    return regressions;
+}
+
+} // namespace
+
+std::vector<std::pair<const char*, void (*)()>>& getBenchmarks()
+{
+    static std::vector<std::pair<const char*, void (*)()>> benchmarks{};
+
+    return benchmarks;
+}
+
+bool registerBenchmark(const char* name, void (*function)())
+{
+    getBenchmarks().emplace_back(name, function);
+
+    return true;
+}
+
+BenchmarkResult measure(const std::string& name, const BenchmarkOptions& options, const std::function<void()>& function)
+{
+    BenchmarkResult result{};
+    result.name = name;
+    result.warmup = options.warmup;
+    result.repetitions = std::max(options.repetitions, 1u);
+
+    for (uint32_t i = 0u; i < result.warmup; i++)
+    {
+        function();
+    }
+
+    std::vector<double> timings_ms{};
+    timings_ms.reserve(result.repetitions);
+
+    for (uint32_t i = 0u; i < result.repetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        auto stop = std::chrono::steady_clock::now();
+
+        timings_ms.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+
+    std::sort(timings_ms.begin(), timings_ms.end());
+
+    // Nearest rank, so with less than 100 runs this is the slowest one.
+    const std::size_t p99_index = (std::size_t)std::ceil(0.99 * (double)timings_ms.size()) - 1u;
+
+    result.median_ms = timings_ms[timings_ms.size() / 2u];
+    result.min_ms = timings_ms.front();
+    result.p99_ms = timings_ms[p99_index];
+
+    if (result.median_ms > 0.0)
+    {
+        result.items_per_second = (double)options.items / (result.median_ms / 1000.0);
+        result.bytes_per_second = (double)options.bytes / (result.median_ms / 1000.0);
+    }
+
+    printf("%-48s median %10.3f ms  min %10.3f ms  p99 %10.3f ms  (%u runs)\n", result.name.c_str(), result.median_ms, result.min_ms, result.p99_ms, result.repetitions);
+    if (options.items > 0u)
+    {
+        printf("    %.3f M items/s\n", result.items_per_second / 1000000.0);
+    }
+    if (options.bytes > 0u)
+    {
+        printf("    %.1f MB/s\n", result.bytes_per_second / (1024.0 * 1024.0));
+    }
+
+    g_results.push_back({ g_current_benchmark, result });
+
+    return result;
+}
+
+BenchmarkResult measure(const std::string& name, uint32_t repetitions, const std::function<void()>& function)
+{
+    BenchmarkOptions options{};
+    options.warmup = 0u;
+    options.repetitions = repetitions;
+
+    return measure(name, options, function);
+}
+
+void failBenchmark(const std::string& message)
+{
+    printf("    FAILED: %s\n", message.c_str());
+
+    g_failed = true;
+}
+
+// Usage: PlaygroundSDK_bench [substring] [--json results.json] [--baseline baseline.json] [--threshold 0.1]
+// Runs all registered benchmarks, or only those whose name contains the substring.
+// --json writes all measurements. --baseline compares the medians with an earlier --json output and
+// fails if one is slower by more than the threshold, a fraction of the baseline median.
+int main(int argc, char* argv[])
+{
+    const char* filter{ nullptr };
+    const char* json_filename{ nullptr };
+    const char* baseline_filename{ nullptr };
+    double threshold{ 0.1 };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--json") == 0 && has_value)
+        {
+            json_filename = argv[++i];
+        }
+        else if (strcmp(argv[i], "--baseline") == 0 && has_value)
+        {
+            baseline_filename = argv[++i];
+        }
+        else if (strcmp(argv[i], "--threshold") == 0 && has_value)
+        {
+            threshold = atof(argv[++i]);
+        }
+        else if (strncmp(argv[i], "--", 2) != 0 && !filter)
+        {
+            filter = argv[i];
+        }
+        else
+        {
+            printf("Usage: %s [substring] [--json results.json] [--baseline baseline.json] [--threshold 0.1]\n", argv[0]);
+
+            return 2;
+        }
+    }
+
+    for (const auto& [name, function] : getBenchmarks())
+    {
+        if (filter && !strstr(name, filter))
+        {
+            continue;
+        }
+
+        printf("[%s]\n", name);
+
+        g_current_benchmark = name;
+        function();
+    }
+
+    if (json_filename && !saveResults(json_filename))
+    {
+        printf("Could not write %s\n", json_filename);
+
+        return 2;
+    }
+
+    if (baseline_filename)
+    {
+        const int32_t regressions = compareResults(baseline_filename, threshold);
+        if (regressions < 0)
+        {
+            printf("Could not read %s\n", baseline_filename);
+
+            return 2;
+        }
+
+        if (regressions > 0)
+        {
+            printf("%d regression(s)\n", regressions);
+
+            return 1;
+        }
+    }
+
+    return g_failed ? 1 : 0;
+}
@@ -202,7 +202,7 @@ bool Application::update(double delta_time, VkCommandBuffer command_buffer)
         return false;
     }
 
-    std::vector<uint8_t> content{};
+    AlignedBuffer<uint8_t> content{};
     bool read_result = deviceToHost<uint8_t>(m_device, staging_buffer->device_memory, 0u, c_buffer_size, content);
 
     destroyResource(m_device, *staging_buffer);
@@ -278,7 +278,7 @@ bool Application::update(double delta_time, VkCommandBuffer command_buffer)
     vkCmdSetScissor(command_buffer, 0u, 1u, &scissor);
 
     // Render the object
-    m_renderable->render(command_buffer);
+    m_renderable->render(command_buffer, &getFrameArena());
 
     m_vulkan_window.endRendering();
 
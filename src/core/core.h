@@ -10,6 +10,7 @@
 
 // io
 
+#include "io/MappedFile.h"
 #include "io/binary_data.h"
 #include "io/filesystem.h"
 
@@ -36,7 +37,12 @@
 
 // utility
 
+#include "utility/AlignedBuffer.h"
 #include "utility/DeltaTime.h"
+#include "utility/FrameArena.h"
+#include "utility/Profiler.h"
+#include "utility/TaskGroup.h"
+#include "utility/ThreadPool.h"
 #include "utility/base64.h"
 #include "utility/convert.h"
 #include "utility/generator.h"
@@ -56,6 +62,11 @@
 // image
 
 #include "image/image_data.h"
+#include "image/image_filter.h"
+#include "image/image_loader.h"
+#include "image/image_pixels.h"
+#include "image/image_resample.h"
+#include "image/image_view.h"
 
 // parser
 
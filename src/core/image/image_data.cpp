@@ -3,13 +3,11 @@
 #include <algorithm>
 #include <cstring>
 
-#include <OpenImageIO/imagebuf.h>
-#include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/imageio.h>
-#include <OpenImageIO/span.h>
 
-#include "core/color/convert.h"
-#include "core/math/matrix.h"
+#include "core/image/image_filter.h"
+#include "core/image/image_view.h"
 
 // Color space string conventions follow the ASWF Color Interop Forum recommendations:
 // https://github.com/AcademySoftwareFoundation/ColorInterop/blob/main/Recommendations/01_TextureAssetColorSpaces/TextureAssetColorSpaces.md
@@ -51,35 +49,12 @@ OIIO::TypeDesc getChannelFormat(ChannelFormat channel_format)
     return OIIO::TypeDesc::UNKNOWN;
 }
 
-//
-
-uint32_t getChannelFormatSize(ChannelFormat channel_format)
+namespace
 {
-    if (channel_format == ChannelFormat::UNORM)
-    {
-        return 1u;
-    }
-    if (channel_format == ChannelFormat::SHALF)
-    {
-        return 2u;
-    }
-    if (channel_format == ChannelFormat::SFLOAT)
-    {
-        return 4u;
-    }
-
-    return 0u;
-}
 
-std::optional<ImageData> loadImageData(const char* filename)
+std::optional<ImageData> readImageData(OIIO::ImageInput& image_input)
 {
-    auto image_input = OIIO::ImageInput::open(filename);
-    if (!image_input)
-    {
-        return {};
-    }
-
-    const OIIO::ImageSpec& image_spec = image_input->spec();
+    const OIIO::ImageSpec& image_spec = image_input.spec();
     const OIIO::ParamValue* color_space_parameter = image_spec.find_attribute("oiio:ColorSpace", OIIO::TypeDesc::STRING);
     if (!color_space_parameter)
     {
@@ -187,8 +162,8 @@ std::optional<ImageData> loadImageData(const char* filename)
 
     image_data.pixels.resize(image_data.width * image_data.height * image_data.channels * channel_size);
 
-    image_input->read_image(0, 0, 0, image_data.channels, image_spec.format, image_data.pixels.data());
-    image_input->close();
+    image_input.read_image(0, 0, 0, image_data.channels, image_spec.format, image_data.pixels.data());
+    image_input.close();
 
     // Note: OpenImageIO loads images with top-left origin (standard for PNG/JPEG).
     // This matches Vulkan/glTF convention where UV (0,0) = top-left.
@@ -198,10 +173,68 @@ std::optional<ImageData> loadImageData(const char* filename)
     return image_data;
 }
 
-bool saveImageData(const char* filename, const ImageData& image_data)
+} // namespace
+
+//
+
+uint32_t getChannelFormatSize(ChannelFormat channel_format)
 {
-    OIIO::TypeDesc format = getChannelFormat(image_data.channel_format);
-    if (format == OIIO::TypeDesc::UNKNOWN)
+    if (channel_format == ChannelFormat::UNORM)
+    {
+        return 1u;
+    }
+    if (channel_format == ChannelFormat::SHALF)
+    {
+        return 2u;
+    }
+    if (channel_format == ChannelFormat::SFLOAT)
+    {
+        return 4u;
+    }
+
+    return 0u;
+}
+
+bool isValidImageData(const ImageData& image_data)
+{
+    uint32_t channel_size = getChannelFormatSize(image_data.channel_format);
+    if (channel_size == 0u || image_data.channels < 1u || image_data.channels > 4u || image_data.width == 0u || image_data.height == 0u)
+    {
+        return false;
+    }
+
+    return image_data.pixels.size() == (std::size_t)image_data.width * image_data.height * image_data.channels * channel_size;
+}
+
+std::optional<ImageData> loadImageData(const char* filename)
+{
+    auto image_input = OIIO::ImageInput::open(filename);
+    if (!image_input)
+    {
+        return {};
+    }
+
+    return readImageData(*image_input);
+}
+
+std::optional<ImageData> loadImageData(const char* filename, const uint8_t* data, std::size_t size)
+{
+    // The file content is already in memory, so only decoding happens here.
+    OIIO::Filesystem::IOMemReader memory_reader((const void*)data, size);
+
+    auto image_input = OIIO::ImageInput::open(filename, nullptr, &memory_reader);
+    if (!image_input)
+    {
+        return {};
+    }
+
+    return readImageData(*image_input);
+}
+
+bool saveImageData(const char* filename, const ImageView& image_view)
+{
+    OIIO::TypeDesc format = getChannelFormat(image_view.channel_format);
+    if (format == OIIO::TypeDesc::UNKNOWN || !isValidImageView(image_view))
     {
         return false;
     }
@@ -212,63 +245,63 @@ bool saveImageData(const char* filename, const ImageData& image_data)
         return false;
     }
 
-    OIIO::ImageSpec image_spec{ (int)image_data.width, (int)image_data.height, (int)image_data.channels, format };
+    OIIO::ImageSpec image_spec{ (int)image_view.width, (int)image_view.height, (int)image_view.channels, format };
 
     std::string color_space{};
-    if (image_data.primaries == ColorPrimaries::REC709)
+    if (image_view.primaries == ColorPrimaries::REC709)
     {
-        if (image_data.transfer == TransferFunction::LINEAR && image_data.image_state == ImageState::SCENE)
+        if (image_view.transfer == TransferFunction::LINEAR && image_view.image_state == ImageState::SCENE)
         {
             color_space = "lin_rec709_scene";
         }
-        else if (image_data.transfer == TransferFunction::LINEAR && image_data.image_state == ImageState::DISPLAY)
+        else if (image_view.transfer == TransferFunction::LINEAR && image_view.image_state == ImageState::DISPLAY)
         {
             color_space = "lin_rec709_display";
         }
-        else if (image_data.transfer == TransferFunction::SRGB && image_data.image_state == ImageState::SCENE)
+        else if (image_view.transfer == TransferFunction::SRGB && image_view.image_state == ImageState::SCENE)
         {
             color_space = "srgb_rec709_scene";
         }
-        else if (image_data.transfer == TransferFunction::SRGB && image_data.image_state == ImageState::DISPLAY)
+        else if (image_view.transfer == TransferFunction::SRGB && image_view.image_state == ImageState::DISPLAY)
         {
             color_space = "srgb_rec709_display";
         }
-        else if (image_data.transfer == TransferFunction::GAMMA18 && image_data.image_state == ImageState::SCENE)
+        else if (image_view.transfer == TransferFunction::GAMMA18 && image_view.image_state == ImageState::SCENE)
         {
             color_space = "g18_rec709_scene";
         }
-        else if (image_data.transfer == TransferFunction::GAMMA22 && image_data.image_state == ImageState::SCENE)
+        else if (image_view.transfer == TransferFunction::GAMMA22 && image_view.image_state == ImageState::SCENE)
         {
             color_space = "g22_rec709_scene";
         }
-        else if (image_data.transfer == TransferFunction::GAMMA22 && image_data.image_state == ImageState::DISPLAY)
+        else if (image_view.transfer == TransferFunction::GAMMA22 && image_view.image_state == ImageState::DISPLAY)
         {
             color_space = "g22_rec709_display";
         }
-        else if (image_data.transfer == TransferFunction::GAMMA24 && image_data.image_state == ImageState::DISPLAY)
+        else if (image_view.transfer == TransferFunction::GAMMA24 && image_view.image_state == ImageState::DISPLAY)
         {
             color_space = "g24_rec709_display";
         }
-        else if (image_data.transfer == TransferFunction::SRGBE)
+        else if (image_view.transfer == TransferFunction::SRGBE)
         {
             color_space = "scRGB";
         }
     }
-    else if (image_data.primaries == ColorPrimaries::REC2020)
+    else if (image_view.primaries == ColorPrimaries::REC2020)
     {
-        if (image_data.transfer == TransferFunction::LINEAR && image_data.image_state == ImageState::SCENE)
+        if (image_view.transfer == TransferFunction::LINEAR && image_view.image_state == ImageState::SCENE)
         {
             color_space = "lin_rec2020_scene";
         }
-        else if (image_data.transfer == TransferFunction::LINEAR && image_data.image_state == ImageState::DISPLAY)
+        else if (image_view.transfer == TransferFunction::LINEAR && image_view.image_state == ImageState::DISPLAY)
         {
             color_space = "lin_rec2020_display";
         }
-        else if (image_data.transfer == TransferFunction::ST2084_PQ)
+        else if (image_view.transfer == TransferFunction::ST2084_PQ)
         {
             color_space = "pq_rec2020_display";
         }
-        else if (image_data.transfer == TransferFunction::HLG)
+        else if (image_view.transfer == TransferFunction::HLG)
         {
             color_space = "hlg_rec2020_display";
         }
@@ -283,12 +316,17 @@ bool saveImageData(const char* filename, const ImageData& image_data)
     // No flipping needed - write directly.
 
     image_output->open(filename, image_spec);
-    image_output->write_image(image_spec.format, image_data.pixels.data());
+    image_output->write_image(image_spec.format, image_view.data, OIIO::AutoStride, (OIIO::stride_t)image_view.row_pitch);
     image_output->close();
 
     return true;
 }
 
+bool saveImageData(const char* filename, const ImageData& image_data)
+{
+    return saveImageData(filename, makeImageView(image_data));
+}
+
 std::optional<ImageData> convertImageDataChannels(uint32_t channels, const ImageData& image_data)
 {
     if (channels < 1u || channels > 4u)
@@ -301,15 +339,11 @@ std::optional<ImageData> convertImageDataChannels(uint32_t channels, const Image
         return image_data;
     }
 
-    OIIO::TypeDesc format = getChannelFormat(image_data.channel_format);
-    if (format == OIIO::TypeDesc::UNKNOWN)
+    uint32_t channel_size = getChannelFormatSize(image_data.channel_format);
+    if (channel_size == 0u)
     {
         return {};
     }
-    uint32_t channel_size = getChannelFormatSize(image_data.channel_format);
-
-    OIIO::ImageSpec image_spec{ (int)image_data.width, (int)image_data.height, (int)image_data.channels, format };
-    OIIO::ImageBuf image_buf(image_spec, (void*)image_data.pixels.data());
 
     ImageData converted_image_data{};
     converted_image_data.width = image_data.width;
@@ -321,41 +355,50 @@ std::optional<ImageData> convertImageDataChannels(uint32_t channels, const Image
     converted_image_data.image_state = image_data.image_state;
     converted_image_data.pixels.resize(converted_image_data.width * converted_image_data.height * converted_image_data.channels * channel_size);
 
-    OIIO::ImageSpec converted_image_spec{ (int)converted_image_data.width, (int)converted_image_data.height, (int)converted_image_data.channels, format };
-    OIIO::ImageBuf converted_image_buf(converted_image_spec, (void*)converted_image_data.pixels.data());
-
-    std::vector<float> colors{ 0.0f, 0.0f, 0.0f, 1.0f };
-    for (uint32_t y = 0u; y < converted_image_data.height; y++)
+    if (!convertImageChannels(makeImageView(image_data), makeMutableImageView(converted_image_data)))
     {
-        for (uint32_t x = 0u; x < converted_image_data.width; x++)
-        {
-            for (uint32_t c = 0u; c < converted_image_data.channels; c++)
-            {
-                if (c < image_data.channels)
-                {
-                    colors[c] = image_buf.getchannel(x, y, 0, c);
-                }
-            }
-
-            converted_image_buf.setpixel(x, y, 0, OIIO::cspan<float>(colors));
-        }
+        return {};
     }
 
     return converted_image_data;
 }
 
-std::optional<ImageData> convertImageDataColorSpace(ColorPrimaries primaries, TransferFunction transfer, ImageState image_state, const ImageData& image_data)
+std::optional<ImageData> convertImageDataChannels(uint32_t channels, ImageData&& image_data)
 {
-    OIIO::TypeDesc format = getChannelFormat(image_data.channel_format);
-    if (format == OIIO::TypeDesc::UNKNOWN)
+    if (channels < 1u || channels > 4u)
     {
         return {};
     }
-    uint32_t channel_size = getChannelFormatSize(image_data.channel_format);
 
-    OIIO::ImageSpec image_spec{ (int)image_data.width, (int)image_data.height, (int)image_data.channels, format };
-    OIIO::ImageBuf image_buf(image_spec, (void*)image_data.pixels.data());
+    if (channels == image_data.channels)
+    {
+        return std::move(image_data);
+    }
+
+    // Dropping channels fits into the existing buffer
+    if (channels < image_data.channels && isValidImageData(image_data))
+    {
+        MutableImageView source = makeMutableImageView(image_data);
+        MutableImageView destination = source;
+        destination.channels = channels;
+        destination.row_pitch = (std::size_t)image_data.width * getPixelSize(destination);
+
+        if (!convertImageChannels(source, destination))
+        {
+            return {};
+        }
+
+        image_data.channels = channels;
+        image_data.pixels.resize(destination.row_pitch * image_data.height);
+
+        return std::move(image_data);
+    }
+
+    return convertImageDataChannels(channels, static_cast<const ImageData&>(image_data));
+}
 
+std::optional<ImageData> convertImageDataColorSpace(ColorPrimaries primaries, TransferFunction transfer, ImageState image_state, const ImageData& image_data)
+{
     ImageData converted_image_data{};
     converted_image_data.width = image_data.width;
     converted_image_data.height = image_data.height;
@@ -364,148 +407,34 @@ std::optional<ImageData> convertImageDataColorSpace(ColorPrimaries primaries, Tr
     converted_image_data.primaries = primaries;
     converted_image_data.transfer = transfer;
     converted_image_data.image_state = image_state;
-    converted_image_data.pixels.resize(converted_image_data.width * converted_image_data.height * converted_image_data.channels * channel_size);
+    converted_image_data.pixels.resize(image_data.pixels.size());
 
-    OIIO::ImageSpec converted_image_spec{ (int)converted_image_data.width, (int)converted_image_data.height, (int)converted_image_data.channels, format };
-    OIIO::ImageBuf converted_image_buf(converted_image_spec, (void*)converted_image_data.pixels.data());
-
-    //
-
-    float3x3 to_xyz{};
-    switch (image_data.primaries)
+    if (!convertImageColorSpace(makeImageView(image_data), makeMutableImageView(converted_image_data)))
     {
-        case ColorPrimaries::REC709:
-            to_xyz = rgbToXYZ(COLOR_PRIMARY_REC709);
-            break;
-        case ColorPrimaries::REC2020:
-            to_xyz = rgbToXYZ(COLOR_PRIMARY_REC2020);
-            break;
-        case ColorPrimaries::UNKNOWN:
-        default:
-            return {};
+        return {};
     }
 
-    float3x3 from_xyz{};
-    switch (converted_image_data.primaries)
-    {
-        case ColorPrimaries::REC709:
-            from_xyz = inverse(rgbToXYZ(COLOR_PRIMARY_REC709));
-            break;
-        case ColorPrimaries::REC2020:
-            from_xyz = inverse(rgbToXYZ(COLOR_PRIMARY_REC2020));
-            break;
-        case ColorPrimaries::UNKNOWN:
-        default:
-            return {};
-    }
+    return converted_image_data;
+}
 
-    const float3x3 conversion = from_xyz * to_xyz;
+std::optional<ImageData> convertImageDataColorSpace(ColorPrimaries primaries, TransferFunction transfer, ImageState image_state, ImageData&& image_data)
+{
+    MutableImageView source = makeMutableImageView(image_data);
+    MutableImageView destination = source;
+    destination.primaries = primaries;
+    destination.transfer = transfer;
+    destination.image_state = image_state;
 
-    std::vector<float> colors{ 0.0f, 0.0f, 0.0f, 1.0f };
-    for (uint32_t y = 0u; y < converted_image_data.height; y++)
+    if (!convertImageColorSpace(source, destination))
     {
-        for (uint32_t x = 0u; x < converted_image_data.width; x++)
-        {
-            for (uint32_t c = 0u; c < converted_image_data.channels; c++)
-            {
-                if (c < image_data.channels)
-                {
-                    colors[c] = image_buf.getchannel(x, y, 0, c);
-                }
-            }
-
-            float3 output_colors{ colors[0], colors[1], colors[2] };
-
-            // Non-linear to linear if required
-            if (image_data.transfer != TransferFunction::LINEAR)
-            {
-                switch (image_data.transfer)
-                {
-                    case TransferFunction::SRGB:
-                        output_colors = srgbToLinear709(output_colors);
-                        break;
-                    case TransferFunction::SRGBE:
-                        output_colors = scrgbToLinear709(output_colors);
-                        break;
-                    case TransferFunction::GAMMA18:
-                        output_colors = gamma18ToLinear709(output_colors);
-                        break;
-                    case TransferFunction::GAMMA22:
-                        output_colors = gamma22ToLinear709(output_colors);
-                        break;
-                    case TransferFunction::GAMMA24:
-                        output_colors = gamma24ToLinear709(output_colors);
-                        break;
-                    case TransferFunction::BT709:
-                        output_colors = bt709ToLinear709(output_colors);
-                        break;
-                    case TransferFunction::BT2020:
-                        output_colors = bt2020ToLinear2020(output_colors);
-                        break;
-                    case TransferFunction::ST2084_PQ:
-                        output_colors = pqToLinear2020(output_colors);
-                        break;
-                    case TransferFunction::HLG:
-                        output_colors = hlgToLinear2020(output_colors);
-                        break;
-                    case TransferFunction::LINEAR:
-                    case TransferFunction::UNKNOWN:
-                    default:
-                        return {};
-                }
-            }
-
-            // Source primaries -> XYZ -> target primaries
-            output_colors = conversion * output_colors;
-
-            // Linear to non-linear if required
-            if (converted_image_data.transfer != TransferFunction::LINEAR)
-            {
-                switch (converted_image_data.transfer)
-                {
-                    case TransferFunction::SRGB:
-                        output_colors = linear709ToSrgb(output_colors);
-                        break;
-                    case TransferFunction::SRGBE:
-                        output_colors = linear709ToScrgb(output_colors);
-                        break;
-                    case TransferFunction::GAMMA18:
-                        output_colors = linear709ToGamma18(output_colors);
-                        break;
-                    case TransferFunction::GAMMA22:
-                        output_colors = linear709ToGamma22(output_colors);
-                        break;
-                    case TransferFunction::GAMMA24:
-                        output_colors = linear709ToGamma24(output_colors);
-                        break;
-                    case TransferFunction::BT709:
-                        output_colors = linear709ToBt709(output_colors);
-                        break;
-                    case TransferFunction::BT2020:
-                        output_colors = linear2020ToBt2020(output_colors);
-                        break;
-                    case TransferFunction::ST2084_PQ:
-                        output_colors = linear2020ToPq(output_colors);
-                        break;
-                    case TransferFunction::HLG:
-                        output_colors = linear2020ToHlg(output_colors);
-                        break;
-                    case TransferFunction::LINEAR:
-                    case TransferFunction::UNKNOWN:
-                    default:
-                        return {};
-                }
-            }
-
-            colors[0] = output_colors[0];
-            colors[1] = output_colors[1];
-            colors[2] = output_colors[2];
-
-            converted_image_buf.setpixel(x, y, 0, OIIO::cspan<float>(colors));
-        }
+        return {};
     }
 
-    return converted_image_data;
+    image_data.primaries = primaries;
+    image_data.transfer = transfer;
+    image_data.image_state = image_state;
+
+    return std::move(image_data);
 }
 
 std::vector<ImageData> generateMipMaps(const ImageData& image_data)
@@ -513,18 +442,11 @@ std::vector<ImageData> generateMipMaps(const ImageData& image_data)
     std::vector<ImageData> mip_levels;
     mip_levels.push_back(image_data);
 
-    OIIO::TypeDesc format = getChannelFormat(image_data.channel_format);
-    if (format == OIIO::TypeDesc::UNKNOWN)
+    if (!isValidImageData(image_data))
     {
         return mip_levels;
     }
 
-    uint32_t channel_size = getChannelFormatSize(image_data.channel_format);
-
-    // Always resize from level 0 to avoid accumulated resampling error
-    OIIO::ImageSpec base_spec{ (int)image_data.width, (int)image_data.height, (int)image_data.channels, format };
-    OIIO::ImageBuf base_buf(base_spec, (void*)image_data.pixels.data());
-
     uint32_t width = image_data.width;
     uint32_t height = image_data.height;
 
@@ -533,22 +455,14 @@ std::vector<ImageData> generateMipMaps(const ImageData& image_data)
         uint32_t mip_width = std::max(width / 2u, 1u);
         uint32_t mip_height = std::max(height / 2u, 1u);
 
-        OIIO::ROI roi{ 0, (int)mip_width, 0, (int)mip_height };
-        OIIO::ImageBuf dst_buf = OIIO::ImageBufAlgo::resize(base_buf, "box", 0.0f, roi);
-
-        ImageData mip_data{};
-        mip_data.width = mip_width;
-        mip_data.height = mip_height;
-        mip_data.channels = image_data.channels;
-        mip_data.channel_format = image_data.channel_format;
-        mip_data.primaries = image_data.primaries;
-        mip_data.transfer = image_data.transfer;
-        mip_data.image_state = image_data.image_state;
-        mip_data.pixels.resize(mip_width * mip_height * image_data.channels * channel_size);
-
-        dst_buf.get_pixels(OIIO::ROI::All(), format, mip_data.pixels.data());
+        // Always resize from level 0 to avoid accumulated resampling error
+        auto mip_data = resizeImageData(mip_width, mip_height, FilterKernel::BOX, image_data);
+        if (!mip_data.has_value())
+        {
+            break;
+        }
 
-        mip_levels.push_back(std::move(mip_data));
+        mip_levels.push_back(std::move(*mip_data));
 
         width = mip_width;
         height = mip_height;
@@ -556,4 +470,3 @@ std::vector<ImageData> generateMipMaps(const ImageData& image_data)
 
     return mip_levels;
 }
-
@@ -1,11 +1,13 @@
 #ifndef CORE_IMAGE_DATA_H_
 #define CORE_IMAGE_DATA_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <vector>
 
 #include "core/color/types.h"
+#include "core/utility/AlignedBuffer.h"
 
 // Image coordinate system convention:
 // - Images use top-left origin throughout: files, memory, and GPU textures
@@ -34,19 +36,32 @@ struct ImageData
     TransferFunction transfer{ TransferFunction::UNKNOWN };
     ImageState image_state{ ImageState::UNKNOWN };
 
-    std::vector<uint8_t> pixels{};
+    // 64 byte aligned and not zero filled on resize, every producer overwrites all pixels.
+    AlignedBuffer<uint8_t> pixels{};
 };
 
 uint32_t getChannelFormatSize(ChannelFormat channel_format);
 
+// True if the format is known, there are 1 to 4 channels and the pixel buffer matches the dimensions.
+bool isValidImageData(const ImageData& image_data);
+
 std::optional<ImageData> loadImageData(const char* filename);
 
+// Decodes a file which is already in memory. The filename only selects the decoder.
+std::optional<ImageData> loadImageData(const char* filename, const uint8_t* data, std::size_t size);
+
 bool saveImageData(const char* filename, const ImageData& image_data);
 
 std::optional<ImageData> convertImageDataChannels(uint32_t channels, const ImageData& image_data);
 
+// Reuses the pixel buffer where possible, e.g. no copy at all if the channel count already matches.
+std::optional<ImageData> convertImageDataChannels(uint32_t channels, ImageData&& image_data);
+
 std::optional<ImageData> convertImageDataColorSpace(ColorPrimaries primaries, TransferFunction transfer, ImageState image_state, const ImageData& image_data);
 
+// Converts in place.
+std::optional<ImageData> convertImageDataColorSpace(ColorPrimaries primaries, TransferFunction transfer, ImageState image_state, ImageData&& image_data);
+
 std::vector<ImageData> generateMipMaps(const ImageData& image_data);
 
 #endif /* CORE_IMAGE_DATA_H_ */
@@ -0,0 +1,420 @@
+#include "image_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "core/image/image_pixels.h"
+#include "core/image/image_view.h"
+#include "core/utility/AlignedBuffer.h"
+#include "core/utility/ThreadPool.h"
+#include "core/utility/simd.h"
+
+namespace
+{
+
+// Output rows per task. The horizontally filtered source rows of a band are reused by all its output rows.
+constexpr uint32_t BAND_ROWS{ 32u };
+
+// Output columns per tile in the vertical pass, so the band rows of a tile stay in cache.
+constexpr uint32_t TILE_COLUMNS{ 256u };
+
+// Precomputed weights of one axis. Every output pixel reads taps consecutive source pixels starting at first.
+struct AxisWeights
+{
+    uint32_t taps{ 0u };
+
+    std::vector<uint32_t> first{};
+    std::vector<float> weights{};
+};
+
+float sinc(float x)
+{
+    if (std::fabs(x) < 1.0e-6f)
+    {
+        return 1.0f;
+    }
+
+    const float pi_x = std::numbers::pi_v<float> * x;
+
+    return std::sin(pi_x) / pi_x;
+}
+
+float getKernelSupport(FilterKernel kernel)
+{
+    switch (kernel)
+    {
+        case FilterKernel::BOX:
+            return 0.5f;
+        case FilterKernel::TENT:
+            return 1.0f;
+        case FilterKernel::GAUSSIAN:
+            return 1.5f;
+        case FilterKernel::MITCHELL:
+            return 2.0f;
+        case FilterKernel::LANCZOS3:
+            return 3.0f;
+    }
+
+    return 0.5f;
+}
+
+float evaluateKernel(FilterKernel kernel, float x)
+{
+    const float ax = std::fabs(x);
+
+    switch (kernel)
+    {
+        case FilterKernel::BOX:
+            return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+        case FilterKernel::TENT:
+            return std::max(1.0f - ax, 0.0f);
+        case FilterKernel::GAUSSIAN:
+            // Sigma of 0.5 pixels, truncated at three sigma
+            return ax < 1.5f ? std::exp(-2.0f * x * x) : 0.0f;
+        case FilterKernel::MITCHELL:
+        {
+            // B = C = 1/3
+            constexpr float B{ 1.0f / 3.0f };
+            constexpr float C{ 1.0f / 3.0f };
+
+            if (ax < 1.0f)
+            {
+                return ((12.0f - 9.0f * B - 6.0f * C) * ax * ax * ax + (-18.0f + 12.0f * B + 6.0f * C) * ax * ax + (6.0f - 2.0f * B)) / 6.0f;
+            }
+            if (ax < 2.0f)
+            {
+                return ((-B - 6.0f * C) * ax * ax * ax + (6.0f * B + 30.0f * C) * ax * ax + (-12.0f * B - 48.0f * C) * ax + (8.0f * B + 24.0f * C)) / 6.0f;
+            }
+
+            return 0.0f;
+        }
+        case FilterKernel::LANCZOS3:
+            return ax < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+    }
+
+    return 0.0f;
+}
+
+// tap_range(i, lo, hi) gives the inclusive range of virtual source pixels for output i, which may exceed the image.
+// tap_weight(i, j) gives the weight of virtual source pixel j. Pixels outside the image are folded onto the border.
+template<class R, class W>
+AxisWeights buildAxisWeights(uint32_t source_size, uint32_t destination_size, bool normalize, const R& tap_range, const W& tap_weight)
+{
+    AxisWeights axis{};
+
+    uint32_t max_span{ 1u };
+    for (uint32_t i = 0u; i < destination_size; i++)
+    {
+        int32_t lo{ 0 };
+        int32_t hi{ 0 };
+        tap_range(i, lo, hi);
+
+        max_span = std::max(max_span, (uint32_t)(hi - lo + 1));
+    }
+    axis.taps = std::min(max_span, source_size);
+
+    axis.first.resize(destination_size);
+    axis.weights.assign((std::size_t)destination_size * axis.taps, 0.0f);
+
+    for (uint32_t i = 0u; i < destination_size; i++)
+    {
+        int32_t lo{ 0 };
+        int32_t hi{ 0 };
+        tap_range(i, lo, hi);
+
+        const int32_t first = std::clamp(lo, 0, (int32_t)(source_size - axis.taps));
+        axis.first[i] = (uint32_t)first;
+
+        float* weights = &axis.weights[(std::size_t)i * axis.taps];
+
+        float sum{ 0.0f };
+        for (int32_t j = lo; j <= hi; j++)
+        {
+            const float weight = tap_weight(i, j);
+            const int32_t index = std::clamp(j, 0, (int32_t)source_size - 1);
+
+            weights[index - first] += weight;
+            sum += weight;
+        }
+
+        if (normalize && sum != 0.0f)
+        {
+            for (uint32_t k = 0u; k < axis.taps; k++)
+            {
+                weights[k] /= sum;
+            }
+        }
+    }
+
+    return axis;
+}
+
+AxisWeights buildResizeWeights(uint32_t source_size, uint32_t destination_size, FilterKernel kernel)
+{
+    const float scale = (float)destination_size / (float)source_size;
+
+    // When minifying, the kernel is widened to the destination pixel footprint.
+    const float filter_scale = std::min(scale, 1.0f);
+    const float support = getKernelSupport(kernel) / filter_scale;
+
+    auto center = [scale](uint32_t i) { return ((float)i + 0.5f) / scale; };
+
+    return buildAxisWeights(
+        source_size,
+        destination_size,
+        true,
+        [&](uint32_t i, int32_t& lo, int32_t& hi) {
+            lo = (int32_t)std::ceil(center(i) - support - 0.5f);
+            hi = (int32_t)std::floor(center(i) + support - 0.5f);
+            hi = std::max(hi, lo);
+        },
+        [&](uint32_t i, int32_t j) { return evaluateKernel(kernel, ((float)j + 0.5f - center(i)) * filter_scale); });
+}
+
+AxisWeights buildConvolutionWeights(uint32_t size, const std::vector<float>& kernel)
+{
+    const int32_t radius = (int32_t)kernel.size() / 2;
+
+    return buildAxisWeights(
+        size,
+        size,
+        false,
+        [&](uint32_t i, int32_t& lo, int32_t& hi) {
+            lo = (int32_t)i - radius;
+            hi = (int32_t)i + radius;
+        },
+        [&](uint32_t i, int32_t j) { return kernel[(std::size_t)(j - (int32_t)i + radius)]; });
+}
+
+std::vector<float> buildGaussianKernel(float sigma)
+{
+    const int32_t radius = std::max((int32_t)std::ceil(3.0f * sigma), 1);
+
+    std::vector<float> kernel((std::size_t)(2 * radius + 1));
+
+    float sum{ 0.0f };
+    for (int32_t i = -radius; i <= radius; i++)
+    {
+        const float weight = std::exp(-(float)(i * i) / (2.0f * sigma * sigma));
+        kernel[(std::size_t)(i + radius)] = weight;
+        sum += weight;
+    }
+
+    for (float& weight : kernel)
+    {
+        weight /= sum;
+    }
+
+    return kernel;
+}
+
+void filterRow(const float* source, const AxisWeights& axis, uint32_t width, float* destination)
+{
+    for (uint32_t x = 0u; x < width; x++)
+    {
+        const float* pixels = &source[(std::size_t)axis.first[x] * 4u];
+        const float* weights = &axis.weights[(std::size_t)x * axis.taps];
+
+        SimdFloat4 sum = simdSet(0.0f);
+        for (uint32_t k = 0u; k < axis.taps; k++)
+        {
+            sum = simdMulAdd(sum, simdLoad(&pixels[k * 4u]), weights[k]);
+        }
+
+        simdStore(&destination[(std::size_t)x * 4u], sum);
+    }
+}
+
+// Runs the horizontal and then the vertical pass. If sharpen_amount is not zero, the result is used as
+// blurred image for an unsharp mask, which requires source and destination to have the same size.
+// The destination may use a different channel count and format, the pixels are converted on the fly.
+void filterImage(const ImageView& source, const MutableImageView& destination, const AxisWeights& horizontal, const AxisWeights& vertical, float sharpen_amount)
+{
+    const uint32_t width = destination.width;
+    const uint32_t height = destination.height;
+
+    const std::size_t row_stride = (std::size_t)width * 4u;
+    const uint32_t number_bands = (height + BAND_ROWS - 1u) / BAND_ROWS;
+
+    getThreadPool().parallelFor(number_bands, 1u, [&](std::size_t begin, std::size_t end) {
+        AlignedBuffer<float> source_row((std::size_t)source.width * 4u);
+        AlignedBuffer<float> band{};
+        AlignedBuffer<float> output((std::size_t)BAND_ROWS * row_stride);
+
+        for (std::size_t b = begin; b < end; b++)
+        {
+            const uint32_t y_begin = (uint32_t)b * BAND_ROWS;
+            const uint32_t y_end = std::min(y_begin + BAND_ROWS, height);
+
+            const uint32_t row_begin = vertical.first[y_begin];
+            const uint32_t row_end = vertical.first[y_end - 1u] + vertical.taps;
+
+            // Horizontal pass over all source rows this band needs
+            band.resize((std::size_t)(row_end - row_begin) * row_stride);
+            for (uint32_t row = row_begin; row < row_end; row++)
+            {
+                decodePixels(source.data + row * source.row_pitch, source.channel_format, source.channels, source.width, source_row.data());
+                filterRow(source_row.data(), horizontal, width, &band[(row - row_begin) * row_stride]);
+            }
+
+            // Vertical pass, tiled over columns
+            for (uint32_t x_begin = 0u; x_begin < width; x_begin += TILE_COLUMNS)
+            {
+                const uint32_t x_end = std::min(x_begin + TILE_COLUMNS, width);
+
+                for (uint32_t y = y_begin; y < y_end; y++)
+                {
+                    const float* weights = &vertical.weights[(std::size_t)y * vertical.taps];
+                    const float* rows = &band[(vertical.first[y] - row_begin) * row_stride];
+                    float* destination = &output[(y - y_begin) * row_stride];
+
+                    for (uint32_t x = x_begin; x < x_end; x++)
+                    {
+                        SimdFloat4 sum = simdSet(0.0f);
+                        for (uint32_t k = 0u; k < vertical.taps; k++)
+                        {
+                            sum = simdMulAdd(sum, simdLoad(&rows[k * row_stride + (std::size_t)x * 4u]), weights[k]);
+                        }
+
+                        simdStore(&destination[(std::size_t)x * 4u], sum);
+                    }
+                }
+            }
+
+            for (uint32_t y = y_begin; y < y_end; y++)
+            {
+                float* row = &output[(y - y_begin) * row_stride];
+
+                if (sharpen_amount != 0.0f)
+                {
+                    decodePixels(source.data + y * source.row_pitch, source.channel_format, source.channels, source.width, source_row.data());
+
+                    for (uint32_t x = 0u; x < width; x++)
+                    {
+                        SimdFloat4 original = simdLoad(&source_row[(std::size_t)x * 4u]);
+                        SimdFloat4 blurred = simdLoad(&row[(std::size_t)x * 4u]);
+
+                        simdStore(&row[(std::size_t)x * 4u], simdMulAdd(original, simdSub(original, blurred), sharpen_amount));
+                    }
+                }
+
+                encodePixels(row, width, destination.channel_format, destination.channels, destination.data + y * destination.row_pitch);
+            }
+        }
+    });
+}
+
+ImageData createImageData(uint32_t width, uint32_t height, const ImageData& image_data)
+{
+    ImageData result{};
+    result.width = width;
+    result.height = height;
+    result.channels = image_data.channels;
+    result.channel_format = image_data.channel_format;
+    result.primaries = image_data.primaries;
+    result.transfer = image_data.transfer;
+    result.image_state = image_data.image_state;
+    result.pixels.resize((std::size_t)width * height * image_data.channels * getChannelFormatSize(image_data.channel_format));
+
+    return result;
+}
+
+} // namespace
+
+bool resizeImage(const ImageView& source, const MutableImageView& destination, FilterKernel kernel)
+{
+    if (!isValidImageView(source) || !isValidImageView(destination))
+    {
+        return false;
+    }
+
+    const AxisWeights horizontal = buildResizeWeights(source.width, destination.width, kernel);
+    const AxisWeights vertical = buildResizeWeights(source.height, destination.height, kernel);
+
+    filterImage(source, destination, horizontal, vertical, 0.0f);
+
+    return true;
+}
+
+bool blurImage(float sigma, const ImageView& source, const MutableImageView& destination)
+{
+    if (sigma <= 0.0f || !isValidImageView(source) || !isValidImageView(destination) || source.width != destination.width || source.height != destination.height)
+    {
+        return false;
+    }
+
+    const std::vector<float> kernel = buildGaussianKernel(sigma);
+
+    const AxisWeights horizontal = buildConvolutionWeights(source.width, kernel);
+    const AxisWeights vertical = buildConvolutionWeights(source.height, kernel);
+
+    filterImage(source, destination, horizontal, vertical, 0.0f);
+
+    return true;
+}
+
+std::optional<ImageData> resizeImageData(uint32_t width, uint32_t height, FilterKernel kernel, const ImageData& image_data)
+{
+    if (width == 0u || height == 0u || !isValidImageData(image_data))
+    {
+        return {};
+    }
+
+    ImageData result = createImageData(width, height, image_data);
+    resizeImage(makeImageView(image_data), makeMutableImageView(result), kernel);
+
+    return result;
+}
+
+std::optional<ImageData> blurImageData(float sigma, const ImageData& image_data)
+{
+    if (sigma <= 0.0f || !isValidImageData(image_data))
+    {
+        return {};
+    }
+
+    ImageData result = createImageData(image_data.width, image_data.height, image_data);
+    blurImage(sigma, makeImageView(image_data), makeMutableImageView(result));
+
+    return result;
+}
+
+std::optional<ImageData> sharpenImageData(float sigma, float amount, const ImageData& image_data)
+{
+    if (sigma <= 0.0f || !isValidImageData(image_data))
+    {
+        return {};
+    }
+
+    if (amount == 0.0f)
+    {
+        return image_data;
+    }
+
+    const std::vector<float> kernel = buildGaussianKernel(sigma);
+
+    const AxisWeights horizontal = buildConvolutionWeights(image_data.width, kernel);
+    const AxisWeights vertical = buildConvolutionWeights(image_data.height, kernel);
+
+    ImageData result = createImageData(image_data.width, image_data.height, image_data);
+    filterImage(makeImageView(image_data), makeMutableImageView(result), horizontal, vertical, amount);
+
+    return result;
+}
+
+std::optional<ImageData> convolveImageData(const std::vector<float>& horizontal_kernel, const std::vector<float>& vertical_kernel, const ImageData& image_data)
+{
+    if (horizontal_kernel.size() % 2u == 0u || vertical_kernel.size() % 2u == 0u || !isValidImageData(image_data))
+    {
+        return {};
+    }
+
+    const AxisWeights horizontal = buildConvolutionWeights(image_data.width, horizontal_kernel);
+    const AxisWeights vertical = buildConvolutionWeights(image_data.height, vertical_kernel);
+
+    ImageData result = createImageData(image_data.width, image_data.height, image_data);
+    filterImage(makeImageView(image_data), makeMutableImageView(result), horizontal, vertical, 0.0f);
+
+    return result;
+}
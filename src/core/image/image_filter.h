@@ -0,0 +1,38 @@
+#ifndef CORE_IMAGE_FILTER_H_
+#define CORE_IMAGE_FILTER_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "core/image/image_data.h"
+#include "core/image/image_view.h"
+
+// Separable filtering on all channel formats. Pixels outside the image repeat the border pixel.
+
+enum class FilterKernel
+{
+    BOX,
+    TENT,
+    GAUSSIAN,
+    MITCHELL,
+    LANCZOS3
+};
+
+// The destination may use a different channel count and format. Source and destination must not overlap.
+bool resizeImage(const ImageView& source, const MutableImageView& destination, FilterKernel kernel);
+
+// Source and destination need the same size and must not overlap.
+bool blurImage(float sigma, const ImageView& source, const MutableImageView& destination);
+
+std::optional<ImageData> resizeImageData(uint32_t width, uint32_t height, FilterKernel kernel, const ImageData& image_data);
+
+std::optional<ImageData> blurImageData(float sigma, const ImageData& image_data);
+
+// Unsharp mask: image + amount * (image - blur(image, sigma)).
+std::optional<ImageData> sharpenImageData(float sigma, float amount, const ImageData& image_data);
+
+// Convolves with the outer product of both kernels. The kernels need an odd size and are centered on the pixel.
+std::optional<ImageData> convolveImageData(const std::vector<float>& horizontal_kernel, const std::vector<float>& vertical_kernel, const ImageData& image_data);
+
+#endif /* CORE_IMAGE_FILTER_H_ */
@@ -0,0 +1,89 @@
+#include "image_loader.h"
+
+#include <algorithm>
+#include <semaphore>
+
+#include "core/io/MappedFile.h"
+#include "core/utility/ThreadPool.h"
+
+namespace
+{
+
+std::vector<ImageData> processImageData(const ImageLoadStages& stages, ImageData image_data)
+{
+    if (stages.channels != 0u && stages.channels != image_data.channels)
+    {
+        auto converted_image_data = convertImageDataChannels(stages.channels, std::move(image_data));
+        if (!converted_image_data.has_value())
+        {
+            return {};
+        }
+        image_data = std::move(*converted_image_data);
+    }
+
+    if (stages.convert_color_space)
+    {
+        auto converted_image_data = convertImageDataColorSpace(stages.primaries, stages.transfer, stages.image_state, std::move(image_data));
+        if (!converted_image_data.has_value())
+        {
+            return {};
+        }
+        image_data = std::move(*converted_image_data);
+    }
+
+    if (stages.generate_mip_maps)
+    {
+        return generateMipMaps(image_data);
+    }
+
+    std::vector<ImageData> result{};
+    result.push_back(std::move(image_data));
+
+    return result;
+}
+
+} // namespace
+
+//
+
+std::future<std::optional<ImageData>> loadImageDataAsync(const std::string& filename)
+{
+    return getThreadPool().submit([filename]() { return loadImageData(filename.c_str()); });
+}
+
+std::vector<std::vector<ImageData>> loadImageDataBatch(const std::vector<std::string>& filenames, const ImageLoadStages& stages, uint32_t max_io_concurrency)
+{
+    std::vector<std::vector<ImageData>> results(filenames.size());
+
+    std::counting_semaphore<> io_semaphore((std::ptrdiff_t)std::max(max_io_concurrency, 1u));
+
+    getThreadPool().parallelFor(filenames.size(), 1u, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            // Only reading the file is throttled, so slow storage is not flooded while decoding uses all cores.
+            // The mapping is populated inside the throttled section, decoding then reads from memory without a copy.
+            MappedFile file{};
+
+            io_semaphore.acquire();
+            bool opened = file.open(filenames[i], MappedFileAccess::SEQUENTIAL, true);
+            io_semaphore.release();
+
+            if (!opened)
+            {
+                continue;
+            }
+
+            auto image_data = loadImageData(filenames[i].c_str(), (const uint8_t*)file.getData().data(), file.getSize());
+            file.close();
+
+            if (!image_data.has_value())
+            {
+                continue;
+            }
+
+            results[i] = processImageData(stages, std::move(*image_data));
+        }
+    });
+
+    return results;
+}
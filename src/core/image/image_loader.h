@@ -0,0 +1,34 @@
+#ifndef CORE_IMAGE_LOADER_H_
+#define CORE_IMAGE_LOADER_H_
+
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/color/types.h"
+#include "core/image/image_data.h"
+
+// Optional processing applied to every image right after decoding, in declaration order.
+struct ImageLoadStages
+{
+    // 0 keeps the channels of the file.
+    uint32_t channels{ 0u };
+
+    bool convert_color_space{ false };
+    ColorPrimaries primaries{ ColorPrimaries::REC709 };
+    TransferFunction transfer{ TransferFunction::LINEAR };
+    ImageState image_state{ ImageState::SCENE };
+
+    bool generate_mip_maps{ false };
+};
+
+std::future<std::optional<ImageData>> loadImageDataAsync(const std::string& filename);
+
+// Loads all files concurrently on the shared thread pool. At most max_io_concurrency files are read from disk at
+// the same time, decoding and the stages are not limited.
+// Returns one entry per filename: empty on failure, otherwise level 0 followed by the mip levels if requested.
+std::vector<std::vector<ImageData>> loadImageDataBatch(const std::vector<std::string>& filenames, const ImageLoadStages& stages = {}, uint32_t max_io_concurrency = 4u);
+
+#endif /* CORE_IMAGE_LOADER_H_ */
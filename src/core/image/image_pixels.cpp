@@ -0,0 +1,82 @@
+#include "image_pixels.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/utility/convert.h"
+
+void decodePixels(const uint8_t* source, ChannelFormat channel_format, uint32_t channels, std::size_t count, float* destination)
+{
+    const uint32_t used_channels = std::min(channels, 4u);
+
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        float* pixel = &destination[i * 4u];
+        pixel[0] = 0.0f;
+        pixel[1] = 0.0f;
+        pixel[2] = 0.0f;
+        pixel[3] = 1.0f;
+
+        const std::size_t offset = i * channels;
+
+        // The format switch is hoisted out of the channel loop, as this runs for every pixel.
+        switch (channel_format)
+        {
+            case ChannelFormat::UNORM:
+                for (uint32_t c = 0u; c < used_channels; c++)
+                {
+                    pixel[c] = (float)source[offset + c] * (1.0f / 255.0f);
+                }
+                break;
+            case ChannelFormat::SHALF:
+                for (uint32_t c = 0u; c < used_channels; c++)
+                {
+                    uint16_t value{ 0u };
+                    std::memcpy(&value, &source[(offset + c) * 2u], sizeof(value));
+                    pixel[c] = halfToFloat(value);
+                }
+                break;
+            case ChannelFormat::SFLOAT:
+                std::memcpy(pixel, &source[offset * 4u], used_channels * sizeof(float));
+                break;
+            case ChannelFormat::UNDEFINED:
+            default:
+                break;
+        }
+    }
+}
+
+void encodePixels(const float* source, std::size_t count, ChannelFormat channel_format, uint32_t channels, uint8_t* destination)
+{
+    const uint32_t used_channels = std::min(channels, 4u);
+
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const float* pixel = &source[i * 4u];
+
+        const std::size_t offset = i * channels;
+
+        switch (channel_format)
+        {
+            case ChannelFormat::UNORM:
+                for (uint32_t c = 0u; c < used_channels; c++)
+                {
+                    destination[offset + c] = (uint8_t)(std::clamp(pixel[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+                }
+                break;
+            case ChannelFormat::SHALF:
+                for (uint32_t c = 0u; c < used_channels; c++)
+                {
+                    uint16_t value = floatToHalf(pixel[c]);
+                    std::memcpy(&destination[(offset + c) * 2u], &value, sizeof(value));
+                }
+                break;
+            case ChannelFormat::SFLOAT:
+                std::memcpy(&destination[offset * 4u], pixel, used_channels * sizeof(float));
+                break;
+            case ChannelFormat::UNDEFINED:
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef CORE_IMAGE_PIXELS_H_
+#define CORE_IMAGE_PIXELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/image/image_data.h"
+
+// Converts count pixels to RGBA float. Missing color channels become 0, a missing alpha becomes 1.
+// UNORM values are mapped to [0, 1] without any transfer function being applied.
+void decodePixels(const uint8_t* source, ChannelFormat channel_format, uint32_t channels, std::size_t count, float* destination);
+
+// Converts count RGBA float pixels back to the given layout, dropping channels which are not present.
+void encodePixels(const float* source, std::size_t count, ChannelFormat channel_format, uint32_t channels, uint8_t* destination);
+
+#endif /* CORE_IMAGE_PIXELS_H_ */
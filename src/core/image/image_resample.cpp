@@ -0,0 +1,327 @@
+#include "image_resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "core/image/image_pixels.h"
+#include "core/utility/AlignedBuffer.h"
+#include "core/utility/ThreadPool.h"
+#include "core/utility/simd.h"
+
+namespace
+{
+
+struct RgbaImage
+{
+    uint32_t width{ 0u };
+    uint32_t height{ 0u };
+
+    // Four floats per pixel, so every texel can be fetched with one aligned SIMD load.
+    AlignedBuffer<float> pixels{};
+};
+
+bool isValidCube(const ImageData& image_data)
+{
+    return isValidImageData(image_data) && image_data.height == image_data.width * 6u;
+}
+
+RgbaImage decodeImage(const ImageData& image_data)
+{
+    RgbaImage image{};
+    image.width = image_data.width;
+    image.height = image_data.height;
+    image.pixels.resize((std::size_t)image.width * image.height * 4u);
+
+    const std::size_t row_size = (std::size_t)image_data.width * image_data.channels * getChannelFormatSize(image_data.channel_format);
+
+    getThreadPool().parallelFor(image.height, 16u, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t y = begin; y < end; y++)
+        {
+            decodePixels(&image_data.pixels[y * row_size], image_data.channel_format, image_data.channels, image.width, &image.pixels[y * image.width * 4u]);
+        }
+    });
+
+    return image;
+}
+
+uint32_t addressTexel(int32_t coordinate, uint32_t size, bool wrap)
+{
+    if (wrap)
+    {
+        int32_t wrapped = coordinate % (int32_t)size;
+
+        return (uint32_t)(wrapped < 0 ? wrapped + (int32_t)size : wrapped);
+    }
+
+    return (uint32_t)std::clamp(coordinate, 0, (int32_t)size - 1);
+}
+
+void catmullRomWeights(float t, float weights[4])
+{
+    weights[0] = ((-0.5f * t + 1.0f) * t - 0.5f) * t;
+    weights[1] = (1.5f * t - 2.5f) * t * t + 1.0f;
+    weights[2] = ((-1.5f * t + 2.0f) * t + 0.5f) * t;
+    weights[3] = (0.5f * t - 0.5f) * t * t;
+}
+
+// Samples the width x height region starting at first_row at the continuous texel position (x, y),
+// with texel centers at half integers. x wraps if requested, everything else is clamped to the region.
+SimdFloat4 sampleRegion(const RgbaImage& image, uint32_t first_row, uint32_t width, uint32_t height, float x, float y, bool wrap_x, ResampleFilter filter)
+{
+    const float px = x - 0.5f;
+    const float py = y - 0.5f;
+
+    const float fx = std::floor(px);
+    const float fy = std::floor(py);
+
+    const float tx = px - fx;
+    const float ty = py - fy;
+
+    const int32_t ix = (int32_t)fx;
+    const int32_t iy = (int32_t)fy;
+
+    auto texel = [&](int32_t sx, int32_t sy) {
+        uint32_t ax = addressTexel(sx, width, wrap_x);
+        uint32_t ay = addressTexel(sy, height, false) + first_row;
+
+        return simdLoad(&image.pixels[((std::size_t)ay * image.width + ax) * 4u]);
+    };
+
+    if (filter == ResampleFilter::BICUBIC)
+    {
+        float weights_x[4];
+        float weights_y[4];
+        catmullRomWeights(tx, weights_x);
+        catmullRomWeights(ty, weights_y);
+
+        SimdFloat4 result = simdSet(0.0f);
+        for (int32_t j = 0; j < 4; j++)
+        {
+            SimdFloat4 row = simdSet(0.0f);
+            for (int32_t i = 0; i < 4; i++)
+            {
+                row = simdMulAdd(row, texel(ix - 1 + i, iy - 1 + j), weights_x[i]);
+            }
+            result = simdMulAdd(result, row, weights_y[j]);
+        }
+
+        return result;
+    }
+
+    SimdFloat4 top = simdSet(0.0f);
+    top = simdMulAdd(top, texel(ix, iy), 1.0f - tx);
+    top = simdMulAdd(top, texel(ix + 1, iy), tx);
+
+    SimdFloat4 bottom = simdSet(0.0f);
+    bottom = simdMulAdd(bottom, texel(ix, iy + 1), 1.0f - tx);
+    bottom = simdMulAdd(bottom, texel(ix + 1, iy + 1), tx);
+
+    return simdMulAdd(simdMul(top, simdSet(1.0f - ty)), bottom, ty);
+}
+
+// Same convention as cubeFaceUVToDirection in geometry.slang.
+void cubeFaceUVToDirection(uint32_t face, float u, float v, float direction[3])
+{
+    const float s = u * 2.0f - 1.0f;
+    const float t = v * 2.0f - 1.0f;
+
+    switch (face)
+    {
+        case 0u:
+            direction[0] = 1.0f;
+            direction[1] = -t;
+            direction[2] = -s;
+            break;
+        case 1u:
+            direction[0] = -1.0f;
+            direction[1] = -t;
+            direction[2] = s;
+            break;
+        case 2u:
+            direction[0] = s;
+            direction[1] = 1.0f;
+            direction[2] = t;
+            break;
+        case 3u:
+            direction[0] = s;
+            direction[1] = -1.0f;
+            direction[2] = -t;
+            break;
+        case 4u:
+            direction[0] = s;
+            direction[1] = -t;
+            direction[2] = 1.0f;
+            break;
+        default:
+            direction[0] = -s;
+            direction[1] = -t;
+            direction[2] = -1.0f;
+            break;
+    }
+
+    const float length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+    direction[0] /= length;
+    direction[1] /= length;
+    direction[2] /= length;
+}
+
+// Inverse of cubeFaceUVToDirection, the direction does not need to be normalized.
+uint32_t directionToCubeFaceUV(const float direction[3], float& u, float& v)
+{
+    const float ax = std::fabs(direction[0]);
+    const float ay = std::fabs(direction[1]);
+    const float az = std::fabs(direction[2]);
+
+    uint32_t face{ 0u };
+    float s{ 0.0f };
+    float t{ 0.0f };
+
+    if (ax >= ay && ax >= az)
+    {
+        face = direction[0] >= 0.0f ? 0u : 1u;
+        s = (direction[0] >= 0.0f ? -direction[2] : direction[2]) / ax;
+        t = -direction[1] / ax;
+    }
+    else if (ay >= az)
+    {
+        face = direction[1] >= 0.0f ? 2u : 3u;
+        s = direction[0] / ay;
+        t = (direction[1] >= 0.0f ? direction[2] : -direction[2]) / ay;
+    }
+    else
+    {
+        face = direction[2] >= 0.0f ? 4u : 5u;
+        s = (direction[2] >= 0.0f ? direction[0] : -direction[0]) / az;
+        t = -direction[1] / az;
+    }
+
+    u = (s + 1.0f) * 0.5f;
+    v = (t + 1.0f) * 0.5f;
+
+    return face;
+}
+
+// Same convention as directionToEquirectangularUV in geometry.slang.
+void directionToEquirectangularUV(const float direction[3], float& u, float& v)
+{
+    u = 0.5f + std::atan2(direction[2], direction[0]) * (0.5f / std::numbers::pi_v<float>);
+    v = 0.5f - std::asin(std::clamp(direction[1], -1.0f, 1.0f)) * (1.0f / std::numbers::pi_v<float>);
+}
+
+void equirectangularUVToDirection(float u, float v, float direction[3])
+{
+    const float phi = (u - 0.5f) * 2.0f * std::numbers::pi_v<float>;
+    const float theta = (0.5f - v) * std::numbers::pi_v<float>;
+
+    direction[0] = std::cos(theta) * std::cos(phi);
+    direction[1] = std::sin(theta);
+    direction[2] = std::cos(theta) * std::sin(phi);
+}
+
+// Evaluates function(x, y) for every output pixel in parallel over rows and encodes into the source format.
+template<class F>
+ImageData resampleImage(uint32_t width, uint32_t height, const ImageData& image_data, const F& function)
+{
+    ImageData result{};
+    result.width = width;
+    result.height = height;
+    result.channels = image_data.channels;
+    result.channel_format = image_data.channel_format;
+    result.primaries = image_data.primaries;
+    result.transfer = image_data.transfer;
+    result.image_state = image_data.image_state;
+
+    const std::size_t row_size = (std::size_t)width * result.channels * getChannelFormatSize(result.channel_format);
+    result.pixels.resize(row_size * height);
+
+    getThreadPool().parallelFor(height, 8u, [&](std::size_t begin, std::size_t end) {
+        AlignedBuffer<float> row((std::size_t)width * 4u);
+
+        for (std::size_t y = begin; y < end; y++)
+        {
+            for (uint32_t x = 0u; x < width; x++)
+            {
+                simdStore(&row[(std::size_t)x * 4u], function(x, (uint32_t)y));
+            }
+
+            encodePixels(row.data(), width, result.channel_format, result.channels, &result.pixels[y * row_size]);
+        }
+    });
+
+    return result;
+}
+
+} // namespace
+
+std::optional<ImageData> convertEquirectangularToCube(uint32_t face_size, ResampleFilter filter, const ImageData& image_data)
+{
+    if (face_size == 0u || !isValidImageData(image_data))
+    {
+        return {};
+    }
+
+    const RgbaImage source = decodeImage(image_data);
+
+    const float inverse_size = 1.0f / (float)face_size;
+    const float source_width = (float)source.width;
+    const float source_height = (float)source.height;
+
+    return resampleImage(face_size, face_size * 6u, image_data, [&](uint32_t x, uint32_t y) {
+        const uint32_t face = y / face_size;
+
+        float direction[3];
+        cubeFaceUVToDirection(face, ((float)x + 0.5f) * inverse_size, ((float)(y % face_size) + 0.5f) * inverse_size, direction);
+
+        float u{ 0.0f };
+        float v{ 0.0f };
+        directionToEquirectangularUV(direction, u, v);
+
+        return sampleRegion(source, 0u, source.width, source.height, u * source_width, v * source_height, true, filter);
+    });
+}
+
+std::optional<ImageData> convertCubeToEquirectangular(uint32_t width, uint32_t height, ResampleFilter filter, const ImageData& image_data)
+{
+    if (width == 0u || height == 0u || !isValidCube(image_data))
+    {
+        return {};
+    }
+
+    const RgbaImage source = decodeImage(image_data);
+
+    const uint32_t source_size = image_data.width;
+    const float inverse_width = 1.0f / (float)width;
+    const float inverse_height = 1.0f / (float)height;
+
+    return resampleImage(width, height, image_data, [&](uint32_t x, uint32_t y) {
+        float direction[3];
+        equirectangularUVToDirection(((float)x + 0.5f) * inverse_width, ((float)y + 0.5f) * inverse_height, direction);
+
+        float u{ 0.0f };
+        float v{ 0.0f };
+        const uint32_t face = directionToCubeFaceUV(direction, u, v);
+
+        return sampleRegion(source, face * source_size, source_size, source_size, u * (float)source_size, v * (float)source_size, false, filter);
+    });
+}
+
+std::optional<ImageData> resizeCube(uint32_t face_size, ResampleFilter filter, const ImageData& image_data)
+{
+    if (face_size == 0u || !isValidCube(image_data))
+    {
+        return {};
+    }
+
+    const RgbaImage source = decodeImage(image_data);
+
+    const uint32_t source_size = image_data.width;
+    const float scale = (float)source_size / (float)face_size;
+
+    return resampleImage(face_size, face_size * 6u, image_data, [&](uint32_t x, uint32_t y) {
+        const uint32_t face = y / face_size;
+
+        return sampleRegion(source, face * source_size, source_size, source_size, ((float)x + 0.5f) * scale, ((float)(y % face_size) + 0.5f) * scale, false, filter);
+    });
+}
@@ -0,0 +1,25 @@
+#ifndef CORE_IMAGE_RESAMPLE_H_
+#define CORE_IMAGE_RESAMPLE_H_
+
+#include <cstdint>
+#include <optional>
+
+#include "core/image/image_data.h"
+
+// Cube maps are stored as one ImageData with width == face size and height == 6 * face size.
+// The faces are stacked top to bottom in Vulkan layer order +X, -X, +Y, -Y, +Z, -Z, matching the
+// per-face layout TextureCube::upload expects and the direction convention of geometry.slang.
+
+enum class ResampleFilter
+{
+    BILINEAR,
+    BICUBIC
+};
+
+std::optional<ImageData> convertEquirectangularToCube(uint32_t face_size, ResampleFilter filter, const ImageData& image_data);
+
+std::optional<ImageData> convertCubeToEquirectangular(uint32_t width, uint32_t height, ResampleFilter filter, const ImageData& image_data);
+
+std::optional<ImageData> resizeCube(uint32_t face_size, ResampleFilter filter, const ImageData& image_data);
+
+#endif /* CORE_IMAGE_RESAMPLE_H_ */
@@ -0,0 +1,445 @@
+#include "image_view.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/color/convert.h"
+#include "core/image/image_filter.h"
+#include "core/image/image_pixels.h"
+#include "core/math/matrix.h"
+#include "core/utility/AlignedBuffer.h"
+#include "core/utility/ThreadPool.h"
+
+namespace
+{
+
+template<class V>
+std::optional<V> cropView(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const V& image_view)
+{
+    if (!isValidImageView(image_view) || width == 0u || height == 0u || x + width > image_view.width || y + height > image_view.height)
+    {
+        return {};
+    }
+
+    V result = image_view;
+    result.data = image_view.data + y * image_view.row_pitch + x * getPixelSize(image_view);
+    result.width = width;
+    result.height = height;
+
+    return result;
+}
+
+template<class V>
+std::optional<V> cubeFaceView(uint32_t face, const V& image_view)
+{
+    if (face >= 6u || image_view.height != image_view.width * 6u)
+    {
+        return {};
+    }
+
+    return cropView(0u, face * image_view.width, image_view.width, image_view.width, image_view);
+}
+
+bool isSameLayout(const ImageView& source, const ImageView& destination)
+{
+    return source.width == destination.width && source.height == destination.height && source.channels == destination.channels && source.channel_format == destination.channel_format;
+}
+
+float3 toLinear(TransferFunction transfer, const float3& color)
+{
+    switch (transfer)
+    {
+        case TransferFunction::SRGB:
+            return srgbToLinear709(color);
+        case TransferFunction::SRGBE:
+            return scrgbToLinear709(color);
+        case TransferFunction::GAMMA18:
+            return gamma18ToLinear709(color);
+        case TransferFunction::GAMMA22:
+            return gamma22ToLinear709(color);
+        case TransferFunction::GAMMA24:
+            return gamma24ToLinear709(color);
+        case TransferFunction::BT709:
+            return bt709ToLinear709(color);
+        case TransferFunction::BT2020:
+            return bt2020ToLinear2020(color);
+        case TransferFunction::ST2084_PQ:
+            return pqToLinear2020(color);
+        case TransferFunction::HLG:
+            return hlgToLinear2020(color);
+        case TransferFunction::LINEAR:
+        case TransferFunction::UNKNOWN:
+        default:
+            return color;
+    }
+}
+
+float3 fromLinear(TransferFunction transfer, const float3& color)
+{
+    switch (transfer)
+    {
+        case TransferFunction::SRGB:
+            return linear709ToSrgb(color);
+        case TransferFunction::SRGBE:
+            return linear709ToScrgb(color);
+        case TransferFunction::GAMMA18:
+            return linear709ToGamma18(color);
+        case TransferFunction::GAMMA22:
+            return linear709ToGamma22(color);
+        case TransferFunction::GAMMA24:
+            return linear709ToGamma24(color);
+        case TransferFunction::BT709:
+            return linear709ToBt709(color);
+        case TransferFunction::BT2020:
+            return linear2020ToBt2020(color);
+        case TransferFunction::ST2084_PQ:
+            return linear2020ToPq(color);
+        case TransferFunction::HLG:
+            return linear2020ToHlg(color);
+        case TransferFunction::LINEAR:
+        case TransferFunction::UNKNOWN:
+        default:
+            return color;
+    }
+}
+
+std::optional<float3x3> getRgbToXYZ(ColorPrimaries primaries)
+{
+    switch (primaries)
+    {
+        case ColorPrimaries::REC709:
+            return rgbToXYZ(COLOR_PRIMARY_REC709);
+        case ColorPrimaries::REC2020:
+            return rgbToXYZ(COLOR_PRIMARY_REC2020);
+        case ColorPrimaries::UNKNOWN:
+        default:
+            return {};
+    }
+}
+
+} // namespace
+
+MutableImageView::operator ImageView() const
+{
+    return ImageView{ data, width, height, row_pitch, channels, channel_format, primaries, transfer, image_state };
+}
+
+std::size_t getPixelSize(const ImageView& image_view)
+{
+    return (std::size_t)image_view.channels * getChannelFormatSize(image_view.channel_format);
+}
+
+bool isValidImageView(const ImageView& image_view)
+{
+    if (!image_view.data || image_view.width == 0u || image_view.height == 0u || image_view.channels < 1u || image_view.channels > 4u)
+    {
+        return false;
+    }
+
+    std::size_t pixel_size = getPixelSize(image_view);
+
+    return pixel_size != 0u && image_view.row_pitch >= image_view.width * pixel_size;
+}
+
+ImageView makeImageView(const ImageData& image_data)
+{
+    ImageView image_view{};
+    image_view.data = image_data.pixels.data();
+    image_view.width = image_data.width;
+    image_view.height = image_data.height;
+    image_view.row_pitch = (std::size_t)image_data.width * image_data.channels * getChannelFormatSize(image_data.channel_format);
+    image_view.channels = image_data.channels;
+    image_view.channel_format = image_data.channel_format;
+    image_view.primaries = image_data.primaries;
+    image_view.transfer = image_data.transfer;
+    image_view.image_state = image_data.image_state;
+
+    return image_view;
+}
+
+MutableImageView makeMutableImageView(ImageData& image_data)
+{
+    MutableImageView image_view{};
+    image_view.data = image_data.pixels.data();
+    image_view.width = image_data.width;
+    image_view.height = image_data.height;
+    image_view.row_pitch = (std::size_t)image_data.width * image_data.channels * getChannelFormatSize(image_data.channel_format);
+    image_view.channels = image_data.channels;
+    image_view.channel_format = image_data.channel_format;
+    image_view.primaries = image_data.primaries;
+    image_view.transfer = image_data.transfer;
+    image_view.image_state = image_data.image_state;
+
+    return image_view;
+}
+
+ImageData toImageData(const ImageView& image_view)
+{
+    ImageData image_data{};
+    if (!isValidImageView(image_view))
+    {
+        return image_data;
+    }
+
+    image_data.width = image_view.width;
+    image_data.height = image_view.height;
+    image_data.channels = image_view.channels;
+    image_data.channel_format = image_view.channel_format;
+    image_data.primaries = image_view.primaries;
+    image_data.transfer = image_view.transfer;
+    image_data.image_state = image_view.image_state;
+    image_data.pixels.resize(image_view.height * image_view.width * getPixelSize(image_view));
+
+    copyImage(image_view, makeMutableImageView(image_data));
+
+    return image_data;
+}
+
+std::optional<ImageView> cropImageView(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const ImageView& image_view)
+{
+    return cropView(x, y, width, height, image_view);
+}
+
+std::optional<MutableImageView> cropImageView(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const MutableImageView& image_view)
+{
+    return cropView(x, y, width, height, image_view);
+}
+
+std::optional<ImageView> getCubeFaceView(uint32_t face, const ImageView& image_view)
+{
+    return cubeFaceView(face, image_view);
+}
+
+std::optional<MutableImageView> getCubeFaceView(uint32_t face, const MutableImageView& image_view)
+{
+    return cubeFaceView(face, image_view);
+}
+
+std::size_t getMipChainSize(uint32_t width, uint32_t height, uint32_t channels, ChannelFormat channel_format)
+{
+    const std::size_t pixel_size = (std::size_t)channels * getChannelFormatSize(channel_format);
+
+    std::size_t size{ 0u };
+    while (width > 0u && height > 0u)
+    {
+        size += (std::size_t)width * height * pixel_size;
+
+        if (width == 1u && height == 1u)
+        {
+            break;
+        }
+
+        width = std::max(width / 2u, 1u);
+        height = std::max(height / 2u, 1u);
+    }
+
+    return size;
+}
+
+std::vector<MutableImageView> getMipChainViews(const MutableImageView& base)
+{
+    std::vector<MutableImageView> mip_levels{};
+    if (!isValidImageView(base))
+    {
+        return mip_levels;
+    }
+
+    const std::size_t pixel_size = getPixelSize(base);
+
+    MutableImageView level = base;
+    level.row_pitch = level.width * pixel_size;
+
+    while (true)
+    {
+        mip_levels.push_back(level);
+
+        if (level.width == 1u && level.height == 1u)
+        {
+            break;
+        }
+
+        level.data += level.row_pitch * level.height;
+        level.width = std::max(level.width / 2u, 1u);
+        level.height = std::max(level.height / 2u, 1u);
+        level.row_pitch = level.width * pixel_size;
+    }
+
+    return mip_levels;
+}
+
+bool generateMipMaps(const std::vector<MutableImageView>& mip_levels)
+{
+    if (mip_levels.empty())
+    {
+        return false;
+    }
+
+    // Always resize from level 0 to avoid accumulated resampling error
+    for (std::size_t i = 1u; i < mip_levels.size(); i++)
+    {
+        if (!resizeImage(mip_levels[0], mip_levels[i], FilterKernel::BOX))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool copyImage(const ImageView& source, const MutableImageView& destination)
+{
+    if (!isValidImageView(source) || !isValidImageView(destination) || !isSameLayout(source, destination))
+    {
+        return false;
+    }
+
+    if (source.data == destination.data)
+    {
+        return source.row_pitch == destination.row_pitch;
+    }
+
+    const std::size_t row_size = source.width * getPixelSize(source);
+    for (uint32_t y = 0u; y < source.height; y++)
+    {
+        std::memmove(destination.data + y * destination.row_pitch, source.data + y * source.row_pitch, row_size);
+    }
+
+    return true;
+}
+
+bool convertImageChannels(const ImageView& source, const MutableImageView& destination)
+{
+    if (!isValidImageView(source) || !isValidImageView(destination))
+    {
+        return false;
+    }
+
+    if (source.width != destination.width || source.height != destination.height || source.channel_format != destination.channel_format)
+    {
+        return false;
+    }
+
+    if (source.channels == destination.channels)
+    {
+        return copyImage(source, destination);
+    }
+
+    const std::size_t channel_size = getChannelFormatSize(source.channel_format);
+    const std::size_t source_pixel_size = getPixelSize(source);
+    const std::size_t destination_pixel_size = getPixelSize(destination);
+
+    // In place, growing pixels are written back to front and shrinking pixels front to back,
+    // so no source pixel is overwritten before it is read.
+    const bool in_place = source.data == destination.data;
+    const bool grows = destination_pixel_size > source_pixel_size;
+    if (in_place && (grows ? destination.row_pitch < source.row_pitch : destination.row_pitch > source.row_pitch))
+    {
+        return false;
+    }
+    const bool backwards = in_place && grows;
+
+    // Channels missing in the source become 0, a missing alpha becomes 1, matching decodePixels().
+    uint8_t default_pixel[16]{};
+    const float rgba[4]{ 0.0f, 0.0f, 0.0f, 1.0f };
+    encodePixels(rgba, 1u, destination.channel_format, 4u, default_pixel);
+
+    const std::size_t copy_size = std::min(source.channels, destination.channels) * channel_size;
+
+    auto convertPixel = [&](uint32_t x, uint32_t y) {
+        const uint8_t* source_pixel = source.data + y * source.row_pitch + x * source_pixel_size;
+        uint8_t* destination_pixel = destination.data + y * destination.row_pitch + x * destination_pixel_size;
+
+        uint8_t pixel[16];
+        std::memcpy(pixel, source_pixel, copy_size);
+        std::memcpy(pixel + copy_size, default_pixel + copy_size, destination_pixel_size - copy_size);
+        std::memcpy(destination_pixel, pixel, destination_pixel_size);
+    };
+
+    if (backwards)
+    {
+        for (uint32_t y = source.height; y-- > 0u;)
+        {
+            for (uint32_t x = source.width; x-- > 0u;)
+            {
+                convertPixel(x, y);
+            }
+        }
+    }
+    else if (in_place)
+    {
+        for (uint32_t y = 0u; y < source.height; y++)
+        {
+            for (uint32_t x = 0u; x < source.width; x++)
+            {
+                convertPixel(x, y);
+            }
+        }
+    }
+    else
+    {
+        getThreadPool().parallelFor(source.height, 64u, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t y = begin; y < end; y++)
+            {
+                for (uint32_t x = 0u; x < source.width; x++)
+                {
+                    convertPixel(x, (uint32_t)y);
+                }
+            }
+        });
+    }
+
+    return true;
+}
+
+bool convertImageColorSpace(const ImageView& source, const MutableImageView& destination)
+{
+    if (!isValidImageView(source) || !isValidImageView(destination) || !isSameLayout(source, destination))
+    {
+        return false;
+    }
+
+    if (source.data == destination.data && source.row_pitch != destination.row_pitch)
+    {
+        return false;
+    }
+
+    if (source.transfer == TransferFunction::UNKNOWN || destination.transfer == TransferFunction::UNKNOWN)
+    {
+        return false;
+    }
+
+    auto to_xyz = getRgbToXYZ(source.primaries);
+    auto from_xyz = getRgbToXYZ(destination.primaries);
+    if (!to_xyz.has_value() || !from_xyz.has_value())
+    {
+        return false;
+    }
+
+    // Source primaries -> XYZ -> target primaries
+    const float3x3 conversion = inverse(*from_xyz) * *to_xyz;
+
+    // Rows are independent, so this also works in place.
+    getThreadPool().parallelFor(source.height, 16u, [&](std::size_t begin, std::size_t end) {
+        AlignedBuffer<float> row((std::size_t)source.width * 4u);
+
+        for (std::size_t y = begin; y < end; y++)
+        {
+            decodePixels(source.data + y * source.row_pitch, source.channel_format, source.channels, source.width, row.data());
+
+            for (uint32_t x = 0u; x < source.width; x++)
+            {
+                float* pixel = &row[(std::size_t)x * 4u];
+
+                const float3 color = fromLinear(destination.transfer, conversion * toLinear(source.transfer, float3{ pixel[0], pixel[1], pixel[2] }));
+
+                pixel[0] = color[0];
+                pixel[1] = color[1];
+                pixel[2] = color[2];
+            }
+
+            encodePixels(row.data(), source.width, destination.channel_format, destination.channels, destination.data + y * destination.row_pitch);
+        }
+    });
+
+    return true;
+}
@@ -0,0 +1,96 @@
+#ifndef CORE_IMAGE_VIEW_H_
+#define CORE_IMAGE_VIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "core/color/types.h"
+#include "core/image/image_data.h"
+
+// Non-owning views onto pixel memory. Rows are row_pitch bytes apart, pixels inside a row are tightly packed.
+// Crops, cube faces and mip levels of a packed mip chain are views onto the same memory, no pixels are copied.
+
+struct ImageView
+{
+    const uint8_t* data{ nullptr };
+
+    uint32_t width{ 0u };
+    uint32_t height{ 0u };
+    std::size_t row_pitch{ 0u };
+
+    uint32_t channels{ 0u };
+    ChannelFormat channel_format{ ChannelFormat::UNDEFINED };
+
+    ColorPrimaries primaries{ ColorPrimaries::UNKNOWN };
+    TransferFunction transfer{ TransferFunction::UNKNOWN };
+    ImageState image_state{ ImageState::UNKNOWN };
+};
+
+struct MutableImageView
+{
+    uint8_t* data{ nullptr };
+
+    uint32_t width{ 0u };
+    uint32_t height{ 0u };
+    std::size_t row_pitch{ 0u };
+
+    uint32_t channels{ 0u };
+    ChannelFormat channel_format{ ChannelFormat::UNDEFINED };
+
+    ColorPrimaries primaries{ ColorPrimaries::UNKNOWN };
+    TransferFunction transfer{ TransferFunction::UNKNOWN };
+    ImageState image_state{ ImageState::UNKNOWN };
+
+    operator ImageView() const;
+};
+
+std::size_t getPixelSize(const ImageView& image_view);
+
+bool isValidImageView(const ImageView& image_view);
+
+ImageView makeImageView(const ImageData& image_data);
+
+MutableImageView makeMutableImageView(ImageData& image_data);
+
+// Copies the pixels into a new, tightly packed image.
+ImageData toImageData(const ImageView& image_view);
+
+// Writes the view, e.g. a crop or a cube face, without copying it first.
+bool saveImageData(const char* filename, const ImageView& image_view);
+
+// Sub-rectangles
+
+std::optional<ImageView> cropImageView(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const ImageView& image_view);
+
+std::optional<MutableImageView> cropImageView(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const MutableImageView& image_view);
+
+// Faces of a cube map stored as six vertically stacked faces, see image_resample.h.
+
+std::optional<ImageView> getCubeFaceView(uint32_t face, const ImageView& image_view);
+
+std::optional<MutableImageView> getCubeFaceView(uint32_t face, const MutableImageView& image_view);
+
+// Mip chains packed into one allocation, level 0 first, every level tightly packed.
+
+std::size_t getMipChainSize(uint32_t width, uint32_t height, uint32_t channels, ChannelFormat channel_format);
+
+// base describes level 0 and points to at least getMipChainSize() bytes.
+std::vector<MutableImageView> getMipChainViews(const MutableImageView& base);
+
+// Fills levels 1 and up from level 0 with a box filter.
+bool generateMipMaps(const std::vector<MutableImageView>& mip_levels);
+
+// Operations writing into caller provided destinations. The destination defines the target layout.
+
+// Same size and layout required.
+bool copyImage(const ImageView& source, const MutableImageView& destination);
+
+// The destination channel count selects the conversion. Runs in place if both views start at the same memory.
+bool convertImageChannels(const ImageView& source, const MutableImageView& destination);
+
+// The destination color metadata selects the conversion. Runs in place if both views start at the same memory.
+bool convertImageColorSpace(const ImageView& source, const MutableImageView& destination);
+
+#endif /* CORE_IMAGE_VIEW_H_ */
@@ -0,0 +1,217 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0u);
+        m_open = std::exchange(other.m_open, false);
+
+#if defined(_WIN32)
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(const std::string& filename, MappedFileAccess access, bool populate)
+{
+    close();
+
+    DWORD flags = access == MappedFileAccess::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+
+        return false;
+    }
+
+    m_file = file;
+    m_size = (std::size_t)file_size.QuadPart;
+    m_open = true;
+
+    if (m_size == 0u)
+    {
+        return true;
+    }
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+    if (!m_mapping)
+    {
+        close();
+
+        return false;
+    }
+
+    m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0u, 0u, 0u));
+    if (!m_data)
+    {
+        close();
+
+        return false;
+    }
+
+    if (populate)
+    {
+        WIN32_MEMORY_RANGE_ENTRY range{ (void*)m_data, m_size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1u, &range, 0u);
+    }
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data)
+    {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+
+    if (m_file)
+    {
+        CloseHandle(m_file);
+    }
+
+    m_data = nullptr;
+    m_size = 0u;
+    m_open = false;
+
+    m_file = nullptr;
+    m_mapping = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename, MappedFileAccess access, bool populate)
+{
+    close();
+
+    int file = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat file_status{};
+    if (fstat(file, &file_status) != 0 || !S_ISREG(file_status.st_mode))
+    {
+        ::close(file);
+
+        return false;
+    }
+
+    m_size = (std::size_t)file_status.st_size;
+    m_open = true;
+
+    if (m_size == 0u)
+    {
+        ::close(file);
+
+        return true;
+    }
+
+    int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+    if (populate)
+    {
+        flags |= MAP_POPULATE;
+    }
+#endif
+
+    void* data = mmap(nullptr, m_size, PROT_READ, flags, file, 0);
+
+    // The mapping keeps its own reference to the file.
+    ::close(file);
+
+    if (data == MAP_FAILED)
+    {
+        close();
+
+        return false;
+    }
+
+    m_data = static_cast<const std::byte*>(data);
+
+    madvise(data, m_size, access == MappedFileAccess::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+#if !defined(MAP_POPULATE)
+    if (populate)
+    {
+        madvise(data, m_size, MADV_WILLNEED);
+    }
+#endif
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data)
+    {
+        munmap((void*)m_data, m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0u;
+    m_open = false;
+}
+
+#endif
+
+bool MappedFile::isOpen() const
+{
+    return m_open;
+}
+
+std::span<const std::byte> MappedFile::getData() const
+{
+    return { m_data, m_size };
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return m_size;
+}
@@ -0,0 +1,58 @@
+#ifndef CORE_IO_MAPPEDFILE_H_
+#define CORE_IO_MAPPEDFILE_H_
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+// Read-ahead hint passed to the operating system.
+enum class MappedFileAccess
+{
+    SEQUENTIAL,
+    RANDOM
+};
+
+// Read only view of a whole file mapped into memory. Pages are read on first access, nothing is copied.
+class MappedFile
+{
+
+private:
+
+    const std::byte* m_data{ nullptr };
+    std::size_t m_size{ 0u };
+
+    bool m_open{ false };
+
+#if defined(_WIN32)
+    void* m_file{ nullptr };
+    void* m_mapping{ nullptr };
+#endif
+
+public:
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile operator=(const MappedFile&) = delete;
+
+    MappedFile() = default;
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    // populate reads the whole file before returning, e.g. to keep the I/O inside a throttled section.
+    bool open(const std::string& filename, MappedFileAccess access = MappedFileAccess::SEQUENTIAL, bool populate = false);
+
+    void close();
+
+    // Empty files open successfully and have no data.
+    bool isOpen() const;
+
+    std::span<const std::byte> getData() const;
+
+    std::size_t getSize() const;
+};
+
+#endif /* CORE_IO_MAPPEDFILE_H_ */
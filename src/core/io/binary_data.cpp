@@ -1,6 +1,12 @@
 #include "binary_data.h"
 
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
 
 bool save(const std::string& output, const std::string& filename)
 {
@@ -16,6 +22,49 @@ bool save(const std::string& output, const std::string& filename)
     return true;
 }
 
+bool saveAtomic(std::span<const std::byte> output, const std::string& filename)
+{
+    static std::atomic<uint32_t> counter{ 0u };
+
+    // Unique per thread and call, so concurrent writers of the same file never share a temporary file.
+    const std::string temporary_filename = filename + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "_" + std::to_string(counter.fetch_add(1u));
+
+    {
+        std::ofstream file(temporary_filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file.write((const char*)output.data(), (std::streamsize)output.size());
+        file.close();
+
+        if (file.fail())
+        {
+            std::error_code error_code{};
+            std::filesystem::remove(temporary_filename, error_code);
+
+            return false;
+        }
+    }
+
+    std::error_code error_code{};
+    std::filesystem::rename(temporary_filename, filename, error_code);
+    if (error_code)
+    {
+        std::filesystem::remove(temporary_filename, error_code);
+
+        return false;
+    }
+
+    return true;
+}
+
+bool saveAtomic(const std::string& output, const std::string& filename)
+{
+    return saveAtomic(std::as_bytes(std::span<const char>(output.data(), output.size())), filename);
+}
+
 std::optional<std::string> load(const std::string& filename)
 {
     std::ifstream file(filename, std::ios::ate | std::ios::binary);
@@ -1,11 +1,19 @@
 #ifndef CORE_IO_BINARYDATA_H_
 #define CORE_IO_BINARYDATA_H_
 
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <string>
 
 bool save(const std::string& output, const std::string& filename);
 
+// Writes a temporary file next to the target and renames it, so readers see either the old or the complete new file.
+bool saveAtomic(std::span<const std::byte> output, const std::string& filename);
+
+bool saveAtomic(const std::string& output, const std::string& filename);
+
+// Copies the file into memory. Use MappedFile to access large files without a copy.
 std::optional<std::string> load(const std::string& filename);
 
 #endif /* CORE_IO_BINARYDATA_H_ */
@@ -5,11 +5,14 @@
 // https://en.wikipedia.org/wiki/Extended_Backus%E2%80%93Naur_form
 
 #include "ebnf_base.h"
+#include "ebnf_character_class.h"
 #include "ebnf_character_rule.h"
+#include "ebnf_compiler.h"
 #include "ebnf_conjunction.h"
 #include "ebnf_escape.h"
 #include "ebnf_exclude.h"
 #include "ebnf_factor.h"
+#include "ebnf_incremental.h"
 #include "ebnf_terminal.h"
 
 #endif /* CORE_PARSER_EBNF_H_ */
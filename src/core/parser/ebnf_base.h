@@ -1,13 +1,19 @@
 #ifndef CORE_PARSER_EBNF_BASE_H_
 #define CORE_PARSER_EBNF_BASE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace ebnf
@@ -19,10 +25,246 @@ struct ParseResult
 {
     bool success{ false };
     std::size_t next_position{ 0 };
-    std::string value{};
+
+    // The matched slice of the parsed text, valid as long as the text.
+    std::string_view value{};
 
     // C++20: Spaceship operator for comparisons
     auto operator<=>(const ParseResult&) const = default;
+
+    [[nodiscard]] std::size_t getPosition() const noexcept
+    {
+        return next_position - value.size();
+    }
+
+    // For callers, which keep the value beyond the lifetime of the text.
+    [[nodiscard]] std::string toString() const
+    {
+        return std::string(value);
+    }
+};
+
+// Memo table of a packrat parse.
+// Results are kept per (symbol id, position), so no symbol is parsed twice at the same position.
+// Allocated once per input, with a slot per position of the text.
+// For incremental parsing, every entry also keeps how far its parse looked into the text. After an edit, entries
+// whose examined text is unchanged are reused, also if they moved. The lengths of an entry are relative to its
+// position, so only the slots move with an edit. Entries are checked lazily against the edits since they were
+// last found valid.
+
+class ParseMemo
+{
+
+private:
+
+    static constexpr std::uint32_t NO_ENTRY = UINT32_MAX;
+
+    // Symbol id of an entry found invalid.
+    static constexpr std::uint32_t NO_SYMBOL = UINT32_MAX;
+
+    struct Entry
+    {
+        std::uint32_t symbol_id{ 0u };
+        std::uint32_t next{ NO_ENTRY };
+
+        // Number of edits, when the entry was last known to be valid.
+        std::uint32_t edit_count{ 0u };
+
+        bool success{ false };
+
+        std::size_t length{ 0u };
+        std::size_t value_size{ 0u };
+        std::size_t examined_length{ 0u };
+    };
+
+    struct Edit
+    {
+        std::size_t offset{ 0u };
+        std::size_t removed{ 0u };
+        std::size_t inserted{ 0u };
+    };
+
+    std::pmr::vector<std::uint32_t> m_heads;
+    std::pmr::vector<Entry> m_entries;
+    std::pmr::vector<Edit> m_edits;
+
+    std::size_t m_hits{ 0u };
+
+    bool m_incremental{ false };
+
+    // Maps the entry back through the edits since it was last valid. Fails if one of them touched its examined text.
+    bool isValid(Entry& entry, std::size_t position) const noexcept
+    {
+        for (std::size_t i = m_edits.size(); i > entry.edit_count; i--)
+        {
+            const Edit& edit = m_edits[i - 1u];
+
+            if (position + entry.examined_length <= edit.offset)
+            {
+                continue;
+            }
+
+            if (position < edit.offset + edit.inserted)
+            {
+                return false;
+            }
+
+            position = position - edit.inserted + edit.removed;
+        }
+
+        entry.edit_count = (std::uint32_t)m_edits.size();
+
+        return true;
+    }
+
+public:
+
+    struct Hit
+    {
+        ParseResult result{};
+
+        // One past the last examined position.
+        std::size_t examined_end{ 0u };
+    };
+
+    explicit ParseMemo(std::size_t text_size, std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource()) :
+        m_heads(text_size + 1u, NO_ENTRY, memory_resource),
+        m_entries(memory_resource),
+        m_edits(memory_resource)
+    {
+    }
+
+    // Reuses the memory for another input.
+    void reset(std::size_t text_size)
+    {
+        m_heads.assign(text_size + 1u, NO_ENTRY);
+        m_entries.clear();
+        m_edits.clear();
+        m_hits = 0u;
+    }
+
+    // The value of the result is a view of the given text.
+    [[nodiscard]] std::optional<Hit> find(std::uint32_t symbol_id, std::size_t position, std::string_view text)
+    {
+        if (position >= m_heads.size()) [[unlikely]]
+        {
+            return {};
+        }
+
+        for (std::uint32_t index = m_heads[position]; index != NO_ENTRY; index = m_entries[index].next)
+        {
+            Entry& entry = m_entries[index];
+            if (entry.symbol_id != symbol_id)
+            {
+                continue;
+            }
+
+            if (entry.edit_count != m_edits.size() && !isValid(entry, position)) [[unlikely]]
+            {
+                entry.symbol_id = NO_SYMBOL;
+
+                return {};
+            }
+
+            m_hits++;
+
+            if (!entry.success)
+            {
+                return Hit{ .examined_end = position + entry.examined_length };
+            }
+
+            const std::size_t next_position = position + entry.length;
+
+            return Hit{ .result = { .success = true,
+                                    .next_position = next_position,
+                                    .value = text.substr(next_position - entry.value_size, entry.value_size) },
+                        .examined_end = position + entry.examined_length };
+        }
+
+        return {};
+    }
+
+    // Failed results are kept without position and value.
+    void insert(std::uint32_t symbol_id, std::size_t position, const ParseResult& result, std::size_t examined_end)
+    {
+        if (position >= m_heads.size()) [[unlikely]]
+        {
+            return;
+        }
+
+        m_entries.push_back({ .symbol_id = symbol_id,
+                              .next = m_heads[position],
+                              .edit_count = (std::uint32_t)m_edits.size(),
+                              .success = result.success,
+                              .length = result.success ? result.next_position - position : 0u,
+                              .value_size = result.success ? result.value.size() : 0u,
+                              .examined_length = examined_end - position });
+        m_heads[position] = (std::uint32_t)(m_entries.size() - 1u);
+    }
+
+    // Replaces removed characters at the offset by inserted ones. Slots of removed positions are dropped and
+    // those after the edit move, all other entries are checked when found.
+    void edit(std::size_t offset, std::size_t removed, std::size_t inserted)
+    {
+        offset = std::min(offset, m_heads.size() - 1u);
+        removed = std::min(removed, m_heads.size() - 1u - offset);
+
+        if (inserted > removed)
+        {
+            m_heads.insert(m_heads.begin() + (std::ptrdiff_t)offset, inserted - removed, NO_ENTRY);
+        }
+        else
+        {
+            m_heads.erase(m_heads.begin() + (std::ptrdiff_t)offset, m_heads.begin() + (std::ptrdiff_t)(offset + removed - inserted));
+        }
+        std::fill_n(m_heads.begin() + (std::ptrdiff_t)offset, inserted, NO_ENTRY);
+
+        m_edits.push_back({ offset, removed, inserted });
+    }
+
+    // Lets repetitions also memoize chunks of their iterations, so parses after an edit skip unchanged ones.
+    // Costs time and memory on the first parse, so it is off for parses without edits.
+    void setIncremental(bool incremental) noexcept
+    {
+        m_incremental = incremental;
+    }
+
+    [[nodiscard]] bool isIncremental() const noexcept
+    {
+        return m_incremental;
+    }
+
+    [[nodiscard]] std::size_t getEntryCount() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    [[nodiscard]] std::size_t getHitCount() const noexcept
+    {
+        return m_hits;
+    }
+
+    [[nodiscard]] std::size_t getEditCount() const noexcept
+    {
+        return m_edits.size();
+    }
+};
+
+// State shared by all symbols during one parse.
+
+struct ParseContext
+{
+    // Enables packrat parsing, if set.
+    ParseMemo* memo{ nullptr };
+
+    // One past the last position looked at, where the end of the text counts as a position.
+    std::size_t examined_end{ 0u };
+
+    // Symbols reading the text directly report how far they looked, so memoized results can be reused after edits.
+    void examine(std::size_t end) noexcept
+    {
+        examined_end = std::max(examined_end, end);
+    }
 };
 
 // Base symbol
@@ -32,10 +274,33 @@ class ASymbol
 
 private:
 
+    std::uint32_t m_id{ createId() };
+
+    bool m_memoize{ true };
+
     std::function<void(std::string_view)> m_on_success{};
 
 protected:
 
+    // Unique id, also for memo entries of a symbol beside its results.
+    static std::uint32_t createId() noexcept
+    {
+        static std::atomic<std::uint32_t> next_id{ 0u };
+
+        return next_id.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    virtual ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const = 0;
+
+    // Text between the positions, clamped to the text.
+    [[nodiscard]] static std::string_view slice(std::string_view text, std::size_t begin, std::size_t end) noexcept
+    {
+        begin = std::min(begin, text.size());
+        end = std::clamp(end, begin, text.size());
+
+        return text.substr(begin, end - begin);
+    }
+
     void executeOnSuccess(std::string_view sequence) const noexcept
     {
         if (m_on_success)
@@ -56,12 +321,75 @@ public:
     ASymbol(ASymbol&&) = default;
     ASymbol& operator=(ASymbol&&) = default;
 
-    virtual ParseResult parse(std::string_view text, std::size_t position) const = 0;
+    // Does not allocate, the values of the results are views of the text.
+    ParseResult parse(std::string_view text, std::size_t position) const
+    {
+        ParseContext context{};
+
+        return doParse(text, position, context);
+    }
+
+    // With a memo in the context, a memoized result is returned without parsing and without calling on_success again.
+    ParseResult parse(std::string_view text, std::size_t position, ParseContext& context) const
+    {
+        if (!context.memo || !m_memoize) [[likely]]
+        {
+            return doParse(text, position, context);
+        }
+
+        if (std::optional<ParseMemo::Hit> hit = context.memo->find(m_id, position, text))
+        {
+            context.examine(hit->examined_end);
+
+            return hit->result;
+        }
+
+        const std::size_t examined_end = std::exchange(context.examined_end, position);
+
+        ParseResult result = doParse(text, position, context);
+
+        // At least the matched text or the first character, for symbols which do not report.
+        context.examine(std::max(result.next_position, position + 1u));
+        context.memo->insert(m_id, position, result, context.examined_end);
+        context.examine(examined_end);
+
+        return result;
+    }
+
+    // Packrat parse in linear time, with a memo table for this input allocated from memory_resource.
+    ParseResult parsePackrat(std::string_view text, std::size_t position = 0, std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource()) const
+    {
+        ParseMemo memo{ text.size(), memory_resource };
+        ParseContext context{ &memo };
+
+        return parse(text, position, context);
+    }
+
+    [[nodiscard]] std::uint32_t getId() const noexcept
+    {
+        return m_id;
+    }
+
+    // Symbols cheaper to parse again than to look up, like terminals, opt out by default.
+    void setMemoize(bool memoize) noexcept
+    {
+        m_memoize = memoize;
+    }
+
+    [[nodiscard]] bool isMemoize() const noexcept
+    {
+        return m_memoize;
+    }
 
     void setOnSuccess(std::function<void(std::string_view)> on_success) noexcept
     {
         m_on_success = std::move(on_success);
     }
+
+    [[nodiscard]] const std::function<void(std::string_view)>& getOnSuccess() const noexcept
+    {
+        return m_on_success;
+    }
 };
 
 class ASingleSymbol : public ASymbol
@@ -79,6 +407,11 @@ public:
         m_symbol{ std::move(symbol) }
     {
     }
+
+    [[nodiscard]] const std::shared_ptr<ASymbol>& getSymbol() const noexcept
+    {
+        return m_symbol;
+    }
 };
 
 class ASequenceSymbol : public ASymbol
@@ -97,6 +430,11 @@ public:
         m_symbols.push_back(std::move(symbol));
     }
 
+    [[nodiscard]] const std::vector<std::shared_ptr<ASymbol>>& getSymbols() const noexcept
+    {
+        return m_symbols;
+    }
+
     // C++20: Add range-based initialization
     template<std::ranges::range R>
         requires std::convertible_to<std::ranges::range_value_t<R>, std::shared_ptr<ASymbol>>
@@ -0,0 +1,227 @@
+#ifndef CORE_PARSER_EBNF_CHARACTER_CLASS_H_
+#define CORE_PARSER_EBNF_CHARACTER_CLASS_H_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "core/utility/simd.h"
+
+#if defined(PLAYGROUND_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace ebnf
+{
+
+// Set of the 256 byte values as a bitset.
+// The bits are laid out as two 16 byte tables indexed by the low nibble, one for the bytes below 0x80 and one
+// for those above, with a bit per high nibble. So membership of 16 or 32 bytes is tested at once with pshufb,
+// following the vectorised classification of Muła and Lemire.
+
+class CharacterClass
+{
+
+private:
+
+    std::array<std::uint8_t, 32> m_table{};
+
+    [[nodiscard]] static constexpr std::size_t getIndex(unsigned char c) noexcept
+    {
+        return ((std::size_t)(c >> 7u) << 4u) | (std::size_t)(c & 0x0Fu);
+    }
+
+    [[nodiscard]] static constexpr std::uint8_t getBit(unsigned char c) noexcept
+    {
+        return (std::uint8_t)(1u << ((c >> 4u) & 0x07u));
+    }
+
+#if defined(PLAYGROUND_SSE2)
+
+    PLAYGROUND_TARGET("avx2")
+    static std::size_t scanAvx2(const std::uint8_t* table, const char* data, std::size_t size) noexcept
+    {
+        const __m256i table_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+        const __m256i table_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16)));
+        const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+
+        std::size_t i{ 0u };
+        for (; i + 32u <= size; i += 32u)
+        {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+
+            const __m256i low = _mm256_and_si256(input, nibble_mask);
+            const __m256i high = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask);
+
+            // The sign bit of the byte selects the table, pshufb ignores bit 3 of the index for the row bit.
+            const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(table_low, low), _mm256_shuffle_epi8(table_high, low), input);
+            const __m256i bit = _mm256_shuffle_epi8(bits, high);
+
+            const std::uint32_t matches = (std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit));
+            if (matches != UINT32_MAX)
+            {
+                return i + (std::size_t)std::countr_zero(~matches);
+            }
+        }
+
+        return i;
+    }
+
+    PLAYGROUND_TARGET("ssse3")
+    static std::size_t scanSsse3(const std::uint8_t* table, const char* data, std::size_t size) noexcept
+    {
+        const __m128i table_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+        const __m128i table_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16));
+        const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+
+        std::size_t i{ 0u };
+        for (; i + 16u <= size; i += 16u)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+            const __m128i low = _mm_and_si128(input, nibble_mask);
+            const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask);
+
+            const __m128i upper = _mm_cmplt_epi8(input, _mm_setzero_si128());
+            const __m128i row = _mm_or_si128(_mm_andnot_si128(upper, _mm_shuffle_epi8(table_low, low)), _mm_and_si128(upper, _mm_shuffle_epi8(table_high, low)));
+            const __m128i bit = _mm_shuffle_epi8(bits, high);
+
+            const std::uint32_t matches = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), bit));
+            if (matches != 0xFFFFu)
+            {
+                return i + (std::size_t)std::countr_zero(~matches);
+            }
+        }
+
+        return i;
+    }
+
+    static bool hasAvx2()
+    {
+        static const bool has_avx2 = simdHasAvx2();
+
+        return has_avx2;
+    }
+
+    static bool hasSsse3()
+    {
+        static const bool has_ssse3 = simdHasSsse3();
+
+        return has_ssse3;
+    }
+
+    std::size_t scanVector(std::string_view text, std::size_t position) const noexcept
+    {
+        if (hasAvx2())
+        {
+            position += scanAvx2(m_table.data(), text.data() + position, text.size() - position);
+        }
+        else if (hasSsse3())
+        {
+            position += scanSsse3(m_table.data(), text.data() + position, text.size() - position);
+        }
+
+        while (position < text.size() && contains(text[position]))
+        {
+            position++;
+        }
+
+        return position;
+    }
+
+#endif
+
+public:
+
+    constexpr CharacterClass() = default;
+
+    bool operator==(const CharacterClass&) const = default;
+
+    constexpr void add(char c) noexcept
+    {
+        m_table[getIndex((unsigned char)c)] |= getBit((unsigned char)c);
+    }
+
+    // Characters from first to last, both included. Empty if first is greater than last.
+    constexpr void addInterval(char first, char last) noexcept
+    {
+        for (int c = first; c <= last; c++)
+        {
+            add((char)c);
+        }
+    }
+
+    constexpr void addList(std::string_view characters) noexcept
+    {
+        for (char c : characters)
+        {
+            add(c);
+        }
+    }
+
+    constexpr void addAll() noexcept
+    {
+        m_table.fill(0xFFu);
+    }
+
+    constexpr void remove(char c) noexcept
+    {
+        m_table[getIndex((unsigned char)c)] &= (std::uint8_t)~getBit((unsigned char)c);
+    }
+
+    // Removes all characters of the other class.
+    constexpr void exclude(const CharacterClass& character_class) noexcept
+    {
+        for (std::size_t i = 0u; i < m_table.size(); i++)
+        {
+            m_table[i] &= (std::uint8_t)~character_class.m_table[i];
+        }
+    }
+
+    [[nodiscard]] constexpr bool contains(char c) const noexcept
+    {
+        return (m_table[getIndex((unsigned char)c)] & getBit((unsigned char)c)) != 0u;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        for (std::uint8_t row : m_table)
+        {
+            if (row != 0u)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // End of the run of characters of the class, which starts at the position. The position itself, if there is none.
+    [[nodiscard]] std::size_t scan(std::string_view text, std::size_t position) const noexcept
+    {
+        std::size_t end_position = position;
+
+        while (end_position < text.size() && contains(text[end_position]))
+        {
+            end_position++;
+
+#if defined(PLAYGROUND_SSE2)
+            // Most runs, like separators and short names, end before the vector setup pays off.
+            if (end_position - position == 16u) [[unlikely]]
+            {
+                return scanVector(text, end_position);
+            }
+#endif
+        }
+
+        return end_position;
+    }
+};
+
+} // namespace ebnf
+
+#endif /* CORE_PARSER_EBNF_CHARACTER_CLASS_H_ */
@@ -2,38 +2,78 @@
 #define CORE_PARSER_EBNF_CHARACTER_RULE_H_
 
 #include <cstddef>
-#include <ranges>
-#include <string>
 #include <string_view>
-#include <unordered_set>
 
 #include "ebnf_base.h"
+#include "ebnf_character_class.h"
 
 namespace ebnf
 {
 
 // Character rules
+// Membership is tested in a CharacterClass, which holds the characters of the rule without the ignored ones.
 
 class ACharacterRule : public ASymbol
 {
 
 protected:
 
-    std::unordered_set<char> m_characters_ignored;
+    CharacterClass m_character_class{};
+
+    CharacterClass m_characters_ignored{};
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
+    {
+        const std::size_t current_pos = scan(text, position);
+
+        // The character ending the run, or the end of the text.
+        context.examine(current_pos + 1u);
+
+        if (current_pos == position)
+        {
+            return {};
+        }
+
+        const std::string_view value = slice(text, position, current_pos);
+
+        executeOnSuccess(value);
+
+        return { .success = true, .next_position = current_pos, .value = value };
+    }
 
 public:
 
-    ACharacterRule() = default;
+    ACharacterRule()
+    {
+        setMemoize(false);
+    }
 
     void addIgnoredCharacter(char ignore_character)
     {
-        m_characters_ignored.insert(ignore_character);
+        m_characters_ignored.add(ignore_character);
+        m_character_class.remove(ignore_character);
     }
 
     [[nodiscard]] bool isIgnored(char c) const noexcept
     {
         return m_characters_ignored.contains(c);
     }
+
+    [[nodiscard]] const CharacterClass& getIgnoredCharacters() const noexcept
+    {
+        return m_characters_ignored;
+    }
+
+    [[nodiscard]] const CharacterClass& getCharacterClass() const noexcept
+    {
+        return m_character_class;
+    }
+
+    // End of the run of matching characters from the position, without calling on_success.
+    [[nodiscard]] std::size_t scan(std::string_view text, std::size_t position) const noexcept
+    {
+        return m_character_class.scan(text, position);
+    }
 };
 
 class IntervalCharacterRule : public ACharacterRule
@@ -52,44 +92,30 @@ public:
         m_character_start{ character_start },
         m_character_end{ character_end }
     {
+        m_character_class.addInterval(character_start, character_end);
     }
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+    [[nodiscard]] char getCharacterStart() const noexcept
     {
-        if (m_character_start > m_character_end) [[unlikely]]
-        {
-            return {};
-        }
-
-        if (position >= text.size()) [[unlikely]]
-        {
-            return {};
-        }
-
-        std::string result;
-        std::size_t current_pos = position;
-
-        // C++20: Use ranges view with take_while
-        for (char c : text | std::views::drop(position))
-        {
-            if (c < m_character_start || c > m_character_end)
-                break;
+        return m_character_start;
+    }
 
-            if (isIgnored(c))
-                break;
+    [[nodiscard]] char getCharacterEnd() const noexcept
+    {
+        return m_character_end;
+    }
+};
 
-            result += c;
-            ++current_pos;
-        }
+class ListCharacterRule : public ACharacterRule
+{
 
-        if (result.empty())
-        {
-            return {};
-        }
+public:
 
-        executeOnSuccess(result);
+    ListCharacterRule() = delete;
 
-        return { .success = true, .next_position = current_pos, .value = std::move(result) };
+    explicit ListCharacterRule(std::string_view characters)
+    {
+        m_character_class.addList(characters);
     }
 };
 
@@ -98,36 +124,9 @@ class AnyCharacterRule : public ACharacterRule
 
 public:
 
-    AnyCharacterRule() = default;
-
-    ParseResult parse(std::string_view text, std::size_t position) const override
+    AnyCharacterRule()
     {
-        if (position >= text.size()) [[unlikely]]
-        {
-            return {};
-        }
-
-        std::string result;
-        std::size_t current_pos = position;
-
-        // C++20: Use ranges with filter
-        for (char c : text | std::views::drop(position))
-        {
-            if (isIgnored(c))
-                break;
-
-            result += c;
-            ++current_pos;
-        }
-
-        if (result.empty())
-        {
-            return {};
-        }
-
-        executeOnSuccess(result);
-
-        return { .success = true, .next_position = current_pos, .value = std::move(result) };
+        m_character_class.addAll();
     }
 };
 
@@ -0,0 +1,635 @@
+#ifndef CORE_PARSER_EBNF_COMPILER_H_
+#define CORE_PARSER_EBNF_COMPILER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ebnf_base.h"
+#include "ebnf_character_class.h"
+#include "ebnf_character_rule.h"
+#include "ebnf_conjunction.h"
+#include "ebnf_exclude.h"
+#include "ebnf_factor.h"
+#include "ebnf_terminal.h"
+
+namespace ebnf
+{
+
+// Instructions of the parsing machine, see CompiledGrammar.
+
+enum class Opcode : std::uint8_t
+{
+    // Matches the character in the operand.
+    CHAR,
+    // Matches the literal with the index in the operand.
+    STRING,
+    // Matches the longest run of one or more characters of the class with the index in the operand.
+    CLASS_RUN,
+    // Pushes a backtrack entry, which continues at the operand.
+    CHOICE,
+    // Pops the backtrack entry and continues at the operand.
+    COMMIT,
+    // Backtracks to the last backtrack entry.
+    FAIL,
+    // Pops the backtrack entry and backtracks, the not-predicate of Exclude.
+    FAIL_TWICE,
+    CALL,
+    RETURN,
+    // Returns and records the match of the subroutine for the action with the index in the operand.
+    CAPTURE_RETURN,
+    END
+};
+
+struct Instruction
+{
+    Opcode opcode{ Opcode::FAIL };
+    std::uint32_t operand{ 0u };
+};
+
+// Grammar lowered to a flat instruction array, run by a dispatch loop with an explicit backtrack stack.
+// The machine follows the PEG machine of LPeg: alternatives become CHOICE and COMMIT, repetitions loops
+// and Exclude a not-predicate. Symbols used more than once, recursive ones and those with an on_success
+// action become subroutines, all others are inlined.
+// Results are the same as of the symbols. Actions fire only for the committed parse, after it succeeded, in
+// the order the symbols completed. Callbacks are copied at compile time.
+class CompiledGrammar
+{
+
+private:
+
+    struct Literal
+    {
+        std::uint32_t offset{ 0u };
+        std::uint32_t size{ 0u };
+    };
+
+    struct StackEntry
+    {
+        // Alternative or return address.
+        std::uint32_t address{ 0u };
+        bool choice{ false };
+
+        // Position to restore or start of the subroutine.
+        std::size_t position{ 0u };
+        std::size_t capture_count{ 0u };
+    };
+
+    struct Capture
+    {
+        std::uint32_t action{ 0u };
+
+        std::size_t begin{ 0u };
+        std::size_t end{ 0u };
+    };
+
+    class Compiler;
+
+    std::vector<Instruction> m_instructions{};
+
+    std::string m_literal_data{};
+    std::vector<Literal> m_literals{};
+
+    std::vector<CharacterClass> m_classes{};
+
+    std::vector<std::function<void(std::string_view)>> m_actions{};
+
+public:
+
+    CompiledGrammar() = default;
+
+    // Fails for symbol types unknown to the compiler.
+    static std::optional<CompiledGrammar> compile(const std::shared_ptr<ASymbol>& symbol);
+
+    ParseResult parse(std::string_view text, std::size_t position = 0) const
+    {
+        if (m_instructions.empty()) [[unlikely]]
+        {
+            return {};
+        }
+
+        const std::size_t start_position = position;
+
+        std::vector<StackEntry> stack{};
+        stack.reserve(64u);
+
+        std::vector<Capture> captures{};
+
+        std::uint32_t pc{ 0u };
+
+        for (;;)
+        {
+            const Instruction instruction = m_instructions[pc];
+
+            switch (instruction.opcode)
+            {
+                case Opcode::CHAR:
+                    if (position < text.size() && text[position] == (char)instruction.operand)
+                    {
+                        position++;
+                        pc++;
+
+                        continue;
+                    }
+                    break;
+                case Opcode::STRING:
+                {
+                    const Literal& literal = m_literals[instruction.operand];
+                    const std::string_view sequence{ m_literal_data.data() + literal.offset, literal.size };
+                    if (position <= text.size() && text.substr(position).starts_with(sequence))
+                    {
+                        position += sequence.size();
+                        pc++;
+
+                        continue;
+                    }
+                    break;
+                }
+                case Opcode::CLASS_RUN:
+                {
+                    const std::size_t end_position = m_classes[instruction.operand].scan(text, position);
+
+                    if (end_position > position)
+                    {
+                        position = end_position;
+                        pc++;
+
+                        continue;
+                    }
+                    break;
+                }
+                case Opcode::CHOICE:
+                    stack.push_back({ instruction.operand, true, position, captures.size() });
+                    pc++;
+
+                    continue;
+                case Opcode::COMMIT:
+                    stack.pop_back();
+                    pc = instruction.operand;
+
+                    continue;
+                case Opcode::FAIL:
+                    break;
+                case Opcode::FAIL_TWICE:
+                    stack.pop_back();
+                    break;
+                case Opcode::CALL:
+                    stack.push_back({ pc + 1u, false, position, 0u });
+                    pc = instruction.operand;
+
+                    continue;
+                case Opcode::RETURN:
+                    pc = stack.back().address;
+                    stack.pop_back();
+
+                    continue;
+                case Opcode::CAPTURE_RETURN:
+                    captures.push_back({ instruction.operand, stack.back().position, position });
+                    pc = stack.back().address;
+                    stack.pop_back();
+
+                    continue;
+                case Opcode::END:
+                {
+                    for (const Capture& capture : captures)
+                    {
+                        m_actions[capture.action](text.substr(capture.begin, capture.end - capture.begin));
+                    }
+
+                    const std::size_t begin = std::min(start_position, text.size());
+
+                    return { .success = true,
+                             .next_position = position,
+                             .value = text.substr(begin, position - begin) };
+                }
+            }
+
+            // Backtracks to the last choice, dropping the subroutines entered since.
+            while (!stack.empty() && !stack.back().choice)
+            {
+                stack.pop_back();
+            }
+
+            if (stack.empty())
+            {
+                return {};
+            }
+
+            position = stack.back().position;
+            captures.resize(stack.back().capture_count);
+            pc = stack.back().address;
+
+            stack.pop_back();
+        }
+    }
+
+    [[nodiscard]] const std::vector<Instruction>& getInstructions() const noexcept
+    {
+        return m_instructions;
+    }
+};
+
+class CompiledGrammar::Compiler
+{
+
+private:
+
+    CompiledGrammar& m_grammar;
+
+    // Incoming references per symbol, the root counts as referenced once.
+    std::unordered_map<const ASymbol*, std::uint32_t> m_references{};
+
+    std::unordered_map<const ASymbol*, std::uint32_t> m_subroutines{};
+    std::vector<const ASymbol*> m_pending_subroutines{};
+    std::vector<std::pair<std::uint32_t, const ASymbol*>> m_calls{};
+
+    template<class T>
+    static const T* getIf(const ASymbol* symbol)
+    {
+        return typeid(*symbol) == typeid(T) ? static_cast<const T*>(symbol) : nullptr;
+    }
+
+    static std::vector<const ASymbol*> getChildren(const ASymbol* symbol)
+    {
+        std::vector<const ASymbol*> children{};
+
+        if (const auto* sequence_symbol = dynamic_cast<const ASequenceSymbol*>(symbol))
+        {
+            for (const auto& child : sequence_symbol->getSymbols())
+            {
+                children.push_back(child.get());
+            }
+        }
+        else if (const auto* single_symbol = dynamic_cast<const ASingleSymbol*>(symbol))
+        {
+            children.push_back(single_symbol->getSymbol().get());
+
+            if (const auto* exclude = dynamic_cast<const Exclude*>(symbol))
+            {
+                children.push_back(exclude->getExcludeSymbol().get());
+            }
+        }
+
+        return children;
+    }
+
+    void countReferences(const ASymbol* symbol)
+    {
+        std::vector<const ASymbol*> symbols{ symbol };
+
+        while (!symbols.empty())
+        {
+            const ASymbol* current_symbol = symbols.back();
+            symbols.pop_back();
+
+            for (const ASymbol* child : getChildren(current_symbol))
+            {
+                if (child && m_references[child]++ == 0u)
+                {
+                    symbols.push_back(child);
+                }
+            }
+        }
+    }
+
+    std::uint32_t getAddress() const
+    {
+        return (std::uint32_t)m_grammar.m_instructions.size();
+    }
+
+    std::uint32_t emit(Opcode opcode, std::uint32_t operand = 0u)
+    {
+        m_grammar.m_instructions.push_back({ opcode, operand });
+
+        return getAddress() - 1u;
+    }
+
+    void patch(std::uint32_t address)
+    {
+        m_grammar.m_instructions[address].operand = getAddress();
+    }
+
+    std::uint32_t addClass(const CharacterClass& character_class)
+    {
+        m_grammar.m_classes.push_back(character_class);
+
+        return (std::uint32_t)(m_grammar.m_classes.size() - 1u);
+    }
+
+    static const ACharacterRule* getCharacterRule(const ASymbol* symbol)
+    {
+        if (const auto* interval_rule = getIf<IntervalCharacterRule>(symbol))
+        {
+            return interval_rule;
+        }
+
+        if (const auto* list_rule = getIf<ListCharacterRule>(symbol))
+        {
+            return list_rule;
+        }
+
+        return getIf<AnyCharacterRule>(symbol);
+    }
+
+    bool isSubroutine(const ASymbol* symbol) const
+    {
+        auto it = m_references.find(symbol);
+
+        return symbol->getOnSuccess() || (it != m_references.end() && it->second > 1u);
+    }
+
+    bool emitSymbol(const ASymbol* symbol)
+    {
+        if (!symbol)
+        {
+            emit(Opcode::FAIL);
+
+            return true;
+        }
+
+        if (!isSubroutine(symbol))
+        {
+            return emitBody(symbol);
+        }
+
+        if (!m_subroutines.contains(symbol))
+        {
+            m_subroutines[symbol] = UINT32_MAX;
+            m_pending_subroutines.push_back(symbol);
+        }
+
+        m_calls.emplace_back(emit(Opcode::CALL), symbol);
+
+        return true;
+    }
+
+    bool emitRepetition(const ASymbol* symbol)
+    {
+        const std::uint32_t loop_address = getAddress();
+        const std::uint32_t choice = emit(Opcode::CHOICE);
+
+        if (!emitSymbol(symbol))
+        {
+            return false;
+        }
+
+        emit(Opcode::COMMIT, loop_address);
+        patch(choice);
+
+        return true;
+    }
+
+    bool emitBody(const ASymbol* symbol)
+    {
+        if (const auto* terminal = getIf<Terminal>(symbol))
+        {
+            const std::string& character_sequence = terminal->getCharacterSequence();
+
+            if (character_sequence.empty())
+            {
+                emit(Opcode::FAIL);
+            }
+            else if (character_sequence.size() == 1u)
+            {
+                emit(Opcode::CHAR, (std::uint32_t)(unsigned char)character_sequence[0]);
+            }
+            else
+            {
+                m_grammar.m_literals.push_back({ (std::uint32_t)m_grammar.m_literal_data.size(), (std::uint32_t)character_sequence.size() });
+                m_grammar.m_literal_data += character_sequence;
+
+                emit(Opcode::STRING, (std::uint32_t)(m_grammar.m_literals.size() - 1u));
+            }
+
+            return true;
+        }
+
+        if (const auto* character_rule = getCharacterRule(symbol))
+        {
+            if (character_rule->getCharacterClass().empty())
+            {
+                emit(Opcode::FAIL);
+            }
+            else
+            {
+                emit(Opcode::CLASS_RUN, addClass(character_rule->getCharacterClass()));
+            }
+
+            return true;
+        }
+
+        if (const auto* alternation = getIf<Alternation>(symbol))
+        {
+            const auto& symbols = alternation->getSymbols();
+            if (symbols.empty())
+            {
+                emit(Opcode::FAIL);
+
+                return true;
+            }
+
+            std::vector<std::uint32_t> commits{};
+
+            for (std::size_t i = 0u; i + 1u < symbols.size(); i++)
+            {
+                const std::uint32_t choice = emit(Opcode::CHOICE);
+
+                if (!emitSymbol(symbols[i].get()))
+                {
+                    return false;
+                }
+
+                commits.push_back(emit(Opcode::COMMIT));
+                patch(choice);
+            }
+
+            if (!emitSymbol(symbols.back().get()))
+            {
+                return false;
+            }
+
+            for (std::uint32_t commit : commits)
+            {
+                patch(commit);
+            }
+
+            return true;
+        }
+
+        if (const auto* concatenation = getIf<Concatenation>(symbol))
+        {
+            const auto& symbols = concatenation->getSymbols();
+            if (symbols.empty())
+            {
+                emit(Opcode::FAIL);
+
+                return true;
+            }
+
+            for (const auto& element : symbols)
+            {
+                if (!emitSymbol(element.get()))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        if (const auto* zero_one = getIf<ZeroOneFactor>(symbol))
+        {
+            if (!zero_one->getSymbol())
+            {
+                emit(Opcode::FAIL);
+
+                return true;
+            }
+
+            const std::uint32_t choice = emit(Opcode::CHOICE);
+
+            if (!emitSymbol(zero_one->getSymbol().get()))
+            {
+                return false;
+            }
+
+            const std::uint32_t commit = emit(Opcode::COMMIT);
+            patch(choice);
+            patch(commit);
+
+            return true;
+        }
+
+        if (const auto* zero_many = getIf<ZeroManyFactor>(symbol))
+        {
+            if (!zero_many->getSymbol())
+            {
+                emit(Opcode::FAIL);
+
+                return true;
+            }
+
+            return emitRepetition(zero_many->getSymbol().get());
+        }
+
+        if (const auto* one_many = getIf<OneManyFactor>(symbol))
+        {
+            if (!one_many->getSymbol())
+            {
+                emit(Opcode::FAIL);
+
+                return true;
+            }
+
+            return emitSymbol(one_many->getSymbol().get()) && emitRepetition(one_many->getSymbol().get());
+        }
+
+        if (const auto* exclude = getIf<Exclude>(symbol))
+        {
+            if (!exclude->getSymbol() || !exclude->getExcludeSymbol())
+            {
+                emit(Opcode::FAIL);
+
+                return true;
+            }
+
+            // Fails if the excluded symbol matches at the position, without consuming it.
+            const std::uint32_t choice = emit(Opcode::CHOICE);
+
+            if (!emitSymbol(exclude->getExcludeSymbol().get()))
+            {
+                return false;
+            }
+
+            emit(Opcode::FAIL_TWICE);
+            patch(choice);
+
+            return emitSymbol(exclude->getSymbol().get());
+        }
+
+        return false;
+    }
+
+public:
+
+    Compiler() = delete;
+
+    explicit Compiler(CompiledGrammar& grammar) :
+        m_grammar{ grammar }
+    {
+    }
+
+    bool compile(const ASymbol* symbol)
+    {
+        if (!symbol)
+        {
+            return false;
+        }
+
+        m_references[symbol] = 1u;
+        countReferences(symbol);
+
+        if (!emitSymbol(symbol))
+        {
+            return false;
+        }
+        emit(Opcode::END);
+
+        // Subroutines may add further ones.
+        for (std::size_t i = 0u; i < m_pending_subroutines.size(); i++)
+        {
+            const ASymbol* subroutine = m_pending_subroutines[i];
+
+            m_subroutines[subroutine] = getAddress();
+
+            if (!emitBody(subroutine))
+            {
+                return false;
+            }
+
+            if (subroutine->getOnSuccess())
+            {
+                m_grammar.m_actions.push_back(subroutine->getOnSuccess());
+
+                emit(Opcode::CAPTURE_RETURN, (std::uint32_t)(m_grammar.m_actions.size() - 1u));
+            }
+            else
+            {
+                emit(Opcode::RETURN);
+            }
+        }
+
+        for (const auto& [address, subroutine] : m_calls)
+        {
+            m_grammar.m_instructions[address].operand = m_subroutines[subroutine];
+        }
+
+        return true;
+    }
+};
+
+inline std::optional<CompiledGrammar> CompiledGrammar::compile(const std::shared_ptr<ASymbol>& symbol)
+{
+    CompiledGrammar grammar{};
+
+    Compiler compiler{ grammar };
+    if (!compiler.compile(symbol.get()))
+    {
+        return {};
+    }
+
+    return grammar;
+}
+
+} // namespace ebnf
+
+#endif /* CORE_PARSER_EBNF_COMPILER_H_ */
@@ -19,7 +19,9 @@ public:
 
     Alternation() = default;
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+protected:
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
     {
         if (m_symbols.empty()) [[unlikely]]
         {
@@ -29,7 +31,7 @@ public:
         // C++20: Use ranges to find first successful parse
         for (const auto& element : m_symbols)
         {
-            auto result = element->parse(text, position);
+            auto result = element->parse(text, position, context);
 
             if (result.success)
             {
@@ -49,35 +51,38 @@ public:
 
     Concatenation() = default;
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+protected:
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
     {
         if (m_symbols.empty()) [[unlikely]]
         {
             return {};
         }
 
-        std::string accumulated_value;
         std::size_t current_position = position;
 
         // C++20: All symbols must succeed in sequence
         for (const auto& element : m_symbols)
         {
-            auto result = element->parse(text, current_position);
+            auto result = element->parse(text, current_position, context);
 
             if (!result.success)
             {
                 return {};
             }
 
-            accumulated_value += result.value;
             current_position = result.next_position;
         }
 
-        executeOnSuccess(accumulated_value);
+        // The matches are adjacent, so the value is the slice they span.
+        const std::string_view value = slice(text, position, current_position);
+
+        executeOnSuccess(value);
 
         return { .success = true,
                  .next_position = current_position,
-                 .value = std::move(accumulated_value) };
+                 .value = value };
     }
 };
 
@@ -30,14 +30,21 @@ public:
     {
     }
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+    [[nodiscard]] const std::shared_ptr<ASymbol>& getExcludeSymbol() const noexcept
+    {
+        return m_exclude_symbol;
+    }
+
+protected:
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
     {
         if (!m_symbol || !m_exclude_symbol) [[unlikely]]
         {
             return {};
         }
 
-        auto main_result = m_symbol->parse(text, position);
+        auto main_result = m_symbol->parse(text, position, context);
 
         if (!main_result.success)
         {
@@ -45,7 +52,7 @@ public:
         }
 
         // C++20: Check if exclude pattern also matches at the same position
-        auto exclude_result = m_exclude_symbol->parse(text, position);
+        auto exclude_result = m_exclude_symbol->parse(text, position, context);
 
         if (exclude_result.success)
         {
@@ -1,12 +1,17 @@
 #ifndef CORE_PARSER_EBNF_FACTOR_H_
 #define CORE_PARSER_EBNF_FACTOR_H_
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "ebnf_base.h"
+#include "ebnf_character_rule.h"
 
 namespace ebnf
 {
@@ -25,14 +30,16 @@ public:
     {
     }
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+protected:
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
     {
         if (!m_symbol) [[unlikely]]
         {
             return {};
         }
 
-        auto result = m_symbol->parse(text, position);
+        auto result = m_symbol->parse(text, position, context);
 
         if (result.success)
         {
@@ -41,51 +48,175 @@ public:
         }
 
         // C++20: Designated initializers
-        executeOnSuccess("");
-        return { .success = true, .next_position = position, .value = "" };
+        const std::string_view value = slice(text, position, position);
+
+        executeOnSuccess(value);
+        return { .success = true, .next_position = position, .value = value };
     }
 };
 
-class ZeroManyFactor : public ASingleSymbol
+// Base of the repetitions.
+// With an incremental memo, the iterations are also memoized in chunks, so a parse after an edit jumps over the unchanged
+// chunks instead of looking up every iteration. Chunks end after iterations whose text hashes to a multiple of
+// CHUNK_SIZE, so the same text gives the same chunks, wherever it moved to.
+
+class ARepetitionFactor : public ASingleSymbol
 {
 
-public:
+private:
 
-    ZeroManyFactor() = delete;
+    static constexpr std::uint32_t CHUNK_SIZE{ 64u };
 
-    explicit ZeroManyFactor(std::shared_ptr<ASymbol> symbol) :
-        ASingleSymbol(std::move(symbol))
+    // Ends chunks of equal iterations, where the hash would not.
+    static constexpr std::uint32_t MAX_CHUNK_ITERATIONS{ CHUNK_SIZE * 4u };
+
+    // Id of the chunks in the memo.
+    std::uint32_t m_chunk_id{ createId() };
+
+    // Set if the symbol is a character rule, whose runs are scanned directly.
+    const ACharacterRule* m_character_rule{ nullptr };
+
+    [[nodiscard]] static bool isChunkEnd(std::string_view value) noexcept
     {
+        // FNV-1a
+        std::uint32_t hash{ 2166136261u };
+        for (char c : value)
+        {
+            hash = (hash ^ (std::uint8_t)c) * 16777619u;
+        }
+
+        return hash % CHUNK_SIZE == 0u;
     }
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+    std::size_t repeatChunked(std::string_view text, std::size_t position, ParseContext& context) const
     {
-        if (!m_symbol) [[unlikely]]
+        std::size_t current_position = position;
+
+        std::size_t chunk_position = position;
+        std::size_t chunk_examined_end = position;
+        std::uint32_t chunk_iterations{ 0u };
+
+        for (;;)
         {
-            return {};
+            if (chunk_iterations == 0u)
+            {
+                if (std::optional<ParseMemo::Hit> hit = context.memo->find(m_chunk_id, current_position, text))
+                {
+                    context.examine(hit->examined_end);
+
+                    current_position = hit->result.next_position;
+                    chunk_position = current_position;
+                    chunk_examined_end = current_position;
+
+                    continue;
+                }
+            }
+
+            const std::size_t examined_end = std::exchange(context.examined_end, current_position);
+
+            const ParseResult result = m_symbol->parse(text, current_position, context);
+
+            chunk_examined_end = std::max(chunk_examined_end, context.examined_end);
+            context.examine(examined_end);
+
+            if (!result.success)
+            {
+                break;
+            }
+
+            current_position = result.next_position;
+            chunk_iterations++;
+
+            if (chunk_iterations == MAX_CHUNK_ITERATIONS || isChunkEnd(result.value))
+            {
+                context.memo->insert(m_chunk_id, chunk_position, { .success = true, .next_position = current_position, .value = slice(text, chunk_position, current_position) }, chunk_examined_end);
+
+                chunk_position = current_position;
+                chunk_examined_end = current_position;
+                chunk_iterations = 0u;
+            }
+        }
+
+        return current_position;
+    }
+
+protected:
+
+    // End of the repetition from the position, which is the position itself without a match.
+    std::size_t repeat(std::string_view text, std::size_t position, ParseContext& context) const
+    {
+        // A character rule matches the whole run at once, so the loop ends after one match anyway.
+        if (m_character_rule && !m_character_rule->getOnSuccess())
+        {
+            const std::size_t current_position = m_character_rule->scan(text, position);
+            context.examine(current_position + 1u);
+
+            return current_position;
+        }
+
+        if (context.memo && context.memo->isIncremental())
+        {
+            return repeatChunked(text, position, context);
         }
 
-        std::string accumulated_value;
         std::size_t current_position = position;
 
         // Match while possible
-        for (auto result = m_symbol->parse(text, current_position);
+        for (auto result = m_symbol->parse(text, current_position, context);
              result.success;
-             result = m_symbol->parse(text, current_position))
+             result = m_symbol->parse(text, current_position, context))
         {
-            accumulated_value += result.value;
             current_position = result.next_position;
         }
 
-        executeOnSuccess(accumulated_value);
+        return current_position;
+    }
+
+public:
+
+    ARepetitionFactor() = delete;
+
+    explicit ARepetitionFactor(std::shared_ptr<ASymbol> symbol) :
+        ASingleSymbol(std::move(symbol)),
+        m_character_rule{ dynamic_cast<const ACharacterRule*>(m_symbol.get()) }
+    {
+    }
+};
+
+class ZeroManyFactor : public ARepetitionFactor
+{
+
+public:
+
+    ZeroManyFactor() = delete;
+
+    explicit ZeroManyFactor(std::shared_ptr<ASymbol> symbol) :
+        ARepetitionFactor(std::move(symbol))
+    {
+    }
+
+protected:
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
+    {
+        if (!m_symbol) [[unlikely]]
+        {
+            return {};
+        }
+
+        const std::size_t current_position = repeat(text, position, context);
+
+        const std::string_view value = slice(text, position, current_position);
+
+        executeOnSuccess(value);
 
         return { .success = true,
                  .next_position = current_position,
-                 .value = std::move(accumulated_value) };
+                 .value = value };
     }
 };
 
-class OneManyFactor : public ASingleSymbol
+class OneManyFactor : public ARepetitionFactor
 {
 
 public:
@@ -93,41 +224,33 @@ public:
     OneManyFactor() = delete;
 
     explicit OneManyFactor(std::shared_ptr<ASymbol> symbol) :
-        ASingleSymbol(std::move(symbol))
+        ARepetitionFactor(std::move(symbol))
     {
     }
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+protected:
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
     {
         if (!m_symbol) [[unlikely]]
         {
             return {};
         }
 
-        auto first_result = m_symbol->parse(text, position);
-
-        if (!first_result.success)
+        // The symbol matched at least once, as an empty match would repeat forever.
+        const std::size_t current_position = repeat(text, position, context);
+        if (current_position == position)
         {
             return {};
         }
 
-        std::string accumulated_value = std::move(first_result.value);
-        std::size_t current_position = first_result.next_position;
-
-        // Continue matching while possible
-        for (auto result = m_symbol->parse(text, current_position);
-             result.success;
-             result = m_symbol->parse(text, current_position))
-        {
-            accumulated_value += result.value;
-            current_position = result.next_position;
-        }
+        const std::string_view value = slice(text, position, current_position);
 
-        executeOnSuccess(accumulated_value);
+        executeOnSuccess(value);
 
         return { .success = true,
                  .next_position = current_position,
-                 .value = std::move(accumulated_value) };
+                 .value = value };
     }
 };
 
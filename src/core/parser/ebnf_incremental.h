@@ -0,0 +1,91 @@
+#ifndef CORE_PARSER_EBNF_INCREMENTAL_H_
+#define CORE_PARSER_EBNF_INCREMENTAL_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "ebnf_base.h"
+
+namespace ebnf
+{
+
+// Incremental parsing
+
+// Owns a text and the memo of its parses, so after an edit only the symbols which looked at the changed text
+// are parsed again. All other results are taken from the memo, also if the edit moved them.
+// The values of the results are views of the owned text and valid until the next edit.
+// Invalidated entries stay in the memo, setText() starts over with an empty one.
+
+class IncrementalParser
+{
+
+private:
+
+    std::shared_ptr<ASymbol> m_symbol;
+
+    std::string m_text;
+
+    ParseMemo m_memo;
+
+public:
+
+    IncrementalParser() = delete;
+
+    IncrementalParser(std::shared_ptr<ASymbol> symbol, std::string text, std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource()) :
+        m_symbol{ std::move(symbol) },
+        m_text{ std::move(text) },
+        m_memo{ m_text.size(), memory_resource }
+    {
+        m_memo.setIncremental(true);
+    }
+
+    ParseResult parse(std::size_t position = 0)
+    {
+        if (!m_symbol) [[unlikely]]
+        {
+            return {};
+        }
+
+        ParseContext context{ &m_memo };
+
+        return m_symbol->parse(m_text, position, context);
+    }
+
+    // Replaces the removed characters at the offset by the inserted ones. Fails, if the range is outside of the text.
+    bool edit(std::size_t offset, std::size_t removed, std::string_view inserted)
+    {
+        if (offset > m_text.size() || removed > m_text.size() - offset)
+        {
+            return false;
+        }
+
+        m_text.replace(offset, removed, inserted);
+        m_memo.edit(offset, removed, inserted.size());
+
+        return true;
+    }
+
+    void setText(std::string text)
+    {
+        m_text = std::move(text);
+        m_memo.reset(m_text.size());
+    }
+
+    [[nodiscard]] const std::string& getText() const noexcept
+    {
+        return m_text;
+    }
+
+    [[nodiscard]] const ParseMemo& getMemo() const noexcept
+    {
+        return m_memo;
+    }
+};
+
+} // namespace ebnf
+
+#endif /* CORE_PARSER_EBNF_INCREMENTAL_H_ */
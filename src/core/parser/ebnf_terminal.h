@@ -26,36 +26,48 @@ public:
     explicit Terminal(char character) :
         m_character_sequence{ character }
     {
+        setMemoize(false);
     }
 
     explicit Terminal(std::string character_sequence) :
         m_character_sequence{ std::move(character_sequence) }
     {
+        setMemoize(false);
     }
 
-    ParseResult parse(std::string_view text, std::size_t position) const override
+    [[nodiscard]] const std::string& getCharacterSequence() const noexcept
+    {
+        return m_character_sequence;
+    }
+
+protected:
+
+    ParseResult doParse(std::string_view text, std::size_t position, ParseContext& context) const override
     {
         if (m_character_sequence.empty()) [[unlikely]]
         {
             return {};
         }
 
+        context.examine(position + m_character_sequence.size());
+
         if (position + m_character_sequence.size() > text.size()) [[unlikely]]
         {
             return {};
         }
 
         // C++20: Use string_view for comparison
-        if (text.substr(position, m_character_sequence.size()) != m_character_sequence)
+        const std::string_view value = text.substr(position, m_character_sequence.size());
+        if (value != m_character_sequence)
         {
             return {};
         }
 
-        executeOnSuccess(m_character_sequence);
+        executeOnSuccess(value);
 
         return { .success = true,
                  .next_position = position + m_character_sequence.size(),
-                 .value = m_character_sequence };
+                 .value = value };
     }
 };
 
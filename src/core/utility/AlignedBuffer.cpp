@@ -0,0 +1,157 @@
+#include "AlignedBuffer.h"
+
+#include <bit>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+// Below this size the allocator is fast enough, so blocks are never pooled.
+constexpr std::size_t POOLED_SIZE_MINIMUM = 64u * 1024u;
+
+struct AlignedMemoryPool
+{
+    std::mutex mutex{};
+
+    std::unordered_map<std::size_t, std::vector<void*>> free_blocks{};
+    std::size_t pooled_size{ 0u };
+    std::size_t limit{ 0u };
+};
+
+AlignedMemoryPool& getAlignedMemoryPool()
+{
+    // Intentionally leaked, buffers in static objects may be freed after a static pool would be destroyed.
+    static AlignedMemoryPool* pool = new AlignedMemoryPool{};
+
+    return *pool;
+}
+
+void* allocateSystemMemory(std::size_t size)
+{
+    return ::operator new(size, std::align_val_t{ ALIGNED_MEMORY_ALIGNMENT });
+}
+
+void freeSystemMemory(void* memory)
+{
+    ::operator delete(memory, std::align_val_t{ ALIGNED_MEMORY_ALIGNMENT });
+}
+
+void trimAlignedMemoryPool(AlignedMemoryPool& pool)
+{
+    for (auto it = pool.free_blocks.begin(); it != pool.free_blocks.end() && pool.pooled_size > pool.limit;)
+    {
+        while (!it->second.empty() && pool.pooled_size > pool.limit)
+        {
+            freeSystemMemory(it->second.back());
+            it->second.pop_back();
+
+            pool.pooled_size -= it->first;
+        }
+
+        if (it->second.empty())
+        {
+            it = pool.free_blocks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+} // namespace
+
+std::size_t getAlignedAllocationSize(std::size_t size)
+{
+    size = std::max<std::size_t>(size, 1u);
+
+    if (size < POOLED_SIZE_MINIMUM)
+    {
+        return (size + ALIGNED_MEMORY_ALIGNMENT - 1u) & ~(ALIGNED_MEMORY_ALIGNMENT - 1u);
+    }
+
+    // Four classes per power of two waste at most 25% and keep the number of classes small.
+    std::size_t step = std::bit_floor(size) / 4u;
+
+    return (size + step - 1u) & ~(step - 1u);
+}
+
+void* allocateAlignedMemory(std::size_t size)
+{
+    if (size >= POOLED_SIZE_MINIMUM)
+    {
+        AlignedMemoryPool& pool = getAlignedMemoryPool();
+
+        std::unique_lock<std::mutex> lock(pool.mutex);
+
+        auto it = pool.free_blocks.find(size);
+        if (it != pool.free_blocks.end() && !it->second.empty())
+        {
+            void* memory = it->second.back();
+            it->second.pop_back();
+
+            pool.pooled_size -= size;
+
+            return memory;
+        }
+    }
+
+    return allocateSystemMemory(size);
+}
+
+void freeAlignedMemory(void* memory, std::size_t size)
+{
+    if (!memory)
+    {
+        return;
+    }
+
+    if (size >= POOLED_SIZE_MINIMUM)
+    {
+        AlignedMemoryPool& pool = getAlignedMemoryPool();
+
+        std::unique_lock<std::mutex> lock(pool.mutex);
+
+        if (pool.pooled_size + size <= pool.limit)
+        {
+            pool.free_blocks[size].push_back(memory);
+            pool.pooled_size += size;
+
+            return;
+        }
+    }
+
+    freeSystemMemory(memory);
+}
+
+void setAlignedMemoryPoolLimit(std::size_t limit)
+{
+    AlignedMemoryPool& pool = getAlignedMemoryPool();
+
+    std::unique_lock<std::mutex> lock(pool.mutex);
+
+    pool.limit = limit;
+
+    trimAlignedMemoryPool(pool);
+}
+
+std::size_t getAlignedMemoryPoolLimit()
+{
+    AlignedMemoryPool& pool = getAlignedMemoryPool();
+
+    std::unique_lock<std::mutex> lock(pool.mutex);
+
+    return pool.limit;
+}
+
+std::size_t getAlignedMemoryPoolSize()
+{
+    AlignedMemoryPool& pool = getAlignedMemoryPool();
+
+    std::unique_lock<std::mutex> lock(pool.mutex);
+
+    return pool.pooled_size;
+}
@@ -0,0 +1,277 @@
+#ifndef CORE_UTILITY_ALIGNEDBUFFER_H_
+#define CORE_UTILITY_ALIGNEDBUFFER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+// Alignment of every aligned allocation, enough for any SIMD load and a cache line.
+constexpr std::size_t ALIGNED_MEMORY_ALIGNMENT = 64u;
+
+// Size actually reserved for a request: multiples of the alignment and, from 64 KiB on, quarter power of two steps.
+std::size_t getAlignedAllocationSize(std::size_t size);
+
+// Memory is not initialised. Large blocks are taken from the pool if one of the same size class is free.
+void* allocateAlignedMemory(std::size_t size);
+
+// size has to be the value passed to allocateAlignedMemory().
+void freeAlignedMemory(void* memory, std::size_t size);
+
+// Upper bound of the bytes kept for reuse. 0, the default, disables the pool and releases all kept blocks.
+void setAlignedMemoryPoolLimit(std::size_t limit);
+
+std::size_t getAlignedMemoryPoolLimit();
+
+// Bytes currently kept for reuse.
+std::size_t getAlignedMemoryPoolSize();
+
+// Contiguous, 64 byte aligned storage for trivially copyable elements.
+// Unlike std::vector, growing with resize(size) leaves the new elements uninitialised, as they are usually overwritten right away.
+template<class T>
+class AlignedBuffer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "AlignedBuffer requires trivially copyable elements");
+
+private:
+
+    T* m_data{ nullptr };
+    std::size_t m_size{ 0u };
+    std::size_t m_capacity{ 0u };
+
+    std::size_t m_allocation_size{ 0u };
+
+    void reallocate(std::size_t capacity)
+    {
+        std::size_t allocation_size = getAlignedAllocationSize(capacity * sizeof(T));
+        T* data = static_cast<T*>(allocateAlignedMemory(allocation_size));
+
+        if (m_size > 0u)
+        {
+            std::memcpy(data, m_data, m_size * sizeof(T));
+        }
+
+        release();
+
+        m_data = data;
+        m_capacity = allocation_size / sizeof(T);
+        m_allocation_size = allocation_size;
+    }
+
+    void release()
+    {
+        if (m_data)
+        {
+            freeAlignedMemory(m_data, m_allocation_size);
+        }
+
+        m_data = nullptr;
+        m_capacity = 0u;
+        m_allocation_size = 0u;
+    }
+
+public:
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    AlignedBuffer() = default;
+
+    // Elements are not initialised.
+    explicit AlignedBuffer(std::size_t size)
+    {
+        resize(size);
+    }
+
+    AlignedBuffer(std::size_t size, const T& value)
+    {
+        resize(size, value);
+    }
+
+    AlignedBuffer(std::initializer_list<T> values)
+    {
+        assign(values.begin(), values.size());
+    }
+
+    AlignedBuffer(const AlignedBuffer& other)
+    {
+        assign(other.m_data, other.m_size);
+    }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept :
+        m_data{ std::exchange(other.m_data, nullptr) }, m_size{ std::exchange(other.m_size, 0u) }, m_capacity{ std::exchange(other.m_capacity, 0u) }, m_allocation_size{ std::exchange(other.m_allocation_size, 0u) }
+    {
+    }
+
+    ~AlignedBuffer()
+    {
+        release();
+    }
+
+    AlignedBuffer& operator=(const AlignedBuffer& other)
+    {
+        if (this != &other)
+        {
+            assign(other.m_data, other.m_size);
+        }
+
+        return *this;
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0u);
+            m_capacity = std::exchange(other.m_capacity, 0u);
+            m_allocation_size = std::exchange(other.m_allocation_size, 0u);
+        }
+
+        return *this;
+    }
+
+    AlignedBuffer& operator=(std::initializer_list<T> values)
+    {
+        assign(values.begin(), values.size());
+
+        return *this;
+    }
+
+    void assign(const T* values, std::size_t count)
+    {
+        m_size = 0u;
+        reserve(count);
+
+        if (count > 0u)
+        {
+            std::memcpy(m_data, values, count * sizeof(T));
+        }
+        m_size = count;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > m_capacity)
+        {
+            reallocate(capacity);
+        }
+    }
+
+    // New elements are not initialised.
+    void resize(std::size_t size)
+    {
+        if (size > m_capacity)
+        {
+            // Geometric growth keeps repeated appends linear.
+            reallocate(std::max(size, m_capacity + m_capacity / 2u));
+        }
+
+        m_size = size;
+    }
+
+    void resize(std::size_t size, const T& value)
+    {
+        std::size_t old_size = m_size;
+
+        resize(size);
+
+        if (size > old_size)
+        {
+            std::fill(m_data + old_size, m_data + size, value);
+        }
+    }
+
+    void clear()
+    {
+        m_size = 0u;
+    }
+
+    T* data()
+    {
+        return m_data;
+    }
+
+    const T* data() const
+    {
+        return m_data;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0u;
+    }
+
+    T& operator[](std::size_t index)
+    {
+        return m_data[index];
+    }
+
+    const T& operator[](std::size_t index) const
+    {
+        return m_data[index];
+    }
+
+    T& front()
+    {
+        return m_data[0];
+    }
+
+    const T& front() const
+    {
+        return m_data[0];
+    }
+
+    T& back()
+    {
+        return m_data[m_size - 1u];
+    }
+
+    const T& back() const
+    {
+        return m_data[m_size - 1u];
+    }
+
+    T* begin()
+    {
+        return m_data;
+    }
+
+    const T* begin() const
+    {
+        return m_data;
+    }
+
+    T* end()
+    {
+        return m_data + m_size;
+    }
+
+    const T* end() const
+    {
+        return m_data + m_size;
+    }
+
+    bool operator==(const AlignedBuffer& other) const
+    {
+        return m_size == other.m_size && std::equal(begin(), end(), other.begin());
+    }
+};
+
+#endif /* CORE_UTILITY_ALIGNEDBUFFER_H_ */
@@ -0,0 +1,122 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+
+constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+std::size_t getPadding(const std::byte* address, std::size_t alignment)
+{
+    return (alignment - (std::size_t)((std::uintptr_t)address % alignment)) % alignment;
+}
+
+} // namespace
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    // Blocks skipped here stay unused until the next reset.
+    while (m_block_index < m_blocks.size())
+    {
+        const Block& block = m_blocks[m_block_index];
+
+        const std::size_t padding = getPadding(block.data + m_offset, alignment);
+        if (m_offset + padding + bytes <= block.size)
+        {
+            std::byte* memory = block.data + m_offset + padding;
+
+            m_offset += padding + bytes;
+            m_used_bytes += padding + bytes;
+            m_peak_bytes = std::max(m_peak_bytes, m_used_bytes);
+
+            return memory;
+        }
+
+        m_block_index++;
+        m_offset = 0u;
+    }
+
+    // Room for the worst case padding, so the allocation always fits into the new block.
+    Block block{};
+    block.size = std::max(m_block_size, bytes + std::max(alignment, BLOCK_ALIGNMENT));
+    block.data = static_cast<std::byte*>(m_upstream->allocate(block.size, BLOCK_ALIGNMENT));
+
+    m_blocks.push_back(block);
+    m_block_index = m_blocks.size() - 1u;
+    m_offset = 0u;
+
+    return do_allocate(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void* memory, std::size_t bytes, std::size_t alignment)
+{
+    // Freed all at once by reset().
+    (void)memory;
+    (void)bytes;
+    (void)alignment;
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+FrameArena::FrameArena(std::size_t block_size, std::pmr::memory_resource* upstream) :
+    m_upstream{ upstream },
+    m_block_size{ std::max<std::size_t>(block_size, BLOCK_ALIGNMENT) }
+{
+}
+
+FrameArena::~FrameArena()
+{
+    release();
+}
+
+void FrameArena::reset()
+{
+    m_block_index = 0u;
+    m_offset = 0u;
+    m_used_bytes = 0u;
+}
+
+void FrameArena::release()
+{
+    for (const Block& block : m_blocks)
+    {
+        m_upstream->deallocate(block.data, block.size, BLOCK_ALIGNMENT);
+    }
+
+    m_blocks.clear();
+
+    reset();
+}
+
+std::size_t FrameArena::getUsedBytes() const
+{
+    return m_used_bytes;
+}
+
+std::size_t FrameArena::getPeakBytes() const
+{
+    return m_peak_bytes;
+}
+
+std::size_t FrameArena::getCapacity() const
+{
+    std::size_t capacity{ 0u };
+    for (const Block& block : m_blocks)
+    {
+        capacity += block.size;
+    }
+
+    return capacity;
+}
+
+FrameArena& getFrameArena()
+{
+    static FrameArena frame_arena{};
+
+    return frame_arena;
+}
@@ -0,0 +1,73 @@
+#ifndef CORE_UTILITY_FRAMEARENA_H_
+#define CORE_UTILITY_FRAMEARENA_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Linear allocator for data living until the end of a frame, e.g. temporary containers while recording commands.
+// Allocating bumps an offset, deallocating does nothing and reset() rewinds. Blocks are kept over resets, so once
+// the arena has grown to the needs of a frame, further frames do not allocate any memory.
+// Not thread safe, every thread needs its own arena.
+class FrameArena : public std::pmr::memory_resource
+{
+
+private:
+
+    struct Block
+    {
+        std::byte* data{ nullptr };
+        std::size_t size{ 0u };
+    };
+
+    std::pmr::memory_resource* m_upstream{ nullptr };
+    std::size_t m_block_size{ 0u };
+
+    std::vector<Block> m_blocks{};
+    std::size_t m_block_index{ 0u };
+    std::size_t m_offset{ 0u };
+
+    std::size_t m_used_bytes{ 0u };
+    std::size_t m_peak_bytes{ 0u };
+
+protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+
+    FrameArena operator=(const FrameArena&) = delete;
+    FrameArena operator=(FrameArena&&) = delete;
+
+    // Blocks are taken from upstream, larger ones for allocations exceeding block_size.
+    explicit FrameArena(std::size_t block_size = 256u * 1024u, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    ~FrameArena() override;
+
+    // Makes all memory available again. Nothing allocated before may be used afterwards.
+    void reset();
+
+    // Resets and returns all blocks to upstream.
+    void release();
+
+    // Bytes handed out since the last reset, including alignment padding.
+    std::size_t getUsedBytes() const;
+
+    // Highest used bytes of all frames.
+    std::size_t getPeakBytes() const;
+
+    // Bytes of all blocks.
+    std::size_t getCapacity() const;
+};
+
+// Arena of the thread running the frame loop. VulkanRuntime resets it at the beginning of every frame.
+FrameArena& getFrameArena();
+
+#endif /* CORE_UTILITY_FRAMEARENA_H_ */
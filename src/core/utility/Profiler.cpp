@@ -0,0 +1,316 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+namespace
+{
+
+constexpr std::size_t MAX_FRAMES = 256u;
+
+// Bounds the memory of threads recording zones while no frames are profiled.
+constexpr std::size_t MAX_THREAD_EVENTS = 64u * 1024u;
+
+// Track of the frame markers in the trace.
+constexpr std::uint32_t FRAME_TRACK = 0u;
+
+std::atomic<std::uint64_t> g_next_profiler_id{ 1u };
+
+void addStatistics(ProfilerFrame& frame, const char* name, bool gpu, std::int64_t duration_ns)
+{
+    const double duration_ms = (double)duration_ns / 1000000.0;
+
+    for (ProfilerZoneStatistics& zone : frame.zones)
+    {
+        // Names are usually literals, so comparing pointers is enough in most cases.
+        if (zone.gpu == gpu && (zone.name == name || std::string_view(zone.name) == name))
+        {
+            zone.count++;
+            zone.total_ms += duration_ms;
+            zone.max_ms = std::max(zone.max_ms, duration_ms);
+
+            return;
+        }
+    }
+
+    frame.zones.push_back({ name, gpu, 1u, duration_ms, duration_ms });
+}
+
+} // namespace
+
+// Zones are appended to a buffer of the recording thread, so threads do not contend with each other.
+struct Profiler::ThreadBuffer
+{
+    std::mutex mutex{};
+    std::vector<Event> events{};
+
+    std::uint32_t track{ 0u };
+
+    std::thread::id thread_id{};
+};
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer()
+{
+    // Cached per thread for the profiler used last, which usually is the global one.
+    // Compared by id, as a new profiler can reuse the address of a destroyed one.
+    thread_local std::uint64_t t_profiler_id{ 0u };
+    thread_local ThreadBuffer* t_thread_buffer{ nullptr };
+
+    if (t_profiler_id == m_id)
+    {
+        return *t_thread_buffer;
+    }
+
+    const std::thread::id thread_id = std::this_thread::get_id();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // The thread may have recorded into this profiler before it switched to another one.
+    auto it = std::find_if(m_thread_buffers.begin(), m_thread_buffers.end(), [thread_id](const std::unique_ptr<ThreadBuffer>& thread_buffer) { return thread_buffer->thread_id == thread_id; });
+    if (it == m_thread_buffers.end())
+    {
+        auto thread_buffer = std::make_unique<ThreadBuffer>();
+        thread_buffer->track = (std::uint32_t)m_track_names.size();
+        thread_buffer->thread_id = thread_id;
+        m_track_names.push_back("CPU thread " + std::to_string(m_thread_buffers.size()));
+
+        m_thread_buffers.push_back(std::move(thread_buffer));
+
+        it = m_thread_buffers.end() - 1;
+    }
+
+    t_profiler_id = m_id;
+    t_thread_buffer = it->get();
+
+    return *t_thread_buffer;
+}
+
+void Profiler::capture(const Event& event)
+{
+    if (m_capturing && m_trace_events.size() < m_max_trace_events)
+    {
+        m_trace_events.push_back(event);
+    }
+}
+
+Profiler::Profiler() :
+    m_id{ g_next_profiler_id.fetch_add(1u) },
+    m_start{ std::chrono::steady_clock::now() }
+{
+    m_track_names.push_back("Frames");
+}
+
+Profiler::~Profiler() = default;
+
+void Profiler::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() const
+{
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+std::int64_t Profiler::getTimeNs() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+void Profiler::addZone(const char* name, std::int64_t begin_ns, std::int64_t end_ns)
+{
+    ThreadBuffer& thread_buffer = getThreadBuffer();
+
+    std::unique_lock<std::mutex> lock(thread_buffer.mutex);
+
+    if (thread_buffer.events.size() >= MAX_THREAD_EVENTS)
+    {
+        return;
+    }
+
+    thread_buffer.events.push_back({ name, thread_buffer.track, begin_ns, end_ns });
+}
+
+std::uint32_t Profiler::addTrack(const std::string& name)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto it = std::find(m_track_names.begin(), m_track_names.end(), name);
+    if (it != m_track_names.end())
+    {
+        return (std::uint32_t)(it - m_track_names.begin());
+    }
+
+    m_track_names.push_back(name);
+
+    return (std::uint32_t)(m_track_names.size() - 1u);
+}
+
+void Profiler::addGpuZone(std::uint64_t frame_index, std::uint32_t track, const char* name, std::int64_t begin_ns, std::int64_t end_ns)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (ProfilerFrame& frame : m_frames)
+    {
+        if (frame.index == frame_index)
+        {
+            addStatistics(frame, name, true, end_ns - begin_ns);
+
+            break;
+        }
+    }
+
+    capture({ name, track, begin_ns, end_ns });
+}
+
+void Profiler::beginFrame()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_frame_begin_ns = getTimeNs();
+    m_frame_open = true;
+}
+
+void Profiler::endFrame()
+{
+    std::vector<Event> events{};
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (!m_frame_open)
+    {
+        return;
+    }
+
+    const std::int64_t frame_end_ns = getTimeNs();
+
+    ProfilerFrame frame{};
+    frame.index = m_frame_index;
+    frame.cpu_ms = (double)(frame_end_ns - m_frame_begin_ns) / 1000000.0;
+
+    capture({ "Frame", FRAME_TRACK, m_frame_begin_ns, frame_end_ns });
+
+    for (const std::unique_ptr<ThreadBuffer>& thread_buffer : m_thread_buffers)
+    {
+        {
+            std::unique_lock<std::mutex> thread_lock(thread_buffer->mutex);
+
+            events.swap(thread_buffer->events);
+        }
+
+        for (const Event& event : events)
+        {
+            addStatistics(frame, event.name, false, event.end_ns - event.begin_ns);
+
+            capture(event);
+        }
+
+        events.clear();
+    }
+
+    m_frames.push_back(std::move(frame));
+    if (m_frames.size() > MAX_FRAMES)
+    {
+        m_frames.pop_front();
+    }
+
+    m_frame_index++;
+    m_frame_open = false;
+}
+
+std::uint64_t Profiler::getFrameIndex() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_frame_index;
+}
+
+std::vector<ProfilerFrame> Profiler::getFrames() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return std::vector<ProfilerFrame>(m_frames.begin(), m_frames.end());
+}
+
+void Profiler::beginCapture(std::size_t max_events)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_capturing = true;
+    m_max_trace_events = max_events;
+    m_trace_events.clear();
+}
+
+void Profiler::endCapture()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_capturing = false;
+}
+
+std::string Profiler::getChromeTrace() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    nlohmann::json trace_events = nlohmann::json::array();
+
+    for (std::size_t i = 0u; i < m_track_names.size(); i++)
+    {
+        trace_events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", i }, { "args", { { "name", m_track_names[i] } } } });
+    }
+
+    // Complete events with microseconds, the unit of the format.
+    for (const Event& event : m_trace_events)
+    {
+        trace_events.push_back({ { "name", event.name }, { "ph", "X" }, { "pid", 1 }, { "tid", event.track }, { "ts", (double)event.begin_ns / 1000.0 }, { "dur", (double)(event.end_ns - event.begin_ns) / 1000.0 } });
+    }
+
+    nlohmann::json trace{};
+    trace["traceEvents"] = std::move(trace_events);
+    trace["displayTimeUnit"] = "ms";
+
+    return trace.dump();
+}
+
+bool Profiler::saveChromeTrace(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << getChromeTrace();
+
+    return file.good();
+}
+
+Profiler& getProfiler()
+{
+    static Profiler profiler{};
+
+    return profiler;
+}
+
+ProfilerZone::ProfilerZone(const char* name, Profiler& profiler) :
+    m_profiler{ profiler }
+{
+    if (m_profiler.isEnabled())
+    {
+        m_name = name;
+        m_begin_ns = m_profiler.getTimeNs();
+    }
+}
+
+ProfilerZone::~ProfilerZone()
+{
+    if (m_name)
+    {
+        m_profiler.addZone(m_name, m_begin_ns, m_profiler.getTimeNs());
+    }
+}
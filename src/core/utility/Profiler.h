@@ -0,0 +1,162 @@
+#ifndef CORE_UTILITY_PROFILER_H_
+#define CORE_UTILITY_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ProfilerZoneStatistics
+{
+    const char* name{ nullptr };
+
+    bool gpu{ false };
+
+    std::uint32_t count{ 0u };
+
+    double total_ms{ 0.0 };
+    double max_ms{ 0.0 };
+};
+
+struct ProfilerFrame
+{
+    std::uint64_t index{ 0u };
+
+    double cpu_ms{ 0.0 };
+
+    // CPU zones of all threads. GPU zones are added a few frames later, once their timestamps are available.
+    std::vector<ProfilerZoneStatistics> zones{};
+};
+
+// Collects timed zones of all threads and GPU queues per frame.
+// Zone names are not copied, so they have to outlive the profiler, e.g. string literals.
+class Profiler
+{
+
+private:
+
+    struct Event
+    {
+        const char* name{ nullptr };
+        std::uint32_t track{ 0u };
+
+        std::int64_t begin_ns{ 0 };
+        std::int64_t end_ns{ 0 };
+    };
+
+    struct ThreadBuffer;
+
+    std::uint64_t m_id{ 0u };
+
+    std::chrono::steady_clock::time_point m_start{};
+
+    std::atomic<bool> m_enabled{ true };
+
+    mutable std::mutex m_mutex{};
+
+    std::vector<std::unique_ptr<ThreadBuffer>> m_thread_buffers{};
+    std::vector<std::string> m_track_names{};
+
+    std::uint64_t m_frame_index{ 0u };
+    std::int64_t m_frame_begin_ns{ 0 };
+    bool m_frame_open{ false };
+
+    std::deque<ProfilerFrame> m_frames{};
+
+    bool m_capturing{ false };
+    std::size_t m_max_trace_events{ 0u };
+    std::vector<Event> m_trace_events{};
+
+    ThreadBuffer& getThreadBuffer();
+
+    void capture(const Event& event);
+
+public:
+
+    Profiler(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+
+    Profiler operator=(const Profiler&) = delete;
+    Profiler operator=(Profiler&&) = delete;
+
+    Profiler();
+
+    ~Profiler();
+
+    // Disabled zones cost a single relaxed load.
+    void setEnabled(bool enabled);
+
+    bool isEnabled() const;
+
+    // Time since construction, the time base of all zones.
+    std::int64_t getTimeNs() const;
+
+    // Zone of the calling thread.
+    void addZone(const char* name, std::int64_t begin_ns, std::int64_t end_ns);
+
+    // Additional timeline, e.g. for a GPU queue. Tracks with the same name are shared.
+    std::uint32_t addTrack(const std::string& name);
+
+    // Zone on a track of addTrack(), belonging to an earlier frame.
+    void addGpuZone(std::uint64_t frame_index, std::uint32_t track, const char* name, std::int64_t begin_ns, std::int64_t end_ns);
+
+    void beginFrame();
+
+    // Aggregates the zones recorded since beginFrame().
+    void endFrame();
+
+    // Index of the current or, between frames, the next frame.
+    std::uint64_t getFrameIndex() const;
+
+    // Up to the last 256 completed frames, oldest first.
+    std::vector<ProfilerFrame> getFrames() const;
+
+    // Keeps every zone for the trace export until endCapture() or max_events.
+    void beginCapture(std::size_t max_events = 1024u * 1024u);
+
+    void endCapture();
+
+    // Chrome trace event format, readable by chrome://tracing and Perfetto.
+    std::string getChromeTrace() const;
+
+    bool saveChromeTrace(const std::string& filename) const;
+};
+
+// Process wide profiler used by the SDK.
+Profiler& getProfiler();
+
+// Measures the enclosing scope on the calling thread.
+class ProfilerZone
+{
+
+private:
+
+    Profiler& m_profiler;
+
+    const char* m_name{ nullptr };
+    std::int64_t m_begin_ns{ 0 };
+
+public:
+
+    ProfilerZone(const ProfilerZone&) = delete;
+    ProfilerZone(ProfilerZone&&) = delete;
+
+    ProfilerZone operator=(const ProfilerZone&) = delete;
+    ProfilerZone operator=(ProfilerZone&&) = delete;
+
+    explicit ProfilerZone(const char* name, Profiler& profiler = getProfiler());
+
+    ~ProfilerZone();
+};
+
+#define PROFILER_ZONE_CONCAT_(a, b) a##b
+#define PROFILER_ZONE_CONCAT(a, b) PROFILER_ZONE_CONCAT_(a, b)
+
+#define PROFILER_ZONE(name) ProfilerZone PROFILER_ZONE_CONCAT(profiler_zone_, __LINE__)(name)
+
+#endif /* CORE_UTILITY_PROFILER_H_ */
@@ -0,0 +1,181 @@
+#include "TaskGroup.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+struct TaskGroup::State
+{
+    struct Task
+    {
+        std::function<void()> function{};
+
+        std::size_t missing_dependencies{ 0u };
+        std::vector<TaskId> successors{};
+
+        bool finished{ false };
+    };
+
+    std::mutex mutex{};
+    std::condition_variable condition{};
+
+    // Deque, so references stay valid while tasks are added.
+    std::deque<Task> tasks{};
+
+    std::size_t unfinished_tasks{ 0u };
+
+    // First exception of a task, until wait() rethrows it.
+    std::exception_ptr exception{};
+};
+
+void TaskGroup::schedule(ThreadPool& thread_pool, const std::shared_ptr<State>& state, std::size_t task_id)
+{
+    thread_pool.post([&thread_pool, state, task_id]() {
+        std::function<void()> function{};
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+
+            // After a failure, the remaining tasks are skipped.
+            if (!state->exception)
+            {
+                function = std::move(state->tasks[task_id].function);
+            }
+        }
+
+        if (function)
+        {
+            try
+            {
+                function();
+            }
+            catch (...)
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+
+                if (!state->exception)
+                {
+                    state->exception = std::current_exception();
+                }
+            }
+        }
+
+        std::vector<TaskId> ready{};
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+
+            State::Task& task = state->tasks[task_id];
+            task.finished = true;
+
+            for (TaskId successor : task.successors)
+            {
+                if (--state->tasks[successor].missing_dependencies == 0u)
+                {
+                    ready.push_back(successor);
+                }
+            }
+
+            state->unfinished_tasks--;
+            if (state->unfinished_tasks == 0u)
+            {
+                state->condition.notify_all();
+            }
+        }
+
+        for (TaskId successor : ready)
+        {
+            schedule(thread_pool, state, successor);
+        }
+    });
+}
+
+TaskGroup::TaskGroup(ThreadPool& thread_pool) :
+    m_thread_pool{ thread_pool },
+    m_state{ std::make_shared<State>() }
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    waitForTasks();
+}
+
+TaskGroup::TaskId TaskGroup::add(std::function<void()> function, std::initializer_list<TaskId> dependencies)
+{
+    TaskId task_id{ 0u };
+    bool ready{ false };
+
+    {
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+
+        task_id = m_state->tasks.size();
+
+        State::Task& task = m_state->tasks.emplace_back();
+        task.function = std::move(function);
+
+        for (TaskId dependency : dependencies)
+        {
+            // Unknown ids are ignored, they cannot be satisfied.
+            if (dependency >= task_id || m_state->tasks[dependency].finished)
+            {
+                continue;
+            }
+
+            m_state->tasks[dependency].successors.push_back(task_id);
+            task.missing_dependencies++;
+        }
+
+        m_state->unfinished_tasks++;
+
+        ready = task.missing_dependencies == 0u;
+    }
+
+    if (ready)
+    {
+        schedule(m_thread_pool, m_state, task_id);
+    }
+
+    return task_id;
+}
+
+void TaskGroup::wait()
+{
+    waitForTasks();
+
+    std::exception_ptr exception{};
+    {
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+
+        std::swap(exception, m_state->exception);
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskGroup::waitForTasks()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_state->mutex);
+
+            if (m_state->unfinished_tasks == 0u)
+            {
+                return;
+            }
+        }
+
+        if (!m_thread_pool.runPendingTask())
+        {
+            std::unique_lock<std::mutex> lock(m_state->mutex);
+
+            m_state->condition.wait_for(lock, std::chrono::microseconds(100), [this]() { return m_state->unfinished_tasks == 0u; });
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef CORE_UTILITY_TASKGROUP_H_
+#define CORE_UTILITY_TASKGROUP_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+
+#include "core/utility/ThreadPool.h"
+
+// Set of tasks with dependencies on the thread pool. A task starts once all its dependencies have finished.
+// Dependencies can only refer to tasks added before, so the graph cannot contain cycles.
+// If a task throws, the tasks which have not started yet are skipped and wait() rethrows the first exception.
+class TaskGroup
+{
+
+private:
+
+    struct State;
+
+    ThreadPool& m_thread_pool;
+
+    std::shared_ptr<State> m_state{};
+
+    static void schedule(ThreadPool& thread_pool, const std::shared_ptr<State>& state, std::size_t task_id);
+
+    void waitForTasks();
+
+public:
+
+    using TaskId = std::size_t;
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup(TaskGroup&&) = delete;
+
+    TaskGroup operator=(const TaskGroup&) = delete;
+    TaskGroup operator=(TaskGroup&&) = delete;
+
+    explicit TaskGroup(ThreadPool& thread_pool = getThreadPool());
+
+    // Waits for all tasks. An exception not taken by wait() is dropped.
+    ~TaskGroup();
+
+    TaskId add(std::function<void()> function, std::initializer_list<TaskId> dependencies = {});
+
+    // Helps with queued tasks until every task added so far has finished or was skipped.
+    // Rethrows the first exception of a task since the last call.
+    void wait();
+};
+
+#endif /* CORE_UTILITY_TASKGROUP_H_ */
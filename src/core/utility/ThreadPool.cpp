@@ -0,0 +1,406 @@
+#include "ThreadPool.h"
+
+#include <exception>
+#include <limits>
+
+namespace
+{
+
+constexpr std::size_t NO_WORKER = std::numeric_limits<std::size_t>::max();
+
+// Pool and queue of the current thread, if it is a worker.
+thread_local const ThreadPool* t_thread_pool{ nullptr };
+thread_local std::size_t t_worker_index{ NO_WORKER };
+
+// Of the task the worker is running, negative once it is counted.
+thread_local std::int64_t t_task_start_ns{ -1 };
+thread_local bool t_task_stolen{ false };
+
+std::int64_t getTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+void ThreadPool::enqueue(std::function<void()> task)
+{
+    // Counted first, so a worker never sleeps while the task is on its way into a queue.
+    m_pending.fetch_add(1u);
+
+    if (t_thread_pool == this)
+    {
+        Worker& worker = *m_workers[t_worker_index];
+
+        std::unique_lock<std::mutex> lock(worker.mutex);
+
+        worker.tasks.push_back(std::move(task));
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(m_tasks_mutex);
+
+        m_tasks.push_back(std::move(task));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+    }
+
+    m_condition.notify_one();
+}
+
+bool ThreadPool::popTask(std::size_t worker_index, std::function<void()>& task, bool& stolen)
+{
+    stolen = false;
+
+    if (worker_index != NO_WORKER)
+    {
+        Worker& worker = *m_workers[worker_index];
+
+        std::unique_lock<std::mutex> lock(worker.mutex);
+
+        if (!worker.tasks.empty())
+        {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+
+            m_pending.fetch_sub(1u);
+
+            return true;
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_tasks_mutex);
+
+        if (!m_tasks.empty())
+        {
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+
+            m_pending.fetch_sub(1u);
+
+            return true;
+        }
+    }
+
+    const std::size_t first = worker_index != NO_WORKER ? worker_index + 1u : 0u;
+    for (std::size_t i = 0u; i < m_workers.size(); i++)
+    {
+        const std::size_t victim_index = (first + i) % m_workers.size();
+        if (victim_index == worker_index)
+        {
+            continue;
+        }
+
+        Worker& victim = *m_workers[victim_index];
+
+        std::unique_lock<std::mutex> lock(victim.mutex);
+
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+
+            m_pending.fetch_sub(1u);
+
+            stolen = true;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::work(std::size_t worker_index)
+{
+    t_thread_pool = this;
+    t_worker_index = worker_index;
+
+    while (true)
+    {
+        std::function<void()> task{};
+        bool stolen{ false };
+
+        if (popTask(worker_index, task, stolen))
+        {
+            t_task_start_ns = getTimeNs();
+            t_task_stolen = stolen;
+
+            task();
+
+            finishTask();
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_condition.wait(lock, [this]() { return m_stop || m_pending.load() > 0u; });
+
+        if (m_stop && m_pending.load() == 0u)
+        {
+            return;
+        }
+    }
+}
+
+void ThreadPool::runNested(std::function<void()>& task, bool stolen)
+{
+    const std::int64_t task_start_ns = t_task_start_ns;
+    t_task_start_ns = -1;
+
+    task();
+
+    t_task_start_ns = task_start_ns;
+
+    // Its busy time is already part of the enclosing task.
+    if (t_thread_pool == this && t_worker_index != NO_WORKER)
+    {
+        Worker& worker = *m_workers[t_worker_index];
+
+        worker.executed_tasks.fetch_add(1u, std::memory_order_relaxed);
+        if (stolen)
+        {
+            worker.stolen_tasks.fetch_add(1u, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ThreadPool::finishTask()
+{
+    if (t_thread_pool != this || t_task_start_ns < 0)
+    {
+        return;
+    }
+
+    Worker& worker = *m_workers[t_worker_index];
+
+    worker.busy_ns.fetch_add((std::uint64_t)(getTimeNs() - t_task_start_ns), std::memory_order_relaxed);
+    worker.executed_tasks.fetch_add(1u, std::memory_order_relaxed);
+    if (t_task_stolen)
+    {
+        worker.stolen_tasks.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    t_task_start_ns = -1;
+}
+
+ThreadPool::ThreadPool(std::size_t number_threads)
+{
+    if (number_threads == 0u)
+    {
+        number_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_statistics_start_ns = getTimeNs();
+
+    m_workers.reserve(number_threads);
+    for (std::size_t i = 0u; i < number_threads; i++)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    m_threads.reserve(number_threads);
+    for (std::size_t i = 0u; i < number_threads; i++)
+    {
+        m_threads.emplace_back([this, i]() { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_stop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+std::size_t ThreadPool::getNumberThreads() const
+{
+    return m_threads.size();
+}
+
+void ThreadPool::setDeterministic(bool deterministic)
+{
+    m_deterministic = deterministic;
+}
+
+bool ThreadPool::isDeterministic() const
+{
+    return m_deterministic.load();
+}
+
+void ThreadPool::post(std::function<void()> task)
+{
+    if (m_deterministic.load())
+    {
+        runNested(task, false);
+
+        return;
+    }
+
+    enqueue(std::move(task));
+}
+
+bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task{};
+    bool stolen{ false };
+
+    if (!popTask(t_thread_pool == this ? t_worker_index : NO_WORKER, task, stolen))
+    {
+        return false;
+    }
+
+    runNested(task, stolen);
+
+    return true;
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain_size, const std::function<void(std::size_t begin, std::size_t end)>& function)
+{
+    if (count == 0u)
+    {
+        return;
+    }
+
+    grain_size = std::max<std::size_t>(1u, grain_size);
+
+    std::size_t number_chunks = (count + grain_size - 1u) / grain_size;
+    if (number_chunks == 1u)
+    {
+        function(0u, count);
+
+        return;
+    }
+
+    if (m_deterministic.load())
+    {
+        for (std::size_t begin = 0u; begin < count; begin += grain_size)
+        {
+            function(begin, std::min(begin + grain_size, count));
+        }
+
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<std::size_t> next_chunk{ 0u };
+        std::atomic<std::size_t> finished_chunks{ 0u };
+        std::atomic<bool> failed{ false };
+        std::mutex mutex{};
+        std::condition_variable condition{};
+        std::exception_ptr exception{};
+    };
+
+    auto state = std::make_shared<State>();
+
+    // Helpers only ever claim chunks, so a helper that starts late finds nothing left and returns immediately.
+    auto run = [state, count, grain_size, number_chunks, &function]() {
+        while (true)
+        {
+            std::size_t chunk = state->next_chunk.fetch_add(1u);
+            if (chunk >= number_chunks)
+            {
+                return;
+            }
+
+            std::size_t begin = chunk * grain_size;
+            std::size_t end = std::min(begin + grain_size, count);
+
+            // After a failure, the remaining chunks are only counted.
+            if (!state->failed.load())
+            {
+                try
+                {
+                    function(begin, end);
+                }
+                catch (...)
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+
+                    if (!state->exception)
+                    {
+                        state->exception = std::current_exception();
+                        state->failed = true;
+                    }
+                }
+            }
+
+            if (state->finished_chunks.fetch_add(1u) + 1u == number_chunks)
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+
+                state->condition.notify_all();
+            }
+        }
+    };
+
+    // On a worker the helpers go into its own queue, from where idle workers steal them.
+    std::size_t number_helpers = std::min(m_threads.size(), number_chunks - 1u);
+    for (std::size_t i = 0u; i < number_helpers; i++)
+    {
+        enqueue(run);
+    }
+
+    run();
+
+    // All chunks are claimed at this point, the remaining ones are running on other threads.
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&state, number_chunks]() { return state->finished_chunks.load() == number_chunks; });
+
+    // Rethrown only now, as the helpers no longer use the function.
+    if (state->exception)
+    {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+std::vector<ThreadPoolWorkerStatistics> ThreadPool::getWorkerStatistics() const
+{
+    const double elapsed_ms = (double)(getTimeNs() - m_statistics_start_ns.load()) / 1000000.0;
+
+    std::vector<ThreadPoolWorkerStatistics> result(m_workers.size());
+    for (std::size_t i = 0u; i < m_workers.size(); i++)
+    {
+        const Worker& worker = *m_workers[i];
+
+        result[i].executed_tasks = worker.executed_tasks.load(std::memory_order_relaxed);
+        result[i].stolen_tasks = worker.stolen_tasks.load(std::memory_order_relaxed);
+        result[i].busy_ms = (double)worker.busy_ns.load(std::memory_order_relaxed) / 1000000.0;
+        result[i].utilisation = elapsed_ms > 0.0 ? std::min(1.0, result[i].busy_ms / elapsed_ms) : 0.0;
+    }
+
+    return result;
+}
+
+void ThreadPool::resetWorkerStatistics()
+{
+    for (const std::unique_ptr<Worker>& worker : m_workers)
+    {
+        worker->executed_tasks = 0u;
+        worker->stolen_tasks = 0u;
+        worker->busy_ns = 0u;
+    }
+
+    m_statistics_start_ns = getTimeNs();
+}
+
+ThreadPool& getThreadPool()
+{
+    static ThreadPool thread_pool{};
+
+    return thread_pool;
+}
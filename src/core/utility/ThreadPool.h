@@ -0,0 +1,194 @@
+#ifndef CORE_UTILITY_THREADPOOL_H_
+#define CORE_UTILITY_THREADPOOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct ThreadPoolWorkerStatistics
+{
+    std::uint64_t executed_tasks{ 0u };
+
+    // Taken from the queue of another worker.
+    std::uint64_t stolen_tasks{ 0u };
+
+    double busy_ms{ 0.0 };
+
+    // Busy time relative to the time since construction or the last reset.
+    double utilisation{ 0.0 };
+};
+
+// Work stealing pool. Every worker has its own queue, runs its newest task first and steals the oldest ones of others.
+// Threads outside the pool submit to a shared queue.
+class ThreadPool
+{
+
+private:
+
+    struct Worker
+    {
+        std::mutex mutex{};
+        std::deque<std::function<void()>> tasks{};
+
+        std::atomic<std::uint64_t> executed_tasks{ 0u };
+        std::atomic<std::uint64_t> stolen_tasks{ 0u };
+        std::atomic<std::uint64_t> busy_ns{ 0u };
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers{};
+    std::vector<std::thread> m_threads{};
+
+    std::deque<std::function<void()>> m_tasks{};
+    std::mutex m_tasks_mutex{};
+
+    // Queued, not yet started tasks over all queues. Idle workers sleep while it is zero.
+    std::atomic<std::size_t> m_pending{ 0u };
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+
+    bool m_stop{ false };
+
+    std::atomic<bool> m_deterministic{ false };
+
+    std::atomic<std::int64_t> m_statistics_start_ns{ 0 };
+
+    void enqueue(std::function<void()> task);
+
+    bool popTask(std::size_t worker_index, std::function<void()>& task, bool& stolen);
+
+    void work(std::size_t worker_index);
+
+    // Runs a task outside of work(), e.g. inline or while waiting, so it does not count as the end of the current one.
+    // On a worker, the task itself is counted as executed.
+    void runNested(std::function<void()>& task, bool stolen);
+
+    // Counts the task the calling worker is running. Only the first call per task has an effect.
+    void finishTask();
+
+public:
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+
+    ThreadPool operator=(const ThreadPool&) = delete;
+    ThreadPool operator=(ThreadPool&&) = delete;
+
+    // 0 selects one thread per hardware thread.
+    explicit ThreadPool(std::size_t number_threads = 0u);
+
+    ~ThreadPool();
+
+    std::size_t getNumberThreads() const;
+
+    // Runs all new work on the calling thread in submission order, e.g. to reproduce a failure in a test.
+    // Chunk boundaries of parallelFor() and parallelReduce() stay the same, so results do not change.
+    void setDeterministic(bool deterministic);
+
+    bool isDeterministic() const;
+
+    // Fire and forget.
+    void post(std::function<void()> task);
+
+    template<class F>
+    std::future<std::invoke_result_t<F>> submit(F&& function)
+    {
+        using R = std::invoke_result_t<F>;
+
+        // The statistics are counted before the packaged task makes the future ready, so they are complete
+        // once it is.
+        struct Finish
+        {
+            ThreadPool* thread_pool;
+
+            ~Finish()
+            {
+                thread_pool->finishTask();
+            }
+        };
+
+        // std::function requires a copyable target, so the packaged task is shared.
+        auto task = std::make_shared<std::packaged_task<R()>>([this, function = std::forward<F>(function)]() mutable -> R {
+            Finish finish{ this };
+
+            return function();
+        });
+        std::future<R> future = task->get_future();
+
+        post([task]() { (*task)(); });
+
+        return future;
+    }
+
+    // Runs one queued task on the calling thread, false if there was none.
+    bool runPendingTask();
+
+    // Helps with queued tasks until the future is ready. Unlike future.wait(), this cannot deadlock on a worker thread.
+    template<class R>
+    void wait(const std::future<R>& future)
+    {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            if (!runPendingTask())
+            {
+                future.wait_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    // Splits [0, count) into chunks of grain_size and runs them on the pool.
+    // The calling thread processes chunks as well, so nested calls from worker threads cannot deadlock.
+    // If a chunk throws, the remaining chunks are skipped and the first exception is rethrown once all helpers are done.
+    void parallelFor(std::size_t count, std::size_t grain_size, const std::function<void(std::size_t begin, std::size_t end)>& function);
+
+    // map returns the value of one chunk, reduce combines two values.
+    // Chunks are combined in order, so e.g. floating point sums do not depend on the number of threads.
+    template<class T, class Map, class Reduce>
+    T parallelReduce(std::size_t count, std::size_t grain_size, T identity, Map&& map, Reduce&& reduce)
+    {
+        if (count == 0u)
+        {
+            return identity;
+        }
+
+        grain_size = std::max<std::size_t>(1u, grain_size);
+
+        const std::size_t number_chunks = (count + grain_size - 1u) / grain_size;
+
+        std::vector<T> partials(number_chunks, identity);
+        parallelFor(number_chunks, 1u, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t chunk = begin; chunk < end; chunk++)
+            {
+                partials[chunk] = map(chunk * grain_size, std::min((chunk + 1u) * grain_size, count));
+            }
+        });
+
+        T result = std::move(identity);
+        for (T& partial : partials)
+        {
+            result = reduce(std::move(result), std::move(partial));
+        }
+
+        return result;
+    }
+
+    std::vector<ThreadPoolWorkerStatistics> getWorkerStatistics() const;
+
+    void resetWorkerStatistics();
+};
+
+// Process wide pool shared by the SDK.
+ThreadPool& getThreadPool();
+
+#endif /* CORE_UTILITY_THREADPOOL_H_ */
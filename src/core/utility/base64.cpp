@@ -1,6 +1,13 @@
-
 #include "base64.h"
 
+#include <array>
+
+#include "core/utility/simd.h"
+
+#if defined(PLAYGROUND_SSE2)
+#include <immintrin.h>
+#endif
+
 namespace
 {
 constexpr char ENCODING_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -32,19 +39,21 @@ constexpr std::uint8_t getDecodingValue(char c)
     }
     return INVALID_VALUE;
 }
-} // namespace
 
-std::string base64Encode(const std::uint8_t* data, std::size_t length)
-{
-    if (data == nullptr || length == 0)
+constexpr std::array<std::uint8_t, 256> DECODING_TABLE = []() {
+    std::array<std::uint8_t, 256> table{};
+    for (std::size_t i = 0; i < table.size(); i++)
     {
-        return {};
+        table[i] = getDecodingValue(static_cast<char>(i));
     }
+    return table;
+}();
 
-    std::size_t encoded_length = ((length + 2) / 3) * 4;
-    std::string result{};
-    result.reserve(encoded_length);
+// Scalar
 
+// Full triples only, returns the number of bytes consumed.
+std::size_t encodeScalar(const std::uint8_t* data, std::size_t length, char* destination)
+{
     std::size_t i{ 0 };
     for (; i + 2 < length; i += 3)
     {
@@ -52,58 +61,266 @@ std::string base64Encode(const std::uint8_t* data, std::size_t length)
                                (static_cast<std::uint32_t>(data[i + 1]) << 8) |
                                static_cast<std::uint32_t>(data[i + 2]);
 
-        result += ENCODING_TABLE[(triple >> 18) & 0x3F];
-        result += ENCODING_TABLE[(triple >> 12) & 0x3F];
-        result += ENCODING_TABLE[(triple >> 6) & 0x3F];
-        result += ENCODING_TABLE[triple & 0x3F];
+        *destination++ = ENCODING_TABLE[(triple >> 18) & 0x3F];
+        *destination++ = ENCODING_TABLE[(triple >> 12) & 0x3F];
+        *destination++ = ENCODING_TABLE[(triple >> 6) & 0x3F];
+        *destination++ = ENCODING_TABLE[triple & 0x3F];
     }
 
-    if (i < length)
+    return i;
+}
+
+// Full quads without padding. Returns the number of characters consumed, which stops at the first quad with an invalid character.
+std::size_t decodeScalar(const char* encoded, std::size_t length, std::uint8_t* destination)
+{
+    std::size_t i{ 0 };
+    for (; i + 3 < length; i += 4)
     {
-        std::uint32_t triple = static_cast<std::uint32_t>(data[i]) << 16;
-        if (i + 1 < length)
+        std::uint32_t a = DECODING_TABLE[static_cast<std::uint8_t>(encoded[i])];
+        std::uint32_t b = DECODING_TABLE[static_cast<std::uint8_t>(encoded[i + 1])];
+        std::uint32_t c = DECODING_TABLE[static_cast<std::uint8_t>(encoded[i + 2])];
+        std::uint32_t d = DECODING_TABLE[static_cast<std::uint8_t>(encoded[i + 3])];
+
+        if (((a | b | c | d) & 0xC0) != 0)
         {
-            triple |= static_cast<std::uint32_t>(data[i + 1]) << 8;
+            break;
         }
 
-        result += ENCODING_TABLE[(triple >> 18) & 0x3F];
-        result += ENCODING_TABLE[(triple >> 12) & 0x3F];
+        std::uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
 
-        if (i + 1 < length)
+        *destination++ = static_cast<std::uint8_t>((triple >> 16) & 0xFF);
+        *destination++ = static_cast<std::uint8_t>((triple >> 8) & 0xFF);
+        *destination++ = static_cast<std::uint8_t>(triple & 0xFF);
+    }
+
+    return i;
+}
+
+#if defined(PLAYGROUND_SSE2)
+
+// Vectorised kernels following the pshufb based approach of Muła and Lemire.
+// Encoding expands 12 bytes per 128 bit lane into 16 characters, decoding packs 16 characters per lane into 12 bytes.
+
+PLAYGROUND_TARGET("ssse3")
+__m128i encodeLane(__m128i input)
+{
+    // Every 32 bit element receives one source triple in the order the bit shuffle below expects.
+    input = _mm_shuffle_epi8(input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+    // Split each triple into four 6 bit indices, one per byte
+    const __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003F03F0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map the index ranges to offsets into ASCII
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+}
+
+PLAYGROUND_TARGET("ssse3")
+std::size_t encodeSsse3(const std::uint8_t* data, std::size_t length, char* destination)
+{
+    std::size_t i{ 0 };
+
+    // Reads 16 bytes and consumes 12
+    for (; i + 16 <= length; i += 12)
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), encodeLane(input));
+        destination += 16;
+    }
+
+    return i;
+}
+
+PLAYGROUND_TARGET("avx2")
+std::size_t encodeAvx2(const std::uint8_t* data, std::size_t length, char* destination)
+{
+    std::size_t i{ 0 };
+
+    // Reads 28 bytes and consumes 24
+    for (; i + 28 <= length; i += 24)
+    {
+        __m256i input = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        input = _mm256_inserti128_si256(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12)), 1);
+
+        input = _mm256_shuffle_epi8(input, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+        const __m256i t0 = _mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        reduced = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+
+        const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                                 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+        const __m256i output = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, reduced), indices);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), output);
+        destination += 32;
+    }
+
+    return i;
+}
+
+// Classifies characters by their nibbles. A character is valid if the lookups of its low and high nibble share no bit.
+// roll is the offset turning a valid character into its 6 bit value.
+
+PLAYGROUND_TARGET("ssse3")
+bool decodeLane(__m128i input, __m128i& values)
+{
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2F);
+
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), mask_2f);
+    const __m128i lo_nibbles = _mm_and_si128(input, mask_2f);
+
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF)
+    {
+        return false;
+    }
+
+    const __m128i eq_2f = _mm_cmpeq_epi8(input, mask_2f);
+    const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+
+    values = _mm_add_epi8(input, roll);
+
+    return true;
+}
+
+PLAYGROUND_TARGET("ssse3")
+__m128i packLane(__m128i values)
+{
+    // Four 6 bit values to one 24 bit triple per 32 bit element, then drop the fourth byte
+    const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+
+    return _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+PLAYGROUND_TARGET("ssse3")
+std::size_t decodeSsse3(const char* encoded, std::size_t length, std::uint8_t* destination, std::size_t destination_size)
+{
+    std::size_t i{ 0 };
+    std::size_t written{ 0 };
+
+    // Stores 16 bytes and advances by 12
+    for (; i + 16 <= length && written + 16 <= destination_size; i += 16)
+    {
+        __m128i values{};
+        if (!decodeLane(_mm_loadu_si128(reinterpret_cast<const __m128i*>(encoded + i)), values))
         {
-            result += ENCODING_TABLE[(triple >> 6) & 0x3F];
+            break;
         }
-        else
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + written), packLane(values));
+        written += 12;
+    }
+
+    return i;
+}
+
+PLAYGROUND_TARGET("avx2")
+std::size_t decodeAvx2(const char* encoded, std::size_t length, std::uint8_t* destination, std::size_t destination_size)
+{
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+
+    std::size_t i{ 0 };
+    std::size_t written{ 0 };
+
+    // Stores 32 bytes and advances by 24
+    for (; i + 32 <= length && written + 32 <= destination_size; i += 32)
+    {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(encoded + i));
+
+        const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), mask_2f);
+        const __m256i lo_nibbles = _mm256_and_si256(input, mask_2f);
+
+        const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+
+        if (!_mm256_testz_si256(lo, hi))
         {
-            result += PADDING_CHAR;
+            break;
         }
 
-        result += PADDING_CHAR;
+        const __m256i eq_2f = _mm256_cmpeq_epi8(input, mask_2f);
+        const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+        const __m256i values = _mm256_add_epi8(input, roll);
+
+        const __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+
+        packed = _mm256_shuffle_epi8(packed, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        // Close the gap between the lanes, so the 24 bytes are contiguous
+        packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + written), packed);
+        written += 24;
     }
 
-    return result;
+    return i;
 }
 
-std::string base64Encode(const std::vector<std::uint8_t>& data)
+bool hasAvx2()
 {
-    return base64Encode(data.data(), data.size());
+    static const bool has_avx2 = simdHasAvx2();
+
+    return has_avx2;
 }
 
-std::vector<std::uint8_t> base64Decode(const std::string& encoded)
+bool hasSsse3()
 {
-    if (encoded.empty())
-    {
-        return {};
-    }
+    static const bool has_ssse3 = simdHasSsse3();
 
+    return has_ssse3;
+}
+
+#endif
+
+} // namespace
+
+std::size_t base64EncodedSize(std::size_t length)
+{
+    return ((length + 2) / 3) * 4;
+}
+
+std::size_t base64DecodedSize(std::string_view encoded)
+{
     std::size_t length = encoded.length();
     if (length % 4 != 0)
     {
-        return {};
+        return 0;
     }
 
     std::size_t padding{ 0 };
-    if (encoded[length - 1] == PADDING_CHAR)
+    if (length > 0 && encoded[length - 1] == PADDING_CHAR)
     {
         padding++;
         if (encoded[length - 2] == PADDING_CHAR)
@@ -112,41 +329,192 @@ std::vector<std::uint8_t> base64Decode(const std::string& encoded)
         }
     }
 
-    std::size_t decoded_length = (length / 4) * 3 - padding;
-    std::vector<std::uint8_t> result{};
-    result.reserve(decoded_length);
+    return (length / 4) * 3 - padding;
+}
 
-    for (std::size_t i = 0; i < length; i += 4)
+bool base64EncodeInto(std::span<const std::uint8_t> data, std::span<char> destination)
+{
+    if (destination.size() < base64EncodedSize(data.size()))
     {
-        std::uint8_t a = getDecodingValue(encoded[i]);
-        std::uint8_t b = getDecodingValue(encoded[i + 1]);
-        std::uint8_t c = (i + 2 < length && encoded[i + 2] != PADDING_CHAR) ? getDecodingValue(encoded[i + 2]) : 0;
-        std::uint8_t d = (i + 3 < length && encoded[i + 3] != PADDING_CHAR) ? getDecodingValue(encoded[i + 3]) : 0;
+        return false;
+    }
+
+    const std::uint8_t* input = data.data();
+    const std::size_t length = data.size();
+    char* output = destination.data();
+
+    std::size_t i{ 0 };
+
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2())
+    {
+        i = encodeAvx2(input, length, output);
+    }
+    if (hasSsse3())
+    {
+        i += encodeSsse3(input + i, length - i, output + (i / 3) * 4);
+    }
+#endif
+
+    i += encodeScalar(input + i, length - i, output + (i / 3) * 4);
+    output += (i / 3) * 4;
+
+    if (i < length)
+    {
+        std::uint32_t triple = static_cast<std::uint32_t>(input[i]) << 16;
+        if (i + 1 < length)
+        {
+            triple |= static_cast<std::uint32_t>(input[i + 1]) << 8;
+        }
 
-        if (a == INVALID_VALUE || b == INVALID_VALUE ||
-            (encoded[i + 2] != PADDING_CHAR && c == INVALID_VALUE) ||
-            (encoded[i + 3] != PADDING_CHAR && d == INVALID_VALUE))
+        *output++ = ENCODING_TABLE[(triple >> 18) & 0x3F];
+        *output++ = ENCODING_TABLE[(triple >> 12) & 0x3F];
+
+        if (i + 1 < length)
+        {
+            *output++ = ENCODING_TABLE[(triple >> 6) & 0x3F];
+        }
+        else
         {
-            return {};
+            *output++ = PADDING_CHAR;
         }
 
-        std::uint32_t triple = (static_cast<std::uint32_t>(a) << 18) |
-                               (static_cast<std::uint32_t>(b) << 12) |
-                               (static_cast<std::uint32_t>(c) << 6) |
-                               static_cast<std::uint32_t>(d);
+        *output++ = PADDING_CHAR;
+    }
+
+    return true;
+}
 
-        result.push_back(static_cast<std::uint8_t>((triple >> 16) & 0xFF));
+std::string base64Encode(std::span<const std::uint8_t> data)
+{
+    if (data.empty())
+    {
+        return {};
+    }
+
+    std::string result(base64EncodedSize(data.size()), '\0');
+    base64EncodeInto(data, result);
+
+    return result;
+}
+
+std::string base64Encode(const std::uint8_t* data, std::size_t length)
+{
+    if (data == nullptr || length == 0)
+    {
+        return {};
+    }
 
-        if (i + 2 < length && encoded[i + 2] != PADDING_CHAR)
+    return base64Encode(std::span<const std::uint8_t>(data, length));
+}
+
+std::string base64Encode(const std::vector<std::uint8_t>& data)
+{
+    return base64Encode(std::span<const std::uint8_t>(data));
+}
+
+Base64DecodeResult base64DecodeInto(std::string_view encoded, std::span<std::uint8_t> destination)
+{
+    Base64DecodeResult result{};
+
+    const std::size_t length = encoded.length();
+    if (length % 4 != 0)
+    {
+        result.error = Base64Error::INVALID_LENGTH;
+        result.position = length;
+        return result;
+    }
+
+    const std::size_t decoded_length = base64DecodedSize(encoded);
+    if (destination.size() < decoded_length)
+    {
+        result.error = Base64Error::BUFFER_TOO_SMALL;
+        return result;
+    }
+
+    // The last quad is decoded separately if it carries padding.
+    const std::size_t padded = length > 0 && encoded[length - 1] == PADDING_CHAR ? 4 : 0;
+    const std::size_t body_length = length - padded;
+
+    const char* input = encoded.data();
+    std::uint8_t* output = destination.data();
+
+    std::size_t i{ 0 };
+
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2())
+    {
+        i = decodeAvx2(input, body_length, output, destination.size());
+    }
+    if (hasSsse3())
+    {
+        i += decodeSsse3(input + i, body_length - i, output + (i / 4) * 3, destination.size() - (i / 4) * 3);
+    }
+#endif
+
+    // Also finds the exact position after a vector kernel stopped at an invalid block.
+    i += decodeScalar(input + i, body_length - i, output + (i / 4) * 3);
+
+    if (i < body_length)
+    {
+        for (std::size_t k = i; k < i + 4; k++)
+        {
+            if (DECODING_TABLE[static_cast<std::uint8_t>(input[k])] == INVALID_VALUE)
+            {
+                result.error = Base64Error::INVALID_CHARACTER;
+                result.position = k;
+                result.written = (i / 4) * 3;
+                return result;
+            }
+        }
+    }
+
+    result.written = (i / 4) * 3;
+
+    if (padded > 0)
+    {
+        const char* quad = input + body_length;
+
+        std::uint32_t a = DECODING_TABLE[static_cast<std::uint8_t>(quad[0])];
+        std::uint32_t b = DECODING_TABLE[static_cast<std::uint8_t>(quad[1])];
+        std::uint32_t c = quad[2] == PADDING_CHAR ? 0 : DECODING_TABLE[static_cast<std::uint8_t>(quad[2])];
+
+        for (std::size_t k = 0; k < 3; k++)
         {
-            result.push_back(static_cast<std::uint8_t>((triple >> 8) & 0xFF));
+            const std::uint32_t value = k == 0 ? a : (k == 1 ? b : c);
+            if (value == INVALID_VALUE)
+            {
+                result.error = Base64Error::INVALID_CHARACTER;
+                result.position = body_length + k;
+                return result;
+            }
         }
 
-        if (i + 3 < length && encoded[i + 3] != PADDING_CHAR)
+        std::uint32_t triple = (a << 18) | (b << 12) | (c << 6);
+
+        output[result.written++] = static_cast<std::uint8_t>((triple >> 16) & 0xFF);
+        if (quad[2] != PADDING_CHAR)
         {
-            result.push_back(static_cast<std::uint8_t>(triple & 0xFF));
+            output[result.written++] = static_cast<std::uint8_t>((triple >> 8) & 0xFF);
         }
     }
 
     return result;
 }
+
+std::vector<std::uint8_t> base64Decode(std::string_view encoded)
+{
+    if (encoded.empty())
+    {
+        return {};
+    }
+
+    std::vector<std::uint8_t> result(base64DecodedSize(encoded));
+
+    if (base64DecodeInto(encoded, result).error != Base64Error::NONE)
+    {
+        return {};
+    }
+
+    return result;
+}
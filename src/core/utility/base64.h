@@ -1,15 +1,50 @@
-
 #ifndef CORE_UTILITY_BASE64_H_
 #define CORE_UTILITY_BASE64_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
+// Standard alphabet with padding. Encoding and decoding use AVX2 or SSSE3 if the CPU supports it.
+
+enum class Base64Error
+{
+    NONE,
+    INVALID_LENGTH,     // Not a multiple of four characters
+    INVALID_CHARACTER,  // Outside the alphabet, including padding before the end
+    BUFFER_TOO_SMALL
+};
+
+struct Base64DecodeResult
+{
+    Base64Error error{ Base64Error::NONE };
+
+    // Offset of the offending character for INVALID_CHARACTER.
+    std::size_t position{ 0u };
+
+    std::size_t written{ 0u };
+};
+
+std::size_t base64EncodedSize(std::size_t length);
+
+// Exact size for valid input, including padding. 0 if the length is invalid.
+std::size_t base64DecodedSize(std::string_view encoded);
+
+// Writes base64EncodedSize() characters, false if the destination is too small.
+bool base64EncodeInto(std::span<const std::uint8_t> data, std::span<char> destination);
+
+std::string base64Encode(std::span<const std::uint8_t> data);
+
 std::string base64Encode(const std::uint8_t* data, std::size_t length);
 
 std::string base64Encode(const std::vector<std::uint8_t>& data);
 
-std::vector<std::uint8_t> base64Decode(const std::string& encoded);
+Base64DecodeResult base64DecodeInto(std::string_view encoded, std::span<std::uint8_t> destination);
+
+// Empty on any error, use base64DecodeInto() for details.
+std::vector<std::uint8_t> base64Decode(std::string_view encoded);
 
 #endif /* CORE_UTILITY_BASE64_H_ */
@@ -1,44 +1,357 @@
 #include "convert.h"
 
-std::vector<uint8_t> interleaveData(const std::vector<RawData>& raw_data, std::size_t& stride)
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "core/utility/ThreadPool.h"
+
+namespace
 {
-    std::vector<uint8_t> result{};
 
-    std::size_t total_length{ 0u };
-    std::size_t elements{ 0u };
+// Enough work per task to hide the scheduling overhead, small meshes run on the calling thread.
+constexpr std::size_t ELEMENTS_PER_TASK = 64u * 1024u;
+
+bool getElementCount(const std::vector<RawData>& raw_data, std::size_t& elements)
+{
+    if (raw_data.empty())
+    {
+        return false;
+    }
+
     for (std::size_t i = 0u; i < raw_data.size(); i++)
     {
-        if (i > 0u)
+        if (raw_data[i].data == nullptr || raw_data[i].stride == 0u)
         {
-            // All elements need to have the same amount of elements.
-            if ((raw_data[i].length / raw_data[i].stride) != elements)
+            return false;
+        }
+
+        // All attributes need to have the same amount of elements.
+        const std::size_t count = raw_data[i].length / raw_data[i].stride;
+        if (i > 0u && count != elements)
+        {
+            return false;
+        }
+
+        elements = count;
+    }
+
+    return true;
+}
+
+std::size_t getStride(const std::vector<RawData>& raw_data)
+{
+    std::size_t stride{ 0u };
+    for (const RawData& attribute : raw_data)
+    {
+        stride += attribute.stride;
+    }
+
+    return stride;
+}
+
+// Both directions share the kernels. Interleaving reads the attribute arrays, deinterleaving writes them.
+template<bool INTERLEAVE>
+using Attributes = std::conditional_t<INTERLEAVE, const uint8_t* const*, uint8_t* const*>;
+
+template<bool INTERLEAVE>
+using Interleaved = std::conditional_t<INTERLEAVE, uint8_t*, const uint8_t*>;
+
+template<bool INTERLEAVE>
+using CopyKernel = void (*)(Attributes<INTERLEAVE> attributes, Interleaved<INTERLEAVE> interleaved, const std::vector<std::size_t>& strides, std::size_t begin, std::size_t end);
+
+template<std::size_t... SIZES>
+constexpr std::array<std::size_t, sizeof...(SIZES)> getOffsets()
+{
+    std::array<std::size_t, sizeof...(SIZES)> result{};
+
+    std::size_t offset{ 0u };
+    std::size_t i{ 0u };
+    ((result[i++] = offset, offset += SIZES), ...);
+
+    return result;
+}
+
+// All sizes known at compile time, so every copy becomes a few moves.
+template<bool INTERLEAVE, std::size_t... SIZES>
+void copyFixed(Attributes<INTERLEAVE> attributes, Interleaved<INTERLEAVE> interleaved, const std::vector<std::size_t>&, std::size_t begin, std::size_t end)
+{
+    constexpr std::size_t count = sizeof...(SIZES);
+    constexpr std::array<std::size_t, count> sizes{ SIZES... };
+    constexpr std::size_t stride = (SIZES + ...);
+    constexpr std::array<std::size_t, count> offsets = getOffsets<SIZES...>();
+
+    for (std::size_t i = begin; i < end; i++)
+    {
+        auto element = interleaved + i * stride;
+
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            if constexpr (INTERLEAVE)
             {
-                stride = 0u;
+                (std::memcpy(element + offsets[I], attributes[I] + i * sizes[I], sizes[I]), ...);
+            }
+            else
+            {
+                (std::memcpy(attributes[I] + i * sizes[I], element + offsets[I], sizes[I]), ...);
+            }
+        }(std::make_index_sequence<count>{});
+    }
+}
+
+// Any layout. Works attribute by attribute over blocks which stay in cache.
+template<bool INTERLEAVE>
+void copyGeneric(Attributes<INTERLEAVE> attributes, Interleaved<INTERLEAVE> interleaved, const std::vector<std::size_t>& strides, std::size_t begin, std::size_t end)
+{
+    constexpr std::size_t block_size = 1024u;
+
+    std::size_t stride{ 0u };
+    for (std::size_t size : strides)
+    {
+        stride += size;
+    }
 
-                return result;
+    for (std::size_t block_begin = begin; block_begin < end; block_begin += block_size)
+    {
+        const std::size_t block_end = std::min(block_begin + block_size, end);
+
+        std::size_t offset{ 0u };
+        for (std::size_t j = 0u; j < strides.size(); j++)
+        {
+            const std::size_t size = strides[j];
+
+            for (std::size_t i = block_begin; i < block_end; i++)
+            {
+                if constexpr (INTERLEAVE)
+                {
+                    std::memcpy(interleaved + i * stride + offset, attributes[j] + i * size, size);
+                }
+                else
+                {
+                    std::memcpy(attributes[j] + i * size, interleaved + i * stride + offset, size);
+                }
             }
+
+            offset += size;
         }
-        else
+    }
+}
+
+template<bool INTERLEAVE>
+CopyKernel<INTERLEAVE> selectKernel(const std::vector<std::size_t>& strides)
+{
+    using Strides = std::vector<std::size_t>;
+
+    // MeshData layouts: position, normal and tangent are float3, uv is float2.
+    if (strides == Strides{ 12u, 12u, 12u, 8u })
+    {
+        return copyFixed<INTERLEAVE, 12u, 12u, 12u, 8u>;
+    }
+    if (strides == Strides{ 12u, 12u, 8u })
+    {
+        return copyFixed<INTERLEAVE, 12u, 12u, 8u>;
+    }
+    if (strides == Strides{ 12u, 12u, 12u })
+    {
+        return copyFixed<INTERLEAVE, 12u, 12u, 12u>;
+    }
+    if (strides == Strides{ 12u, 12u })
+    {
+        return copyFixed<INTERLEAVE, 12u, 12u>;
+    }
+    if (strides == Strides{ 12u, 8u })
+    {
+        return copyFixed<INTERLEAVE, 12u, 8u>;
+    }
+    if (strides == Strides{ 16u, 16u, 16u, 8u })
+    {
+        return copyFixed<INTERLEAVE, 16u, 16u, 16u, 8u>;
+    }
+
+    return copyGeneric<INTERLEAVE>;
+}
+
+} // namespace
+
+float halfToFloat(uint16_t value)
+{
+    uint32_t sign = (uint32_t)(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x03FFu;
+
+    uint32_t bits{ 0u };
+    if (exponent == 0x1Fu)
+    {
+        // Infinity or NaN
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent != 0u)
+    {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    else if (mantissa != 0u)
+    {
+        // Subnormal half, normalized in single precision
+        exponent = 113u;
+        while ((mantissa & 0x0400u) == 0u)
         {
-            elements = raw_data[i].length / raw_data[i].stride;
+            mantissa <<= 1;
+            exponent--;
         }
+        bits = sign | (exponent << 23) | ((mantissa & 0x03FFu) << 13);
+    }
+    else
+    {
+        bits = sign;
+    }
 
-        total_length += raw_data[i].length;
-        stride += raw_data[i].stride;
+    float result{ 0.0f };
+    std::memcpy(&result, &bits, sizeof(result));
+
+    return result;
+}
+
+uint16_t floatToHalf(float value)
+{
+    uint32_t bits{ 0u };
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint16_t sign = (uint16_t)((bits >> 16) & 0x8000u);
+    uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x007FFFFFu;
+
+    if (exponent == 0xFFu)
+    {
+        // Infinity stays infinity, NaN stays a quiet NaN
+        return (uint16_t)(sign | 0x7C00u | (mantissa != 0u ? 0x0200u : 0u));
     }
 
-    result.resize(total_length);
+    int32_t half_exponent = (int32_t)exponent - 112;
+    if (half_exponent >= 0x1F)
+    {
+        return (uint16_t)(sign | 0x7C00u);
+    }
 
-    std::size_t offset{ 0u };
-    for (std::size_t i = 0u; i < elements; i++)
+    if (half_exponent <= 0)
     {
-        for (std::size_t j = 0u; j < raw_data.size(); j++)
+        if (half_exponent < -10)
         {
-            memcpy(result.data() + offset, raw_data[j].data + (raw_data[j].stride * i), raw_data[j].stride);
+            return sign;
+        }
 
-            offset += raw_data[j].stride;
+        // Subnormal half
+        mantissa |= 0x00800000u;
+        uint32_t shift = (uint32_t)(14 - half_exponent);
+        uint32_t half_mantissa = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half_mantissa & 1u) != 0u))
+        {
+            half_mantissa++;
         }
+
+        return (uint16_t)(sign | half_mantissa);
+    }
+
+    uint32_t half = ((uint32_t)half_exponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0u))
+    {
+        // A carry into the exponent is correct, it also rounds up to infinity
+        half++;
     }
 
+    return (uint16_t)(sign | half);
+}
+
+std::vector<uint8_t> interleaveData(const std::vector<RawData>& raw_data, std::size_t& stride)
+{
+    std::vector<uint8_t> result{};
+
+    std::size_t elements{ 0u };
+    if (!getElementCount(raw_data, elements))
+    {
+        stride = 0u;
+
+        return result;
+    }
+
+    stride = getStride(raw_data);
+
+    result.resize(elements * stride);
+    interleaveDataInto(raw_data, result.data(), result.size());
+
     return result;
 }
+
+bool interleaveDataInto(const std::vector<RawData>& raw_data, uint8_t* destination, std::size_t destination_size)
+{
+    std::size_t elements{ 0u };
+    if (!getElementCount(raw_data, elements))
+    {
+        return false;
+    }
+
+    const std::size_t stride = getStride(raw_data);
+    if (destination == nullptr || destination_size < elements * stride)
+    {
+        return false;
+    }
+
+    std::vector<std::size_t> strides(raw_data.size());
+    std::vector<const uint8_t*> sources(raw_data.size());
+    for (std::size_t i = 0u; i < raw_data.size(); i++)
+    {
+        strides[i] = raw_data[i].stride;
+        sources[i] = raw_data[i].data;
+    }
+
+    auto kernel = selectKernel<true>(strides);
+
+    getThreadPool().parallelFor(elements, ELEMENTS_PER_TASK, [&](std::size_t begin, std::size_t end) {
+        kernel(sources.data(), destination, strides, begin, end);
+    });
+
+    return true;
+}
+
+bool deinterleaveData(const uint8_t* source, std::size_t source_size, const std::vector<MutableRawData>& raw_data)
+{
+    if (source == nullptr || raw_data.empty())
+    {
+        return false;
+    }
+
+    std::vector<std::size_t> strides(raw_data.size());
+    std::vector<uint8_t*> destinations(raw_data.size());
+
+    std::size_t stride{ 0u };
+    for (std::size_t i = 0u; i < raw_data.size(); i++)
+    {
+        if (raw_data[i].data == nullptr || raw_data[i].stride == 0u)
+        {
+            return false;
+        }
+
+        strides[i] = raw_data[i].stride;
+        destinations[i] = raw_data[i].data;
+        stride += raw_data[i].stride;
+    }
+
+    const std::size_t elements = source_size / stride;
+    for (const MutableRawData& attribute : raw_data)
+    {
+        if (attribute.length < elements * attribute.stride)
+        {
+            return false;
+        }
+    }
+
+    auto kernel = selectKernel<false>(strides);
+
+    getThreadPool().parallelFor(elements, ELEMENTS_PER_TASK, [&](std::size_t begin, std::size_t end) {
+        kernel(destinations.data(), source, strides, begin, end);
+    });
+
+    return true;
+}
@@ -14,6 +14,13 @@ struct RawData
     std::size_t stride{ 0u };
 };
 
+struct MutableRawData
+{
+    uint8_t* data{ nullptr };
+    std::size_t length{ 0u };
+    std::size_t stride{ 0u };
+};
+
 template<class T>
 std::vector<T> stringToVector(const std::string& s)
 {
@@ -39,6 +46,21 @@ std::string vectorToString(const std::vector<T>& v)
     return output;
 }
 
+float halfToFloat(uint16_t value);
+
+// Rounds to nearest even, overflows to infinity.
+uint16_t floatToHalf(float value);
+
+// Interleaved elements are the attribute elements in order, tightly packed. The stride is the sum of the attribute strides.
+// Common vertex layouts, e.g. 12/12/12/8 bytes for position/normal/tangent/uv, use specialised kernels.
+// Large inputs are split across the thread pool.
+
 std::vector<uint8_t> interleaveData(const std::vector<RawData>& raw_data, std::size_t& stride);
 
+// Writes into a caller provided buffer, e.g. mapped memory. Fails if the element counts differ or the destination is too small.
+bool interleaveDataInto(const std::vector<RawData>& raw_data, uint8_t* destination, std::size_t destination_size);
+
+// Inverse of interleaveDataInto. The attributes describe the interleaved layout and receive the element arrays.
+bool deinterleaveData(const uint8_t* source, std::size_t source_size, const std::vector<MutableRawData>& raw_data);
+
 #endif /* CORE_UTILITY_CONVERT_H_ */
@@ -1,13 +1,200 @@
-
 #include "gzip.h"
 
+#include <algorithm>
+#include <limits>
+#include <optional>
+
 #include <zlib.h>
 
 namespace
 {
-constexpr std::size_t CHUNK_SIZE = 16384;
+// Output buffer of the streaming objects.
+constexpr std::size_t STREAM_BUFFER_SIZE = 64u * 1024u;
+
+// Deflate window, the most any block can reference of the preceding input.
+constexpr std::size_t WINDOW_SIZE = 32768u;
+
+// Slices inputs above the 32 bit avail_in limit of zlib.
+constexpr std::size_t MAX_STREAM_INPUT = std::numeric_limits<uInt>::max();
+
+void writeLittleEndian32(std::uint32_t value, std::uint8_t* destination)
+{
+    destination[0] = (std::uint8_t)(value & 0xFFu);
+    destination[1] = (std::uint8_t)((value >> 8u) & 0xFFu);
+    destination[2] = (std::uint8_t)((value >> 16u) & 0xFFu);
+    destination[3] = (std::uint8_t)((value >> 24u) & 0xFFu);
 }
 
+// Raw deflate of one block. All blocks except the last end on a byte boundary without the final bit.
+bool deflateBlock(const std::uint8_t* data, std::size_t length, const std::uint8_t* dictionary, std::size_t dictionary_length, int level, bool last, std::vector<std::uint8_t>& output)
+{
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return false;
+    }
+
+    if (dictionary_length > 0u && deflateSetDictionary(&stream, dictionary, (uInt)dictionary_length) != Z_OK)
+    {
+        deflateEnd(&stream);
+        return false;
+    }
+
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = (uInt)length;
+
+    // Room for the sync flush marker on top of the bound
+    output.resize(deflateBound(&stream, (uLong)length) + 16u);
+
+    const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    std::size_t written{ 0u };
+
+    while (true)
+    {
+        stream.next_out = output.data() + written;
+        stream.avail_out = (uInt)(output.size() - written);
+
+        int result = deflate(&stream, flush);
+        if (result == Z_STREAM_ERROR)
+        {
+            deflateEnd(&stream);
+            return false;
+        }
+
+        written = output.size() - stream.avail_out;
+
+        if ((last && result == Z_STREAM_END) || (!last && stream.avail_out != 0u))
+        {
+            break;
+        }
+
+        output.resize(output.size() * 2u);
+    }
+
+    deflateEnd(&stream);
+
+    output.resize(written);
+
+    return true;
+}
+
+enum class InflateStatus
+{
+    FINISHED,
+    DESTINATION_FULL,
+    INVALID
+};
+
+// Inflates all members straight into the destination. Z_FINISH lets zlib skip its sliding window whenever the output fits.
+InflateStatus inflateMembers(std::span<const std::uint8_t> source, std::span<std::uint8_t> destination, std::size_t& written)
+{
+    written = 0u;
+
+    if (source.empty())
+    {
+        return InflateStatus::INVALID;
+    }
+
+    z_stream stream{};
+
+    // zlib rejects a null output pointer, even for empty output.
+    std::uint8_t empty_output{ 0u };
+    stream.next_out = &empty_output;
+
+    // windowBits = 15 + 16 for gzip format, zlib verifies CRC and ISIZE of every member.
+    if (inflateInit2(&stream, 15 + 16) != Z_OK)
+    {
+        return InflateStatus::INVALID;
+    }
+
+    std::size_t input_offset{ 0u };
+    std::size_t output_offset{ 0u };
+    InflateStatus status{ InflateStatus::INVALID };
+
+    while (true)
+    {
+        // zlib counts in 32 bit, so larger buffers are passed in slices.
+        if (stream.avail_in == 0u && input_offset < source.size())
+        {
+            const std::size_t size = std::min(source.size() - input_offset, MAX_STREAM_INPUT);
+
+            stream.next_in = const_cast<Bytef*>(source.data() + input_offset);
+            stream.avail_in = (uInt)size;
+            input_offset += size;
+        }
+
+        if (stream.avail_out == 0u && output_offset < destination.size())
+        {
+            const std::size_t size = std::min(destination.size() - output_offset, MAX_STREAM_INPUT);
+
+            stream.next_out = destination.data() + output_offset;
+            stream.avail_out = (uInt)size;
+            output_offset += size;
+        }
+
+        const uInt available_output = stream.avail_out;
+
+        int result = inflate(&stream, Z_FINISH);
+
+        written += available_output - stream.avail_out;
+
+        if (result == Z_STREAM_END)
+        {
+            // Another member only follows if the remaining input starts with the gzip magic, anything else is ignored like in gzip.
+            const std::size_t next = input_offset - stream.avail_in;
+            if (source.size() - next < 2u || source[next] != 0x1Fu || source[next + 1u] != 0x8Bu)
+            {
+                status = InflateStatus::FINISHED;
+                break;
+            }
+
+            inflateReset(&stream);
+        }
+        else if (result == Z_BUF_ERROR || result == Z_OK)
+        {
+            if (stream.avail_out == 0u && output_offset == destination.size())
+            {
+                status = InflateStatus::DESTINATION_FULL;
+                break;
+            }
+
+            if (stream.avail_in == 0u && input_offset == source.size())
+            {
+                // Truncated input
+                break;
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    inflateEnd(&stream);
+
+    return status;
+}
+
+// Inputs too large for a single zlib call
+std::vector<std::uint8_t> gzipCompressStreaming(const std::uint8_t* data, std::size_t length, int level)
+{
+    std::vector<std::uint8_t> compressed{};
+
+    GzipCompressor compressor([&compressed](std::span<const std::uint8_t> output) {
+        compressed.insert(compressed.end(), output.begin(), output.end());
+        return true;
+    }, level);
+
+    if (!compressor.push({ data, length }) || !compressor.finish())
+    {
+        return {};
+    }
+
+    return compressed;
+}
+
+} // namespace
+
 std::vector<std::uint8_t> gzipCompress(const std::uint8_t* data, std::size_t length, int level)
 {
     if (data == nullptr || length == 0)
@@ -34,27 +221,21 @@ std::vector<std::uint8_t> gzipCompress(const std::uint8_t* data, std::size_t len
         return {};
     }
 
-    std::vector<std::uint8_t> compressed{};
-    compressed.reserve(length / 2);
-
-    std::uint8_t buffer[CHUNK_SIZE]{};
-
-    do
+    // The bound includes the gzip header and trailer, so a single call compresses everything.
+    const std::size_t bound = deflateBound(&stream, static_cast<uLong>(length));
+    if (length > MAX_STREAM_INPUT || bound > MAX_STREAM_INPUT)
     {
-        stream.next_out = buffer;
-        stream.avail_out = CHUNK_SIZE;
+        deflateEnd(&stream);
 
-        result = deflate(&stream, Z_FINISH);
-        if (result == Z_STREAM_ERROR)
-        {
-            deflateEnd(&stream);
-            return {};
-        }
+        return gzipCompressStreaming(data, length, level);
+    }
+
+    std::vector<std::uint8_t> compressed(bound);
 
-        std::size_t have = CHUNK_SIZE - stream.avail_out;
-        compressed.insert(compressed.end(), buffer, buffer + have);
+    stream.next_out = compressed.data();
+    stream.avail_out = static_cast<uInt>(bound);
 
-    } while (stream.avail_out == 0);
+    result = deflate(&stream, Z_FINISH);
 
     deflateEnd(&stream);
 
@@ -63,6 +244,8 @@ std::vector<std::uint8_t> gzipCompress(const std::uint8_t* data, std::size_t len
         return {};
     }
 
+    compressed.resize(stream.total_out);
+
     return compressed;
 }
 
@@ -78,54 +261,301 @@ std::vector<std::uint8_t> gzipDecompress(const std::uint8_t* data, std::size_t l
         return {};
     }
 
-    z_stream stream{};
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
-    stream.next_in = const_cast<Bytef*>(data);
-    stream.avail_in = static_cast<uInt>(length);
+    const std::span<const std::uint8_t> source{ data, length };
 
-    // windowBits = 15 + 16 for gzip format
-    int result = inflateInit2(&stream, 15 + 16);
-    if (result != Z_OK)
+    // Exact for single member streams below 4 GiB, which is the common case.
+    // Deflate expands at most about 1032 times, which bounds the allocation for a corrupt trailer.
+    std::vector<std::uint8_t> decompressed(std::min(gzipDecompressedSize(source).value_or(0u), length * 1032u));
+
+    std::size_t written{ 0u };
+    InflateStatus status = inflateMembers(source, decompressed, written);
+    if (status == InflateStatus::FINISHED)
+    {
+        decompressed.resize(written);
+
+        return decompressed;
+    }
+
+    if (status != InflateStatus::DESTINATION_FULL)
     {
         return {};
     }
 
-    std::vector<std::uint8_t> decompressed{};
-    decompressed.reserve(length * 2);
+    // The trailer did not describe the whole stream, e.g. several members, trailing data or 4 GiB and more.
+    while (status == InflateStatus::DESTINATION_FULL)
+    {
+        decompressed.resize(std::max<std::size_t>(decompressed.size() * 2u, STREAM_BUFFER_SIZE));
 
-    std::uint8_t buffer[CHUNK_SIZE]{};
+        status = inflateMembers(source, decompressed, written);
+    }
 
-    do
+    if (status != InflateStatus::FINISHED)
     {
-        stream.next_out = buffer;
-        stream.avail_out = CHUNK_SIZE;
+        return {};
+    }
 
-        result = inflate(&stream, Z_NO_FLUSH);
+    decompressed.resize(written);
+
+    return decompressed;
+}
 
-        if (result == Z_STREAM_ERROR || result == Z_DATA_ERROR || result == Z_MEM_ERROR)
+std::vector<std::uint8_t> gzipDecompress(const std::vector<std::uint8_t>& data)
+{
+    return gzipDecompress(data.data(), data.size());
+}
+
+std::optional<std::size_t> gzipDecompressedSize(std::span<const std::uint8_t> data)
+{
+    // Header and trailer of the smallest possible member
+    if (data.size() < 18u || data[0] != 0x1Fu || data[1] != 0x8Bu)
+    {
+        return {};
+    }
+
+    const std::uint8_t* trailer = data.data() + data.size() - 4u;
+
+    return (std::size_t)trailer[0] | ((std::size_t)trailer[1] << 8u) | ((std::size_t)trailer[2] << 16u) | ((std::size_t)trailer[3] << 24u);
+}
+
+std::optional<std::size_t> gzipDecompressInto(std::span<const std::uint8_t> data, std::span<std::uint8_t> destination)
+{
+    std::size_t written{ 0u };
+    if (inflateMembers(data, destination, written) != InflateStatus::FINISHED)
+    {
+        return {};
+    }
+
+    return written;
+}
+
+std::vector<std::uint8_t> gzipCompressParallel(const std::uint8_t* data, std::size_t length, int level, std::size_t block_size, ThreadPool& thread_pool)
+{
+    if (data == nullptr || length == 0)
+    {
+        return {};
+    }
+
+    if (level < -1 || level > 9)
+    {
+        level = Z_DEFAULT_COMPRESSION;
+    }
+
+    block_size = std::clamp<std::size_t>(block_size, WINDOW_SIZE, 1024u * 1024u * 1024u);
+
+    const std::size_t number_blocks = (length + block_size - 1u) / block_size;
+
+    std::vector<std::vector<std::uint8_t>> blocks(number_blocks);
+    std::vector<uLong> block_crcs(number_blocks);
+    std::vector<std::uint8_t> block_results(number_blocks, 0u);
+
+    thread_pool.parallelFor(number_blocks, 1u, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const std::size_t offset = i * block_size;
+            const std::size_t size = std::min(block_size, length - offset);
+            const std::size_t dictionary_length = std::min(offset, WINDOW_SIZE);
+
+            block_crcs[i] = crc32(0u, data + offset, (uInt)size);
+            block_results[i] = deflateBlock(data + offset, size, data + offset - dictionary_length, dictionary_length, level, i + 1u == number_blocks, blocks[i]) ? 1u : 0u;
+        }
+    });
+
+    std::size_t compressed_size{ 10u + 8u };
+    uLong crc = crc32(0u, Z_NULL, 0u);
+    for (std::size_t i = 0u; i < number_blocks; i++)
+    {
+        if (!block_results[i])
         {
-            inflateEnd(&stream);
             return {};
         }
 
-        std::size_t have = CHUNK_SIZE - stream.avail_out;
-        decompressed.insert(decompressed.end(), buffer, buffer + have);
+        compressed_size += blocks[i].size();
+        crc = crc32_combine(crc, block_crcs[i], (z_off_t)std::min(block_size, length - i * block_size));
+    }
 
-    } while (stream.avail_out == 0);
+    std::vector<std::uint8_t> compressed{};
+    compressed.reserve(compressed_size);
 
-    inflateEnd(&stream);
+    // Header without name and time stamp, operating system unknown
+    const std::uint8_t header[10]{ 0x1Fu, 0x8Bu, 0x08u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0xFFu };
+    compressed.insert(compressed.end(), header, header + 10u);
 
-    if (result != Z_STREAM_END && result != Z_OK)
+    for (const std::vector<std::uint8_t>& block : blocks)
     {
-        return {};
+        compressed.insert(compressed.end(), block.begin(), block.end());
     }
 
-    return decompressed;
+    std::uint8_t trailer[8]{};
+    writeLittleEndian32((std::uint32_t)crc, trailer);
+    writeLittleEndian32((std::uint32_t)(length & 0xFFFFFFFFu), trailer + 4u);
+    compressed.insert(compressed.end(), trailer, trailer + 8u);
+
+    return compressed;
 }
 
-std::vector<std::uint8_t> gzipDecompress(const std::vector<std::uint8_t>& data)
+// GzipCompressor
+
+bool GzipCompressor::process(std::span<const std::uint8_t> data, int flush)
 {
-    return gzipDecompress(data.data(), data.size());
+    std::size_t offset{ 0u };
+
+    do
+    {
+        const std::size_t size = std::min(data.size() - offset, MAX_STREAM_INPUT);
+
+        m_stream->next_in = const_cast<Bytef*>(data.data() + offset);
+        m_stream->avail_in = (uInt)size;
+        offset += size;
+
+        const int current_flush = offset < data.size() ? Z_NO_FLUSH : flush;
+
+        do
+        {
+            m_stream->next_out = m_buffer.data();
+            m_stream->avail_out = (uInt)m_buffer.size();
+
+            if (deflate(m_stream.get(), current_flush) == Z_STREAM_ERROR)
+            {
+                m_valid = false;
+                return false;
+            }
+
+            const std::size_t have = m_buffer.size() - m_stream->avail_out;
+            if (have > 0u && !m_sink({ m_buffer.data(), have }))
+            {
+                m_valid = false;
+                return false;
+            }
+        } while (m_stream->avail_out == 0u);
+    } while (offset < data.size());
+
+    return true;
+}
+
+GzipCompressor::GzipCompressor(GzipSink sink, int level) :
+    m_stream{ std::make_unique<z_stream>() }, m_sink{ std::move(sink) }
+{
+    if (level < -1 || level > 9)
+    {
+        level = Z_DEFAULT_COMPRESSION;
+    }
+
+    m_valid = deflateInit2(m_stream.get(), level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    m_buffer.resize(STREAM_BUFFER_SIZE);
+}
+
+GzipCompressor::~GzipCompressor()
+{
+    deflateEnd(m_stream.get());
+}
+
+bool GzipCompressor::isValid() const
+{
+    return m_valid && !m_finished;
+}
+
+bool GzipCompressor::push(std::span<const std::uint8_t> data)
+{
+    if (!isValid())
+    {
+        return false;
+    }
+
+    if (data.empty())
+    {
+        return true;
+    }
+
+    return process(data, Z_NO_FLUSH);
+}
+
+bool GzipCompressor::finish()
+{
+    if (!isValid())
+    {
+        return false;
+    }
+
+    m_finished = true;
+
+    return process({}, Z_FINISH);
+}
+
+// GzipDecompressor
+
+GzipDecompressor::GzipDecompressor(GzipSink sink) :
+    m_stream{ std::make_unique<z_stream>() }, m_sink{ std::move(sink) }
+{
+    // windowBits = 15 + 16 for gzip format
+    m_valid = inflateInit2(m_stream.get(), 15 + 16) == Z_OK;
+    m_buffer.resize(STREAM_BUFFER_SIZE);
+}
+
+GzipDecompressor::~GzipDecompressor()
+{
+    inflateEnd(m_stream.get());
+}
+
+bool GzipDecompressor::isValid() const
+{
+    return m_valid;
+}
+
+bool GzipDecompressor::push(std::span<const std::uint8_t> data)
+{
+    if (!m_valid)
+    {
+        return false;
+    }
+
+    std::size_t offset{ 0u };
+
+    while (offset < data.size())
+    {
+        const std::size_t size = std::min(data.size() - offset, MAX_STREAM_INPUT);
+
+        m_stream->next_in = const_cast<Bytef*>(data.data() + offset);
+        m_stream->avail_in = (uInt)size;
+        offset += size;
+
+        // Also continues while the output buffer was filled, inflate may hold back pending output.
+        do
+        {
+            // Another member follows
+            if (m_member_finished && m_stream->avail_in > 0u)
+            {
+                inflateReset(m_stream.get());
+                m_member_finished = false;
+            }
+
+            m_stream->next_out = m_buffer.data();
+            m_stream->avail_out = (uInt)m_buffer.size();
+
+            int result = inflate(m_stream.get(), Z_NO_FLUSH);
+            if (result == Z_NEED_DICT || result == Z_DATA_ERROR || result == Z_MEM_ERROR || result == Z_STREAM_ERROR)
+            {
+                m_valid = false;
+                return false;
+            }
+
+            const std::size_t have = m_buffer.size() - m_stream->avail_out;
+            if (have > 0u && !m_sink({ m_buffer.data(), have }))
+            {
+                m_valid = false;
+                return false;
+            }
+
+            if (result == Z_STREAM_END)
+            {
+                m_member_finished = true;
+            }
+        } while (m_stream->avail_in > 0u || m_stream->avail_out == 0u);
+    }
+
+    return true;
+}
+
+bool GzipDecompressor::isFinished() const
+{
+    return m_valid && m_member_finished;
 }
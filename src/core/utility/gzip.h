@@ -1,16 +1,112 @@
-
 #ifndef CORE_UTILITY_GZIP_H_
 #define CORE_UTILITY_GZIP_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
+#include "core/utility/ThreadPool.h"
+
+// zlib stream state, only used through pointers here.
+struct z_stream_s;
+
 std::vector<std::uint8_t> gzipCompress(const std::uint8_t* data, std::size_t length, int level = -1);
 
 std::vector<std::uint8_t> gzipCompress(const std::vector<std::uint8_t>& data, int level = -1);
 
+// Decompresses all members. Data after the last member, which does not start another one, is ignored.
+// Returns an empty result on corrupt data, CRC or size mismatches and truncated input.
 std::vector<std::uint8_t> gzipDecompress(const std::uint8_t* data, std::size_t length);
 
 std::vector<std::uint8_t> gzipDecompress(const std::vector<std::uint8_t>& data);
 
+// Size stored in the trailer of the last member, i.e. the exact size for a single member below 4 GiB without trailing data.
+std::optional<std::size_t> gzipDecompressedSize(std::span<const std::uint8_t> data);
+
+// Decompresses all members into the destination, e.g. mapped staging memory, and returns the number of bytes written.
+// Trailing data is ignored like in gzipDecompress. Fails on corrupt data, CRC or size mismatches, truncated input and if the destination is too small.
+std::optional<std::size_t> gzipDecompressInto(std::span<const std::uint8_t> data, std::span<std::uint8_t> destination);
+
+// Compresses independent blocks on the thread pool, similar to pigz. The result is a single, regular gzip member.
+// Every block is primed with the last 32 KiB of the preceding input, so the ratio stays close to gzipCompress.
+// The output only depends on the input, level and block size, not on the number of threads.
+std::vector<std::uint8_t> gzipCompressParallel(const std::uint8_t* data, std::size_t length, int level = -1, std::size_t block_size = 128u * 1024u, ThreadPool& thread_pool = getThreadPool());
+
+// Streaming
+
+// Receives every piece of produced output. Returning false aborts the stream.
+using GzipSink = std::function<bool(std::span<const std::uint8_t> data)>;
+
+class GzipCompressor
+{
+
+private:
+
+    std::unique_ptr<z_stream_s> m_stream{};
+    bool m_valid{ false };
+    bool m_finished{ false };
+
+    GzipSink m_sink{};
+    std::vector<std::uint8_t> m_buffer{};
+
+    bool process(std::span<const std::uint8_t> data, int flush);
+
+public:
+
+    GzipCompressor(const GzipCompressor&) = delete;
+    GzipCompressor(GzipCompressor&&) = delete;
+
+    GzipCompressor operator=(const GzipCompressor&) = delete;
+    GzipCompressor operator=(GzipCompressor&&) = delete;
+
+    explicit GzipCompressor(GzipSink sink, int level = -1);
+
+    ~GzipCompressor();
+
+    // False after an error, an aborting sink or once finished.
+    bool isValid() const;
+
+    bool push(std::span<const std::uint8_t> data);
+
+    // Flushes the remaining output and writes the trailer.
+    bool finish();
+};
+
+class GzipDecompressor
+{
+
+private:
+
+    std::unique_ptr<z_stream_s> m_stream{};
+    bool m_valid{ false };
+    bool m_member_finished{ false };
+
+    GzipSink m_sink{};
+    std::vector<std::uint8_t> m_buffer{};
+
+public:
+
+    GzipDecompressor(const GzipDecompressor&) = delete;
+    GzipDecompressor(GzipDecompressor&&) = delete;
+
+    GzipDecompressor operator=(const GzipDecompressor&) = delete;
+    GzipDecompressor operator=(GzipDecompressor&&) = delete;
+
+    explicit GzipDecompressor(GzipSink sink);
+
+    ~GzipDecompressor();
+
+    bool isValid() const;
+
+    // Input may be split anywhere. Concatenated gzip members are decompressed one after the other.
+    bool push(std::span<const std::uint8_t> data);
+
+    // True if the input pushed so far ends exactly at the end of a gzip member.
+    bool isFinished() const;
+};
+
 #endif /* CORE_UTILITY_GZIP_H_ */
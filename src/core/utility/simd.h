@@ -0,0 +1,162 @@
+#ifndef CORE_UTILITY_SIMD_H_
+#define CORE_UTILITY_SIMD_H_
+
+// Minimal four lane float abstraction. Uses SSE2 where available, otherwise plain scalar code.
+// Also runtime checks for wider x86 instruction sets.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLAYGROUND_SSE2
+#endif
+
+#if defined(PLAYGROUND_SSE2)
+#include <emmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// Kernels for wider instruction sets are compiled per function with e.g. PLAYGROUND_TARGET("ssse3") or PLAYGROUND_TARGET("avx2,fma")
+// and only called if the matching simdHas...() check passes, so the SDK itself needs no extra compiler flags.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PLAYGROUND_TARGET(instruction_set)
+#else
+#define PLAYGROUND_TARGET(instruction_set) __attribute__((target(instruction_set)))
+#endif
+
+inline bool simdHasSsse3()
+{
+#if !defined(PLAYGROUND_SSE2)
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4]{};
+    __cpuid(info, 1);
+
+    return (info[2] & (1 << 9)) != 0;
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+inline bool simdHasAvx2()
+{
+#if !defined(PLAYGROUND_SSE2)
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4]{};
+    __cpuid(info, 1);
+
+    // The operating system has to save the AVX registers as well.
+    const bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6u) == 0x6u;
+
+    __cpuidex(info, 7, 0);
+
+    return avx && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// Fused multiply add, which changes rounding against a separate multiply and add. Kernels use it together with AVX2.
+inline bool simdHasFma()
+{
+#if !defined(PLAYGROUND_SSE2)
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4]{};
+    __cpuid(info, 1);
+
+    return (info[2] & (1 << 12)) != 0 && simdHasAvx2();
+#else
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("fma") && simdHasAvx2();
+#endif
+}
+
+#if defined(PLAYGROUND_SSE2)
+
+using SimdFloat4 = __m128;
+
+inline SimdFloat4 simdLoad(const float* data)
+{
+    return _mm_loadu_ps(data);
+}
+
+inline void simdStore(float* data, SimdFloat4 value)
+{
+    _mm_storeu_ps(data, value);
+}
+
+inline SimdFloat4 simdSet(float value)
+{
+    return _mm_set1_ps(value);
+}
+
+inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b)
+{
+    return _mm_add_ps(a, b);
+}
+
+inline SimdFloat4 simdSub(SimdFloat4 a, SimdFloat4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+#else
+
+struct SimdFloat4
+{
+    float v[4];
+};
+
+inline SimdFloat4 simdLoad(const float* data)
+{
+    return { { data[0], data[1], data[2], data[3] } };
+}
+
+inline void simdStore(float* data, SimdFloat4 value)
+{
+    data[0] = value.v[0];
+    data[1] = value.v[1];
+    data[2] = value.v[2];
+    data[3] = value.v[3];
+}
+
+inline SimdFloat4 simdSet(float value)
+{
+    return { { value, value, value, value } };
+}
+
+inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b)
+{
+    return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+}
+
+inline SimdFloat4 simdSub(SimdFloat4 a, SimdFloat4 b)
+{
+    return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+}
+
+inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b)
+{
+    return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+}
+
+#endif
+
+// Returns a + b * weight.
+inline SimdFloat4 simdMulAdd(SimdFloat4 a, SimdFloat4 b, float weight)
+{
+    return simdAdd(a, simdMul(b, simdSet(weight)));
+}
+
+#endif /* CORE_UTILITY_SIMD_H_ */
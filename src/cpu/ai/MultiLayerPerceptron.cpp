@@ -1,10 +1,110 @@
 #include "MultiLayerPerceptron.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <utility>
 
 #include "core/math/RandomGenerator.h"
+#include "core/utility/ThreadPool.h"
 #include "loss_functions.h"
+#include "matrix_kernels.h"
+
+namespace
+{
+
+// Rows are padded to whole cache lines.
+std::size_t getPaddedSize(std::size_t size)
+{
+    return (size + 15u) & ~(std::size_t)15u;
+}
+
+struct LibraryActivation
+{
+    Activation activation;
+    float (*function)(float);
+    float (*derivative)(float);
+};
+
+constexpr LibraryActivation LIBRARY_ACTIVATIONS[]{
+    { Activation::IDENTITY, identity, identityDerivative },
+    { Activation::BINARY_STEP, binaryStep, binaryStepDerivative },
+    { Activation::SIGMOID, sigmoid, sigmoidDerivative },
+    { Activation::HYPERBOLIC_TANGENT, hyperbolicTangent, hyperbolicTangentDerivative },
+    { Activation::RECTIFIED_LINEAR_UNIT, rectifiedLinearUnit, rectifiedLinearUnitDerivative },
+    { Activation::LEAKY_RECTIFIED_LINEAR_UNIT, leakyRectifiedLinearUnit, leakyRectifiedLinearUnitDerivative },
+    { Activation::EXPONENTIAL_LINEAR_UNIT, exponentialLinearUnit, exponentialLinearUnitDerivative },
+    { Activation::SWISH, swish, swishDerivative },
+    { Activation::GAUSSIAN_ERROR_LINEAR_UNIT, gaussianErrorLinearUnit, gaussianErrorLinearUnitDerivative }
+};
+
+Activation findActivation(const ActivationFunction& activation_function)
+{
+    if (activation_function.activation != Activation::CUSTOM)
+    {
+        return activation_function.activation;
+    }
+
+    const auto* function = activation_function.function.target<float (*)(float)>();
+    const auto* derivative = activation_function.derivative.target<float (*)(float)>();
+    if (!function || !derivative)
+    {
+        return Activation::CUSTOM;
+    }
+
+    for (const auto& library_activation : LIBRARY_ACTIVATIONS)
+    {
+        if ((*function == library_activation.function) && (*derivative == library_activation.derivative))
+        {
+            return library_activation.activation;
+        }
+    }
+
+    return Activation::CUSTOM;
+}
+
+void applyFunction(const ActivationFunction& activation_function, std::span<float> values)
+{
+    if (activate(activation_function.activation, values))
+    {
+        return;
+    }
+
+    for (float& value : values)
+    {
+        value = activation_function.function(value);
+    }
+}
+
+void applyDerivative(const ActivationFunction& activation_function, std::span<const float> outputs, std::span<float> deltas)
+{
+    if (multiplyDerivative(activation_function.activation, outputs, deltas))
+    {
+        return;
+    }
+
+    for (std::size_t i = 0u; i < deltas.size(); i++)
+    {
+        deltas[i] *= activation_function.derivative(outputs[i]);
+    }
+}
+
+} // namespace
+
+ActivationFunction createActivationFunction(Activation activation)
+{
+    for (const auto& library_activation : LIBRARY_ACTIVATIONS)
+    {
+        if (library_activation.activation == activation)
+        {
+            return { library_activation.function, library_activation.derivative, activation };
+        }
+    }
+
+    return {};
+}
 
 MultiLayerPerceptron::MultiLayerPerceptron(std::size_t number_inputs, bool use_bias, float mean) :
     m_number_inputs{ number_inputs },
@@ -19,7 +119,7 @@ bool MultiLayerPerceptron::addLayer(std::size_t number_neurons, const Activation
     {
         return false;
     }
-    if ((activation_function.function == nullptr) || (activation_function.derivative == nullptr))
+    if ((activation_function.activation == Activation::CUSTOM) && ((activation_function.function == nullptr) || (activation_function.derivative == nullptr)))
     {
         return false;
     }
@@ -27,16 +127,19 @@ bool MultiLayerPerceptron::addLayer(std::size_t number_neurons, const Activation
     std::size_t number_inputs{ m_number_inputs };
     if (!m_layers.empty())
     {
-        number_inputs = m_layers.back().neurons.size();
+        number_inputs = m_layers.back().number_neurons;
     }
 
     Layer layer{};
-    layer.neurons.resize(number_neurons);
-    for (auto& neuron : layer.neurons)
-    {
-        neuron.weights.resize(number_inputs);
-    }
+    layer.number_inputs = number_inputs;
+    layer.number_neurons = number_neurons;
+    layer.stride = getPaddedSize(number_inputs);
+    layer.weights.resize(number_neurons * layer.stride, 0.0f);
+    layer.biases.resize(number_neurons, 0.0f);
+    layer.outputs.resize(number_neurons, 0.0f);
+    layer.deltas.resize(number_neurons, 0.0f);
     layer.af = activation_function;
+    layer.af.activation = findActivation(activation_function);
 
     m_layers.push_back(std::move(layer));
 
@@ -54,7 +157,7 @@ bool MultiLayerPerceptron::reset(InitializationMethod initialization_method, flo
 
     for (auto& layer : m_layers)
     {
-        for (auto& neuron : layer.neurons)
+        for (std::size_t neuron_index = 0u; neuron_index < layer.number_neurons; neuron_index++)
         {
             std::unique_ptr<ARandomGenerator> rg{ nullptr };
 
@@ -64,16 +167,16 @@ bool MultiLayerPerceptron::reset(InitializationMethod initialization_method, flo
             }
             else if (initialization_method == InitializationMethod::KAIMING)
             {
-                rg = std::make_unique<NormalRandomGenerator>(m_mean, std::sqrt(2.0f / (float)neuron.weights.size()), current_seed);
+                rg = std::make_unique<NormalRandomGenerator>(m_mean, std::sqrt(2.0f / (float)layer.number_inputs), current_seed);
             }
             else if (initialization_method == InitializationMethod::UNIFORM_XAVIER)
             {
-                float limit = std::sqrt(6.0f / (float)(layer.neurons.size() + neuron.weights.size()));
+                float limit = std::sqrt(6.0f / (float)(layer.number_neurons + layer.number_inputs));
                 rg = std::make_unique<UniformRandomGenerator>(-limit + m_mean, limit + m_mean, current_seed);
             }
             else if (initialization_method == InitializationMethod::NORMAL_XAVIER)
             {
-                rg = std::make_unique<NormalRandomGenerator>(m_mean, std::sqrt(2.0f / (float)(layer.neurons.size() + neuron.weights.size())), current_seed);
+                rg = std::make_unique<NormalRandomGenerator>(m_mean, std::sqrt(2.0f / (float)(layer.number_neurons + layer.number_inputs)), current_seed);
             }
 
             if (!rg)
@@ -81,14 +184,15 @@ bool MultiLayerPerceptron::reset(InitializationMethod initialization_method, flo
                 return false;
             }
 
-            for (auto& weight : neuron.weights)
+            float* weights = layer.weights.data() + neuron_index * layer.stride;
+            for (std::size_t weight_index = 0u; weight_index < layer.number_inputs; weight_index++)
             {
-                weight = rg->generate();
+                weights[weight_index] = rg->generate();
             }
 
             if (m_use_bias)
             {
-                neuron.bias = bias_value;
+                layer.biases[neuron_index] = bias_value;
             }
 
             // Change seed every loop.
@@ -96,64 +200,110 @@ bool MultiLayerPerceptron::reset(InitializationMethod initialization_method, flo
         }
     }
 
+    clearOptimizerStates();
+
     return true;
 }
 
-std::vector<float> MultiLayerPerceptron::forwardPropagation(const std::vector<float>& inputs)
+void MultiLayerPerceptron::clearOptimizerStates()
+{
+    for (auto& layer : m_layers)
+    {
+        layer.weight_state = {};
+        layer.bias_state = {};
+    }
+
+    if (m_optimizer)
+    {
+        m_optimizer->reset();
+    }
+}
+
+bool MultiLayerPerceptron::propagate(std::span<const float> inputs)
 {
     if (m_layers.size() < 2u)
     {
-        return {};
+        return false;
     }
     if (inputs.size() != m_number_inputs)
     {
-        return {};
+        return false;
     }
 
-    std::vector<float> current_inputs{ inputs };
+    const float* current_inputs = inputs.data();
 
     for (auto& layer : m_layers)
     {
-        std::vector<float> current_outputs(layer.neurons.size());
+        gemv(layer.weights.data(), layer.number_neurons, layer.number_inputs, layer.stride, current_inputs, layer.outputs.data());
 
-        for (std::size_t neuron_index = 0u; neuron_index < layer.neurons.size(); neuron_index++)
+        if (m_use_bias)
         {
-            auto& neuron{ layer.neurons[neuron_index] };
+            axpy(layer.number_neurons, 1.0f, layer.biases.data(), layer.outputs.data());
+        }
 
-            float weighted_sum = 0.0f;
+        applyFunction(layer.af, { layer.outputs.data(), layer.number_neurons });
 
-            for (std::size_t input_index = 0u; input_index < current_inputs.size(); input_index++)
-            {
-                weighted_sum += neuron.weights[input_index] * current_inputs[input_index];
-            }
+        current_inputs = layer.outputs.data();
+    }
 
-            if (m_use_bias)
-            {
-                weighted_sum += neuron.bias;
-            }
+    return true;
+}
 
-            neuron.output = layer.af.function(weighted_sum);
+std::size_t MultiLayerPerceptron::getNumberSamples(std::span<const float> inputs, std::span<const float> targets) const
+{
+    if (m_layers.size() < 2u)
+    {
+        return 0u;
+    }
+    if (inputs.empty() || (inputs.size() % m_number_inputs) != 0u)
+    {
+        return 0u;
+    }
 
-            current_outputs[neuron_index] = neuron.output;
-        }
+    const std::size_t number_samples = inputs.size() / m_number_inputs;
+    if (targets.size() != number_samples * m_layers.back().number_neurons)
+    {
+        return 0u;
+    }
+
+    return number_samples;
+}
 
-        current_inputs = std::move(current_outputs);
+std::vector<float> MultiLayerPerceptron::forwardPropagation(const std::vector<float>& inputs)
+{
+    if (!propagate(inputs))
+    {
+        return {};
+    }
+
+    return std::vector<float>(m_layers.back().outputs.begin(), m_layers.back().outputs.end());
+}
+
+std::pmr::vector<float> MultiLayerPerceptron::forwardPropagation(std::span<const float> inputs, std::pmr::memory_resource* memory_resource)
+{
+    if (!propagate(inputs))
+    {
+        return std::pmr::vector<float>(memory_resource);
     }
 
-    return current_inputs;
+    return std::pmr::vector<float>(m_layers.back().outputs.begin(), m_layers.back().outputs.end(), memory_resource);
 }
 
 std::optional<float> MultiLayerPerceptron::backwardPropagation(const std::vector<float>& inputs, const std::vector<float>& targets, float learning_rate)
 {
+    if (m_optimizer)
+    {
+        return trainBatch(inputs, targets, learning_rate);
+    }
+
     // Execute the forward propagation.
-    auto result = forwardPropagation(inputs);
-    if (result.empty())
+    if (!propagate(inputs))
     {
         return {};
     }
 
     // Calculate the gradients.
-    if (targets.size() != m_layers.back().neurons.size())
+    if (targets.size() != m_layers.back().number_neurons)
     {
         return {};
     }
@@ -163,74 +313,346 @@ std::optional<float> MultiLayerPerceptron::backwardPropagation(const std::vector
     }
 
     std::vector<float> errors(targets.size());
-    std::vector<float> previous_neurons_deltas{};
 
-    auto layer_it = m_layers.end();
-    while (layer_it != m_layers.begin())
+    // Overall output layer.
+    Layer& output_layer = m_layers.back();
+    for (std::size_t neuron_index = 0u; neuron_index < output_layer.number_neurons; neuron_index++)
     {
-        layer_it--;
-        auto& layer = *layer_it;
+        errors[neuron_index] = targets[neuron_index] - output_layer.outputs[neuron_index];
 
-        std::vector<float> current_neurons_deltas(layer.neurons.size());
+        output_layer.deltas[neuron_index] = errors[neuron_index];
+    }
+    applyDerivative(output_layer.af, { output_layer.outputs.data(), output_layer.number_neurons }, { output_layer.deltas.data(), output_layer.number_neurons });
 
-        for (std::size_t neuron_index = 0u; neuron_index < layer.neurons.size(); neuron_index++)
-        {
-            auto& neuron{ layer.neurons[neuron_index] };
+    // Hidden layers, from the weights of the next layer before they are updated.
+    for (std::size_t layer_index = m_layers.size() - 1u; layer_index > 0u; layer_index--)
+    {
+        const Layer& next_layer = m_layers[layer_index];
+        Layer& layer = m_layers[layer_index - 1u];
 
-            if ((layer_it + 1u) == m_layers.end())
-            {
-                // Overall output layer.
-                neuron.delta = targets[neuron_index] - neuron.output;
+        gemvTransposed(next_layer.weights.data(), next_layer.number_neurons, next_layer.number_inputs, next_layer.stride, next_layer.deltas.data(), layer.deltas.data());
 
-                errors[neuron_index] = neuron.delta;
+        applyDerivative(layer.af, { layer.outputs.data(), layer.number_neurons }, { layer.deltas.data(), layer.number_neurons });
+    }
+
+    // Update weights and biases.
+    const float* current_inputs = inputs.data();
+
+    for (auto& layer : m_layers)
+    {
+        ger(layer.weights.data(), layer.number_neurons, layer.number_inputs, layer.stride, learning_rate, layer.deltas.data(), current_inputs);
+
+        if (m_use_bias)
+        {
+            for (std::size_t neuron_index = 0u; neuron_index < layer.number_neurons; neuron_index++)
+            {
+                layer.biases[neuron_index] += learning_rate * layer.deltas[neuron_index];
             }
-            else
+        }
+
+        current_inputs = layer.outputs.data();
+    }
+
+    // Calculate and return the error.
+    return half_mse(errors);
+}
+
+void MultiLayerPerceptron::trainShard(Shard& shard, const float* inputs, const float* targets, std::size_t number_samples)
+{
+    const std::size_t number_layers = m_layers.size();
+
+    shard.outputs.resize(number_layers);
+    shard.deltas.resize(number_layers);
+    shard.weight_gradients.resize(number_layers);
+    shard.bias_gradients.resize(number_layers);
+
+    // Execute the forward propagation.
+    const float* current_inputs = inputs;
+    std::size_t current_stride{ m_number_inputs };
+
+    for (std::size_t layer_index = 0u; layer_index < number_layers; layer_index++)
+    {
+        const Layer& layer = m_layers[layer_index];
+        const std::size_t stride = getPaddedSize(layer.number_neurons);
+
+        AlignedBuffer<float>& outputs = shard.outputs[layer_index];
+        outputs.resize(number_samples * stride);
+        shard.deltas[layer_index].resize(number_samples * stride);
+
+        gemmTransposedB(number_samples, layer.number_neurons, layer.number_inputs, current_inputs, current_stride, layer.weights.data(), layer.stride, outputs.data(), stride);
+
+        for (std::size_t sample_index = 0u; sample_index < number_samples; sample_index++)
+        {
+            float* sample_outputs = outputs.data() + sample_index * stride;
+
+            if (m_use_bias)
             {
-                // Hidden layers.
-                neuron.delta = 0.0f;
-
-                const auto& next_layer = *(layer_it + 1u);
-                for (std::size_t next_neuron_index = 0u; next_neuron_index < next_layer.neurons.size(); next_neuron_index++)
-                {
-                    neuron.delta += next_layer.neurons[next_neuron_index].weights[neuron_index] * previous_neurons_deltas[next_neuron_index];
-                }
+                axpy(layer.number_neurons, 1.0f, layer.biases.data(), sample_outputs);
             }
 
-            neuron.delta *= layer.af.derivative(neuron.output);
+            applyFunction(layer.af, { sample_outputs, layer.number_neurons });
+        }
+
+        current_inputs = outputs.data();
+        current_stride = stride;
+    }
+
+    // Overall output layer.
+    const Layer& output_layer = m_layers.back();
+    const std::size_t number_outputs = output_layer.number_neurons;
+    const std::size_t output_stride = getPaddedSize(number_outputs);
+
+    shard.squared_error = 0.0f;
+    for (std::size_t sample_index = 0u; sample_index < number_samples; sample_index++)
+    {
+        const float* sample_targets = targets + sample_index * number_outputs;
+        const float* outputs = shard.outputs.back().data() + sample_index * output_stride;
+        float* deltas = shard.deltas.back().data() + sample_index * output_stride;
 
-            current_neurons_deltas[neuron_index] = neuron.delta;
+        for (std::size_t neuron_index = 0u; neuron_index < number_outputs; neuron_index++)
+        {
+            const float error = sample_targets[neuron_index] - outputs[neuron_index];
+            shard.squared_error += error * error;
+
+            deltas[neuron_index] = error;
         }
 
-        previous_neurons_deltas = std::move(current_neurons_deltas);
+        applyDerivative(output_layer.af, { outputs, number_outputs }, { deltas, number_outputs });
     }
 
-    // Update weights and biases.
-    std::vector<float> current_inputs{ inputs };
+    // Hidden layers, from the weights of the next layer before they are updated.
+    for (std::size_t layer_index = number_layers - 1u; layer_index > 0u; layer_index--)
+    {
+        const Layer& next_layer = m_layers[layer_index];
+        const Layer& layer = m_layers[layer_index - 1u];
 
-    for (auto& layer : m_layers)
+        const std::size_t stride = getPaddedSize(layer.number_neurons);
+
+        gemm(number_samples, layer.number_neurons, next_layer.number_neurons, shard.deltas[layer_index].data(), getPaddedSize(next_layer.number_neurons), next_layer.weights.data(), next_layer.stride, shard.deltas[layer_index - 1u].data(), stride);
+
+        for (std::size_t sample_index = 0u; sample_index < number_samples; sample_index++)
+        {
+            const float* outputs = shard.outputs[layer_index - 1u].data() + sample_index * stride;
+            float* deltas = shard.deltas[layer_index - 1u].data() + sample_index * stride;
+
+            applyDerivative(layer.af, { outputs, layer.number_neurons }, { deltas, layer.number_neurons });
+        }
+    }
+
+    // Gradients, summed up over the samples.
+    current_inputs = inputs;
+    current_stride = m_number_inputs;
+
+    for (std::size_t layer_index = 0u; layer_index < number_layers; layer_index++)
+    {
+        const Layer& layer = m_layers[layer_index];
+        const std::size_t stride = getPaddedSize(layer.number_neurons);
+
+        AlignedBuffer<float>& weight_gradients = shard.weight_gradients[layer_index];
+        AlignedBuffer<float>& bias_gradients = shard.bias_gradients[layer_index];
+
+        // The padding stays zero, so the gradients can be added up and applied as a whole.
+        weight_gradients.resize(layer.weights.size(), 0.0f);
+        bias_gradients.resize(layer.number_neurons);
+
+        gemmTransposedA(layer.number_neurons, layer.number_inputs, number_samples, shard.deltas[layer_index].data(), stride, current_inputs, current_stride, weight_gradients.data(), layer.stride);
+
+        std::fill(bias_gradients.begin(), bias_gradients.end(), 0.0f);
+        for (std::size_t sample_index = 0u; sample_index < number_samples; sample_index++)
+        {
+            axpy(layer.number_neurons, 1.0f, shard.deltas[layer_index].data() + sample_index * stride, bias_gradients.data());
+        }
+
+        current_inputs = shard.outputs[layer_index].data();
+        current_stride = stride;
+    }
+}
+
+void MultiLayerPerceptron::forEach(std::size_t count, const std::function<void(std::size_t index)>& function)
+{
+    const std::size_t number_tasks = std::min(m_number_threads, count);
+    if (number_tasks <= 1u)
+    {
+        for (std::size_t index = 0u; index < count; index++)
+        {
+            function(index);
+        }
+
+        return;
+    }
+
+    // Every task takes a fixed subset of the indices, so at most number_tasks threads work at once.
+    getThreadPool().parallelFor(number_tasks, 1u, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t task = begin; task < end; task++)
+        {
+            for (std::size_t index = task; index < count; index += number_tasks)
+            {
+                function(index);
+            }
+        }
+    });
+}
+
+void MultiLayerPerceptron::setNumberThreads(std::size_t number_threads)
+{
+    if (number_threads == 0u)
+    {
+        number_threads = getThreadPool().getNumberThreads();
+    }
+
+    m_number_threads = std::max<std::size_t>(number_threads, 1u);
+}
+
+std::size_t MultiLayerPerceptron::getNumberThreads() const
+{
+    return m_number_threads;
+}
+
+void MultiLayerPerceptron::setOptimizer(std::shared_ptr<AOptimizer> optimizer)
+{
+    m_optimizer = std::move(optimizer);
+
+    clearOptimizerStates();
+}
+
+std::shared_ptr<AOptimizer> MultiLayerPerceptron::getOptimizer() const
+{
+    return m_optimizer;
+}
+
+std::optional<float> MultiLayerPerceptron::trainBatch(std::span<const float> inputs, std::span<const float> targets, float learning_rate)
+{
+    const std::size_t number_samples = getNumberSamples(inputs, targets);
+    if (number_samples == 0u)
+    {
+        return {};
+    }
+    if (learning_rate == 0.0f)
+    {
+        return {};
+    }
+
+    const std::size_t number_outputs = m_layers.back().number_neurons;
+
+    const std::size_t number_shards = (number_samples + SHARD_SIZE - 1u) / SHARD_SIZE;
+    if (m_shards.size() < number_shards)
     {
-        std::vector<float> current_outputs(layer.neurons.size());
+        m_shards.resize(number_shards);
+    }
+
+    forEach(number_shards, [&](std::size_t shard_index) {
+        const std::size_t first = shard_index * SHARD_SIZE;
+        const std::size_t count = std::min(SHARD_SIZE, number_samples - first);
 
-        for (std::size_t neuron_index = 0u; neuron_index < layer.neurons.size(); neuron_index++)
+        trainShard(m_shards[shard_index], inputs.data() + first * m_number_inputs, targets.data() + first * number_outputs, count);
+    });
+
+    // Pairwise sums, the shape of the tree only depends on the number of shards.
+    for (std::size_t step = 1u; step < number_shards; step *= 2u)
+    {
+        const std::size_t number_pairs = (number_shards - step + 2u * step - 1u) / (2u * step);
+
+        forEach(number_pairs, [&](std::size_t pair_index) {
+            Shard& shard = m_shards[pair_index * 2u * step];
+            const Shard& other = m_shards[pair_index * 2u * step + step];
+
+            for (std::size_t layer_index = 0u; layer_index < m_layers.size(); layer_index++)
+            {
+                axpy(shard.weight_gradients[layer_index].size(), 1.0f, other.weight_gradients[layer_index].data(), shard.weight_gradients[layer_index].data());
+                axpy(shard.bias_gradients[layer_index].size(), 1.0f, other.bias_gradients[layer_index].data(), shard.bias_gradients[layer_index].data());
+            }
+            shard.squared_error += other.squared_error;
+        });
+    }
+
+    // Update weights and biases once, with the mean of the gradients.
+    const Shard& gradients = m_shards.front();
+
+    if (m_optimizer)
+    {
+        m_optimizer->beginStep();
+
+        const float rate = m_optimizer->getLearningRate(learning_rate);
+
+        // The gradients are summed up towards the targets, so the negated mean is the one of the loss.
+        const float scale = -1.0f / (float)number_samples;
+
+        for (std::size_t layer_index = 0u; layer_index < m_layers.size(); layer_index++)
         {
-            auto& neuron{ layer.neurons[neuron_index] };
+            Layer& layer = m_layers[layer_index];
+
+            m_optimizer->update({ layer.weights.data(), layer.weights.size() }, { gradients.weight_gradients[layer_index].data(), layer.weights.size() }, scale, rate, layer.weight_state);
 
-            for (std::size_t weight_index = 0u; weight_index < neuron.weights.size(); weight_index++)
+            if (m_use_bias)
             {
-                neuron.weights[weight_index] += learning_rate * neuron.delta * current_inputs[weight_index];
+                m_optimizer->update({ layer.biases.data(), layer.number_neurons }, { gradients.bias_gradients[layer_index].data(), layer.number_neurons }, scale, rate, layer.bias_state);
             }
+        }
+    }
+    else
+    {
+        const float step = learning_rate / (float)number_samples;
+
+        for (std::size_t layer_index = 0u; layer_index < m_layers.size(); layer_index++)
+        {
+            Layer& layer = m_layers[layer_index];
+
+            axpy(layer.weights.size(), step, gradients.weight_gradients[layer_index].data(), layer.weights.data());
 
             if (m_use_bias)
             {
-                neuron.bias += learning_rate * neuron.delta;
+                axpy(layer.number_neurons, step, gradients.bias_gradients[layer_index].data(), layer.biases.data());
             }
+        }
+    }
+
+    // Calculate and return the mean error.
+    return 0.5f * gradients.squared_error / (float)(number_samples * number_outputs);
+}
+
+std::optional<float> MultiLayerPerceptron::trainEpoch(std::span<const float> inputs, std::span<const float> targets, std::size_t batch_size, float learning_rate, std::uint32_t seed)
+{
+    const std::size_t number_samples = getNumberSamples(inputs, targets);
+    if (number_samples == 0u)
+    {
+        return {};
+    }
+    if (batch_size == 0u)
+    {
+        return {};
+    }
+
+    const std::size_t number_outputs = m_layers.back().number_neurons;
+
+    m_order.resize(number_samples);
+    std::iota(m_order.begin(), m_order.end(), (std::size_t)0u);
+    std::shuffle(m_order.begin(), m_order.end(), std::default_random_engine{ seed });
+
+    float error_sum{ 0.0f };
+
+    for (std::size_t first = 0u; first < number_samples; first += batch_size)
+    {
+        const std::size_t count = std::min(batch_size, number_samples - first);
 
-            current_outputs[neuron_index] = neuron.output;
+        // Gather the samples, so the mini-batch is contiguous.
+        m_batch_inputs.resize(count * m_number_inputs);
+        m_batch_targets.resize(count * number_outputs);
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            const std::size_t sample_index = m_order[first + i];
+
+            std::copy_n(inputs.data() + sample_index * m_number_inputs, m_number_inputs, m_batch_inputs.data() + i * m_number_inputs);
+            std::copy_n(targets.data() + sample_index * number_outputs, number_outputs, m_batch_targets.data() + i * number_outputs);
         }
 
-        current_inputs = std::move(current_outputs);
+        auto error = trainBatch({ m_batch_inputs.data(), count * m_number_inputs }, { m_batch_targets.data(), count * number_outputs }, learning_rate);
+        if (!error)
+        {
+            return {};
+        }
+
+        error_sum += *error * (float)count;
     }
 
-    // Calculate and return the error.
-    return half_mse(errors);
+    return error_sum / (float)number_samples;
 }
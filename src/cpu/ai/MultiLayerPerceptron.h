@@ -2,11 +2,17 @@
 #define CPU_AI_MULTILAYERPERCEPTRON_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <vector>
 
+#include "Optimizer.h"
 #include "activation_functions.h"
+#include "core/utility/AlignedBuffer.h"
 
 enum class InitializationMethod
 {
@@ -16,26 +22,56 @@ enum class InitializationMethod
     NORMAL_XAVIER
 };
 
+// With an activation other than CUSTOM, all neurons of a layer are activated at once by the span versions.
+// Otherwise function and derivative are called per neuron, unless they are plain pointers to the library functions.
 struct ActivationFunction
 {
     std::function<float(float)> function{ nullptr };
     std::function<float(float)> derivative{ nullptr };
-};
 
-struct Neuron
-{
-    std::vector<float> weights{};
-    float bias{ 0.0f };
-    float output{ 0.0f };
-    float delta{ 0.0f };
+    Activation activation{ Activation::CUSTOM };
 };
 
+ActivationFunction createActivationFunction(Activation activation);
+
+// Fully connected layer. The weights are a row-major matrix with one row per neuron.
+// Rows are padded to a multiple of 16 floats, so every row starts on a cache line. The padding stays zero.
 struct Layer
 {
-    std::vector<Neuron> neurons{};
+    std::size_t number_inputs{ 0u };
+    std::size_t number_neurons{ 0u };
+
+    // Floats from one row of weights to the next.
+    std::size_t stride{ 0u };
+
+    AlignedBuffer<float> weights{};
+    AlignedBuffer<float> biases{};
+
+    // Of the last forward and backward propagation, one per neuron.
+    AlignedBuffer<float> outputs{};
+    AlignedBuffer<float> deltas{};
+
+    // Of the optimizer, laid out like the weights and biases.
+    OptimizerState weight_state{};
+    OptimizerState bias_state{};
+
     ActivationFunction af{};
 };
 
+// Part of a mini-batch, with one entry per layer.
+struct Shard
+{
+    // One row per sample, padded like the rows of the weights.
+    std::vector<AlignedBuffer<float>> outputs{};
+    std::vector<AlignedBuffer<float>> deltas{};
+
+    // Summed up over the samples, laid out like the weights and biases.
+    std::vector<AlignedBuffer<float>> weight_gradients{};
+    std::vector<AlignedBuffer<float>> bias_gradients{};
+
+    float squared_error{ 0.0f };
+};
+
 class MultiLayerPerceptron
 {
 
@@ -49,6 +85,35 @@ private:
 
     std::vector<Layer> m_layers{};
 
+    // Gathered samples and their order for trainEpoch().
+    AlignedBuffer<float> m_batch_inputs{};
+    AlignedBuffer<float> m_batch_targets{};
+    std::vector<std::size_t> m_order{};
+
+    // Mini-batches are split into shards of SHARD_SIZE samples, whatever the number of threads. The gradients of the
+    // shards are summed up in a fixed binary tree, so the results are bitwise the same for any number of threads.
+    static constexpr std::size_t SHARD_SIZE{ 32u };
+
+    std::vector<Shard> m_shards{};
+
+    std::size_t m_number_threads{ 1u };
+
+    std::shared_ptr<AOptimizer> m_optimizer{ nullptr };
+
+    void clearOptimizerStates();
+
+    // Leaves the results in the outputs of the layers.
+    bool propagate(std::span<const float> inputs);
+
+    // Forward and backward propagation of number_samples rows, leaves the summed up gradients in the shard.
+    void trainShard(Shard& shard, const float* inputs, const float* targets, std::size_t number_samples);
+
+    // Runs function for every index on up to m_number_threads threads of the shared pool.
+    void forEach(std::size_t count, const std::function<void(std::size_t index)>& function);
+
+    // Zero, if the layers are incomplete or the sizes do not match.
+    std::size_t getNumberSamples(std::span<const float> inputs, std::span<const float> targets) const;
+
 public:
 
     MultiLayerPerceptron() = default;
@@ -59,9 +124,34 @@ public:
 
     bool reset(InitializationMethod initialization_method, float bias_value, std::uint32_t seed);
 
+    // Threads of the shared pool trainBatch() and trainEpoch() use, 0 selects all. Custom activation functions
+    // are then called concurrently.
+    void setNumberThreads(std::size_t number_threads);
+
+    std::size_t getNumberThreads() const;
+
+    // Update rule of the training, nullptr for plain gradient descent. An optimizer counts the steps of one network,
+    // so it must not be shared. Setting one, also the same again, starts over with empty states.
+    void setOptimizer(std::shared_ptr<AOptimizer> optimizer);
+
+    std::shared_ptr<AOptimizer> getOptimizer() const;
+
     std::vector<float> forwardPropagation(const std::vector<float>& inputs);
 
+    // Intermediate and output values are allocated from memory_resource, e.g. the frame arena.
+    std::pmr::vector<float> forwardPropagation(std::span<const float> inputs, std::pmr::memory_resource* memory_resource);
+
+    // With an optimizer, the same as trainBatch() with one sample.
     std::optional<float> backwardPropagation(const std::vector<float>& inputs, const std::vector<float>& targets, float learning_rate);
+
+    // Trains on a mini-batch. inputs and targets hold one sample per row, without padding.
+    // The gradients of all samples are averaged and applied in one update, which is one step of the optimizer.
+    // Returns the mean error before the update.
+    std::optional<float> trainBatch(std::span<const float> inputs, std::span<const float> targets, float learning_rate);
+
+    // Trains once on all samples, in mini-batches of batch_size samples in an order shuffled with the seed.
+    // The last mini-batch may be smaller. Returns the mean error.
+    std::optional<float> trainEpoch(std::span<const float> inputs, std::span<const float> targets, std::size_t batch_size, float learning_rate, std::uint32_t seed);
 };
 
 #endif /* CPU_AI_MULTILAYERPERCEPTRON_H_ */
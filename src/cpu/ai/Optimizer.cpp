@@ -0,0 +1,427 @@
+#include "Optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+#include "core/utility/simd.h"
+
+#if defined(PLAYGROUND_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+// Kernels, each one pass over the parameters. g is the scaled gradient.
+
+// p -= rate g
+void sgdScalar(float* parameters, const float* gradients, std::size_t size, float scale, float rate)
+{
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        parameters[i] -= rate * (scale * gradients[i]);
+    }
+}
+
+// v = momentum v + g, p -= rate v
+void momentumScalar(float* parameters, const float* gradients, float* velocities, std::size_t size, float scale, float rate, float momentum)
+{
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        velocities[i] = momentum * velocities[i] + scale * gradients[i];
+        parameters[i] -= rate * velocities[i];
+    }
+}
+
+// r = decay r + (1 - decay) g^2, p -= rate g / (sqrt(r) + epsilon)
+void rmsPropScalar(float* parameters, const float* gradients, float* squares, std::size_t size, float scale, float rate, float decay, float epsilon)
+{
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        const float g = scale * gradients[i];
+
+        squares[i] = decay * squares[i] + (1.0f - decay) * (g * g);
+        parameters[i] -= rate * g / (std::sqrt(squares[i]) + epsilon);
+    }
+}
+
+// m = beta1 m + (1 - beta1) g, v = beta2 v + (1 - beta2) g^2, p = keep p - rate m / (sqrt(v) + epsilon)
+// The bias correction is folded into rate and epsilon, keep is one minus the decoupled weight decay.
+void adamScalar(float* parameters, const float* gradients, float* moments, float* squares, std::size_t size, float scale, float rate, float beta1, float beta2, float epsilon, float keep)
+{
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        const float g = scale * gradients[i];
+
+        moments[i] = beta1 * moments[i] + (1.0f - beta1) * g;
+        squares[i] = beta2 * squares[i] + (1.0f - beta2) * (g * g);
+        parameters[i] = keep * parameters[i] - rate * moments[i] / (std::sqrt(squares[i]) + epsilon);
+    }
+}
+
+#if defined(PLAYGROUND_SSE2)
+
+// The tail is loaded and stored masked, so all elements are updated by the same instructions.
+PLAYGROUND_TARGET("avx2,fma")
+__m256i getTailMask(std::size_t count)
+{
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)count), lanes);
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+void sgdAvx2(float* parameters, const float* gradients, std::size_t size, float scale, float rate)
+{
+    const __m256 step = _mm256_set1_ps(-rate * scale);
+
+    std::size_t i{ 0u };
+    for (; i + 8u <= size; i += 8u)
+    {
+        _mm256_storeu_ps(parameters + i, _mm256_fmadd_ps(step, _mm256_loadu_ps(gradients + i), _mm256_loadu_ps(parameters + i)));
+    }
+
+    if (i < size)
+    {
+        const __m256i mask = getTailMask(size - i);
+
+        _mm256_maskstore_ps(parameters + i, mask, _mm256_fmadd_ps(step, _mm256_maskload_ps(gradients + i, mask), _mm256_maskload_ps(parameters + i, mask)));
+    }
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+inline void momentumAvx2(float* parameters, const float* gradients, float* velocities, std::size_t i, __m256i mask, __m256 scale, __m256 rate, __m256 momentum)
+{
+    const __m256 velocity = _mm256_fmadd_ps(momentum, _mm256_maskload_ps(velocities + i, mask), _mm256_mul_ps(scale, _mm256_maskload_ps(gradients + i, mask)));
+
+    _mm256_maskstore_ps(velocities + i, mask, velocity);
+    _mm256_maskstore_ps(parameters + i, mask, _mm256_fnmadd_ps(rate, velocity, _mm256_maskload_ps(parameters + i, mask)));
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+void momentumAvx2(float* parameters, const float* gradients, float* velocities, std::size_t size, float scale, float rate, float momentum)
+{
+    const __m256 scale_vector = _mm256_set1_ps(scale);
+    const __m256 rate_vector = _mm256_set1_ps(rate);
+    const __m256 momentum_vector = _mm256_set1_ps(momentum);
+    const __m256i all = _mm256_set1_epi32(-1);
+
+    std::size_t i{ 0u };
+    for (; i + 8u <= size; i += 8u)
+    {
+        momentumAvx2(parameters, gradients, velocities, i, all, scale_vector, rate_vector, momentum_vector);
+    }
+
+    if (i < size)
+    {
+        momentumAvx2(parameters, gradients, velocities, i, getTailMask(size - i), scale_vector, rate_vector, momentum_vector);
+    }
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+inline void rmsPropAvx2(float* parameters, const float* gradients, float* squares, std::size_t i, __m256i mask, __m256 scale, __m256 rate, __m256 decay, __m256 epsilon)
+{
+    const __m256 g = _mm256_mul_ps(scale, _mm256_maskload_ps(gradients + i, mask));
+    const __m256 remaining = _mm256_sub_ps(_mm256_set1_ps(1.0f), decay);
+
+    const __m256 square = _mm256_fmadd_ps(decay, _mm256_maskload_ps(squares + i, mask), _mm256_mul_ps(remaining, _mm256_mul_ps(g, g)));
+    const __m256 step = _mm256_div_ps(_mm256_mul_ps(rate, g), _mm256_add_ps(_mm256_sqrt_ps(square), epsilon));
+
+    _mm256_maskstore_ps(squares + i, mask, square);
+    _mm256_maskstore_ps(parameters + i, mask, _mm256_sub_ps(_mm256_maskload_ps(parameters + i, mask), step));
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+void rmsPropAvx2(float* parameters, const float* gradients, float* squares, std::size_t size, float scale, float rate, float decay, float epsilon)
+{
+    const __m256 scale_vector = _mm256_set1_ps(scale);
+    const __m256 rate_vector = _mm256_set1_ps(rate);
+    const __m256 decay_vector = _mm256_set1_ps(decay);
+    const __m256 epsilon_vector = _mm256_set1_ps(epsilon);
+    const __m256i all = _mm256_set1_epi32(-1);
+
+    std::size_t i{ 0u };
+    for (; i + 8u <= size; i += 8u)
+    {
+        rmsPropAvx2(parameters, gradients, squares, i, all, scale_vector, rate_vector, decay_vector, epsilon_vector);
+    }
+
+    if (i < size)
+    {
+        rmsPropAvx2(parameters, gradients, squares, i, getTailMask(size - i), scale_vector, rate_vector, decay_vector, epsilon_vector);
+    }
+}
+
+struct AdamAvx2
+{
+    __m256 scale;
+    __m256 rate;
+    __m256 beta1;
+    __m256 beta2;
+    __m256 remaining1;
+    __m256 remaining2;
+    __m256 epsilon;
+    __m256 keep;
+};
+
+PLAYGROUND_TARGET("avx2,fma")
+inline void adamAvx2(float* parameters, const float* gradients, float* moments, float* squares, std::size_t i, __m256i mask, const AdamAvx2& constants)
+{
+    const __m256 g = _mm256_mul_ps(constants.scale, _mm256_maskload_ps(gradients + i, mask));
+
+    const __m256 moment = _mm256_fmadd_ps(constants.beta1, _mm256_maskload_ps(moments + i, mask), _mm256_mul_ps(constants.remaining1, g));
+    const __m256 square = _mm256_fmadd_ps(constants.beta2, _mm256_maskload_ps(squares + i, mask), _mm256_mul_ps(constants.remaining2, _mm256_mul_ps(g, g)));
+    const __m256 step = _mm256_div_ps(_mm256_mul_ps(constants.rate, moment), _mm256_add_ps(_mm256_sqrt_ps(square), constants.epsilon));
+
+    _mm256_maskstore_ps(moments + i, mask, moment);
+    _mm256_maskstore_ps(squares + i, mask, square);
+    _mm256_maskstore_ps(parameters + i, mask, _mm256_fmsub_ps(constants.keep, _mm256_maskload_ps(parameters + i, mask), step));
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+void adamAvx2(float* parameters, const float* gradients, float* moments, float* squares, std::size_t size, float scale, float rate, float beta1, float beta2, float epsilon, float keep)
+{
+    const AdamAvx2 constants{
+        _mm256_set1_ps(scale),
+        _mm256_set1_ps(rate),
+        _mm256_set1_ps(beta1),
+        _mm256_set1_ps(beta2),
+        _mm256_set1_ps(1.0f - beta1),
+        _mm256_set1_ps(1.0f - beta2),
+        _mm256_set1_ps(epsilon),
+        _mm256_set1_ps(keep)
+    };
+    const __m256i all = _mm256_set1_epi32(-1);
+
+    std::size_t i{ 0u };
+    for (; i + 8u <= size; i += 8u)
+    {
+        adamAvx2(parameters, gradients, moments, squares, i, all, constants);
+    }
+
+    if (i < size)
+    {
+        adamAvx2(parameters, gradients, moments, squares, i, getTailMask(size - i), constants);
+    }
+}
+
+bool hasAvx2Fma()
+{
+    static const bool has_avx2_fma = simdHasFma();
+
+    return has_avx2_fma;
+}
+
+#endif
+
+// Zero initialised on first use.
+float* getState(AlignedBuffer<float>& state, std::size_t size)
+{
+    if (state.size() != size)
+    {
+        state.clear();
+        state.resize(size, 0.0f);
+    }
+
+    return state.data();
+}
+
+} // namespace
+
+LearningRateSchedule createStepDecaySchedule(float factor, std::uint64_t step_size)
+{
+    return [factor, step_size](std::uint64_t step) {
+        if (step_size == 0u)
+        {
+            return 1.0f;
+        }
+
+        return std::pow(factor, (float)(step / step_size));
+    };
+}
+
+LearningRateSchedule createExponentialDecaySchedule(float decay)
+{
+    return [decay](std::uint64_t step) {
+        return std::pow(decay, (float)step);
+    };
+}
+
+LearningRateSchedule createCosineSchedule(std::uint64_t warmup_steps, std::uint64_t steps, float minimum_factor)
+{
+    return [warmup_steps, steps, minimum_factor](std::uint64_t step) {
+        if (step < warmup_steps)
+        {
+            return (float)(step + 1u) / (float)warmup_steps;
+        }
+        if (step >= steps)
+        {
+            return minimum_factor;
+        }
+
+        const float progress = (float)(step - warmup_steps) / (float)(steps - warmup_steps);
+
+        return minimum_factor + (1.0f - minimum_factor) * 0.5f * (1.0f + std::cos(std::numbers::pi_v<float> * progress));
+    };
+}
+
+void AOptimizer::beginStep()
+{
+    m_step++;
+}
+
+std::uint64_t AOptimizer::getStep() const
+{
+    return m_step;
+}
+
+void AOptimizer::reset()
+{
+    m_step = 0u;
+}
+
+void AOptimizer::setSchedule(LearningRateSchedule schedule)
+{
+    m_schedule = std::move(schedule);
+}
+
+float AOptimizer::getLearningRate(float learning_rate) const
+{
+    if (!m_schedule)
+    {
+        return learning_rate;
+    }
+
+    return learning_rate * m_schedule(m_step > 0u ? m_step - 1u : 0u);
+}
+
+SgdOptimizer::SgdOptimizer(float momentum) :
+    m_momentum{ momentum }
+{
+}
+
+void SgdOptimizer::update(std::span<float> parameters, std::span<const float> gradients, float gradient_scale, float learning_rate, OptimizerState& state)
+{
+    if (parameters.size() != gradients.size())
+    {
+        return;
+    }
+
+    const std::size_t size = parameters.size();
+
+    if (m_momentum == 0.0f)
+    {
+#if defined(PLAYGROUND_SSE2)
+        if (hasAvx2Fma())
+        {
+            sgdAvx2(parameters.data(), gradients.data(), size, gradient_scale, learning_rate);
+
+            return;
+        }
+#endif
+
+        sgdScalar(parameters.data(), gradients.data(), size, gradient_scale, learning_rate);
+
+        return;
+    }
+
+    float* velocities = getState(state.first, size);
+
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        momentumAvx2(parameters.data(), gradients.data(), velocities, size, gradient_scale, learning_rate, m_momentum);
+
+        return;
+    }
+#endif
+
+    momentumScalar(parameters.data(), gradients.data(), velocities, size, gradient_scale, learning_rate, m_momentum);
+}
+
+RmsPropOptimizer::RmsPropOptimizer(float decay, float epsilon) :
+    m_decay{ decay },
+    m_epsilon{ epsilon }
+{
+}
+
+void RmsPropOptimizer::update(std::span<float> parameters, std::span<const float> gradients, float gradient_scale, float learning_rate, OptimizerState& state)
+{
+    if (parameters.size() != gradients.size())
+    {
+        return;
+    }
+
+    const std::size_t size = parameters.size();
+
+    float* squares = getState(state.second, size);
+
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        rmsPropAvx2(parameters.data(), gradients.data(), squares, size, gradient_scale, learning_rate, m_decay, m_epsilon);
+
+        return;
+    }
+#endif
+
+    rmsPropScalar(parameters.data(), gradients.data(), squares, size, gradient_scale, learning_rate, m_decay, m_epsilon);
+}
+
+AdamOptimizer::AdamOptimizer(float beta1, float beta2, float epsilon, float weight_decay) :
+    m_beta1{ beta1 },
+    m_beta2{ beta2 },
+    m_epsilon{ epsilon },
+    m_weight_decay{ weight_decay }
+{
+}
+
+void AdamOptimizer::update(std::span<float> parameters, std::span<const float> gradients, float gradient_scale, float learning_rate, OptimizerState& state)
+{
+    if (parameters.size() != gradients.size())
+    {
+        return;
+    }
+
+    const std::size_t size = parameters.size();
+
+    float* moments = getState(state.first, size);
+    float* squares = getState(state.second, size);
+
+    // rate m / (1 - beta1^t) / (sqrt(v / (1 - beta2^t)) + epsilon) with the corrections taken out of the loop.
+    const float step = (float)std::max<std::uint64_t>(m_step, 1u);
+    const float correction1 = 1.0f - std::pow(m_beta1, step);
+    const float correction2 = std::sqrt(1.0f - std::pow(m_beta2, step));
+
+    const float rate = learning_rate * correction2 / correction1;
+    const float epsilon = m_epsilon * correction2;
+    const float keep = 1.0f - learning_rate * m_weight_decay;
+
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        adamAvx2(parameters.data(), gradients.data(), moments, squares, size, gradient_scale, rate, m_beta1, m_beta2, epsilon, keep);
+
+        return;
+    }
+#endif
+
+    adamScalar(parameters.data(), gradients.data(), moments, squares, size, gradient_scale, rate, m_beta1, m_beta2, epsilon, keep);
+}
+
+AdamWOptimizer::AdamWOptimizer() :
+    AdamOptimizer(0.9f, 0.999f, 1e-7f, 0.01f)
+{
+}
+
+AdamWOptimizer::AdamWOptimizer(float weight_decay) :
+    AdamOptimizer(0.9f, 0.999f, 1e-7f, weight_decay)
+{
+}
+
+AdamWOptimizer::AdamWOptimizer(float beta1, float beta2, float epsilon, float weight_decay) :
+    AdamOptimizer(beta1, beta2, epsilon, weight_decay)
+{
+}
@@ -0,0 +1,137 @@
+#ifndef CPU_AI_OPTIMIZER_H_
+#define CPU_AI_OPTIMIZER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "core/utility/AlignedBuffer.h"
+
+// Factor of the learning rate at a step, counted from zero.
+using LearningRateSchedule = std::function<float(std::uint64_t step)>;
+
+// Multiplies by factor every step_size steps.
+LearningRateSchedule createStepDecaySchedule(float factor, std::uint64_t step_size);
+
+// Multiplies by decay every step.
+LearningRateSchedule createExponentialDecaySchedule(float decay);
+
+// Rises linearly over the warmup steps, then falls along a cosine to minimum_factor at steps and stays there.
+LearningRateSchedule createCosineSchedule(std::uint64_t warmup_steps, std::uint64_t steps, float minimum_factor = 0.0f);
+
+// State of an optimizer for one array of parameters, laid out like the parameters.
+// Empty until the first update, zero initialised then.
+struct OptimizerState
+{
+    // Velocity or first moment.
+    AlignedBuffer<float> first{};
+    // Second moment.
+    AlignedBuffer<float> second{};
+};
+
+// Update rule of the training. An update reads the parameters, the gradients and the state in one vectorised pass.
+// The gradients times gradient_scale are the gradients of the loss, so e.g. a sum can be averaged on the fly.
+class AOptimizer
+{
+
+protected:
+
+    LearningRateSchedule m_schedule{ nullptr };
+
+    std::uint64_t m_step{ 0u };
+
+public:
+
+    AOptimizer() = default;
+
+    virtual ~AOptimizer() = default;
+
+    // Starts the next step, all updates until the next call belong to it.
+    void beginStep();
+
+    std::uint64_t getStep() const;
+
+    // Back to the first step. The states are owned by the caller and have to be cleared there.
+    void reset();
+
+    // nullptr keeps the learning rate constant.
+    void setSchedule(LearningRateSchedule schedule);
+
+    // The learning rate of the current step.
+    float getLearningRate(float learning_rate) const;
+
+    // parameters, gradients and the state must not overlap. Does nothing, if the sizes do not match.
+    virtual void update(std::span<float> parameters, std::span<const float> gradients, float gradient_scale, float learning_rate, OptimizerState& state) = 0;
+};
+
+// Stochastic gradient descent, with momentum as velocity = momentum * velocity + gradient. Plain without momentum.
+class SgdOptimizer : public AOptimizer
+{
+
+private:
+
+    float m_momentum{ 0.0f };
+
+public:
+
+    SgdOptimizer() = default;
+
+    explicit SgdOptimizer(float momentum);
+
+    void update(std::span<float> parameters, std::span<const float> gradients, float gradient_scale, float learning_rate, OptimizerState& state) override;
+};
+
+// Divides by the root of the running mean of the squared gradients.
+class RmsPropOptimizer : public AOptimizer
+{
+
+private:
+
+    float m_decay{ 0.9f };
+    float m_epsilon{ 1e-7f };
+
+public:
+
+    RmsPropOptimizer() = default;
+
+    RmsPropOptimizer(float decay, float epsilon);
+
+    void update(std::span<float> parameters, std::span<const float> gradients, float gradient_scale, float learning_rate, OptimizerState& state) override;
+};
+
+// Adam of Kingma and Ba, with bias corrected moments.
+// A weight decay other than zero is decoupled from the gradients, which makes it AdamW of Loshchilov and Hutter.
+class AdamOptimizer : public AOptimizer
+{
+
+private:
+
+    float m_beta1{ 0.9f };
+    float m_beta2{ 0.999f };
+    float m_epsilon{ 1e-7f };
+
+    float m_weight_decay{ 0.0f };
+
+public:
+
+    AdamOptimizer() = default;
+
+    AdamOptimizer(float beta1, float beta2, float epsilon, float weight_decay = 0.0f);
+
+    void update(std::span<float> parameters, std::span<const float> gradients, float gradient_scale, float learning_rate, OptimizerState& state) override;
+};
+
+class AdamWOptimizer : public AdamOptimizer
+{
+
+public:
+
+    AdamWOptimizer();
+
+    explicit AdamWOptimizer(float weight_decay);
+
+    AdamWOptimizer(float beta1, float beta2, float epsilon, float weight_decay);
+};
+
+#endif /* CPU_AI_OPTIMIZER_H_ */
@@ -1,6 +1,14 @@
 #include "activation_functions.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+
+#include "core/utility/simd.h"
+
+#if defined(PLAYGROUND_SSE2)
+#include <immintrin.h>
+#endif
 
 float identity(float x)
 {
@@ -139,3 +147,454 @@ float gaussianErrorLinearUnitDerivative(float x)
     float tanh_derivative{ sqrt_2_over_pi * (1.0f + 3.0f * coeff * x_squared) * sech_squared };
     return 0.5f * (1.0f + tanh_val) + 0.5f * x * tanh_derivative;
 }
+
+namespace
+{
+
+// Scalar, the functions above
+
+template <Activation ACTIVATION>
+float function(float x)
+{
+    if constexpr (ACTIVATION == Activation::IDENTITY)
+    {
+        return identity(x);
+    }
+    else if constexpr (ACTIVATION == Activation::BINARY_STEP)
+    {
+        return binaryStep(x);
+    }
+    else if constexpr (ACTIVATION == Activation::SIGMOID)
+    {
+        return sigmoid(x);
+    }
+    else if constexpr (ACTIVATION == Activation::HYPERBOLIC_TANGENT)
+    {
+        return hyperbolicTangent(x);
+    }
+    else if constexpr (ACTIVATION == Activation::RECTIFIED_LINEAR_UNIT)
+    {
+        return rectifiedLinearUnit(x);
+    }
+    else if constexpr (ACTIVATION == Activation::LEAKY_RECTIFIED_LINEAR_UNIT)
+    {
+        return leakyRectifiedLinearUnit(x);
+    }
+    else if constexpr (ACTIVATION == Activation::EXPONENTIAL_LINEAR_UNIT)
+    {
+        return exponentialLinearUnit(x);
+    }
+    else if constexpr (ACTIVATION == Activation::SWISH)
+    {
+        return swish(x);
+    }
+    else
+    {
+        return gaussianErrorLinearUnit(x);
+    }
+}
+
+template <Activation ACTIVATION>
+float derivative(float x)
+{
+    if constexpr (ACTIVATION == Activation::IDENTITY)
+    {
+        return identityDerivative(x);
+    }
+    else if constexpr (ACTIVATION == Activation::BINARY_STEP)
+    {
+        return binaryStepDerivative(x);
+    }
+    else if constexpr (ACTIVATION == Activation::SIGMOID)
+    {
+        return sigmoidDerivative(x);
+    }
+    else if constexpr (ACTIVATION == Activation::HYPERBOLIC_TANGENT)
+    {
+        return hyperbolicTangentDerivative(x);
+    }
+    else if constexpr (ACTIVATION == Activation::RECTIFIED_LINEAR_UNIT)
+    {
+        return rectifiedLinearUnitDerivative(x);
+    }
+    else if constexpr (ACTIVATION == Activation::LEAKY_RECTIFIED_LINEAR_UNIT)
+    {
+        return leakyRectifiedLinearUnitDerivative(x);
+    }
+    else if constexpr (ACTIVATION == Activation::EXPONENTIAL_LINEAR_UNIT)
+    {
+        return exponentialLinearUnitDerivative(x);
+    }
+    else if constexpr (ACTIVATION == Activation::SWISH)
+    {
+        return swishDerivative(x);
+    }
+    else
+    {
+        return gaussianErrorLinearUnitDerivative(x);
+    }
+}
+
+template <Activation ACTIVATION>
+void activateScalar(float* values, std::size_t size)
+{
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        values[i] = function<ACTIVATION>(values[i]);
+    }
+}
+
+template <Activation ACTIVATION>
+void multiplyDerivativeScalar(const float* outputs, float* deltas, std::size_t size)
+{
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        deltas[i] *= derivative<ACTIVATION>(outputs[i]);
+    }
+}
+
+#if defined(PLAYGROUND_SSE2)
+
+// AVX2 and FMA, eight lanes
+
+// x = n ln(2) + r with |r| <= ln(2) / 2, so e^x = 2^n e^r. Returns 2^n and e^r - 1, the latter as the polynomial of
+// Cephes' expf. The range is clamped, so 2^n stays a normal float.
+PLAYGROUND_TARGET("avx2,fma")
+__m256 reduceExponentialAvx2(__m256 x, __m256& scale)
+{
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-87.0f)), _mm256_set1_ps(88.0f));
+
+    const __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504089f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+    // ln(2) in two parts, so n ln(2) is subtracted without rounding error.
+    __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), x);
+    r = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), r);
+
+    __m256 p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201e-1f));
+
+    scale = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23));
+
+    return _mm256_fmadd_ps(_mm256_mul_ps(p, r), r, r);
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+__m256 exponentialAvx2(__m256 x)
+{
+    __m256 scale;
+    const __m256 q = reduceExponentialAvx2(x, scale);
+
+    return _mm256_fmadd_ps(scale, q, scale);
+}
+
+// e^x - 1 = 2^n (e^r - 1) + 2^n - 1, which is exact for n = 0, so small x keep their precision.
+PLAYGROUND_TARGET("avx2,fma")
+__m256 exponentialMinusOneAvx2(__m256 x)
+{
+    __m256 scale;
+    const __m256 q = reduceExponentialAvx2(x, scale);
+
+    return _mm256_fmadd_ps(scale, q, _mm256_sub_ps(scale, _mm256_set1_ps(1.0f)));
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+__m256 sigmoidAvx2(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    return _mm256_div_ps(one, _mm256_add_ps(one, exponentialAvx2(_mm256_sub_ps(_mm256_setzero_ps(), x))));
+}
+
+// Odd polynomial of Cephes' tanhf below 0.625, otherwise 1 - 2 / (e^2|x| + 1) with the sign of x.
+PLAYGROUND_TARGET("avx2,fma")
+__m256 hyperbolicTangentAvx2(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+
+    const __m256 magnitude = _mm256_andnot_ps(sign_mask, x);
+
+    const __m256 x_squared = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+    p = _mm256_fmadd_ps(p, x_squared, _mm256_set1_ps(2.06390887954e-2f));
+    p = _mm256_fmadd_ps(p, x_squared, _mm256_set1_ps(-5.37397155531e-2f));
+    p = _mm256_fmadd_ps(p, x_squared, _mm256_set1_ps(1.33314422036e-1f));
+    p = _mm256_fmadd_ps(p, x_squared, _mm256_set1_ps(-3.33332819422e-1f));
+    const __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, x_squared), x, x);
+
+    const __m256 e = exponentialAvx2(_mm256_add_ps(magnitude, magnitude));
+    const __m256 large = _mm256_or_ps(_mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, one))), _mm256_and_ps(sign_mask, x));
+
+    return _mm256_blendv_ps(large, small, _mm256_cmp_ps(magnitude, _mm256_set1_ps(0.625f), _CMP_LT_OQ));
+}
+
+template <Activation ACTIVATION>
+PLAYGROUND_TARGET("avx2,fma")
+__m256 functionAvx2(__m256 x)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    if constexpr (ACTIVATION == Activation::IDENTITY)
+    {
+        return x;
+    }
+    else if constexpr (ACTIVATION == Activation::BINARY_STEP)
+    {
+        return _mm256_blendv_ps(one, zero, _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    }
+    else if constexpr (ACTIVATION == Activation::SIGMOID)
+    {
+        return sigmoidAvx2(x);
+    }
+    else if constexpr (ACTIVATION == Activation::HYPERBOLIC_TANGENT)
+    {
+        return hyperbolicTangentAvx2(x);
+    }
+    else if constexpr (ACTIVATION == Activation::RECTIFIED_LINEAR_UNIT)
+    {
+        return _mm256_blendv_ps(x, zero, _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    }
+    else if constexpr (ACTIVATION == Activation::LEAKY_RECTIFIED_LINEAR_UNIT)
+    {
+        return _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(0.01f)), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    }
+    else if constexpr (ACTIVATION == Activation::EXPONENTIAL_LINEAR_UNIT)
+    {
+        return _mm256_blendv_ps(x, exponentialMinusOneAvx2(x), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+    }
+    else if constexpr (ACTIVATION == Activation::SWISH)
+    {
+        return _mm256_mul_ps(x, sigmoidAvx2(x));
+    }
+    else
+    {
+        const __m256 x_cubed = _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+        const __m256 tanh_arg = _mm256_mul_ps(_mm256_set1_ps(0.7978845608f), _mm256_fmadd_ps(_mm256_set1_ps(0.044715f), x_cubed, x));
+
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), _mm256_add_ps(one, hyperbolicTangentAvx2(tanh_arg)));
+    }
+}
+
+template <Activation ACTIVATION>
+PLAYGROUND_TARGET("avx2,fma")
+__m256 derivativeAvx2(__m256 x)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    if constexpr (ACTIVATION == Activation::IDENTITY)
+    {
+        return one;
+    }
+    else if constexpr (ACTIVATION == Activation::BINARY_STEP)
+    {
+        return zero;
+    }
+    else if constexpr (ACTIVATION == Activation::SIGMOID)
+    {
+        return _mm256_mul_ps(x, _mm256_sub_ps(one, x));
+    }
+    else if constexpr (ACTIVATION == Activation::HYPERBOLIC_TANGENT)
+    {
+        return _mm256_fnmadd_ps(x, x, one);
+    }
+    else if constexpr (ACTIVATION == Activation::RECTIFIED_LINEAR_UNIT)
+    {
+        return _mm256_blendv_ps(one, zero, _mm256_cmp_ps(x, zero, _CMP_LE_OQ));
+    }
+    else if constexpr (ACTIVATION == Activation::LEAKY_RECTIFIED_LINEAR_UNIT)
+    {
+        return _mm256_blendv_ps(one, _mm256_set1_ps(0.01f), _mm256_cmp_ps(x, zero, _CMP_LE_OQ));
+    }
+    else if constexpr (ACTIVATION == Activation::EXPONENTIAL_LINEAR_UNIT)
+    {
+        return _mm256_blendv_ps(one, _mm256_add_ps(x, one), _mm256_cmp_ps(x, zero, _CMP_LE_OQ));
+    }
+    else if constexpr (ACTIVATION == Activation::SWISH)
+    {
+        const __m256 sigmoid_x = sigmoidAvx2(x);
+
+        return _mm256_fmadd_ps(_mm256_mul_ps(x, sigmoid_x), _mm256_sub_ps(one, sigmoid_x), sigmoid_x);
+    }
+    else
+    {
+        const __m256 sqrt_2_over_pi = _mm256_set1_ps(0.7978845608f);
+        const __m256 coeff = _mm256_set1_ps(0.044715f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+
+        const __m256 x_squared = _mm256_mul_ps(x, x);
+        const __m256 tanh_arg = _mm256_mul_ps(sqrt_2_over_pi, _mm256_fmadd_ps(coeff, _mm256_mul_ps(x_squared, x), x));
+        const __m256 tanh_val = hyperbolicTangentAvx2(tanh_arg);
+        const __m256 sech_squared = _mm256_fnmadd_ps(tanh_val, tanh_val, one);
+        const __m256 tanh_derivative = _mm256_mul_ps(_mm256_mul_ps(sqrt_2_over_pi, _mm256_fmadd_ps(_mm256_mul_ps(_mm256_set1_ps(3.0f), coeff), x_squared, one)), sech_squared);
+
+        return _mm256_fmadd_ps(_mm256_mul_ps(half, x), tanh_derivative, _mm256_mul_ps(half, _mm256_add_ps(one, tanh_val)));
+    }
+}
+
+// The tail goes through a zero padded vector, so all values get the same approximation.
+template <Activation ACTIVATION>
+PLAYGROUND_TARGET("avx2,fma")
+void activateAvx2(float* values, std::size_t size)
+{
+    std::size_t i{ 0u };
+    for (; i + 8u <= size; i += 8u)
+    {
+        _mm256_storeu_ps(values + i, functionAvx2<ACTIVATION>(_mm256_loadu_ps(values + i)));
+    }
+
+    if (i < size)
+    {
+        float lanes[8]{};
+        std::copy(values + i, values + size, lanes);
+        _mm256_storeu_ps(lanes, functionAvx2<ACTIVATION>(_mm256_loadu_ps(lanes)));
+        std::copy(lanes, lanes + (size - i), values + i);
+    }
+}
+
+template <Activation ACTIVATION>
+PLAYGROUND_TARGET("avx2,fma")
+void multiplyDerivativeAvx2(const float* outputs, float* deltas, std::size_t size)
+{
+    std::size_t i{ 0u };
+    for (; i + 8u <= size; i += 8u)
+    {
+        _mm256_storeu_ps(deltas + i, _mm256_mul_ps(_mm256_loadu_ps(deltas + i), derivativeAvx2<ACTIVATION>(_mm256_loadu_ps(outputs + i))));
+    }
+
+    if (i < size)
+    {
+        float lanes[8]{};
+        std::copy(outputs + i, outputs + size, lanes);
+        _mm256_storeu_ps(lanes, derivativeAvx2<ACTIVATION>(_mm256_loadu_ps(lanes)));
+        for (std::size_t lane = 0u; lane < size - i; lane++)
+        {
+            deltas[i + lane] *= lanes[lane];
+        }
+    }
+}
+
+bool hasAvx2Fma()
+{
+    static const bool has_avx2_fma = simdHasFma();
+
+    return has_avx2_fma;
+}
+
+#endif
+
+template <Activation ACTIVATION>
+void activateSpan(std::span<float> values)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        activateAvx2<ACTIVATION>(values.data(), values.size());
+
+        return;
+    }
+#endif
+
+    activateScalar<ACTIVATION>(values.data(), values.size());
+}
+
+template <Activation ACTIVATION>
+void multiplyDerivativeSpan(std::span<const float> outputs, std::span<float> deltas)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        multiplyDerivativeAvx2<ACTIVATION>(outputs.data(), deltas.data(), deltas.size());
+
+        return;
+    }
+#endif
+
+    multiplyDerivativeScalar<ACTIVATION>(outputs.data(), deltas.data(), deltas.size());
+}
+
+} // namespace
+
+bool activate(Activation activation, std::span<float> values)
+{
+    switch (activation)
+    {
+        case Activation::IDENTITY:
+            break;
+        case Activation::BINARY_STEP:
+            activateSpan<Activation::BINARY_STEP>(values);
+            break;
+        case Activation::SIGMOID:
+            activateSpan<Activation::SIGMOID>(values);
+            break;
+        case Activation::HYPERBOLIC_TANGENT:
+            activateSpan<Activation::HYPERBOLIC_TANGENT>(values);
+            break;
+        case Activation::RECTIFIED_LINEAR_UNIT:
+            activateSpan<Activation::RECTIFIED_LINEAR_UNIT>(values);
+            break;
+        case Activation::LEAKY_RECTIFIED_LINEAR_UNIT:
+            activateSpan<Activation::LEAKY_RECTIFIED_LINEAR_UNIT>(values);
+            break;
+        case Activation::EXPONENTIAL_LINEAR_UNIT:
+            activateSpan<Activation::EXPONENTIAL_LINEAR_UNIT>(values);
+            break;
+        case Activation::SWISH:
+            activateSpan<Activation::SWISH>(values);
+            break;
+        case Activation::GAUSSIAN_ERROR_LINEAR_UNIT:
+            activateSpan<Activation::GAUSSIAN_ERROR_LINEAR_UNIT>(values);
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+bool multiplyDerivative(Activation activation, std::span<const float> outputs, std::span<float> deltas)
+{
+    if (outputs.size() != deltas.size())
+    {
+        return false;
+    }
+
+    switch (activation)
+    {
+        case Activation::IDENTITY:
+            break;
+        case Activation::BINARY_STEP:
+            multiplyDerivativeSpan<Activation::BINARY_STEP>(outputs, deltas);
+            break;
+        case Activation::SIGMOID:
+            multiplyDerivativeSpan<Activation::SIGMOID>(outputs, deltas);
+            break;
+        case Activation::HYPERBOLIC_TANGENT:
+            multiplyDerivativeSpan<Activation::HYPERBOLIC_TANGENT>(outputs, deltas);
+            break;
+        case Activation::RECTIFIED_LINEAR_UNIT:
+            multiplyDerivativeSpan<Activation::RECTIFIED_LINEAR_UNIT>(outputs, deltas);
+            break;
+        case Activation::LEAKY_RECTIFIED_LINEAR_UNIT:
+            multiplyDerivativeSpan<Activation::LEAKY_RECTIFIED_LINEAR_UNIT>(outputs, deltas);
+            break;
+        case Activation::EXPONENTIAL_LINEAR_UNIT:
+            multiplyDerivativeSpan<Activation::EXPONENTIAL_LINEAR_UNIT>(outputs, deltas);
+            break;
+        case Activation::SWISH:
+            multiplyDerivativeSpan<Activation::SWISH>(outputs, deltas);
+            break;
+        case Activation::GAUSSIAN_ERROR_LINEAR_UNIT:
+            multiplyDerivativeSpan<Activation::GAUSSIAN_ERROR_LINEAR_UNIT>(outputs, deltas);
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
@@ -1,6 +1,7 @@
 #ifndef CPU_AI_ACTIVATIONFUNCTIONS_H_
 #define CPU_AI_ACTIVATIONFUNCTIONS_H_
 
+#include <span>
 #include <vector>
 
 // Only supporting one fold x
@@ -39,4 +40,28 @@ float swishDerivative(float x);
 float gaussianErrorLinearUnit(float x);
 float gaussianErrorLinearUnitDerivative(float x);
 
+// The functions above, applied to whole spans at once
+
+enum class Activation
+{
+    CUSTOM, // none of the below, has no span version
+    IDENTITY,
+    BINARY_STEP,
+    SIGMOID,
+    HYPERBOLIC_TANGENT,
+    RECTIFIED_LINEAR_UNIT,
+    LEAKY_RECTIFIED_LINEAR_UNIT,
+    EXPONENTIAL_LINEAR_UNIT,
+    SWISH,
+    GAUSSIAN_ERROR_LINEAR_UNIT
+};
+
+// values = f(values). With AVX2 and FMA vectorised, using approximations of exp and tanh within a few ulp.
+// Fails for Activation::CUSTOM.
+bool activate(Activation activation, std::span<float> values);
+
+// deltas *= f'(outputs), with the derivatives above taking the outputs of the activation as their argument.
+// Fails for Activation::CUSTOM or different sizes.
+bool multiplyDerivative(Activation activation, std::span<const float> outputs, std::span<float> deltas);
+
 #endif /* CPU_AI_ACTIVATIONFUNCTIONS_H_ */
@@ -0,0 +1,644 @@
+#include "matrix_kernels.h"
+
+#include <algorithm>
+
+#include "core/utility/simd.h"
+
+#if defined(PLAYGROUND_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+// Portable, four lanes
+
+float horizontalSum(SimdFloat4 value)
+{
+    float lanes[4];
+    simdStore(lanes, value);
+
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+void gemvFloat4(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y)
+{
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        const float* row = a + r * stride;
+
+        SimdFloat4 sum = simdSet(0.0f);
+
+        std::size_t c{ 0u };
+        for (; c + 4u <= columns; c += 4u)
+        {
+            sum = simdAdd(sum, simdMul(simdLoad(row + c), simdLoad(x + c)));
+        }
+
+        float result = horizontalSum(sum);
+        for (; c < columns; c++)
+        {
+            result += row[c] * x[c];
+        }
+
+        y[r] = result;
+    }
+}
+
+void gemvTransposedFloat4(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y)
+{
+    for (std::size_t c = 0u; c < columns; c++)
+    {
+        y[c] = 0.0f;
+    }
+
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        const float* row = a + r * stride;
+
+        std::size_t c{ 0u };
+        for (; c + 4u <= columns; c += 4u)
+        {
+            simdStore(y + c, simdMulAdd(simdLoad(y + c), simdLoad(row + c), x[r]));
+        }
+        for (; c < columns; c++)
+        {
+            y[c] += row[c] * x[r];
+        }
+    }
+}
+
+void gerFloat4(float* a, std::size_t rows, std::size_t columns, std::size_t stride, float alpha, const float* x, const float* y)
+{
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        float* row = a + r * stride;
+        const float scale = alpha * x[r];
+
+        std::size_t c{ 0u };
+        for (; c + 4u <= columns; c += 4u)
+        {
+            simdStore(row + c, simdMulAdd(simdLoad(row + c), simdLoad(y + c), scale));
+        }
+        for (; c < columns; c++)
+        {
+            row[c] += scale * y[c];
+        }
+    }
+}
+
+void axpyFloat4(std::size_t size, float alpha, const float* x, float* y)
+{
+    std::size_t i{ 0u };
+    for (; i + 4u <= size; i += 4u)
+    {
+        simdStore(y + i, simdMulAdd(simdLoad(y + i), simdLoad(x + i), alpha));
+    }
+    for (; i < size; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+void clear(std::size_t m, std::size_t n, float* c, std::size_t stride_c)
+{
+    for (std::size_t r = 0u; r < m; r++)
+    {
+        std::fill(c + r * stride_c, c + r * stride_c + n, 0.0f);
+    }
+}
+
+// Element (r, p) of A is a[r * step_row + p * step_depth], which covers A and A^T.
+void gemmFloat4(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t step_row, std::size_t step_depth, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+    clear(m, n, c, stride_c);
+
+    for (std::size_t r = 0u; r < m; r++)
+    {
+        for (std::size_t p = 0u; p < k; p++)
+        {
+            axpyFloat4(n, a[r * step_row + p * step_depth], b + p * stride_b, c + r * stride_c);
+        }
+    }
+}
+
+void gemmTransposedBFloat4(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+    for (std::size_t r = 0u; r < m; r++)
+    {
+        gemvFloat4(b, n, k, stride_b, a + r * stride_a, c + r * stride_c);
+    }
+}
+
+#if defined(PLAYGROUND_SSE2)
+
+// AVX2 and FMA, eight lanes
+
+PLAYGROUND_TARGET("avx2,fma")
+float horizontalSum(__m256 value)
+{
+    const __m128 sum = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+    const __m128 pairs = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+// Four rows at once, so every load of x is used four times.
+PLAYGROUND_TARGET("avx2,fma")
+void gemvAvx2(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y)
+{
+    std::size_t r{ 0u };
+    for (; r + 4u <= rows; r += 4u)
+    {
+        const float* row0 = a + r * stride;
+        const float* row1 = row0 + stride;
+        const float* row2 = row1 + stride;
+        const float* row3 = row2 + stride;
+
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps();
+        __m256 sum3 = _mm256_setzero_ps();
+
+        std::size_t c{ 0u };
+        for (; c + 8u <= columns; c += 8u)
+        {
+            const __m256 input = _mm256_loadu_ps(x + c);
+
+            sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(row0 + c), input, sum0);
+            sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(row1 + c), input, sum1);
+            sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(row2 + c), input, sum2);
+            sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(row3 + c), input, sum3);
+        }
+
+        float result0 = horizontalSum(sum0);
+        float result1 = horizontalSum(sum1);
+        float result2 = horizontalSum(sum2);
+        float result3 = horizontalSum(sum3);
+        for (; c < columns; c++)
+        {
+            result0 += row0[c] * x[c];
+            result1 += row1[c] * x[c];
+            result2 += row2[c] * x[c];
+            result3 += row3[c] * x[c];
+        }
+
+        y[r] = result0;
+        y[r + 1u] = result1;
+        y[r + 2u] = result2;
+        y[r + 3u] = result3;
+    }
+
+    for (; r < rows; r++)
+    {
+        const float* row = a + r * stride;
+
+        __m256 sum = _mm256_setzero_ps();
+
+        std::size_t c{ 0u };
+        for (; c + 8u <= columns; c += 8u)
+        {
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(row + c), _mm256_loadu_ps(x + c), sum);
+        }
+
+        float result = horizontalSum(sum);
+        for (; c < columns; c++)
+        {
+            result += row[c] * x[c];
+        }
+
+        y[r] = result;
+    }
+}
+
+// Four rows per pass over y, so y is loaded and stored a quarter as often.
+PLAYGROUND_TARGET("avx2,fma")
+void gemvTransposedAvx2(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y)
+{
+    for (std::size_t c = 0u; c < columns; c++)
+    {
+        y[c] = 0.0f;
+    }
+
+    std::size_t r{ 0u };
+    for (; r + 4u <= rows; r += 4u)
+    {
+        const float* row0 = a + r * stride;
+        const float* row1 = row0 + stride;
+        const float* row2 = row1 + stride;
+        const float* row3 = row2 + stride;
+
+        const __m256 scale0 = _mm256_set1_ps(x[r]);
+        const __m256 scale1 = _mm256_set1_ps(x[r + 1u]);
+        const __m256 scale2 = _mm256_set1_ps(x[r + 2u]);
+        const __m256 scale3 = _mm256_set1_ps(x[r + 3u]);
+
+        std::size_t c{ 0u };
+        for (; c + 8u <= columns; c += 8u)
+        {
+            __m256 sum = _mm256_loadu_ps(y + c);
+
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(row0 + c), scale0, sum);
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(row1 + c), scale1, sum);
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(row2 + c), scale2, sum);
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(row3 + c), scale3, sum);
+
+            _mm256_storeu_ps(y + c, sum);
+        }
+        for (; c < columns; c++)
+        {
+            y[c] += row0[c] * x[r] + row1[c] * x[r + 1u] + row2[c] * x[r + 2u] + row3[c] * x[r + 3u];
+        }
+    }
+
+    for (; r < rows; r++)
+    {
+        const float* row = a + r * stride;
+        const __m256 scale = _mm256_set1_ps(x[r]);
+
+        std::size_t c{ 0u };
+        for (; c + 8u <= columns; c += 8u)
+        {
+            _mm256_storeu_ps(y + c, _mm256_fmadd_ps(_mm256_loadu_ps(row + c), scale, _mm256_loadu_ps(y + c)));
+        }
+        for (; c < columns; c++)
+        {
+            y[c] += row[c] * x[r];
+        }
+    }
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+void gerAvx2(float* a, std::size_t rows, std::size_t columns, std::size_t stride, float alpha, const float* x, const float* y)
+{
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        float* row = a + r * stride;
+        const float scale = alpha * x[r];
+        const __m256 scale_vector = _mm256_set1_ps(scale);
+
+        std::size_t c{ 0u };
+        for (; c + 8u <= columns; c += 8u)
+        {
+            _mm256_storeu_ps(row + c, _mm256_fmadd_ps(_mm256_loadu_ps(y + c), scale_vector, _mm256_loadu_ps(row + c)));
+        }
+        for (; c < columns; c++)
+        {
+            row[c] += scale * y[c];
+        }
+    }
+}
+
+PLAYGROUND_TARGET("avx2,fma")
+void axpyAvx2(std::size_t size, float alpha, const float* x, float* y)
+{
+    const __m256 scale = _mm256_set1_ps(alpha);
+
+    std::size_t i{ 0u };
+    for (; i + 8u <= size; i += 8u)
+    {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(_mm256_loadu_ps(x + i), scale, _mm256_loadu_ps(y + i)));
+    }
+    for (; i < size; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+// Six rows of A times 16 columns of B, which keeps 12 of the 16 registers as accumulators.
+// Every loaded row of B is used six times, every broadcast element of A twice.
+PLAYGROUND_TARGET("avx2,fma")
+void gemmTileAvx2(std::size_t k, const float* a, std::size_t step_row, std::size_t step_depth, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+    float* row0 = c;
+    float* row1 = row0 + stride_c;
+    float* row2 = row1 + stride_c;
+    float* row3 = row2 + stride_c;
+    float* row4 = row3 + stride_c;
+    float* row5 = row4 + stride_c;
+
+    __m256 sum00 = _mm256_loadu_ps(row0);
+    __m256 sum01 = _mm256_loadu_ps(row0 + 8u);
+    __m256 sum10 = _mm256_loadu_ps(row1);
+    __m256 sum11 = _mm256_loadu_ps(row1 + 8u);
+    __m256 sum20 = _mm256_loadu_ps(row2);
+    __m256 sum21 = _mm256_loadu_ps(row2 + 8u);
+    __m256 sum30 = _mm256_loadu_ps(row3);
+    __m256 sum31 = _mm256_loadu_ps(row3 + 8u);
+    __m256 sum40 = _mm256_loadu_ps(row4);
+    __m256 sum41 = _mm256_loadu_ps(row4 + 8u);
+    __m256 sum50 = _mm256_loadu_ps(row5);
+    __m256 sum51 = _mm256_loadu_ps(row5 + 8u);
+
+    for (std::size_t p = 0u; p < k; p++)
+    {
+        const float* depth = a + p * step_depth;
+        const __m256 column0 = _mm256_loadu_ps(b + p * stride_b);
+        const __m256 column1 = _mm256_loadu_ps(b + p * stride_b + 8u);
+
+        __m256 scale = _mm256_broadcast_ss(depth);
+        sum00 = _mm256_fmadd_ps(scale, column0, sum00);
+        sum01 = _mm256_fmadd_ps(scale, column1, sum01);
+
+        scale = _mm256_broadcast_ss(depth + step_row);
+        sum10 = _mm256_fmadd_ps(scale, column0, sum10);
+        sum11 = _mm256_fmadd_ps(scale, column1, sum11);
+
+        scale = _mm256_broadcast_ss(depth + 2u * step_row);
+        sum20 = _mm256_fmadd_ps(scale, column0, sum20);
+        sum21 = _mm256_fmadd_ps(scale, column1, sum21);
+
+        scale = _mm256_broadcast_ss(depth + 3u * step_row);
+        sum30 = _mm256_fmadd_ps(scale, column0, sum30);
+        sum31 = _mm256_fmadd_ps(scale, column1, sum31);
+
+        scale = _mm256_broadcast_ss(depth + 4u * step_row);
+        sum40 = _mm256_fmadd_ps(scale, column0, sum40);
+        sum41 = _mm256_fmadd_ps(scale, column1, sum41);
+
+        scale = _mm256_broadcast_ss(depth + 5u * step_row);
+        sum50 = _mm256_fmadd_ps(scale, column0, sum50);
+        sum51 = _mm256_fmadd_ps(scale, column1, sum51);
+    }
+
+    _mm256_storeu_ps(row0, sum00);
+    _mm256_storeu_ps(row0 + 8u, sum01);
+    _mm256_storeu_ps(row1, sum10);
+    _mm256_storeu_ps(row1 + 8u, sum11);
+    _mm256_storeu_ps(row2, sum20);
+    _mm256_storeu_ps(row2 + 8u, sum21);
+    _mm256_storeu_ps(row3, sum30);
+    _mm256_storeu_ps(row3 + 8u, sum31);
+    _mm256_storeu_ps(row4, sum40);
+    _mm256_storeu_ps(row4 + 8u, sum41);
+    _mm256_storeu_ps(row5, sum50);
+    _mm256_storeu_ps(row5 + 8u, sum51);
+}
+
+// Remaining rows of C and columns right of the last full tile.
+PLAYGROUND_TARGET("avx2,fma")
+void gemmEdgeAvx2(std::size_t rows, std::size_t columns, std::size_t k, const float* a, std::size_t step_row, std::size_t step_depth, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        float* row = c + r * stride_c;
+
+        for (std::size_t p = 0u; p < k; p++)
+        {
+            const float scale = a[r * step_row + p * step_depth];
+            const float* depth = b + p * stride_b;
+            const __m256 scale_vector = _mm256_set1_ps(scale);
+
+            std::size_t column{ 0u };
+            for (; column + 8u <= columns; column += 8u)
+            {
+                _mm256_storeu_ps(row + column, _mm256_fmadd_ps(scale_vector, _mm256_loadu_ps(depth + column), _mm256_loadu_ps(row + column)));
+            }
+            for (; column < columns; column++)
+            {
+                row[column] += scale * depth[column];
+            }
+        }
+    }
+}
+
+// Depth blocks of GEMM_DEPTH rows of B, and within those panels of GEMM_PANEL columns, which stay in the L1 cache
+// while all rows of A pass by.
+constexpr std::size_t GEMM_DEPTH{ 256u };
+constexpr std::size_t GEMM_PANEL{ 16u };
+constexpr std::size_t GEMM_ROWS{ 6u };
+
+PLAYGROUND_TARGET("avx2,fma")
+void gemmAvx2(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t step_row, std::size_t step_depth, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+    clear(m, n, c, stride_c);
+
+    const std::size_t tile_rows = m - m % GEMM_ROWS;
+    const std::size_t tile_columns = n - n % GEMM_PANEL;
+
+    for (std::size_t depth = 0u; depth < k; depth += GEMM_DEPTH)
+    {
+        const std::size_t depth_size = std::min(GEMM_DEPTH, k - depth);
+        const float* a_block = a + depth * step_depth;
+        const float* b_block = b + depth * stride_b;
+
+        for (std::size_t column = 0u; column < tile_columns; column += GEMM_PANEL)
+        {
+            for (std::size_t r = 0u; r < tile_rows; r += GEMM_ROWS)
+            {
+                gemmTileAvx2(depth_size, a_block + r * step_row, step_row, step_depth, b_block + column, stride_b, c + r * stride_c + column, stride_c);
+            }
+        }
+
+        gemmEdgeAvx2(tile_rows, n - tile_columns, depth_size, a_block, step_row, step_depth, b_block + tile_columns, stride_b, c + tile_columns, stride_c);
+        gemmEdgeAvx2(m - tile_rows, n, depth_size, a_block + tile_rows * step_row, step_row, step_depth, b_block, stride_b, c + tile_rows * stride_c, stride_c);
+    }
+}
+
+// Two rows of A against four rows of B, as dot products along k. Every load is used two or four times.
+PLAYGROUND_TARGET("avx2,fma")
+void dotTileAvx2(std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+    const float* a0 = a;
+    const float* a1 = a0 + stride_a;
+    const float* b0 = b;
+    const float* b1 = b0 + stride_b;
+    const float* b2 = b1 + stride_b;
+    const float* b3 = b2 + stride_b;
+
+    __m256 sum00 = _mm256_setzero_ps();
+    __m256 sum01 = _mm256_setzero_ps();
+    __m256 sum02 = _mm256_setzero_ps();
+    __m256 sum03 = _mm256_setzero_ps();
+    __m256 sum10 = _mm256_setzero_ps();
+    __m256 sum11 = _mm256_setzero_ps();
+    __m256 sum12 = _mm256_setzero_ps();
+    __m256 sum13 = _mm256_setzero_ps();
+
+    std::size_t p{ 0u };
+    for (; p + 8u <= k; p += 8u)
+    {
+        const __m256 row0 = _mm256_loadu_ps(a0 + p);
+        const __m256 row1 = _mm256_loadu_ps(a1 + p);
+
+        __m256 values = _mm256_loadu_ps(b0 + p);
+        sum00 = _mm256_fmadd_ps(row0, values, sum00);
+        sum10 = _mm256_fmadd_ps(row1, values, sum10);
+
+        values = _mm256_loadu_ps(b1 + p);
+        sum01 = _mm256_fmadd_ps(row0, values, sum01);
+        sum11 = _mm256_fmadd_ps(row1, values, sum11);
+
+        values = _mm256_loadu_ps(b2 + p);
+        sum02 = _mm256_fmadd_ps(row0, values, sum02);
+        sum12 = _mm256_fmadd_ps(row1, values, sum12);
+
+        values = _mm256_loadu_ps(b3 + p);
+        sum03 = _mm256_fmadd_ps(row0, values, sum03);
+        sum13 = _mm256_fmadd_ps(row1, values, sum13);
+    }
+
+    float results[8]{ horizontalSum(sum00), horizontalSum(sum01), horizontalSum(sum02), horizontalSum(sum03), horizontalSum(sum10), horizontalSum(sum11), horizontalSum(sum12), horizontalSum(sum13) };
+    for (; p < k; p++)
+    {
+        results[0] += a0[p] * b0[p];
+        results[1] += a0[p] * b1[p];
+        results[2] += a0[p] * b2[p];
+        results[3] += a0[p] * b3[p];
+        results[4] += a1[p] * b0[p];
+        results[5] += a1[p] * b1[p];
+        results[6] += a1[p] * b2[p];
+        results[7] += a1[p] * b3[p];
+    }
+
+    for (std::size_t column = 0u; column < 4u; column++)
+    {
+        c[column] = results[column];
+        c[stride_c + column] = results[4u + column];
+    }
+}
+
+// Blocks of GEMM_BLOCK rows of A, so they stay in the L2 cache while the rows of B pass by four at a time.
+constexpr std::size_t GEMM_BLOCK{ 64u };
+
+PLAYGROUND_TARGET("avx2,fma")
+void gemmTransposedBAvx2(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+    const std::size_t tile_columns = n & ~(std::size_t)3u;
+
+    for (std::size_t block = 0u; block < m; block += GEMM_BLOCK)
+    {
+        const std::size_t block_end = std::min(block + GEMM_BLOCK, m);
+        const std::size_t tile_end = block + ((block_end - block) & ~(std::size_t)1u);
+
+        for (std::size_t column = 0u; column < tile_columns; column += 4u)
+        {
+            for (std::size_t r = block; r < tile_end; r += 2u)
+            {
+                dotTileAvx2(k, a + r * stride_a, stride_a, b + column * stride_b, stride_b, c + r * stride_c + column, stride_c);
+            }
+        }
+
+        // A single row of A against the rows of B is a matrix vector product.
+        for (std::size_t r = block; r < block_end; r++)
+        {
+            if (r >= tile_end)
+            {
+                gemvAvx2(b, n, k, stride_b, a + r * stride_a, c + r * stride_c);
+            }
+            else if (tile_columns < n)
+            {
+                gemvAvx2(b + tile_columns * stride_b, n - tile_columns, k, stride_b, a + r * stride_a, c + r * stride_c + tile_columns);
+            }
+        }
+    }
+}
+
+bool hasAvx2Fma()
+{
+    static const bool has_avx2_fma = simdHasFma();
+
+    return has_avx2_fma;
+}
+
+#endif
+
+} // namespace
+
+void gemv(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        gemvAvx2(a, rows, columns, stride, x, y);
+
+        return;
+    }
+#endif
+
+    gemvFloat4(a, rows, columns, stride, x, y);
+}
+
+void gemvTransposed(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        gemvTransposedAvx2(a, rows, columns, stride, x, y);
+
+        return;
+    }
+#endif
+
+    gemvTransposedFloat4(a, rows, columns, stride, x, y);
+}
+
+void ger(float* a, std::size_t rows, std::size_t columns, std::size_t stride, float alpha, const float* x, const float* y)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        gerAvx2(a, rows, columns, stride, alpha, x, y);
+
+        return;
+    }
+#endif
+
+    gerFloat4(a, rows, columns, stride, alpha, x, y);
+}
+
+void axpy(std::size_t size, float alpha, const float* x, float* y)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        axpyAvx2(size, alpha, x, y);
+
+        return;
+    }
+#endif
+
+    axpyFloat4(size, alpha, x, y);
+}
+
+void gemm(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        gemmAvx2(m, n, k, a, stride_a, 1u, b, stride_b, c, stride_c);
+
+        return;
+    }
+#endif
+
+    gemmFloat4(m, n, k, a, stride_a, 1u, b, stride_b, c, stride_c);
+}
+
+void gemmTransposedA(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        gemmAvx2(m, n, k, a, 1u, stride_a, b, stride_b, c, stride_c);
+
+        return;
+    }
+#endif
+
+    gemmFloat4(m, n, k, a, 1u, stride_a, b, stride_b, c, stride_c);
+}
+
+void gemmTransposedB(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c)
+{
+#if defined(PLAYGROUND_SSE2)
+    if (hasAvx2Fma())
+    {
+        gemmTransposedBAvx2(m, n, k, a, stride_a, b, stride_b, c, stride_c);
+
+        return;
+    }
+#endif
+
+    gemmTransposedBFloat4(m, n, k, a, stride_a, b, stride_b, c, stride_c);
+}
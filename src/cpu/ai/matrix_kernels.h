@@ -0,0 +1,33 @@
+#ifndef CPU_AI_MATRIXKERNELS_H_
+#define CPU_AI_MATRIXKERNELS_H_
+
+#include <cstddef>
+
+// Dense float kernels of the multi-layer perceptron, vectorised with AVX2 and FMA where available.
+// Matrices are row-major with a stride in floats between the rows, vectors are contiguous.
+
+// y = A x, with A of rows x columns.
+void gemv(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y);
+
+// y = A^T x, with A of rows x columns.
+void gemvTransposed(const float* a, std::size_t rows, std::size_t columns, std::size_t stride, const float* x, float* y);
+
+// A += alpha x y^T, with x of rows and y of columns elements.
+void ger(float* a, std::size_t rows, std::size_t columns, std::size_t stride, float alpha, const float* x, const float* y);
+
+// y += alpha x, with x and y of size elements.
+void axpy(std::size_t size, float alpha, const float* x, float* y);
+
+// Matrix products, with C of m x n. The strides are in floats between the rows of each matrix.
+// Blocked, so the part of B in use stays in the cache while it is reused.
+
+// C = A B, with A of m x k and B of k x n.
+void gemm(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c);
+
+// C = A^T B, with A of k x m and B of k x n.
+void gemmTransposedA(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c);
+
+// C = A B^T, with A of m x k and B of n x k.
+void gemmTransposedB(std::size_t m, std::size_t n, std::size_t k, const float* a, std::size_t stride_a, const float* b, std::size_t stride_b, float* c, std::size_t stride_c);
+
+#endif /* CPU_AI_MATRIXKERNELS_H_ */
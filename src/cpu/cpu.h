@@ -3,8 +3,10 @@
 #define CPU_H_
 
 #include "ai/MultiLayerPerceptron.h"
+#include "ai/Optimizer.h"
 #include "ai/activation_functions.h"
 #include "ai/loss_functions.h"
+#include "ai/matrix_kernels.h"
 #include "geometry/MeshData.h"
 #include "geometry/mesh_generator.h"
 
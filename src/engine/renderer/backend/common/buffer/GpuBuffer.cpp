@@ -46,7 +46,9 @@ bool GpuBuffer::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage)
         memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
     }
 
-    m_buffer_resource.device_memory = buildBufferDeviceMemory(m_physical_device, m_device, m_buffer_resource.buffer, memory_flags, allocate_flags);
+    VulkanMemoryTag tag = (usage & (VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT)) ? VulkanMemoryTag::DESCRIPTOR : VulkanMemoryTag::GPU_BUFFER;
+
+    m_buffer_resource.device_memory = buildBufferDeviceMemory(m_physical_device, m_device, m_buffer_resource.buffer, memory_flags, allocate_flags, tag);
 
     if (m_buffer_resource.device_memory == VK_NULL_HANDLE)
     {
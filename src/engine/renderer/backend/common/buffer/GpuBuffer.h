@@ -5,6 +5,7 @@
 
 #include <volk.h>
 
+#include "core/utility/AlignedBuffer.h"
 #include "gpu/vulkan/builder/vulkan_resource.h"
 
 class GpuBuffer
@@ -53,6 +54,9 @@ public:
     template<typename T>
     bool readBack(VkDeviceSize offset, std::vector<T>& data, size_t count) const;
 
+    template<typename T>
+    bool readBack(VkDeviceSize offset, AlignedBuffer<T>& data, size_t count) const;
+
     VkBuffer getBuffer() const;
     VkDeviceSize getDeviceSize() const;
 
@@ -236,4 +240,21 @@ bool GpuBuffer::readBack(VkDeviceSize offset, std::vector<T>& data, size_t count
     return true;
 }
 
+template<typename T>
+bool GpuBuffer::readBack(VkDeviceSize offset, AlignedBuffer<T>& data, size_t count) const
+{
+    if (!isValid() || !isReadbackEnabled() || !isHostVisible())
+    {
+        return false;
+    }
+
+    VkDeviceSize size = count * sizeof(T);
+    if (offset + size > getDeviceSize())
+    {
+        return false;
+    }
+
+    return deviceToHost<T>(m_device, m_buffer_resource.device_memory, offset, size, data);
+}
+
 #endif /* ENGINE_RENDERER_BACKEND_COMMON_BUFFER_GPUBUFFER_H_ */
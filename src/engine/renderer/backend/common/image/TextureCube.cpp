@@ -55,6 +55,62 @@ bool TextureCube::create()
     return true;
 }
 
+bool TextureCube::upload(const ImageData& image_data, uint32_t mip_level)
+{
+    if (!isValid())
+    {
+        return false;
+    }
+
+    if (mip_level >= m_mip_levels)
+    {
+        return false;
+    }
+
+    uint32_t expected_size = std::max(m_extent.width >> mip_level, 1u);
+    if (image_data.width != expected_size || image_data.height != expected_size * m_array_layers)
+    {
+        return false;
+    }
+
+    VkFormat expected_format = getVulkanFormat(image_data);
+    if (expected_format != m_format)
+    {
+        return false;
+    }
+
+    // The faces are tightly packed one after another, which is the memory layout expected for a layer range.
+    VkImageSubresourceLayers subresource_layers{};
+    subresource_layers.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    subresource_layers.mipLevel = mip_level;
+    subresource_layers.baseArrayLayer = 0u;
+    subresource_layers.layerCount = m_array_layers;
+
+    hostTransitionImageLayout(m_device, m_image_resource.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, mip_level, 1u, m_array_layers);
+    copyHostToImage(m_device, image_data.pixels.data(), 0u, 0u, m_image_resource.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, { expected_size, expected_size, 1u }, subresource_layers);
+    hostTransitionImageLayout(m_device, m_image_resource.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, mip_level, 1u, m_array_layers);
+
+    return true;
+}
+
+bool TextureCube::uploadMipMaps(const std::vector<ImageData>& mip_levels)
+{
+    if (static_cast<uint32_t>(mip_levels.size()) != m_mip_levels)
+    {
+        return false;
+    }
+
+    for (uint32_t i{ 0u }; i < static_cast<uint32_t>(mip_levels.size()); ++i)
+    {
+        if (!upload(mip_levels[i], i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 VkImageView TextureCube::getStorageImageView() const
 {
     return getStorageImageViewForMip(0u);
@@ -8,7 +8,8 @@
  *
  * All faces are square (width == height). Provides a VK_IMAGE_VIEW_TYPE_CUBE
  * view for sampling and a VK_IMAGE_VIEW_TYPE_2D_ARRAY view for compute
- * shader storage writes (e.g. IBL precomputation).
+ * shader storage writes (e.g. IBL precomputation). Faces can be uploaded
+ * from the host, e.g. after baking an equirectangular map on the CPU.
  */
 
 class TextureCube : public Texture
@@ -33,6 +34,12 @@ public:
 
     bool create() override;
 
+    // Uploads all six faces of one mip level. The faces are stacked vertically in layer order,
+    // as produced by convertEquirectangularToCube() and resizeCube().
+    bool upload(const ImageData& image_data, uint32_t mip_level = 0);
+
+    bool uploadMipMaps(const std::vector<ImageData>& mip_levels);
+
     VkImageView getStorageImageView() const;
 
     VkImageView getStorageImageViewForMip(uint32_t mip) const;
@@ -1,6 +1,8 @@
 #ifndef ENGINE_RENDERER_GEOMETRY_AGEOMETRY_H_
 #define ENGINE_RENDERER_GEOMETRY_AGEOMETRY_H_
 
+#include <memory_resource>
+
 #include <volk.h>
 
 class AGeometry
@@ -11,7 +13,8 @@ public:
     virtual ~AGeometry() = default;
 
     // Bind geometry buffers for rendering
-    virtual void bind(VkCommandBuffer command_buffer) const = 0;
+    // Temporary data is allocated from memory_resource, e.g. the frame arena
+    virtual void bind(VkCommandBuffer command_buffer, std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource()) const = 0;
 
     // Issue draw call
     virtual void draw(VkCommandBuffer command_buffer) const = 0;
@@ -1,5 +1,9 @@
 #include "TriangleMesh.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "engine/renderer/backend/common/buffer/IndexBuffer.h"
 #include "engine/renderer/backend/common/buffer/VertexBuffer.h"
 
@@ -79,38 +83,47 @@ uint32_t TriangleMesh::getVertexCount() const
     return m_vertex_count;
 }
 
-void TriangleMesh::bind(VkCommandBuffer command_buffer) const
+void TriangleMesh::bind(VkCommandBuffer command_buffer, std::pmr::memory_resource* memory_resource) const
 {
     if (!isValid())
     {
         return;
     }
 
-    // Collect unique bindings and their buffers
-    std::map<uint32_t, VkBuffer> binding_to_buffer{};
-    std::map<uint32_t, VkDeviceSize> binding_to_offset{};
+    // Collect unique bindings and their buffers, sorted by binding
+    std::pmr::vector<std::pair<uint32_t, VkBuffer>> binding_to_buffer(memory_resource);
+    binding_to_buffer.reserve(m_vertex_attributes.size());
 
     for (const auto& [name, attr] : m_vertex_attributes)
     {
         if (attr.buffer && attr.buffer->isValid())
         {
-            binding_to_buffer[attr.binding] = attr.buffer->getBuffer();
-            binding_to_offset[attr.binding] = 0u; // Offset handled per-attribute
+            auto it = std::lower_bound(binding_to_buffer.begin(), binding_to_buffer.end(), attr.binding, [](const auto& entry, uint32_t binding) { return entry.first < binding; });
+            if (it != binding_to_buffer.end() && it->first == attr.binding)
+            {
+                it->second = attr.buffer->getBuffer();
+            }
+            else
+            {
+                binding_to_buffer.insert(it, { attr.binding, attr.buffer->getBuffer() });
+            }
         }
     }
 
     // Bind vertex buffers
     if (!binding_to_buffer.empty())
     {
-        std::vector<VkBuffer> buffers{};
-        std::vector<VkDeviceSize> offsets{};
+        std::pmr::vector<VkBuffer> buffers(memory_resource);
+        buffers.reserve(binding_to_buffer.size());
 
         for (const auto& [binding, buffer] : binding_to_buffer)
         {
             buffers.push_back(buffer);
-            offsets.push_back(binding_to_offset[binding]);
         }
 
+        // Offset handled per-attribute
+        const std::pmr::vector<VkDeviceSize> offsets(buffers.size(), 0u, memory_resource);
+
         vkCmdBindVertexBuffers(
             command_buffer,
             0u, // First binding
@@ -3,6 +3,7 @@
 
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <string>
 
 #include <volk.h>
@@ -89,10 +90,10 @@ public:
     uint32_t getVertexCount() const;
 
     // Bind vertex and index buffers for rendering
-    void bind(VkCommandBuffer command_buffer) const;
+    void bind(VkCommandBuffer command_buffer, std::pmr::memory_resource* memory_resource) const override;
 
     // Issue draw call
-    void draw(VkCommandBuffer command_buffer) const;
+    void draw(VkCommandBuffer command_buffer) const override;
 
     bool isValid() const;
 };
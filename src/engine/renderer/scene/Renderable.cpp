@@ -85,7 +85,7 @@ bool Renderable::updateUniforms()
     return true;
 }
 
-void Renderable::render(VkCommandBuffer command_buffer) const
+void Renderable::render(VkCommandBuffer command_buffer, std::pmr::memory_resource* memory_resource) const
 {
     // Bind material descriptors
     if (m_material)
@@ -96,7 +96,7 @@ void Renderable::render(VkCommandBuffer command_buffer) const
     // Bind and draw geometry
     if (m_geometry)
     {
-        m_geometry->bind(command_buffer);
+        m_geometry->bind(command_buffer, memory_resource);
         m_geometry->draw(command_buffer);
     }
 }
@@ -2,6 +2,7 @@
 #define ENGINE_RENDERER_SCENE_RENDERABLE_H_
 
 #include <memory>
+#include <memory_resource>
 
 #include <volk.h>
 
@@ -52,7 +53,8 @@ public:
     bool updateUniforms();
 
     // Render the object (binds material and draws geometry)
-    void render(VkCommandBuffer command_buffer) const;
+    // Temporary data is allocated from memory_resource, e.g. the frame arena
+    void render(VkCommandBuffer command_buffer, std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource()) const;
 
     // Getters
     const float4x4& getWorldMatrix() const;
@@ -99,6 +99,14 @@ bool VulkanRuntime::init()
         vulkan_device_factory.addEnabledExtensionName(VK_KHR_PRESENT_WAIT_2_EXTENSION_NAME);
     }
 
+    // Optional, without it the memory tracker uses the heap sizes as budget.
+    std::vector<VkPhysicalDevice> memory_budget_physical_devices = PhysicalDeviceExtensionNameFilter{ VK_EXT_MEMORY_BUDGET_EXTENSION_NAME } << std::vector<VkPhysicalDevice>{ m_physical_device };
+    const bool memory_budget = !memory_budget_physical_devices.empty();
+    if (memory_budget)
+    {
+        vulkan_device_factory.addEnabledExtensionName(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
     m_device = vulkan_device_factory.create();
     if (m_device == VK_NULL_HANDLE)
     {
@@ -107,6 +115,8 @@ bool VulkanRuntime::init()
         return false;
     }
 
+    getVulkanMemoryTracker().init(m_physical_device, memory_budget);
+
     // If we have a surface, initialize the swapchain automatically
     if (m_surface != VK_NULL_HANDLE && m_window != nullptr)
     {
@@ -144,6 +154,13 @@ bool VulkanRuntime::init()
             return false;
         }
         m_command_buffer = command_buffers.front();
+
+        // Optional, the application records and submits, so the results are read once available.
+        m_timestamp_profiler = std::make_unique<VulkanTimestampProfiler>(m_physical_device, m_device, m_queue_family_index);
+        if (!m_timestamp_profiler->init())
+        {
+            m_timestamp_profiler.reset();
+        }
     }
 
     return true;
@@ -185,13 +202,42 @@ bool VulkanRuntime::loop(IApplication& application, uint32_t num_loops)
         return false;
     }
 
+    Profiler& profiler = getProfiler();
+
     DeltaTime delta_time{};
 
     for (uint32_t i = 0u; i < num_loops; i++)
     {
         auto current_delta_time = delta_time.tick();
 
-        if (!application.update(current_delta_time, m_command_buffer))
+        getFrameArena().reset();
+        getVulkanMemoryTracker().updateBudget();
+
+        profiler.beginFrame();
+        if (m_timestamp_profiler)
+        {
+            m_timestamp_profiler->beginFrame();
+        }
+
+        bool result{ false };
+        {
+            PROFILER_ZONE("IApplication::update");
+
+            result = application.update(current_delta_time, m_command_buffer);
+        }
+
+        if (m_timestamp_profiler)
+        {
+            m_timestamp_profiler->endFrame();
+        }
+        profiler.endFrame();
+
+        if (m_timestamp_profiler)
+        {
+            m_timestamp_profiler->resolve();
+        }
+
+        if (!result)
         {
             return false;
         }
@@ -268,6 +314,8 @@ bool VulkanRuntime::loopWindow(IApplication& application)
         return false;
     }
 
+    Profiler& profiler = getProfiler();
+
     DeltaTime delta_time{};
     while (!glfwWindowShouldClose(m_window))
     {
@@ -275,6 +323,11 @@ bool VulkanRuntime::loopWindow(IApplication& application)
 
         auto current_delta_time = delta_time.tick();
 
+        getFrameArena().reset();
+        getVulkanMemoryTracker().updateBudget();
+
+        profiler.beginFrame();
+
         if (!glfwGetWindowAttrib(m_window, GLFW_ICONIFIED))
         {
             bool resize{ false };
@@ -282,6 +335,8 @@ bool VulkanRuntime::loopWindow(IApplication& application)
             VkCommandBuffer command_buffer = m_vulkan_window->beginFrame();
             if (command_buffer != VK_NULL_HANDLE)
             {
+                PROFILER_ZONE("IApplication::update");
+
                 if (!application.update(current_delta_time, command_buffer))
                 {
                     should_terminate = true;
@@ -307,6 +362,14 @@ bool VulkanRuntime::loopWindow(IApplication& application)
             }
         }
 
+        profiler.endFrame();
+
+        // Earlier frames which already finished on the GPU.
+        if (m_vulkan_window->getTimestampProfiler())
+        {
+            m_vulkan_window->getTimestampProfiler()->resolve();
+        }
+
         glfwPollEvents();
         if (glfwGetKey(m_window, GLFW_KEY_ESCAPE) == GLFW_PRESS || should_terminate)
         {
@@ -348,6 +411,8 @@ void VulkanRuntime::terminate()
 {
     terminateWindow();
 
+    m_timestamp_profiler.reset();
+
     if (m_command_buffer != VK_NULL_HANDLE && m_command_pool != VK_NULL_HANDLE)
     {
         vkFreeCommandBuffers(m_device, m_command_pool, 1u, &m_command_buffer);
@@ -362,6 +427,8 @@ void VulkanRuntime::terminate()
 
     if (m_device != VK_NULL_HANDLE)
     {
+        getVulkanMemoryTracker().terminate();
+
         vkDestroyDevice(m_device, nullptr);
         m_device = VK_NULL_HANDLE;
     }
@@ -409,3 +476,13 @@ IVulkanWindow* VulkanRuntime::getVulkanWindow() const
 {
     return m_vulkan_window.get();
 }
+
+VulkanTimestampProfiler* VulkanRuntime::getTimestampProfiler() const
+{
+    if (m_vulkan_window)
+    {
+        return m_vulkan_window->getTimestampProfiler();
+    }
+
+    return m_timestamp_profiler.get();
+}
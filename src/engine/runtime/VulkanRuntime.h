@@ -20,7 +20,7 @@ struct GLFWwindow;
  *   2. [Optional: setQueueFlags()]      // Set queue type (default: VK_QUEUE_GRAPHICS_BIT)
  *   3. init()                           // Creates device, queue, and command buffer
  *   4. [Initialize application with getPhysicalDevice(), getDevice(), getQueueFamilyIndex()]
- *   5. loop(application, num_loops)     // Execute application for specified iterations
+ *   5. loop(application, num_loops)     // Execute application for specified iterations, one profiler frame each
  *   6. [Terminate application]
  *   7. terminate()                      // Cleanup
  * 
@@ -53,6 +53,9 @@ private:
     VkCommandPool m_command_pool{ VK_NULL_HANDLE };
     VkCommandBuffer m_command_buffer{ VK_NULL_HANDLE };
 
+    // GPU zones for non-window case, the window has its own
+    std::unique_ptr<VulkanTimestampProfiler> m_timestamp_profiler{};
+
     // Window-related
     bool m_glfw_initialized{ false };
     GLFWwindow* m_window{ nullptr };
@@ -109,6 +112,10 @@ public:
     VkFormat getDepthStencilFormat() const;
 
     IVulkanWindow* getVulkanWindow() const;
+
+    // GPU zones for the command buffers passed to the application, nullptr if timestamps are not supported.
+    // CPU zones and per frame statistics are available through getProfiler().
+    VulkanTimestampProfiler* getTimestampProfiler() const;
 };
 
 #endif /* ENGINE_RUNTIME_VULKANRUNTIME_H_ */
@@ -1,28 +1,35 @@
 #include "spirv_io.h"
 
 #include <algorithm>
+#include <cstring>
+#include <span>
 
 #include <spirv-reflect/spirv_reflect.h>
 
+#include "core/io/MappedFile.h"
 #include "core/io/binary_data.h"
-#include "core/utility/convert.h"
 #include "spirv_convert.h"
 
 std::optional<SpirvData> loadSpirv(const std::string& filename)
 {
-    auto input = load(filename);
-    if (!input.has_value())
+    MappedFile input{};
+    if (!input.open(filename))
     {
         return {};
     }
 
-    SpirvData spirv_data{};
-    spirv_data.code = stringToVector<uint32_t>(*input);
-    if (spirv_data.code.empty())
+    if (input.getSize() == 0u || input.getSize() % sizeof(uint32_t) != 0u)
     {
         return {};
     }
 
+    // Copied once, straight from the mapping into the word buffer.
+    SpirvData spirv_data{};
+    spirv_data.code.resize(input.getSize() / sizeof(uint32_t));
+    std::memcpy(spirv_data.code.data(), input.getData().data(), input.getSize());
+
+    input.close();
+
     //
 
     spirv_data.code = convertToColumnMajor(spirv_data.code);
@@ -67,11 +74,10 @@ std::optional<SpirvData> loadSpirv(const std::string& filename)
 
 bool saveSpirv(const std::string& filename, const SpirvData& spirv_data)
 {
-    auto output = vectorToString<uint32_t>(spirv_data.code);
-    if (output.empty())
+    if (spirv_data.code.empty())
     {
         return false;
     }
 
-    return save(output, filename);
+    return saveAtomic(std::as_bytes(std::span<const uint32_t>(spirv_data.code)), filename);
 }
@@ -5,7 +5,7 @@
 #include "gpu/vulkan/utility/VulkanFilter.h"
 #include "gpu/vulkan/utility/vulkan_query.h"
 
-VkDeviceMemory buildImageDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkImage image, VkMemoryPropertyFlags memory_property_flags)
+VkDeviceMemory buildImageDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkImage image, VkMemoryPropertyFlags memory_property_flags, VulkanMemoryTag tag)
 {
     VkDeviceMemory device_memory{ VK_NULL_HANDLE };
 
@@ -26,17 +26,21 @@ VkDeviceMemory buildImageDeviceMemory(VkPhysicalDevice physical_device, VkDevice
         return device_memory;
     }
 
+    const uint32_t memory_type_index = memory_type_indices[0];
+    const uint32_t heap_index = physical_device_memory_properties.memoryProperties.memoryTypes[memory_type_index].heapIndex;
+    getVulkanMemoryTracker().onAllocate(device_memory, image_memory_requirements.memoryRequirements.size, memory_type_index, heap_index, tag);
+
     auto result = vkBindImageMemory(device, image, device_memory, 0u);
     if (result != VK_SUCCESS)
     {
-        vkFreeMemory(device, device_memory, nullptr);
+        freeDeviceMemory(device, device_memory);
         device_memory = VK_NULL_HANDLE;
     }
 
     return device_memory;
 }
 
-VkDeviceMemory buildBufferDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkBuffer buffer, VkMemoryPropertyFlags memory_property_flags, VkMemoryAllocateFlags memory_allocate_flags)
+VkDeviceMemory buildBufferDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkBuffer buffer, VkMemoryPropertyFlags memory_property_flags, VkMemoryAllocateFlags memory_allocate_flags, VulkanMemoryTag tag)
 {
     VkDeviceMemory device_memory{ VK_NULL_HANDLE };
 
@@ -58,12 +62,28 @@ VkDeviceMemory buildBufferDeviceMemory(VkPhysicalDevice physical_device, VkDevic
         return device_memory;
     }
 
+    const uint32_t memory_type_index = memory_type_indices[0];
+    const uint32_t heap_index = physical_device_memory_properties.memoryProperties.memoryTypes[memory_type_index].heapIndex;
+    getVulkanMemoryTracker().onAllocate(device_memory, buffer_memory_requirements.memoryRequirements.size, memory_type_index, heap_index, tag);
+
     auto result = vkBindBufferMemory(device, buffer, device_memory, 0u);
     if (result != VK_SUCCESS)
     {
-        vkFreeMemory(device, device_memory, nullptr);
+        freeDeviceMemory(device, device_memory);
         device_memory = VK_NULL_HANDLE;
     }
 
     return device_memory;
 }
+
+void freeDeviceMemory(VkDevice device, VkDeviceMemory device_memory)
+{
+    if (device_memory == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    getVulkanMemoryTracker().onFree(device_memory);
+
+    vkFreeMemory(device, device_memory, nullptr);
+}
@@ -3,8 +3,14 @@
 
 #include <volk.h>
 
-VkDeviceMemory buildImageDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkImage image, VkMemoryPropertyFlags memory_property_flags);
+#include "gpu/vulkan/utility/VulkanMemoryTracker.h"
 
-VkDeviceMemory buildBufferDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkBuffer buffer, VkMemoryPropertyFlags memory_property_flags, VkMemoryAllocateFlags memory_allocate_flags = 0u);
+// The allocation is recorded in the memory tracker under the given tag.
+VkDeviceMemory buildImageDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkImage image, VkMemoryPropertyFlags memory_property_flags, VulkanMemoryTag tag = VulkanMemoryTag::TEXTURE);
+
+VkDeviceMemory buildBufferDeviceMemory(VkPhysicalDevice physical_device, VkDevice device, VkBuffer buffer, VkMemoryPropertyFlags memory_property_flags, VkMemoryAllocateFlags memory_allocate_flags = 0u, VulkanMemoryTag tag = VulkanMemoryTag::GPU_BUFFER);
+
+// Counterpart of the build functions, which also removes the allocation from the memory tracker.
+void freeDeviceMemory(VkDevice device, VkDeviceMemory device_memory);
 
 #endif /* GPU_VULKAN_BUILDER_VULKANDEVICEMEMORY_H_ */
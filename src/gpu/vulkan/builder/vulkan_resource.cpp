@@ -1,5 +1,7 @@
 #include "vulkan_resource.h"
 
+#include "gpu/vulkan/builder/vulkan_device_memory.h"
+
 void destroyResource(VkDevice device, VulkanImageResource& image_resource)
 {
     if (image_resource.image_view != VK_NULL_HANDLE)
@@ -10,7 +12,7 @@ void destroyResource(VkDevice device, VulkanImageResource& image_resource)
 
     if (image_resource.device_memory != VK_NULL_HANDLE)
     {
-        vkFreeMemory(device, image_resource.device_memory, nullptr);
+        freeDeviceMemory(device, image_resource.device_memory);
         image_resource.device_memory = VK_NULL_HANDLE;
     }
 
@@ -25,7 +27,7 @@ void destroyResource(VkDevice device, VulkanBufferResource& buffer_resource)
 {
     if (buffer_resource.device_memory != VK_NULL_HANDLE)
     {
-        vkFreeMemory(device, buffer_resource.device_memory, nullptr);
+        freeDeviceMemory(device, buffer_resource.device_memory);
         buffer_resource.device_memory = VK_NULL_HANDLE;
     }
 
@@ -65,6 +65,7 @@ VkDevice VulkanDeviceFactory::create() const
     physical_device_vulkan12_features.shaderFloat16 = VK_TRUE;
     physical_device_vulkan12_features.shaderInt8 = VK_TRUE;
     physical_device_vulkan12_features.storageBuffer8BitAccess = VK_TRUE;
+    physical_device_vulkan12_features.hostQueryReset = VK_TRUE;
 
     VkPhysicalDeviceVulkan13Features physical_device_vulkan13_features{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES };
     physical_device_vulkan13_features.maintenance4 = VK_TRUE;
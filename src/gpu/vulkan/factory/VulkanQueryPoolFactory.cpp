@@ -0,0 +1,20 @@
+#include "VulkanQueryPoolFactory.h"
+
+VulkanQueryPoolFactory::VulkanQueryPoolFactory(VkDevice device, VkQueryType query_type, uint32_t query_count) :
+    m_device{ device },
+    m_query_type{ query_type },
+    m_query_count{ query_count }
+{
+}
+
+VkQueryPool VulkanQueryPoolFactory::create() const
+{
+    VkQueryPoolCreateInfo query_pool_create_info{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    query_pool_create_info.queryType = m_query_type;
+    query_pool_create_info.queryCount = m_query_count;
+
+    VkQueryPool query_pool{ VK_NULL_HANDLE };
+    vkCreateQueryPool(m_device, &query_pool_create_info, nullptr, &query_pool);
+
+    return query_pool;
+}
@@ -0,0 +1,27 @@
+#ifndef GPU_VULKAN_FACTORY_VULKANQUERYPOOLFACTORY_H_
+#define GPU_VULKAN_FACTORY_VULKANQUERYPOOLFACTORY_H_
+
+#include <cstdint>
+
+#include <volk.h>
+
+class VulkanQueryPoolFactory
+{
+
+private:
+
+    VkDevice m_device{ VK_NULL_HANDLE };
+
+    VkQueryType m_query_type{ VK_QUERY_TYPE_TIMESTAMP };
+    uint32_t m_query_count{ 0u };
+
+public:
+
+    VulkanQueryPoolFactory() = delete;
+
+    VulkanQueryPoolFactory(VkDevice device, VkQueryType query_type, uint32_t query_count);
+
+    VkQueryPool create() const;
+};
+
+#endif /* GPU_VULKAN_FACTORY_VULKANQUERYPOOLFACTORY_H_ */
@@ -5,6 +5,8 @@
 
 #include "core/math/vector.h"
 
+class VulkanTimestampProfiler;
+
 class IVulkanWindow
 {
 
@@ -31,6 +33,9 @@ public:
     virtual void beginRendering() const = 0;
 
     virtual void endRendering() const = 0;
+
+    // GPU zones of the frame, nullptr if the queue does not support timestamps.
+    virtual VulkanTimestampProfiler* getTimestampProfiler() const = 0;
 };
 
 #endif /* GPU_VULKAN_PRESENTATION_IVULKANWINDOW_H_ */
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "core/utility/Profiler.h"
 #include "gpu/vulkan/builder/vulkan_device_memory.h"
 #include "gpu/vulkan/factory/VulkanCommandBufferFactory.h"
 #include "gpu/vulkan/factory/VulkanCommandPoolFactory.h"
@@ -137,7 +138,7 @@ bool VulkanWindow::init()
 
         // Create the image and the required device memory.
 
-        m_msaa_image_resource.device_memory = buildImageDeviceMemory(m_physical_device, m_device, m_msaa_image_resource.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        m_msaa_image_resource.device_memory = buildImageDeviceMemory(m_physical_device, m_device, m_msaa_image_resource.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VulkanMemoryTag::ATTACHMENT);
         if (m_msaa_image_resource.device_memory == VK_NULL_HANDLE)
         {
             return false;
@@ -219,7 +220,7 @@ bool VulkanWindow::init()
 
         // Create the image and the required device memory.
 
-        m_depth_stencil_image_resource.device_memory = buildImageDeviceMemory(m_physical_device, m_device, m_depth_stencil_image_resource.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        m_depth_stencil_image_resource.device_memory = buildImageDeviceMemory(m_physical_device, m_device, m_depth_stencil_image_resource.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VulkanMemoryTag::ATTACHMENT);
         if (m_depth_stencil_image_resource.device_memory == VK_NULL_HANDLE)
         {
             return false;
@@ -362,6 +363,14 @@ bool VulkanWindow::init()
         m_frame_resources.push_back(vulkan_frame_resource);
     }
 
+    // Optional GPU timestamps.
+
+    m_timestamp_profiler = std::make_unique<VulkanTimestampProfiler>(m_physical_device, m_device, m_queue_family_index, number_frames);
+    if (!m_timestamp_profiler->init())
+    {
+        m_timestamp_profiler.reset();
+    }
+
     return true;
 }
 
@@ -387,6 +396,8 @@ void VulkanWindow::setClearStencil(uint32_t stencil)
 
 VkCommandBuffer VulkanWindow::beginFrame()
 {
+    PROFILER_ZONE("VulkanWindow::beginFrame");
+
     // Wait for the fence of a given frame, that we do not use a command in the queue.
 
     auto result = vkWaitForFences(m_device, 1u, &m_frame_resources[m_frame_index].fence, VK_TRUE, UINT64_MAX);
@@ -395,6 +406,12 @@ VkCommandBuffer VulkanWindow::beginFrame()
         return VK_NULL_HANDLE;
     }
 
+    // The frame is done on the GPU, so its timestamps can be read.
+    if (m_timestamp_profiler)
+    {
+        m_timestamp_profiler->beginFrame(true);
+    }
+
     result = vkResetFences(m_device, 1u, &m_frame_resources[m_frame_index].fence);
     if (result != VK_SUCCESS)
     {
@@ -415,6 +432,11 @@ VkCommandBuffer VulkanWindow::beginFrame()
         return VK_NULL_HANDLE;
     }
 
+    if (m_timestamp_profiler)
+    {
+        m_frame_zone = m_timestamp_profiler->beginZone(m_frame_resources[m_frame_index].command_buffer, "Frame");
+    }
+
     // Change the layouts for rendering.
 
     m_render_image_memory_barriers[0].image = m_swapchain_image_resources[m_swapchain_image_index].image;
@@ -468,6 +490,8 @@ void VulkanWindow::endRendering() const
 
 bool VulkanWindow::endFrame()
 {
+    PROFILER_ZONE("VulkanWindow::endFrame");
+
     // Switch back layouts for presentation.
 
     m_present_image_memory_barriers[0].image = m_swapchain_image_resources[m_swapchain_image_index].image;
@@ -478,6 +502,12 @@ bool VulkanWindow::endFrame()
     dependency_info.pImageMemoryBarriers = m_present_image_memory_barriers.data();
     vkCmdPipelineBarrier2(m_frame_resources[m_frame_index].command_buffer, &dependency_info);
 
+    if (m_timestamp_profiler)
+    {
+        m_timestamp_profiler->endZone(m_frame_resources[m_frame_index].command_buffer, m_frame_zone);
+        m_timestamp_profiler->endFrame();
+    }
+
     // End of command.
 
     auto result = vkEndCommandBuffer(m_frame_resources[m_frame_index].command_buffer);
@@ -547,6 +577,11 @@ bool VulkanWindow::endFrame()
     return true;
 }
 
+VulkanTimestampProfiler* VulkanWindow::getTimestampProfiler() const
+{
+    return m_timestamp_profiler.get();
+}
+
 uint64_t VulkanWindow::getPresentId() const
 {
     return m_present_id;
@@ -567,6 +602,8 @@ void VulkanWindow::terminate()
     {
         vkDeviceWaitIdle(m_device);
 
+        m_timestamp_profiler.reset();
+
         for (auto& frame_resource : m_frame_resources)
         {
             if (frame_resource.wait_semaphore != VK_NULL_HANDLE)
@@ -1,6 +1,7 @@
 #ifndef GPU_VULKAN_PRESENTATION_VULKANWINDOW_H_
 #define GPU_VULKAN_PRESENTATION_VULKANWINDOW_H_
 
+#include <memory>
 #include <vector>
 
 #include <volk.h>
@@ -8,6 +9,7 @@
 #include "IVulkanWindow.h"
 #include "core/math/vector.h"
 #include "gpu/vulkan/builder/vulkan_resource.h"
+#include "gpu/vulkan/utility/VulkanTimestampProfiler.h"
 
 struct VulkanSwapchainImageResource
 {
@@ -71,6 +73,10 @@ private:
     uint64_t m_present_id{ 0u };
     bool m_present_id2_enabled{ false };
 
+    // Advances together with the frame resources, so a signaled frame fence means its timestamps are complete.
+    std::unique_ptr<VulkanTimestampProfiler> m_timestamp_profiler{};
+    uint32_t m_frame_zone{ 0u };
+
 public:
 
     VulkanWindow() = delete;
@@ -120,6 +126,8 @@ public:
 
     void endRendering() const override;
 
+    VulkanTimestampProfiler* getTimestampProfiler() const override;
+
     uint64_t getPresentId() const;
 
     VkResult waitForPresent(uint64_t present_id, uint64_t timeout = UINT64_MAX) const;
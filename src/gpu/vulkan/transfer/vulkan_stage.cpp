@@ -16,7 +16,7 @@ std::optional<VulkanBufferResource> createStagingBuffer(VkPhysicalDevice physica
         return {};
     }
 
-    buffer_resource.device_memory = buildBufferDeviceMemory(physical_device, device, buffer_resource.buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    buffer_resource.device_memory = buildBufferDeviceMemory(physical_device, device, buffer_resource.buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0u, VulkanMemoryTag::STAGING);
     if (buffer_resource.device_memory == VK_NULL_HANDLE)
     {
         destroyResource(device, buffer_resource);
@@ -0,0 +1,452 @@
+#include "VulkanMemoryTracker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "gpu/vulkan/utility/vulkan_query.h"
+
+namespace
+{
+
+nlohmann::json toJson(const VulkanMemoryCounter& counter)
+{
+    return { { "live_bytes", counter.live_bytes },
+             { "peak_bytes", counter.peak_bytes },
+             { "live_count", counter.live_count },
+             { "peak_count", counter.peak_count },
+             { "total_count", counter.total_count } };
+}
+
+void printWarning(const VulkanMemoryWarning& warning)
+{
+    const double mib = 1024.0 * 1024.0;
+
+    printf("Warning: Device memory heap %u at %.1f MiB of a %.1f MiB budget after allocating %.1f MiB for %s\n", warning.heap_index, (double)warning.heap_budget.projected_usage / mib, (double)warning.heap_budget.budget / mib, (double)warning.allocation_size / mib, getVulkanMemoryTagName(warning.tag));
+}
+
+} // namespace
+
+const char* getVulkanMemoryTagName(VulkanMemoryTag tag)
+{
+    switch (tag)
+    {
+        case VulkanMemoryTag::GPU_BUFFER:
+            return "GpuBuffer";
+        case VulkanMemoryTag::TEXTURE:
+            return "Texture";
+        case VulkanMemoryTag::STAGING:
+            return "Staging";
+        case VulkanMemoryTag::DESCRIPTOR:
+            return "Descriptor";
+        case VulkanMemoryTag::ATTACHMENT:
+            return "Attachment";
+        default:
+            return "Other";
+    }
+}
+
+void VulkanMemoryTracker::add(VulkanMemoryCounter& counter, VkDeviceSize size)
+{
+    counter.live_bytes += size;
+    counter.peak_bytes = std::max(counter.peak_bytes, counter.live_bytes);
+
+    counter.live_count++;
+    counter.peak_count = std::max(counter.peak_count, counter.live_count);
+
+    counter.total_count++;
+}
+
+void VulkanMemoryTracker::remove(VulkanMemoryCounter& counter, VkDeviceSize size)
+{
+    counter.live_bytes -= std::min(counter.live_bytes, (uint64_t)size);
+
+    if (counter.live_count > 0u)
+    {
+        counter.live_count--;
+    }
+}
+
+VulkanMemoryTracker::Heap& VulkanMemoryTracker::getHeap(uint32_t heap_index)
+{
+    if (heap_index >= m_heaps.size())
+    {
+        m_heaps.resize(heap_index + 1u);
+    }
+
+    return m_heaps[heap_index];
+}
+
+VulkanMemoryHeapBudget VulkanMemoryTracker::getHeapBudget(const Heap& heap) const
+{
+    VulkanMemoryHeapBudget heap_budget{};
+    heap_budget.heap_size = heap.size;
+
+    if (m_memory_budget && heap.budget > 0u)
+    {
+        heap_budget.budget = heap.budget;
+        heap_budget.usage = heap.usage;
+
+        // The driver usage includes memory of other processes and of the driver itself, so only the difference is added.
+        const int64_t difference = (int64_t)heap.counter.live_bytes - (int64_t)heap.queried_live_bytes;
+        heap_budget.projected_usage = (VkDeviceSize)std::max((int64_t)heap.usage + difference, (int64_t)0);
+    }
+    else
+    {
+        heap_budget.budget = heap.size;
+        heap_budget.usage = heap.counter.live_bytes;
+        heap_budget.projected_usage = heap.counter.live_bytes;
+    }
+
+    return heap_budget;
+}
+
+void VulkanMemoryTracker::removeAllocation(VkDeviceMemory device_memory)
+{
+    auto it = m_allocations.find(device_memory);
+    if (it == m_allocations.end())
+    {
+        return;
+    }
+
+    const Allocation& allocation = it->second;
+
+    remove(m_total, allocation.size);
+
+    Heap& heap = getHeap(allocation.heap_index);
+    remove(heap.counter, allocation.size);
+
+    if (allocation.memory_type_index < m_memory_types.size())
+    {
+        remove(m_memory_types[allocation.memory_type_index], allocation.size);
+    }
+
+    remove(m_tags[(std::size_t)allocation.tag], allocation.size);
+
+    // Re-arms the warning.
+    const VulkanMemoryHeapBudget heap_budget = getHeapBudget(heap);
+    if ((double)heap_budget.projected_usage <= m_warning_fraction * (double)heap_budget.budget)
+    {
+        heap.warned = false;
+    }
+
+    m_allocations.erase(it);
+}
+
+void VulkanMemoryTracker::init(VkPhysicalDevice physical_device, bool memory_budget)
+{
+    auto physical_device_memory_properties = gatherPhysicalDeviceMemoryProperties2(physical_device);
+    auto physical_device_properties = gatherPhysicalDeviceProperties2(physical_device);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_physical_device = physical_device;
+        m_memory_budget = memory_budget;
+        m_max_allocation_count = physical_device_properties.properties.limits.maxMemoryAllocationCount;
+
+        const VkPhysicalDeviceMemoryProperties& memory_properties = physical_device_memory_properties.memoryProperties;
+
+        for (uint32_t i = 0u; i < memory_properties.memoryHeapCount; i++)
+        {
+            getHeap(i).size = memory_properties.memoryHeaps[i].size;
+        }
+
+        if (m_memory_types.size() < memory_properties.memoryTypeCount)
+        {
+            m_memory_types.resize(memory_properties.memoryTypeCount);
+        }
+    }
+
+    updateBudget();
+}
+
+void VulkanMemoryTracker::terminate()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_physical_device = VK_NULL_HANDLE;
+    m_memory_budget = false;
+    m_max_allocation_count = 0u;
+
+    for (Heap& heap : m_heaps)
+    {
+        heap.size = 0u;
+        heap.budget = 0u;
+        heap.usage = 0u;
+        heap.queried_live_bytes = 0u;
+    }
+}
+
+void VulkanMemoryTracker::reset()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_allocations.clear();
+
+    m_total = {};
+    for (Heap& heap : m_heaps)
+    {
+        heap.counter = {};
+        heap.queried_live_bytes = 0u;
+        heap.warned = false;
+    }
+    std::fill(m_memory_types.begin(), m_memory_types.end(), VulkanMemoryCounter{});
+    m_tags.fill({});
+}
+
+void VulkanMemoryTracker::onAllocate(VkDeviceMemory device_memory, VkDeviceSize size, uint32_t memory_type_index, uint32_t heap_index, VulkanMemoryTag tag)
+{
+    if (device_memory == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    std::optional<VulkanMemoryWarning> warning{};
+    std::function<void(const VulkanMemoryWarning&)> warning_callback{};
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // A handle freed without onFree() may be reused by the driver.
+        removeAllocation(device_memory);
+
+        m_allocations[device_memory] = { size, memory_type_index, heap_index, tag };
+
+        add(m_total, size);
+
+        Heap& heap = getHeap(heap_index);
+        add(heap.counter, size);
+
+        if (memory_type_index >= m_memory_types.size())
+        {
+            m_memory_types.resize(memory_type_index + 1u);
+        }
+        add(m_memory_types[memory_type_index], size);
+
+        add(m_tags[(std::size_t)tag], size);
+
+        const VulkanMemoryHeapBudget heap_budget = getHeapBudget(heap);
+        if (heap_budget.budget > 0u && (double)heap_budget.projected_usage > m_warning_fraction * (double)heap_budget.budget && !heap.warned)
+        {
+            heap.warned = true;
+
+            warning = VulkanMemoryWarning{ heap_index, heap_budget, size, tag };
+            warning_callback = m_warning_callback;
+        }
+    }
+
+    if (warning.has_value())
+    {
+        if (warning_callback)
+        {
+            warning_callback(*warning);
+        }
+        else
+        {
+            printWarning(*warning);
+        }
+    }
+}
+
+void VulkanMemoryTracker::onFree(VkDeviceMemory device_memory)
+{
+    if (device_memory == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    removeAllocation(device_memory);
+}
+
+void VulkanMemoryTracker::updateBudget()
+{
+    VkPhysicalDevice physical_device{ VK_NULL_HANDLE };
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (!m_memory_budget)
+        {
+            return;
+        }
+
+        physical_device = m_physical_device;
+    }
+
+    auto memory_budget_properties = gatherPhysicalDeviceMemoryBudgetPropertiesEXT(physical_device);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (uint32_t i = 0u; i < m_heaps.size() && i < VK_MAX_MEMORY_HEAPS; i++)
+    {
+        Heap& heap = m_heaps[i];
+
+        heap.budget = memory_budget_properties.heapBudget[i];
+        heap.usage = memory_budget_properties.heapUsage[i];
+        heap.queried_live_bytes = heap.counter.live_bytes;
+
+        const VulkanMemoryHeapBudget heap_budget = getHeapBudget(heap);
+        if ((double)heap_budget.projected_usage <= m_warning_fraction * (double)heap_budget.budget)
+        {
+            heap.warned = false;
+        }
+    }
+}
+
+void VulkanMemoryTracker::setWarningFraction(double warning_fraction)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_warning_fraction = warning_fraction;
+}
+
+double VulkanMemoryTracker::getWarningFraction() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_warning_fraction;
+}
+
+void VulkanMemoryTracker::setWarningCallback(std::function<void(const VulkanMemoryWarning&)> warning_callback)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_warning_callback = std::move(warning_callback);
+}
+
+VulkanMemoryCounter VulkanMemoryTracker::getTotal() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_total;
+}
+
+VulkanMemoryCounter VulkanMemoryTracker::getHeapCounter(uint32_t heap_index) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (heap_index >= m_heaps.size())
+    {
+        return {};
+    }
+
+    return m_heaps[heap_index].counter;
+}
+
+VulkanMemoryCounter VulkanMemoryTracker::getMemoryTypeCounter(uint32_t memory_type_index) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (memory_type_index >= m_memory_types.size())
+    {
+        return {};
+    }
+
+    return m_memory_types[memory_type_index];
+}
+
+VulkanMemoryCounter VulkanMemoryTracker::getTagCounter(VulkanMemoryTag tag) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (tag >= VulkanMemoryTag::COUNT)
+    {
+        return {};
+    }
+
+    return m_tags[(std::size_t)tag];
+}
+
+std::vector<VulkanMemoryHeapBudget> VulkanMemoryTracker::getHeapBudgets() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    std::vector<VulkanMemoryHeapBudget> heap_budgets{};
+    heap_budgets.reserve(m_heaps.size());
+
+    for (const Heap& heap : m_heaps)
+    {
+        heap_budgets.push_back(getHeapBudget(heap));
+    }
+
+    return heap_budgets;
+}
+
+uint32_t VulkanMemoryTracker::getMaxAllocationCount() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_max_allocation_count;
+}
+
+std::string VulkanMemoryTracker::getJson() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    nlohmann::json heaps = nlohmann::json::array();
+    for (std::size_t i = 0u; i < m_heaps.size(); i++)
+    {
+        const VulkanMemoryHeapBudget heap_budget = getHeapBudget(m_heaps[i]);
+
+        nlohmann::json heap = toJson(m_heaps[i].counter);
+        heap["index"] = i;
+        heap["size"] = heap_budget.heap_size;
+        heap["budget"] = heap_budget.budget;
+        heap["usage"] = heap_budget.usage;
+        heap["projected_usage"] = heap_budget.projected_usage;
+
+        heaps.push_back(std::move(heap));
+    }
+
+    nlohmann::json memory_types = nlohmann::json::array();
+    for (std::size_t i = 0u; i < m_memory_types.size(); i++)
+    {
+        nlohmann::json memory_type = toJson(m_memory_types[i]);
+        memory_type["index"] = i;
+
+        memory_types.push_back(std::move(memory_type));
+    }
+
+    nlohmann::json tags = nlohmann::json::object();
+    for (std::size_t i = 0u; i < m_tags.size(); i++)
+    {
+        tags[getVulkanMemoryTagName((VulkanMemoryTag)i)] = toJson(m_tags[i]);
+    }
+
+    nlohmann::json json{};
+    json["memory_budget"] = m_memory_budget;
+    json["max_allocation_count"] = m_max_allocation_count;
+    json["warning_fraction"] = m_warning_fraction;
+    json["total"] = toJson(m_total);
+    json["heaps"] = std::move(heaps);
+    json["memory_types"] = std::move(memory_types);
+    json["tags"] = std::move(tags);
+
+    return json.dump(4);
+}
+
+bool VulkanMemoryTracker::saveJson(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << getJson() << "\n";
+
+    return file.good();
+}
+
+VulkanMemoryTracker& getVulkanMemoryTracker()
+{
+    static VulkanMemoryTracker memory_tracker{};
+
+    return memory_tracker;
+}
@@ -0,0 +1,176 @@
+#ifndef GPU_VULKAN_UTILITY_VULKANMEMORYTRACKER_H_
+#define GPU_VULKAN_UTILITY_VULKANMEMORYTRACKER_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <volk.h>
+
+// Owner of a device memory allocation.
+enum class VulkanMemoryTag : uint32_t
+{
+    GPU_BUFFER,
+    TEXTURE,
+    STAGING,
+    DESCRIPTOR,
+    ATTACHMENT,
+    OTHER,
+    COUNT
+};
+
+const char* getVulkanMemoryTagName(VulkanMemoryTag tag);
+
+struct VulkanMemoryCounter
+{
+    uint64_t live_bytes{ 0u };
+    uint64_t peak_bytes{ 0u };
+
+    uint32_t live_count{ 0u };
+    uint32_t peak_count{ 0u };
+
+    // Allocations since the start, freed ones included.
+    uint64_t total_count{ 0u };
+};
+
+struct VulkanMemoryHeapBudget
+{
+    VkDeviceSize heap_size{ 0u };
+
+    // Without VK_EXT_memory_budget the heap size and the tracked usage.
+    VkDeviceSize budget{ 0u };
+    VkDeviceSize usage{ 0u };
+
+    // Usage of the last query plus what was allocated and freed since.
+    VkDeviceSize projected_usage{ 0u };
+};
+
+struct VulkanMemoryWarning
+{
+    uint32_t heap_index{ 0u };
+
+    VulkanMemoryHeapBudget heap_budget{};
+
+    // The allocation which crossed the threshold.
+    VkDeviceSize allocation_size{ 0u };
+    VulkanMemoryTag tag{ VulkanMemoryTag::OTHER };
+};
+
+// Accounts every vkAllocateMemory of the SDK by heap, memory type and owner tag.
+// Allocations are recorded without init(), which is needed for the heap sizes and the budget.
+// A warning is raised once projected usage of a heap crosses a fraction of its budget and re-armed once it falls below.
+class VulkanMemoryTracker
+{
+
+private:
+
+    struct Allocation
+    {
+        VkDeviceSize size{ 0u };
+
+        uint32_t memory_type_index{ 0u };
+        uint32_t heap_index{ 0u };
+
+        VulkanMemoryTag tag{ VulkanMemoryTag::OTHER };
+    };
+
+    struct Heap
+    {
+        VulkanMemoryCounter counter{};
+
+        VkDeviceSize size{ 0u };
+
+        // Values of the last budget query, and the tracked bytes at that time.
+        VkDeviceSize budget{ 0u };
+        VkDeviceSize usage{ 0u };
+        uint64_t queried_live_bytes{ 0u };
+
+        bool warned{ false };
+    };
+
+    mutable std::mutex m_mutex{};
+
+    VkPhysicalDevice m_physical_device{ VK_NULL_HANDLE };
+    bool m_memory_budget{ false };
+    uint32_t m_max_allocation_count{ 0u };
+
+    std::unordered_map<VkDeviceMemory, Allocation> m_allocations{};
+
+    VulkanMemoryCounter m_total{};
+    std::vector<Heap> m_heaps{};
+    std::vector<VulkanMemoryCounter> m_memory_types{};
+    std::array<VulkanMemoryCounter, (std::size_t)VulkanMemoryTag::COUNT> m_tags{};
+
+    double m_warning_fraction{ 0.9 };
+    std::function<void(const VulkanMemoryWarning&)> m_warning_callback{};
+
+    static void add(VulkanMemoryCounter& counter, VkDeviceSize size);
+
+    static void remove(VulkanMemoryCounter& counter, VkDeviceSize size);
+
+    Heap& getHeap(uint32_t heap_index);
+
+    VulkanMemoryHeapBudget getHeapBudget(const Heap& heap) const;
+
+    void removeAllocation(VkDeviceMemory device_memory);
+
+public:
+
+    VulkanMemoryTracker(const VulkanMemoryTracker&) = delete;
+    VulkanMemoryTracker(VulkanMemoryTracker&&) = delete;
+
+    VulkanMemoryTracker operator=(const VulkanMemoryTracker&) = delete;
+    VulkanMemoryTracker operator=(VulkanMemoryTracker&&) = delete;
+
+    VulkanMemoryTracker() = default;
+
+    // memory_budget tells that VK_EXT_memory_budget is enabled on the device. Queries the budget once.
+    void init(VkPhysicalDevice physical_device, bool memory_budget);
+
+    // Keeps the counters, but forgets the physical device.
+    void terminate();
+
+    // Forgets all allocations and counters.
+    void reset();
+
+    void onAllocate(VkDeviceMemory device_memory, VkDeviceSize size, uint32_t memory_type_index, uint32_t heap_index, VulkanMemoryTag tag);
+
+    void onFree(VkDeviceMemory device_memory);
+
+    // Queries VK_EXT_memory_budget, if enabled. Cheap enough to be done once per frame.
+    void updateBudget();
+
+    // Fraction of the budget, which raises a warning. Default is 0.9.
+    void setWarningFraction(double warning_fraction);
+
+    double getWarningFraction() const;
+
+    // Called outside of the lock. Without a callback, the warning is printed.
+    void setWarningCallback(std::function<void(const VulkanMemoryWarning&)> warning_callback);
+
+    VulkanMemoryCounter getTotal() const;
+
+    VulkanMemoryCounter getHeapCounter(uint32_t heap_index) const;
+
+    VulkanMemoryCounter getMemoryTypeCounter(uint32_t memory_type_index) const;
+
+    VulkanMemoryCounter getTagCounter(VulkanMemoryTag tag) const;
+
+    std::vector<VulkanMemoryHeapBudget> getHeapBudgets() const;
+
+    // maxMemoryAllocationCount of the device, 0 before init().
+    uint32_t getMaxAllocationCount() const;
+
+    std::string getJson() const;
+
+    bool saveJson(const std::string& filename) const;
+};
+
+// Process wide tracker used by the SDK.
+VulkanMemoryTracker& getVulkanMemoryTracker();
+
+#endif /* GPU_VULKAN_UTILITY_VULKANMEMORYTRACKER_H_ */
@@ -0,0 +1,258 @@
+#include "VulkanTimestampProfiler.h"
+
+#include <algorithm>
+#include <string>
+
+#include "gpu/vulkan/factory/VulkanQueryPoolFactory.h"
+#include "gpu/vulkan/utility/vulkan_query.h"
+
+namespace
+{
+
+constexpr uint32_t INVALID_ZONE = UINT32_MAX;
+
+} // namespace
+
+bool VulkanTimestampProfiler::resolveFrame(uint32_t frame_queries_index, bool complete)
+{
+    FrameQueries& frame_queries = m_frame_queries[frame_queries_index];
+    if (!frame_queries.pending)
+    {
+        return true;
+    }
+
+    const uint32_t first_query = frame_queries_index * m_queries_per_frame;
+
+    // Value and availability per query. VK_NOT_READY still writes the available ones.
+    m_results.assign(frame_queries.used_queries * 2u, 0u);
+    auto result = vkGetQueryPoolResults(m_device, m_query_pool, first_query, frame_queries.used_queries, m_results.size() * sizeof(uint64_t), m_results.data(), 2u * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (result != VK_SUCCESS && result != VK_NOT_READY)
+    {
+        return complete;
+    }
+
+    auto isAvailable = [&](uint32_t query) { return m_results[(query - first_query) * 2u + 1u] != 0u; };
+    auto getTicks = [&](uint32_t query) { return m_results[(query - first_query) * 2u] & m_timestamp_mask; };
+
+    for (const Zone& zone : frame_queries.zones)
+    {
+        if (zone.ended && (!isAvailable(zone.begin_query) || !isAvailable(zone.end_query)) && !complete)
+        {
+            return false;
+        }
+    }
+
+    // The first zone anchors the frame on the CPU timeline.
+    uint64_t base_ticks{ 0u };
+    if (!frame_queries.zones.empty() && isAvailable(frame_queries.zones[0].begin_query))
+    {
+        base_ticks = getTicks(frame_queries.zones[0].begin_query);
+    }
+
+    for (const Zone& zone : frame_queries.zones)
+    {
+        if (!zone.ended || !isAvailable(zone.begin_query) || !isAvailable(zone.end_query))
+        {
+            continue;
+        }
+
+        // Differences of the masked values survive a wrap around of the counter.
+        uint64_t offset_ticks = (getTicks(zone.begin_query) - base_ticks) & m_timestamp_mask;
+        if (offset_ticks > (m_timestamp_mask >> 1u))
+        {
+            offset_ticks = 0u;
+        }
+
+        const double offset_ns = (double)offset_ticks * m_timestamp_period;
+        const double duration_ns = (double)((getTicks(zone.end_query) - getTicks(zone.begin_query)) & m_timestamp_mask) * m_timestamp_period;
+
+        const int64_t begin_ns = frame_queries.cpu_time_ns + (int64_t)offset_ns;
+        m_profiler.addGpuZone(frame_queries.frame_index, m_track, zone.name, begin_ns, begin_ns + (int64_t)duration_ns);
+    }
+
+    frame_queries.zones.clear();
+    frame_queries.pending = false;
+
+    return true;
+}
+
+VulkanTimestampProfiler::VulkanTimestampProfiler(VkPhysicalDevice physical_device, VkDevice device, uint32_t queue_family_index, uint32_t frames_in_flight, uint32_t max_zones_per_frame, Profiler& profiler) :
+    m_physical_device{ physical_device },
+    m_device{ device },
+    m_queue_family_index{ queue_family_index },
+    m_profiler{ profiler },
+    m_frames_in_flight{ std::max(1u, frames_in_flight) },
+    m_queries_per_frame{ 2u * std::max(1u, max_zones_per_frame) }
+{
+    m_track = m_profiler.addTrack("GPU queue family " + std::to_string(queue_family_index));
+}
+
+VulkanTimestampProfiler::~VulkanTimestampProfiler()
+{
+    terminate();
+}
+
+bool VulkanTimestampProfiler::init()
+{
+    terminate();
+
+    auto queue_family_properties = gatherPhysicalDeviceQueueFamilyProperties2(m_physical_device);
+    if (m_queue_family_index >= queue_family_properties.size())
+    {
+        return false;
+    }
+
+    const uint32_t timestamp_valid_bits = queue_family_properties[m_queue_family_index].queueFamilyProperties.timestampValidBits;
+    if (timestamp_valid_bits == 0u)
+    {
+        return false;
+    }
+    m_timestamp_mask = timestamp_valid_bits >= 64u ? UINT64_MAX : ((1ull << timestamp_valid_bits) - 1ull);
+
+    auto physical_device_properties2 = gatherPhysicalDeviceProperties2(m_physical_device);
+    m_timestamp_period = (double)physical_device_properties2.properties.limits.timestampPeriod;
+
+    const uint32_t query_count = m_frames_in_flight * m_queries_per_frame;
+
+    VulkanQueryPoolFactory query_pool_factory{ m_device, VK_QUERY_TYPE_TIMESTAMP, query_count };
+    m_query_pool = query_pool_factory.create();
+    if (m_query_pool == VK_NULL_HANDLE)
+    {
+        return false;
+    }
+
+    // Queries have to be reset before their first use.
+    vkResetQueryPool(m_device, m_query_pool, 0u, query_count);
+
+    m_frame_queries.assign(m_frames_in_flight, FrameQueries{});
+    m_frame_queries_index = m_frames_in_flight - 1u;
+
+    return true;
+}
+
+void VulkanTimestampProfiler::terminate()
+{
+    if (m_query_pool != VK_NULL_HANDLE)
+    {
+        vkDestroyQueryPool(m_device, m_query_pool, nullptr);
+        m_query_pool = VK_NULL_HANDLE;
+    }
+
+    m_frame_queries.clear();
+    m_frame_queries_index = 0u;
+
+    m_recording = false;
+}
+
+bool VulkanTimestampProfiler::isValid() const
+{
+    return m_query_pool != VK_NULL_HANDLE;
+}
+
+void VulkanTimestampProfiler::beginFrame(bool completed)
+{
+    m_recording = false;
+
+    if (!isValid())
+    {
+        return;
+    }
+
+    m_frame_queries_index = (m_frame_queries_index + 1u) % m_frames_in_flight;
+
+    FrameQueries& frame_queries = m_frame_queries[m_frame_queries_index];
+    if (!resolveFrame(m_frame_queries_index, completed))
+    {
+        return;
+    }
+
+    if (frame_queries.used_queries > 0u)
+    {
+        vkResetQueryPool(m_device, m_query_pool, m_frame_queries_index * m_queries_per_frame, frame_queries.used_queries);
+    }
+
+    frame_queries.frame_index = m_profiler.getFrameIndex();
+    frame_queries.cpu_time_ns = m_profiler.getTimeNs();
+    frame_queries.zones.clear();
+    frame_queries.used_queries = 0u;
+    frame_queries.pending = false;
+
+    m_recording = m_profiler.isEnabled();
+}
+
+void VulkanTimestampProfiler::endFrame()
+{
+    m_recording = false;
+}
+
+void VulkanTimestampProfiler::resolve()
+{
+    for (uint32_t i = 0u; i < m_frame_queries.size(); i++)
+    {
+        // A range being recorded is read after endFrame().
+        if (m_recording && i == m_frame_queries_index)
+        {
+            continue;
+        }
+
+        resolveFrame(i, false);
+    }
+}
+
+uint32_t VulkanTimestampProfiler::beginZone(VkCommandBuffer command_buffer, const char* name, VkPipelineStageFlags2 stage)
+{
+    if (!m_recording)
+    {
+        return INVALID_ZONE;
+    }
+
+    FrameQueries& frame_queries = m_frame_queries[m_frame_queries_index];
+    if (frame_queries.used_queries + 2u > m_queries_per_frame)
+    {
+        return INVALID_ZONE;
+    }
+
+    Zone zone{};
+    zone.name = name;
+    zone.begin_query = m_frame_queries_index * m_queries_per_frame + frame_queries.used_queries;
+    zone.end_query = zone.begin_query + 1u;
+
+    frame_queries.used_queries += 2u;
+    frame_queries.pending = true;
+
+    vkCmdWriteTimestamp2(command_buffer, stage, m_query_pool, zone.begin_query);
+
+    frame_queries.zones.push_back(zone);
+
+    return (uint32_t)(frame_queries.zones.size() - 1u);
+}
+
+void VulkanTimestampProfiler::endZone(VkCommandBuffer command_buffer, uint32_t zone, VkPipelineStageFlags2 stage)
+{
+    if (!m_recording || zone == INVALID_ZONE)
+    {
+        return;
+    }
+
+    FrameQueries& frame_queries = m_frame_queries[m_frame_queries_index];
+    if (zone >= frame_queries.zones.size() || frame_queries.zones[zone].ended)
+    {
+        return;
+    }
+
+    vkCmdWriteTimestamp2(command_buffer, stage, m_query_pool, frame_queries.zones[zone].end_query);
+
+    frame_queries.zones[zone].ended = true;
+}
+
+VulkanTimestampZone::VulkanTimestampZone(VulkanTimestampProfiler& timestamp_profiler, VkCommandBuffer command_buffer, const char* name) :
+    m_timestamp_profiler{ timestamp_profiler },
+    m_command_buffer{ command_buffer }
+{
+    m_zone = m_timestamp_profiler.beginZone(m_command_buffer, name);
+}
+
+VulkanTimestampZone::~VulkanTimestampZone()
+{
+    m_timestamp_profiler.endZone(m_command_buffer, m_zone);
+}
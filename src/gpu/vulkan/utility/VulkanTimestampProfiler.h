@@ -0,0 +1,131 @@
+#ifndef GPU_VULKAN_UTILITY_VULKANTIMESTAMPPROFILER_H_
+#define GPU_VULKAN_UTILITY_VULKANTIMESTAMPPROFILER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <volk.h>
+
+#include "core/utility/Profiler.h"
+
+// Brackets command buffer regions with vkCmdWriteTimestamp2 and hands the durations to the profiler.
+// Every frame uses its own range of the query pool. A range is read once the GPU is done with it, usually
+// a few frames later, and is reset on the host, so nothing waits for the GPU.
+// GPU zones keep their exact durations and order. On the CPU timeline a frame starts at its beginFrame().
+class VulkanTimestampProfiler
+{
+
+private:
+
+    struct Zone
+    {
+        const char* name{ nullptr };
+
+        uint32_t begin_query{ 0u };
+        uint32_t end_query{ 0u };
+
+        bool ended{ false };
+    };
+
+    struct FrameQueries
+    {
+        uint64_t frame_index{ 0u };
+        int64_t cpu_time_ns{ 0 };
+
+        std::vector<Zone> zones{};
+        uint32_t used_queries{ 0u };
+
+        // Written by the GPU and not yet read.
+        bool pending{ false };
+    };
+
+    VkPhysicalDevice m_physical_device{ VK_NULL_HANDLE };
+    VkDevice m_device{ VK_NULL_HANDLE };
+    uint32_t m_queue_family_index{ 0u };
+
+    Profiler& m_profiler;
+    uint32_t m_track{ 0u };
+
+    uint32_t m_frames_in_flight{ 0u };
+    uint32_t m_queries_per_frame{ 0u };
+
+    VkQueryPool m_query_pool{ VK_NULL_HANDLE };
+
+    double m_timestamp_period{ 1.0 };
+    uint64_t m_timestamp_mask{ 0u };
+
+    std::vector<FrameQueries> m_frame_queries{};
+    uint32_t m_frame_queries_index{ 0u };
+
+    // False outside of a frame and while the current range is still in use by the GPU.
+    bool m_recording{ false };
+
+    std::vector<uint64_t> m_results{};
+
+    // Complete means the GPU is known to be done with the range, so missing results are given up.
+    bool resolveFrame(uint32_t frame_queries_index, bool complete);
+
+public:
+
+    VulkanTimestampProfiler() = delete;
+
+    VulkanTimestampProfiler(const VulkanTimestampProfiler&) = delete;
+    VulkanTimestampProfiler(VulkanTimestampProfiler&&) = delete;
+
+    VulkanTimestampProfiler operator=(const VulkanTimestampProfiler&) = delete;
+    VulkanTimestampProfiler operator=(VulkanTimestampProfiler&&) = delete;
+
+    VulkanTimestampProfiler(VkPhysicalDevice physical_device, VkDevice device, uint32_t queue_family_index, uint32_t frames_in_flight = 3u, uint32_t max_zones_per_frame = 128u, Profiler& profiler = getProfiler());
+
+    ~VulkanTimestampProfiler();
+
+    // Fails if the queue family does not support timestamps. All other calls do nothing then.
+    bool init();
+
+    void terminate();
+
+    bool isValid() const;
+
+    // Switches to the range of the oldest frame. If its results are not available yet, this frame is not measured.
+    // completed tells that the GPU finished the range, e.g. after waiting for the fence of the frame.
+    void beginFrame(bool completed = false);
+
+    // Ends recording into the range of this frame.
+    void endFrame();
+
+    // Reads all ranges the GPU has finished, without waiting.
+    void resolve();
+
+    // Returns an id for endZone(). Zones beyond max_zones_per_frame are dropped.
+    uint32_t beginZone(VkCommandBuffer command_buffer, const char* name, VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    void endZone(VkCommandBuffer command_buffer, uint32_t zone, VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+};
+
+// Measures the commands recorded in the enclosing scope.
+class VulkanTimestampZone
+{
+
+private:
+
+    VulkanTimestampProfiler& m_timestamp_profiler;
+    VkCommandBuffer m_command_buffer{ VK_NULL_HANDLE };
+
+    uint32_t m_zone{ 0u };
+
+public:
+
+    VulkanTimestampZone() = delete;
+
+    VulkanTimestampZone(const VulkanTimestampZone&) = delete;
+    VulkanTimestampZone(VulkanTimestampZone&&) = delete;
+
+    VulkanTimestampZone operator=(const VulkanTimestampZone&) = delete;
+    VulkanTimestampZone operator=(VulkanTimestampZone&&) = delete;
+
+    VulkanTimestampZone(VulkanTimestampProfiler& timestamp_profiler, VkCommandBuffer command_buffer, const char* name);
+
+    ~VulkanTimestampZone();
+};
+
+#endif /* GPU_VULKAN_UTILITY_VULKANTIMESTAMPPROFILER_H_ */
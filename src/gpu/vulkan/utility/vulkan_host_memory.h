@@ -6,6 +6,8 @@
 
 #include <volk.h>
 
+#include "core/utility/AlignedBuffer.h"
+
 template<class T>
 bool deviceToHost(VkDevice device, VkDeviceMemory device_memory, VkDeviceSize offset, VkDeviceSize size, std::vector<T>& content)
 {
@@ -40,6 +42,41 @@ bool deviceToHost(VkDevice device, VkDeviceMemory device_memory, VkDeviceSize of
     return true;
 }
 
+template<class T>
+bool deviceToHost(VkDevice device, VkDeviceMemory device_memory, VkDeviceSize offset, VkDeviceSize size, AlignedBuffer<T>& content)
+{
+    if (size % sizeof(T) != 0u)
+    {
+        return false;
+    }
+
+    void* mapped_memory{ nullptr };
+    VkMemoryMapInfo map_info{};
+    map_info.sType = VK_STRUCTURE_TYPE_MEMORY_MAP_INFO;
+    map_info.memory = device_memory;
+    map_info.offset = offset;
+    map_info.size = size;
+
+    auto result = vkMapMemory2(device, &map_info, &mapped_memory);
+    if (result != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    // Not zero filled, the copy overwrites every element.
+    content.resize(size / sizeof(T));
+
+    std::memcpy(content.data(), mapped_memory, size);
+
+    VkMemoryUnmapInfo unmap_info{};
+    unmap_info.sType = VK_STRUCTURE_TYPE_MEMORY_UNMAP_INFO;
+    unmap_info.memory = device_memory;
+
+    vkUnmapMemory2(device, &unmap_info);
+
+    return true;
+}
+
 template<class T>
 bool deviceToHost(VkDevice device, VkDeviceMemory device_memory, VkDeviceSize offset, VkDeviceSize size, T& content)
 {
@@ -106,6 +143,38 @@ bool hostToDevice(VkDevice device, VkDeviceMemory device_memory, VkDeviceSize of
     return true;
 }
 
+template<class T>
+bool hostToDevice(VkDevice device, VkDeviceMemory device_memory, VkDeviceSize offset, VkDeviceSize size, const AlignedBuffer<T>& content)
+{
+    if (size < content.size() * sizeof(T))
+    {
+        return false;
+    }
+
+    void* mapped_memory{ nullptr };
+    VkMemoryMapInfo map_info{};
+    map_info.sType = VK_STRUCTURE_TYPE_MEMORY_MAP_INFO;
+    map_info.memory = device_memory;
+    map_info.offset = offset;
+    map_info.size = size;
+
+    auto result = vkMapMemory2(device, &map_info, &mapped_memory);
+    if (result != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    std::memcpy(mapped_memory, content.data(), content.size() * sizeof(T));
+
+    VkMemoryUnmapInfo unmap_info{};
+    unmap_info.sType = VK_STRUCTURE_TYPE_MEMORY_UNMAP_INFO;
+    unmap_info.memory = device_memory;
+
+    vkUnmapMemory2(device, &unmap_info);
+
+    return true;
+}
+
 template<class T>
 bool hostToDevice(VkDevice device, VkDeviceMemory device_memory, VkDeviceSize offset, VkDeviceSize size, const T& content)
 {
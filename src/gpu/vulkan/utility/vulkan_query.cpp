@@ -168,6 +168,18 @@ VkPhysicalDeviceMemoryProperties2 gatherPhysicalDeviceMemoryProperties2(VkPhysic
     return physical_device_memory_properties2;
 }
 
+VkPhysicalDeviceMemoryBudgetPropertiesEXT gatherPhysicalDeviceMemoryBudgetPropertiesEXT(VkPhysicalDevice physical_device)
+{
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT memory_budget_properties{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT };
+
+    VkPhysicalDeviceMemoryProperties2 physical_device_memory_properties2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2 };
+    physical_device_memory_properties2.pNext = &memory_budget_properties;
+
+    vkGetPhysicalDeviceMemoryProperties2(physical_device, &physical_device_memory_properties2);
+
+    return memory_budget_properties;
+}
+
 VkFormatProperties2 gatherPhysicalDeviceFormatProperties2(VkPhysicalDevice physical_device, VkFormat format)
 {
     VkFormatProperties2 format_properties2{ VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2 };
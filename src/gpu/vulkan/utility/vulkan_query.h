@@ -31,6 +31,9 @@ VkPhysicalDeviceVulkan14Features gatherPhysicalDeviceVulkan14Features(VkPhysical
 
 VkPhysicalDeviceMemoryProperties2 gatherPhysicalDeviceMemoryProperties2(VkPhysicalDevice physical_device);
 
+// Requires VK_EXT_memory_budget.
+VkPhysicalDeviceMemoryBudgetPropertiesEXT gatherPhysicalDeviceMemoryBudgetPropertiesEXT(VkPhysicalDevice physical_device);
+
 VkFormatProperties2 gatherPhysicalDeviceFormatProperties2(VkPhysicalDevice physical_device, VkFormat format);
 
 VkPhysicalDeviceDescriptorBufferPropertiesEXT gatherPhysicalDeviceDescriptorBufferPropertiesEXT(VkPhysicalDevice physical_device);
@@ -8,7 +8,9 @@
 
 #include "gpu/vulkan/utility/VulkanFilter.h"
 #include "gpu/vulkan/utility/VulkanFrame.h"
+#include "gpu/vulkan/utility/VulkanMemoryTracker.h"
 #include "gpu/vulkan/utility/VulkanSetup.h"
+#include "gpu/vulkan/utility/VulkanTimestampProfiler.h"
 #include "gpu/vulkan/utility/vulkan_helper.h"
 #include "gpu/vulkan/utility/vulkan_host_memory.h"
 #include "gpu/vulkan/utility/vulkan_query.h"
@@ -29,6 +31,7 @@
 #include "gpu/vulkan/factory/VulkanImageViewFactory.h"
 #include "gpu/vulkan/factory/VulkanInstanceFactory.h"
 #include "gpu/vulkan/factory/VulkanPipelineLayoutFactory.h"
+#include "gpu/vulkan/factory/VulkanQueryPoolFactory.h"
 #include "gpu/vulkan/factory/VulkanSamplerFactory.h"
 #include "gpu/vulkan/factory/VulkanSemaphoreFactory.h"
 #include "gpu/vulkan/factory/VulkanShaderModuleFactory.h"
@@ -1,3 +1,6 @@
+#include <cmath>
+#include <numbers>
+
 #include <gtest/gtest.h>
 
 #include "core/core.h"
@@ -182,3 +185,369 @@ TEST(TestImage, GenerateMipMapsFromFile)
     // Save the smallest mip to verify pixel data was written
     EXPECT_FALSE(last.pixels.empty());
 }
+
+TEST(TestImage, LoadImageDataAsync)
+{
+    auto future = loadImageDataAsync("../resources/images/color_grid.png");
+    auto image_data = future.get();
+
+    ASSERT_TRUE(image_data.has_value());
+
+    auto expected = loadImageData("../resources/images/color_grid.png");
+    ASSERT_TRUE(expected.has_value());
+
+    EXPECT_EQ(image_data->width, expected->width);
+    EXPECT_EQ(image_data->height, expected->height);
+    EXPECT_EQ(image_data->pixels, expected->pixels);
+}
+
+TEST(TestImage, LoadImageDataBatch)
+{
+    std::vector<std::string> filenames{ "../resources/images/color_grid.png", "../resources/images/does_not_exist.png", "../resources/images/red.png" };
+
+    ImageLoadStages stages{};
+    stages.channels = 4u;
+    stages.generate_mip_maps = true;
+
+    auto images = loadImageDataBatch(filenames, stages, 2u);
+
+    ASSERT_EQ(images.size(), 3u);
+    EXPECT_TRUE(images[1].empty());
+
+    for (std::size_t i : { 0u, 2u })
+    {
+        ASSERT_GT(images[i].size(), 1u);
+        EXPECT_EQ(images[i][0].channels, 4u);
+        EXPECT_EQ(images[i].back().width, 1u);
+        EXPECT_EQ(images[i].back().height, 1u);
+    }
+}
+
+ImageData createDirectionEquirectangular(uint32_t width, uint32_t height)
+{
+    // Encodes the direction of every texel as color, so the cube faces can be checked against the expected axes.
+    ImageData image_data{};
+    image_data.width = width;
+    image_data.height = height;
+    image_data.channels = 3u;
+    image_data.channel_format = ChannelFormat::SFLOAT;
+    image_data.primaries = ColorPrimaries::REC709;
+    image_data.transfer = TransferFunction::LINEAR;
+    image_data.image_state = ImageState::SCENE;
+    image_data.pixels.resize(width * height * 3u * sizeof(float));
+
+    float* pixels = (float*)image_data.pixels.data();
+    for (uint32_t y = 0u; y < height; y++)
+    {
+        for (uint32_t x = 0u; x < width; x++)
+        {
+            float phi = (((float)x + 0.5f) / (float)width - 0.5f) * 2.0f * std::numbers::pi_v<float>;
+            float theta = (0.5f - ((float)y + 0.5f) / (float)height) * std::numbers::pi_v<float>;
+
+            float* pixel = &pixels[(y * width + x) * 3u];
+            pixel[0] = std::cos(theta) * std::cos(phi);
+            pixel[1] = std::sin(theta);
+            pixel[2] = std::cos(theta) * std::sin(phi);
+        }
+    }
+
+    return image_data;
+}
+
+TEST(TestImage, EquirectangularToCubeFaceDirections)
+{
+    ImageData equirectangular = createDirectionEquirectangular(256u, 128u);
+
+    auto cube = convertEquirectangularToCube(32u, ResampleFilter::BILINEAR, equirectangular);
+    ASSERT_TRUE(cube.has_value());
+    EXPECT_EQ(cube->width, 32u);
+    EXPECT_EQ(cube->height, 32u * 6u);
+    EXPECT_EQ(cube->pixels.size(), 32u * 32u * 6u * 3u * sizeof(float));
+
+    // Face centers in Vulkan order +X, -X, +Y, -Y, +Z, -Z
+    const float expected[6][3]{ { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+
+    const float* pixels = (const float*)cube->pixels.data();
+    for (uint32_t face = 0u; face < 6u; face++)
+    {
+        // Average the four center texels, as the exact center lies between them
+        for (uint32_t c = 0u; c < 3u; c++)
+        {
+            float sum = 0.0f;
+            for (uint32_t y : { 15u, 16u })
+            {
+                for (uint32_t x : { 15u, 16u })
+                {
+                    sum += pixels[((face * 32u + y) * 32u + x) * 3u + c];
+                }
+            }
+
+            EXPECT_NEAR(sum * 0.25f, expected[face][c], 0.02f) << "face " << face << " channel " << c;
+        }
+    }
+}
+
+TEST(TestImage, CubeToEquirectangularRoundTrip)
+{
+    ImageData equirectangular = createDirectionEquirectangular(128u, 64u);
+
+    auto cube = convertEquirectangularToCube(64u, ResampleFilter::BICUBIC, equirectangular);
+    ASSERT_TRUE(cube.has_value());
+
+    auto result = convertCubeToEquirectangular(128u, 64u, ResampleFilter::BICUBIC, *cube);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->pixels.size(), equirectangular.pixels.size());
+
+    const float* expected = (const float*)equirectangular.pixels.data();
+    const float* actual = (const float*)result->pixels.data();
+
+    // The rows next to the poles are excluded, the equirectangular texels there are heavily stretched
+    for (uint32_t y = 4u; y < 60u; y++)
+    {
+        for (uint32_t i = 0u; i < 128u * 3u; i++)
+        {
+            EXPECT_NEAR(actual[y * 128u * 3u + i], expected[y * 128u * 3u + i], 0.05f);
+        }
+    }
+}
+
+TEST(TestImage, ResizeCubeConstant)
+{
+    ImageData cube{};
+    cube.width = 16u;
+    cube.height = 16u * 6u;
+    cube.channels = 4u;
+    cube.channel_format = ChannelFormat::UNORM;
+    cube.primaries = ColorPrimaries::REC709;
+    cube.transfer = TransferFunction::SRGB;
+    cube.image_state = ImageState::SCENE;
+    cube.pixels.resize(16u * 16u * 6u * 4u, 77u);
+
+    auto resized = resizeCube(40u, ResampleFilter::BICUBIC, cube);
+    ASSERT_TRUE(resized.has_value());
+    EXPECT_EQ(resized->width, 40u);
+    EXPECT_EQ(resized->height, 240u);
+    EXPECT_EQ(resized->transfer, TransferFunction::SRGB);
+
+    for (uint8_t value : resized->pixels)
+    {
+        EXPECT_EQ(value, 77u);
+    }
+
+    // Not a cube layout
+    cube.height = 16u;
+    cube.pixels.resize(16u * 16u * 4u);
+    EXPECT_FALSE(resizeCube(8u, ResampleFilter::BILINEAR, cube).has_value());
+}
+
+ImageData createConstantImage(uint32_t width, uint32_t height, uint32_t channels, ChannelFormat channel_format, float value)
+{
+    ImageData image_data{};
+    image_data.width = width;
+    image_data.height = height;
+    image_data.channels = channels;
+    image_data.channel_format = channel_format;
+    image_data.primaries = ColorPrimaries::REC709;
+    image_data.transfer = TransferFunction::LINEAR;
+    image_data.image_state = ImageState::SCENE;
+    image_data.pixels.resize(width * height * channels * getChannelFormatSize(channel_format));
+
+    std::vector<float> rgba(width * height * 4u, value);
+    encodePixels(rgba.data(), width * height, channel_format, channels, image_data.pixels.data());
+
+    return image_data;
+}
+
+TEST(TestImage, ResizeBoxAverage)
+{
+    ImageData image_data = createConstantImage(4u, 2u, 1u, ChannelFormat::UNORM, 0.0f);
+    image_data.pixels = { 10u, 20u, 30u, 40u, 50u, 60u, 70u, 80u };
+
+    auto resized = resizeImageData(2u, 1u, FilterKernel::BOX, image_data);
+    ASSERT_TRUE(resized.has_value());
+    ASSERT_EQ(resized->pixels.size(), 2u);
+
+    EXPECT_EQ(resized->pixels[0], 35u);
+    EXPECT_EQ(resized->pixels[1], 55u);
+}
+
+TEST(TestImage, ResizeKernelsPreserveConstant)
+{
+    for (ChannelFormat channel_format : { ChannelFormat::UNORM, ChannelFormat::SHALF, ChannelFormat::SFLOAT })
+    {
+        for (FilterKernel kernel : { FilterKernel::BOX, FilterKernel::TENT, FilterKernel::GAUSSIAN, FilterKernel::MITCHELL, FilterKernel::LANCZOS3 })
+        {
+            ImageData image_data = createConstantImage(37u, 23u, 3u, channel_format, 0.5f);
+
+            for (auto [width, height] : { std::pair{ 100u, 70u }, std::pair{ 9u, 5u }, std::pair{ 1u, 1u } })
+            {
+                auto resized = resizeImageData(width, height, kernel, image_data);
+                ASSERT_TRUE(resized.has_value());
+                EXPECT_EQ(resized->width, width);
+                EXPECT_EQ(resized->height, height);
+                EXPECT_EQ(resized->channel_format, channel_format);
+
+                std::vector<float> rgba(width * height * 4u);
+                decodePixels(resized->pixels.data(), channel_format, 3u, width * height, rgba.data());
+                for (uint32_t i = 0u; i < width * height; i++)
+                {
+                    for (uint32_t c = 0u; c < 3u; c++)
+                    {
+                        EXPECT_NEAR(rgba[i * 4u + c], 0.5f, 0.003f);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(TestImage, BlurImpulse)
+{
+    ImageData image_data = createConstantImage(15u, 15u, 1u, ChannelFormat::SFLOAT, 0.0f);
+    float* pixels = (float*)image_data.pixels.data();
+    pixels[7u * 15u + 7u] = 1.0f;
+
+    auto blurred = blurImageData(1.5f, image_data);
+    ASSERT_TRUE(blurred.has_value());
+
+    const float* result = (const float*)blurred->pixels.data();
+
+    float sum = 0.0f;
+    for (uint32_t i = 0u; i < 15u * 15u; i++)
+    {
+        sum += result[i];
+    }
+
+    EXPECT_NEAR(sum, 1.0f, 1.0e-4f);
+    EXPECT_LT(result[7u * 15u + 7u], 0.1f);
+    EXPECT_NEAR(result[7u * 15u + 6u], result[6u * 15u + 7u], 1.0e-6f);
+}
+
+TEST(TestImage, SharpenAndConvolve)
+{
+    ImageData image_data = createConstantImage(16u, 8u, 4u, ChannelFormat::UNORM, 0.25f);
+
+    auto sharpened = sharpenImageData(2.0f, 1.5f, image_data);
+    ASSERT_TRUE(sharpened.has_value());
+    EXPECT_EQ(sharpened->pixels, image_data.pixels);
+
+    auto identity = convolveImageData({ 0.0f, 1.0f, 0.0f }, { 1.0f }, image_data);
+    ASSERT_TRUE(identity.has_value());
+    EXPECT_EQ(identity->pixels, image_data.pixels);
+
+    EXPECT_FALSE(convolveImageData({ 0.5f, 0.5f }, { 1.0f }, image_data).has_value());
+}
+
+TEST(TestImage, CubeFaceAndCropViews)
+{
+    ImageData cube = createConstantImage(8u, 48u, 1u, ChannelFormat::UNORM, 0.0f);
+    for (uint32_t i = 0u; i < 8u * 48u; i++)
+    {
+        cube.pixels[i] = (uint8_t)(i / 64u);
+    }
+
+    auto face = getCubeFaceView(3u, makeImageView(cube));
+    ASSERT_TRUE(face.has_value());
+    EXPECT_EQ(face->width, 8u);
+    EXPECT_EQ(face->height, 8u);
+    EXPECT_EQ(face->data, cube.pixels.data() + 3u * 64u);
+    EXPECT_FALSE(getCubeFaceView(6u, makeImageView(cube)).has_value());
+
+    auto crop = cropImageView(2u, 1u, 3u, 2u, *face);
+    ASSERT_TRUE(crop.has_value());
+    EXPECT_EQ(crop->row_pitch, 8u);
+    EXPECT_EQ(crop->data, face->data + 8u + 2u);
+    EXPECT_FALSE(cropImageView(6u, 0u, 3u, 2u, *face).has_value());
+
+    ImageData copy = toImageData(*crop);
+    EXPECT_EQ(copy.pixels, AlignedBuffer<uint8_t>(6u, 3u));
+}
+
+TEST(TestImage, ConvertChannelsInPlace)
+{
+    ImageData image_data = createConstantImage(4u, 4u, 4u, ChannelFormat::UNORM, 0.0f);
+    for (uint32_t i = 0u; i < 4u * 4u * 4u; i++)
+    {
+        image_data.pixels[i] = (uint8_t)i;
+    }
+    const uint8_t* data = image_data.pixels.data();
+
+    auto rgb = convertImageDataChannels(3u, std::move(image_data));
+    ASSERT_TRUE(rgb.has_value());
+    EXPECT_EQ(rgb->pixels.data(), data);
+    ASSERT_EQ(rgb->pixels.size(), 4u * 4u * 3u);
+    for (uint32_t i = 0u; i < 16u; i++)
+    {
+        EXPECT_EQ(rgb->pixels[i * 3u + 0u], i * 4u + 0u);
+        EXPECT_EQ(rgb->pixels[i * 3u + 2u], i * 4u + 2u);
+    }
+
+    auto same = convertImageDataChannels(3u, std::move(*rgb));
+    ASSERT_TRUE(same.has_value());
+    EXPECT_EQ(same->pixels.data(), data);
+
+    // Growing in place inside a buffer with room for the larger layout
+    ImageData gray = createConstantImage(4u, 4u, 1u, ChannelFormat::UNORM, 0.0f);
+    gray.pixels.resize(4u * 4u * 4u);
+    for (uint32_t i = 0u; i < 16u; i++)
+    {
+        gray.pixels[i] = (uint8_t)(i + 1u);
+    }
+
+    MutableImageView source = makeMutableImageView(gray);
+    MutableImageView destination = source;
+    destination.channels = 4u;
+    destination.row_pitch = 16u;
+
+    ASSERT_TRUE(convertImageChannels(source, destination));
+    for (uint32_t i = 0u; i < 16u; i++)
+    {
+        EXPECT_EQ(gray.pixels[i * 4u + 0u], i + 1u);
+        EXPECT_EQ(gray.pixels[i * 4u + 1u], 0u);
+        EXPECT_EQ(gray.pixels[i * 4u + 3u], 255u);
+    }
+}
+
+TEST(TestImage, MipChainViews)
+{
+    EXPECT_EQ(getMipChainSize(4u, 4u, 1u, ChannelFormat::UNORM), 16u + 4u + 1u);
+    EXPECT_EQ(getMipChainSize(4u, 1u, 2u, ChannelFormat::SFLOAT), (4u + 2u + 1u) * 8u);
+
+    ImageData chain = createConstantImage(4u, 4u, 1u, ChannelFormat::SFLOAT, 0.0f);
+    chain.pixels.resize(getMipChainSize(4u, 4u, 1u, ChannelFormat::SFLOAT));
+
+    float* pixels = (float*)chain.pixels.data();
+    for (uint32_t i = 0u; i < 16u; i++)
+    {
+        pixels[i] = (float)i;
+    }
+
+    auto mip_levels = getMipChainViews(makeMutableImageView(chain));
+    ASSERT_EQ(mip_levels.size(), 3u);
+    EXPECT_EQ(mip_levels[1].width, 2u);
+    EXPECT_EQ(mip_levels[2].data, chain.pixels.data() + 20u * sizeof(float));
+
+    ASSERT_TRUE(generateMipMaps(mip_levels));
+    EXPECT_FLOAT_EQ(pixels[16], (0.0f + 1.0f + 4.0f + 5.0f) / 4.0f);
+    EXPECT_FLOAT_EQ(pixels[20], 7.5f);
+}
+
+TEST(TestImage, ConvertColorSpaceInPlace)
+{
+    ImageData image_data = createConstantImage(8u, 8u, 4u, ChannelFormat::SFLOAT, 0.5f);
+    image_data.transfer = TransferFunction::SRGB;
+    const uint8_t* data = image_data.pixels.data();
+
+    auto linear = convertImageDataColorSpace(ColorPrimaries::REC709, TransferFunction::LINEAR, ImageState::SCENE, std::move(image_data));
+    ASSERT_TRUE(linear.has_value());
+    EXPECT_EQ(linear->pixels.data(), data);
+    EXPECT_EQ(linear->transfer, TransferFunction::LINEAR);
+
+    const float* pixels = (const float*)linear->pixels.data();
+    EXPECT_NEAR(pixels[0], 0.214f, 0.001f);
+    EXPECT_FLOAT_EQ(pixels[3], 0.5f);
+
+    auto srgb = convertImageDataColorSpace(ColorPrimaries::REC709, TransferFunction::SRGB, ImageState::SCENE, *linear);
+    ASSERT_TRUE(srgb.has_value());
+    EXPECT_NEAR(((const float*)srgb->pixels.data())[0], 0.5f, 1.0e-4f);
+}
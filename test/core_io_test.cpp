@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core/core.h"
+
+TEST(TestIo, SaveAtomicAndMap)
+{
+    const std::string filename = "../bin/test_io_mapped.bin";
+
+    std::string content(100000u, '\0');
+    for (std::size_t i = 0u; i < content.size(); i++)
+    {
+        content[i] = (char)(i * 31u);
+    }
+
+    ASSERT_TRUE(saveAtomic(content, filename));
+
+    // Replacing an existing file
+    ASSERT_TRUE(saveAtomic(content, filename));
+
+    MappedFile mapped_file{};
+    ASSERT_TRUE(mapped_file.open(filename, MappedFileAccess::RANDOM, true));
+    ASSERT_EQ(mapped_file.getSize(), content.size());
+    EXPECT_EQ(std::memcmp(mapped_file.getData().data(), content.data(), content.size()), 0);
+
+    MappedFile moved = std::move(mapped_file);
+    EXPECT_FALSE(mapped_file.isOpen());
+    EXPECT_TRUE(moved.isOpen());
+    EXPECT_EQ(moved.getData()[1], (std::byte)31u);
+
+    moved.close();
+    EXPECT_TRUE(moved.getData().empty());
+
+    std::filesystem::remove(filename);
+}
+
+TEST(TestIo, MapEmptyAndMissingFile)
+{
+    const std::string filename = "../bin/test_io_empty.bin";
+
+    ASSERT_TRUE(saveAtomic(std::string{}, filename));
+
+    MappedFile mapped_file{};
+    EXPECT_TRUE(mapped_file.open(filename));
+    EXPECT_TRUE(mapped_file.getData().empty());
+
+    std::filesystem::remove(filename);
+
+    EXPECT_FALSE(mapped_file.open("../bin/does_not_exist.bin"));
+    EXPECT_FALSE(mapped_file.isOpen());
+}
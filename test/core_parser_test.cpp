@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "core/parser/parser.h"
@@ -100,3 +108,444 @@ TEST(EBNF_Parser, Exception)
     auto result2 = non_zero.parse(text2, 0);
     EXPECT_FALSE(result2.success);
 }
+
+// Test that values and callbacks reference the parsed text instead of copying it
+TEST(EBNF_Parser, ZeroCopy)
+{
+    const std::string text{ "abcdefghijklmnopqrstuvwxyz0123456789" };
+
+    auto letters = std::make_shared<ebnf::IntervalCharacterRule>('a', 'z');
+    auto digits = std::make_shared<ebnf::IntervalCharacterRule>('0', '9');
+
+    std::string_view digits_value{};
+    digits->setOnSuccess([&](std::string_view value) { digits_value = value; });
+
+    ebnf::Concatenation sequence{};
+    sequence.append(letters);
+    sequence.append(digits);
+
+    auto result = sequence.parse(text, 0);
+
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.value, text);
+    EXPECT_EQ(result.getPosition(), 0u);
+
+    // Values and callbacks see slices of the text, not copies.
+    EXPECT_EQ(result.value.data(), text.data());
+    EXPECT_EQ(digits_value.data(), text.data() + 26);
+    EXPECT_EQ(digits_value, "0123456789");
+
+    const std::string owned = result.toString();
+    EXPECT_EQ(owned, text);
+    EXPECT_NE(owned.data(), text.data());
+
+    // Past the end, only symbols matching nothing succeed.
+    ebnf::ZeroManyFactor any_letters{ letters };
+
+    auto end_result = any_letters.parse(text, text.size() + 1u);
+    EXPECT_TRUE(end_result.success);
+    EXPECT_TRUE(end_result.value.empty());
+}
+
+TEST(EBNF_Parser, Packrat)
+{
+    // nested = "(", nested, ")", "+" | "(", nested, ")" | "a" ;
+    // Both alternatives share the prefix, so without memo the innermost symbol is parsed 2^depth times.
+    const uint32_t depth{ 10u };
+
+    uint32_t inner_parses{ 0u };
+
+    std::shared_ptr<ebnf::ASymbol> nested = std::make_shared<ebnf::Terminal>('a');
+    nested->setOnSuccess([&](std::string_view) { inner_parses++; });
+
+    std::string text{ "a" };
+    for (uint32_t i = 0u; i < depth; i++)
+    {
+        auto prefix = std::make_shared<ebnf::Concatenation>();
+        prefix->append(std::make_shared<ebnf::Terminal>('('));
+        prefix->append(nested);
+        prefix->append(std::make_shared<ebnf::Terminal>(')'));
+
+        auto sum = std::make_shared<ebnf::Concatenation>();
+        sum->append(prefix);
+        sum->append(std::make_shared<ebnf::Terminal>('+'));
+
+        auto alternation = std::make_shared<ebnf::Alternation>();
+        alternation->append(sum);
+        alternation->append(prefix);
+
+        nested = alternation;
+        text = "(" + text + ")";
+    }
+
+    auto result = nested->parse(text, 0);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.next_position, text.size());
+    EXPECT_EQ(inner_parses, 1u << depth);
+
+    inner_parses = 0u;
+
+    std::pmr::monotonic_buffer_resource memory_resource{};
+
+    auto packrat_result = nested->parsePackrat(text, 0, &memory_resource);
+    EXPECT_TRUE(packrat_result.success);
+    EXPECT_EQ(packrat_result.next_position, text.size());
+    EXPECT_EQ(packrat_result.value, result.value);
+    EXPECT_EQ(inner_parses, 1u);
+
+    // An opted out symbol is parsed again, the symbols below it still use the memo.
+    inner_parses = 0u;
+    nested->setMemoize(false);
+
+    ebnf::ParseMemo memo{ text.size() };
+    ebnf::ParseContext context{ &memo };
+
+    auto opt_out_result = nested->parse(text, 0, context);
+    EXPECT_TRUE(opt_out_result.success);
+    EXPECT_EQ(inner_parses, 1u);
+    EXPECT_GT(memo.getHitCount(), 0u);
+
+    EXPECT_FALSE(std::make_shared<ebnf::Terminal>('a')->isMemoize());
+    EXPECT_TRUE(std::make_shared<ebnf::Alternation>()->isMemoize());
+}
+
+TEST(EBNF_Parser, Compiled)
+{
+    // assignment = identifier, { " " }, "=", { " " }, ( number | identifier ), [ ";" ] ;
+    auto letters = std::make_shared<ebnf::IntervalCharacterRule>('a', 'z');
+    auto digits = std::make_shared<ebnf::IntervalCharacterRule>('0', '9');
+    auto spaces = std::make_shared<ebnf::ZeroManyFactor>(std::make_shared<ebnf::Terminal>(' '));
+
+    auto identifier = std::make_shared<ebnf::Concatenation>();
+    identifier->append(letters);
+    identifier->append(std::make_shared<ebnf::ZeroManyFactor>(digits));
+
+    auto number = std::make_shared<ebnf::OneManyFactor>(digits);
+
+    auto value = std::make_shared<ebnf::Alternation>();
+    value->append(number);
+    value->append(identifier);
+
+    auto assignment = std::make_shared<ebnf::Concatenation>();
+    assignment->append(identifier);
+    assignment->append(spaces);
+    assignment->append(std::make_shared<ebnf::Terminal>("="));
+    assignment->append(spaces);
+    assignment->append(value);
+    assignment->append(std::make_shared<ebnf::ZeroOneFactor>(std::make_shared<ebnf::Terminal>(";")));
+
+    auto compiled = ebnf::CompiledGrammar::compile(assignment);
+    ASSERT_TRUE(compiled.has_value());
+    EXPECT_FALSE(compiled->getInstructions().empty());
+
+    for (const std::string text : { "a = 1;", "abc1=def2", "x =  42", "x = ;", "= 1", "", "name = value;rest" })
+    {
+        auto result = assignment->parse(text, 0);
+        auto compiled_result = compiled->parse(text, 0);
+
+        EXPECT_EQ(compiled_result, result) << text;
+    }
+
+    // The identifier is shared, so it becomes a subroutine.
+    EXPECT_NE(std::find_if(compiled->getInstructions().begin(), compiled->getInstructions().end(), [](const ebnf::Instruction& instruction) { return instruction.opcode == ebnf::Opcode::CALL; }), compiled->getInstructions().end());
+}
+
+TEST(EBNF_Parser, CompiledActions)
+{
+    // keyword = "if" - "iffy" | letters ;
+    auto letters = std::make_shared<ebnf::IntervalCharacterRule>('a', 'z');
+
+    std::vector<std::string> matches{};
+
+    auto keyword = std::make_shared<ebnf::Terminal>("if");
+    keyword->setOnSuccess([&](std::string_view value) { matches.push_back("keyword " + std::string(value)); });
+
+    auto candidate = std::make_shared<ebnf::Concatenation>();
+    candidate->append(keyword);
+    candidate->append(std::make_shared<ebnf::Terminal>(" "));
+
+    letters->setOnSuccess([&](std::string_view value) { matches.push_back("letters " + std::string(value)); });
+
+    auto word = std::make_shared<ebnf::Alternation>();
+    word->append(std::make_shared<ebnf::Exclude>(candidate, std::make_shared<ebnf::Terminal>("if x")));
+    word->append(letters);
+
+    auto compiled = ebnf::CompiledGrammar::compile(word);
+    ASSERT_TRUE(compiled.has_value());
+
+    // The symbols call back on the abandoned alternative too.
+    auto result = word->parse("if x", 0);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.value, "if");
+    EXPECT_EQ(matches, (std::vector<std::string>{ "keyword if", "letters if" }));
+
+    // The compiled grammar only for the committed parse.
+    matches.clear();
+    auto compiled_result = compiled->parse("if x", 0);
+    EXPECT_EQ(compiled_result, result);
+    EXPECT_EQ(matches, (std::vector<std::string>{ "letters if" }));
+
+    matches.clear();
+    compiled_result = compiled->parse("if y", 0);
+    EXPECT_TRUE(compiled_result.success);
+    EXPECT_EQ(compiled_result.value, "if ");
+    EXPECT_EQ(matches, (std::vector<std::string>{ "keyword if" }));
+
+    // Unknown symbol types are not compiled.
+    class Custom : public ebnf::ASymbol
+    {
+
+    protected:
+
+        ebnf::ParseResult doParse(std::string_view, std::size_t, ebnf::ParseContext&) const override
+        {
+            return {};
+        }
+    };
+
+    EXPECT_FALSE(ebnf::CompiledGrammar::compile(std::make_shared<Custom>()).has_value());
+}
+
+TEST(EBNF_Parser, CharacterClass)
+{
+    ebnf::CharacterClass identifier{};
+    identifier.addInterval('a', 'z');
+    identifier.addInterval('A', 'Z');
+    identifier.addList("_0123456789");
+    identifier.remove('x');
+
+    EXPECT_TRUE(identifier.contains('a'));
+    EXPECT_TRUE(identifier.contains('_'));
+    EXPECT_FALSE(identifier.contains('x'));
+    EXPECT_FALSE(identifier.contains(' '));
+    EXPECT_FALSE(identifier.contains('\xE9'));
+
+    ebnf::CharacterClass upper{};
+    upper.addAll();
+    upper.exclude(identifier);
+    EXPECT_TRUE(upper.contains('\xE9'));
+    EXPECT_TRUE(upper.contains('x'));
+    EXPECT_FALSE(upper.contains('a'));
+    EXPECT_TRUE(ebnf::CharacterClass{}.empty());
+
+    // Runs across the vector widths, ending at every offset and with bytes above 0x7F.
+    for (std::size_t length : { 0u, 1u, 7u, 8u, 15u, 16u, 31u, 32u, 33u, 100u, 1000u })
+    {
+        for (char stop : { ' ', 'x', '\xE9', '\0' })
+        {
+            std::string text(length, 'a');
+            for (std::size_t i = 0u; i < length; i++)
+            {
+                text[i] = "Ab_9z"[i % 5u];
+            }
+            text += stop;
+            text += "abc";
+
+            EXPECT_EQ(identifier.scan(text, 0u), length);
+            EXPECT_EQ(upper.scan(text, length), length + 1u);
+            EXPECT_EQ(identifier.scan(text, text.size()), text.size());
+        }
+    }
+
+    // Lists and ignored characters.
+    ebnf::ListCharacterRule blank{ " \t" };
+    EXPECT_EQ(blank.parse(" \t \tx", 0).value, " \t \t");
+    EXPECT_FALSE(blank.parse("x", 0).success);
+
+    ebnf::AnyCharacterRule line{};
+    line.addIgnoredCharacter('\n');
+    EXPECT_TRUE(line.isIgnored('\n'));
+    EXPECT_EQ(line.parse("first line\nsecond", 0).value, "first line");
+
+    ebnf::IntervalCharacterRule empty{ 'z', 'a' };
+    EXPECT_FALSE(empty.parse("m", 0).success);
+
+    // The repetition scans the run directly, unless the rule has an action.
+    auto letters = std::make_shared<ebnf::IntervalCharacterRule>('a', 'z');
+    ebnf::ZeroManyFactor zero_many{ letters };
+    ebnf::OneManyFactor one_many{ letters };
+
+    EXPECT_EQ(zero_many.parse("abc1", 0).value, "abc");
+    EXPECT_TRUE(zero_many.parse("1", 0).success);
+    EXPECT_EQ(one_many.parse("abc1", 0).value, "abc");
+    EXPECT_FALSE(one_many.parse("1", 0).success);
+
+    std::vector<std::string> matches{};
+    letters->setOnSuccess([&](std::string_view value) { matches.push_back(std::string(value)); });
+
+    EXPECT_EQ(one_many.parse("abc1", 0).value, "abc");
+    EXPECT_EQ(matches, (std::vector<std::string>{ "abc" }));
+
+    auto compiled = ebnf::CompiledGrammar::compile(std::make_shared<ebnf::ListCharacterRule>(" \t"));
+    ASSERT_TRUE(compiled.has_value());
+    EXPECT_EQ(compiled->parse(" \t x", 0), blank.parse(" \t x", 0));
+}
+
+TEST(EBNF_Parser, Incremental)
+{
+    // line = "#", text, "\n" | identifier - "end", "=", ( number | identifier ), ";", "\n" ;
+    auto letters = std::make_shared<ebnf::IntervalCharacterRule>('a', 'z');
+    auto digits = std::make_shared<ebnf::IntervalCharacterRule>('0', '9');
+    auto line_feed = std::make_shared<ebnf::Terminal>('\n');
+
+    auto text = std::make_shared<ebnf::AnyCharacterRule>();
+    text->addIgnoredCharacter('\n');
+
+    auto comment = std::make_shared<ebnf::Concatenation>();
+    comment->append(std::make_shared<ebnf::Terminal>('#'));
+    comment->append(text);
+    comment->append(line_feed);
+
+    auto value = std::make_shared<ebnf::Alternation>();
+    value->append(std::make_shared<ebnf::OneManyFactor>(digits));
+    value->append(letters);
+
+    auto assignment = std::make_shared<ebnf::Concatenation>();
+    assignment->append(std::make_shared<ebnf::Exclude>(letters, std::make_shared<ebnf::Terminal>("end")));
+    assignment->append(std::make_shared<ebnf::Terminal>('='));
+    assignment->append(value);
+    assignment->append(std::make_shared<ebnf::Terminal>(';'));
+    assignment->append(line_feed);
+
+    auto line = std::make_shared<ebnf::Alternation>();
+    line->append(comment);
+    line->append(assignment);
+
+    auto lines = std::make_shared<ebnf::ZeroManyFactor>(line);
+
+    std::string source{};
+    for (uint32_t i = 0u; i < 200u; i++)
+    {
+        source += i % 4u == 0u ? "# note\n" : "name=" + std::to_string(i) + ";\n";
+    }
+
+    ebnf::IncrementalParser parser{ lines, source };
+
+    auto result = parser.parse();
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.next_position, source.size());
+
+    // A changed value is parsed again, the other lines come from the memo.
+    const std::size_t offset = source.find("=10;") + 1u;
+    ASSERT_TRUE(parser.edit(offset, 2u, "42"));
+
+    const std::size_t entries = parser.getMemo().getEntryCount();
+    result = parser.parse();
+    EXPECT_EQ(result.next_position, source.size());
+    EXPECT_EQ(result.value, parser.getText());
+    EXPECT_LT(parser.getMemo().getEntryCount() - entries, 32u);
+
+    // Edits which reach into the lookahead of a result, at the ends and outside of the text.
+    EXPECT_TRUE(parser.edit(0u, 1u, "e"));
+    EXPECT_TRUE(parser.edit(1u, 0u, "nd"));
+    EXPECT_FALSE(parser.parse().next_position > 0u);
+    EXPECT_TRUE(parser.edit(parser.getText().size(), 0u, "x=1;\n"));
+    EXPECT_FALSE(parser.edit(parser.getText().size() + 1u, 0u, "x"));
+    EXPECT_FALSE(parser.edit(0u, parser.getText().size() + 1u, ""));
+
+    // An entry is checked against all edits since it was last found, each in the positions of its time.
+    ebnf::ParseMemo memo{ 20u };
+    memo.insert(1u, 10u, { .success = true, .next_position = 12u, .value = std::string_view(source).substr(10u, 2u) }, 13u);
+    memo.insert(2u, 10u, {}, 11u);
+
+    memo.edit(11u, 1u, 1u);
+    memo.edit(2u, 4u, 1u);
+
+    EXPECT_FALSE(memo.find(1u, 7u, source).has_value());
+
+    auto hit = memo.find(2u, 7u, source);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_FALSE(hit->result.success);
+    EXPECT_EQ(hit->examined_end, 8u);
+
+    // Random edits give the same results as parsing from scratch.
+    uint32_t seed{ 1u };
+    auto random = [&](uint32_t range) {
+        seed = seed * 1664525u + 1013904223u;
+
+        return (seed >> 8u) % range;
+    };
+
+    const std::string_view characters{ "ab=;\n#1e" };
+
+    parser.setText("# a\nname=1;\nb=a;\nend=12;\nendless=b;\n");
+
+    for (uint32_t i = 0u; i < 2000u; i++)
+    {
+        const std::size_t size = parser.getText().size();
+
+        const std::size_t edit_offset = random((uint32_t)size + 1u);
+        const std::size_t removed = std::min<std::size_t>(random(3u), size - edit_offset);
+
+        std::string inserted{};
+        for (uint32_t k = random(3u); k > 0u; k--)
+        {
+            inserted += characters[random((uint32_t)characters.size())];
+        }
+
+        ASSERT_TRUE(parser.edit(edit_offset, removed, inserted));
+
+        const std::string& edited = parser.getText();
+
+        // From every line start, so also results behind a failed line are compared.
+        std::vector<std::size_t> positions{ 0u };
+        for (std::size_t k = 0u; k < edited.size(); k++)
+        {
+            if (edited[k] == '\n')
+            {
+                positions.push_back(k + 1u);
+            }
+        }
+
+        for (std::size_t position : positions)
+        {
+            const auto incremental_result = parser.parse(position);
+            const auto expected_result = lines->parsePackrat(edited, position);
+
+            ASSERT_EQ(incremental_result.success, expected_result.success) << "edit " << i;
+            ASSERT_EQ(incremental_result.next_position, expected_result.next_position) << "edit " << i;
+            ASSERT_EQ(incremental_result.value, expected_result.value) << "edit " << i;
+            ASSERT_EQ(incremental_result.getPosition(), expected_result.getPosition()) << "edit " << i;
+        }
+    }
+
+    // Line wise edits of a long text, which keep it mostly valid, so whole chunks of lines are reused.
+    parser.setText(source + source + source + source + source);
+
+    for (uint32_t i = 0u; i < 300u; i++)
+    {
+        const std::string& current = parser.getText();
+
+        std::size_t line_start = random((uint32_t)current.size());
+        line_start = current.rfind('\n', line_start);
+        line_start = line_start == std::string::npos ? 0u : line_start + 1u;
+
+        switch (random(5u))
+        {
+            case 0u:
+                ASSERT_TRUE(parser.edit(line_start, 0u, "b=" + std::to_string(i) + ";\n"));
+                break;
+            case 1u:
+                ASSERT_TRUE(parser.edit(line_start, current.find('\n', line_start) + 1u - line_start, ""));
+                break;
+            case 2u:
+                ASSERT_TRUE(parser.edit(line_start, 1u, std::string(1u, characters[random((uint32_t)characters.size())])));
+                break;
+            case 3u:
+                ASSERT_TRUE(parser.edit(current.find('\n', line_start), 0u, "1"));
+                break;
+            default:
+                ASSERT_TRUE(parser.edit(line_start, 0u, "#"));
+                break;
+        }
+
+        const auto incremental_result = parser.parse();
+        const auto expected_result = lines->parsePackrat(parser.getText());
+
+        ASSERT_EQ(incremental_result, expected_result) << "line edit " << i;
+    }
+
+    parser.setText("a=1;\n");
+    EXPECT_EQ(parser.getMemo().getEditCount(), 0u);
+    EXPECT_EQ(parser.parse().next_position, 5u);
+}
@@ -1,4 +1,13 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -63,6 +72,97 @@ TEST(TestUtility, Interleave)
     EXPECT_EQ(*(const std::uint32_t*)(interleaved.data() + (1u * stride)), 2u);
 }
 
+TEST(TestUtility, InterleaveVertexLayouts)
+{
+    // Enough vertices to be split across the thread pool.
+    const std::size_t count{ 100000u };
+
+    // Position, normal, tangent and uv use a specialised kernel, the odd sizes the generic one.
+    const std::vector<std::vector<std::size_t>> layouts{
+        { 12u, 12u, 12u, 8u },
+        { 12u, 12u, 8u },
+        { 12u, 8u },
+        { 3u, 16u, 5u }
+    };
+
+    for (const auto& layout : layouts)
+    {
+        std::vector<std::vector<std::uint8_t>> attributes{};
+        std::vector<RawData> raw_data{};
+        for (std::size_t j = 0u; j < layout.size(); j++)
+        {
+            std::vector<std::uint8_t> attribute(count * layout[j]);
+            for (std::size_t i = 0u; i < attribute.size(); i++)
+            {
+                attribute[i] = (std::uint8_t)(i * 31u + j * 7u);
+            }
+            attributes.push_back(std::move(attribute));
+        }
+        for (std::size_t j = 0u; j < layout.size(); j++)
+        {
+            raw_data.push_back({ attributes[j].data(), attributes[j].size(), layout[j] });
+        }
+
+        std::size_t stride{ 0u };
+        std::vector<std::uint8_t> interleaved = interleaveData(raw_data, stride);
+        ASSERT_EQ(interleaved.size(), count * stride);
+
+        // Spot check against the definition.
+        for (std::size_t i : { std::size_t{ 0u }, std::size_t{ 65537u }, count - 1u })
+        {
+            std::size_t offset{ 0u };
+            for (std::size_t j = 0u; j < layout.size(); j++)
+            {
+                EXPECT_EQ(std::memcmp(interleaved.data() + i * stride + offset, attributes[j].data() + i * layout[j], layout[j]), 0);
+                offset += layout[j];
+            }
+        }
+
+        std::vector<std::vector<std::uint8_t>> restored{};
+        std::vector<MutableRawData> mutable_raw_data{};
+        for (std::size_t j = 0u; j < layout.size(); j++)
+        {
+            restored.emplace_back(count * layout[j]);
+        }
+        for (std::size_t j = 0u; j < layout.size(); j++)
+        {
+            mutable_raw_data.push_back({ restored[j].data(), restored[j].size(), layout[j] });
+        }
+
+        EXPECT_TRUE(deinterleaveData(interleaved.data(), interleaved.size(), mutable_raw_data));
+        EXPECT_EQ(restored, attributes);
+    }
+}
+
+TEST(TestUtility, InterleaveInto)
+{
+    std::vector<float> positions{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    std::vector<float> uvs{ 0.0f, 1.0f, 0.5f, 0.25f };
+
+    std::vector<RawData> raw_data{
+        { (const std::uint8_t*)positions.data(), positions.size() * sizeof(float), 3u * sizeof(float) },
+        { (const std::uint8_t*)uvs.data(), uvs.size() * sizeof(float), 2u * sizeof(float) }
+    };
+
+    std::vector<float> interleaved(10u);
+    EXPECT_FALSE(interleaveDataInto(raw_data, (std::uint8_t*)interleaved.data(), 9u * sizeof(float)));
+    ASSERT_TRUE(interleaveDataInto(raw_data, (std::uint8_t*)interleaved.data(), interleaved.size() * sizeof(float)));
+
+    EXPECT_EQ(interleaved, (std::vector<float>{ 1.0f, 2.0f, 3.0f, 0.0f, 1.0f, 4.0f, 5.0f, 6.0f, 0.5f, 0.25f }));
+
+    // Different element counts
+    raw_data[1].length = sizeof(float) * 2u;
+    EXPECT_FALSE(interleaveDataInto(raw_data, (std::uint8_t*)interleaved.data(), interleaved.size() * sizeof(float)));
+
+    // Too small destination
+    std::vector<float> restored_uvs(2u);
+    std::vector<MutableRawData> mutable_raw_data{
+        { (std::uint8_t*)positions.data(), positions.size() * sizeof(float), 3u * sizeof(float) },
+        { (std::uint8_t*)restored_uvs.data(), restored_uvs.size() * sizeof(float), 2u * sizeof(float) }
+    };
+    EXPECT_FALSE(deinterleaveData((const std::uint8_t*)interleaved.data(), interleaved.size() * sizeof(float), mutable_raw_data));
+}
+
 TEST(TestUtility, Base64EncodeEmpty)
 {
     std::vector<std::uint8_t> empty{};
@@ -178,6 +278,73 @@ TEST(TestUtility, Base64EncodeNullPointer)
     EXPECT_EQ(encoded, "");
 }
 
+TEST(TestUtility, Base64RoundTripAllLengths)
+{
+    // Covers the vector kernels, their tails and the scalar remainder
+    std::vector<std::uint8_t> data(1000u);
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>((i * 131u) ^ (i >> 3));
+    }
+
+    for (std::size_t length = 0; length <= data.size(); length += (length < 100u ? 1u : 37u))
+    {
+        std::span<const std::uint8_t> input(data.data(), length);
+
+        std::string encoded = base64Encode(input);
+        ASSERT_EQ(encoded.size(), base64EncodedSize(length));
+
+        std::string expected{};
+        for (std::size_t i = 0; i < length; i += 3)
+        {
+            expected += base64Encode(input.subspan(i, std::min<std::size_t>(3u, length - i)));
+        }
+        ASSERT_EQ(encoded, expected);
+
+        std::vector<std::uint8_t> decoded = base64Decode(encoded);
+        ASSERT_EQ(decoded, std::vector<std::uint8_t>(input.begin(), input.end()));
+    }
+}
+
+TEST(TestUtility, Base64DecodeInto)
+{
+    std::vector<std::uint8_t> data(300u);
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i * 7u);
+    }
+
+    std::string encoded = base64Encode(data);
+    ASSERT_EQ(base64DecodedSize(encoded), data.size());
+
+    std::vector<std::uint8_t> destination(data.size());
+    Base64DecodeResult result = base64DecodeInto(encoded, destination);
+    EXPECT_EQ(result.error, Base64Error::NONE);
+    EXPECT_EQ(result.written, data.size());
+    EXPECT_EQ(destination, data);
+
+    std::vector<std::uint8_t> small(data.size() - 1u);
+    EXPECT_EQ(base64DecodeInto(encoded, small).error, Base64Error::BUFFER_TOO_SMALL);
+
+    EXPECT_EQ(base64DecodeInto(encoded.substr(1), destination).error, Base64Error::INVALID_LENGTH);
+
+    // Invalid characters are reported at their exact position, inside and after the vectorised blocks
+    for (std::size_t position : { 0u, 5u, 37u, 100u, 395u, 399u })
+    {
+        std::string invalid = encoded;
+        invalid[position] = '*';
+
+        result = base64DecodeInto(invalid, destination);
+        EXPECT_EQ(result.error, Base64Error::INVALID_CHARACTER);
+        EXPECT_EQ(result.position, position);
+    }
+
+    // Padding is only allowed at the end
+    result = base64DecodeInto("TQ==TWFu", destination);
+    EXPECT_EQ(result.error, Base64Error::INVALID_CHARACTER);
+    EXPECT_EQ(result.position, 2u);
+}
+
 TEST(TestUtility, GzipCompressEmpty)
 {
     std::vector<std::uint8_t> empty{};
@@ -286,6 +453,51 @@ TEST(TestUtility, GzipDecompressInvalid)
     EXPECT_TRUE(decompressed.empty());
 }
 
+TEST(TestUtility, GzipDecompressTrailingData)
+{
+    std::vector<std::uint8_t> original(50000u);
+    for (std::size_t i = 0u; i < original.size(); i++)
+    {
+        original[i] = static_cast<std::uint8_t>(i * 7u);
+    }
+
+    std::vector<std::uint8_t> compressed = gzipCompress(original);
+
+    // Padding and garbage after a complete member
+    for (std::uint8_t value : { 0x00u, 0x1Fu, 0x42u })
+    {
+        for (std::size_t count : { 1u, 7u, 1000u })
+        {
+            std::vector<std::uint8_t> trailing = compressed;
+            trailing.insert(trailing.end(), count, value);
+
+            EXPECT_EQ(gzipDecompress(trailing), original);
+        }
+    }
+}
+
+TEST(TestUtility, GzipDecompressTruncated)
+{
+    std::vector<std::uint8_t> original(50000u);
+    for (std::size_t i = 0u; i < original.size(); i++)
+    {
+        original[i] = static_cast<std::uint8_t>(i * 7u);
+    }
+
+    std::vector<std::uint8_t> compressed = gzipCompress(original);
+
+    // Missing data or trailer
+    for (std::size_t length : { compressed.size() / 2u, compressed.size() - 4u, compressed.size() - 1u })
+    {
+        EXPECT_TRUE(gzipDecompress(compressed.data(), length).empty());
+    }
+
+    // A second member, which is truncated
+    std::vector<std::uint8_t> members = compressed;
+    members.insert(members.end(), compressed.begin(), compressed.begin() + compressed.size() / 2u);
+    EXPECT_TRUE(gzipDecompress(members).empty());
+}
+
 TEST(TestUtility, GzipCompressHighlyCompressible)
 {
     std::vector<std::uint8_t> repetitive{};
@@ -302,3 +514,644 @@ TEST(TestUtility, GzipCompressHighlyCompressible)
     std::vector<std::uint8_t> decompressed = gzipDecompress(compressed);
     EXPECT_EQ(decompressed, repetitive);
 }
+
+TEST(TestUtility, GzipStreamingRoundTrip)
+{
+    std::vector<std::uint8_t> original(300000u);
+    for (std::size_t i = 0u; i < original.size(); i++)
+    {
+        original[i] = static_cast<std::uint8_t>((i * i) >> 7);
+    }
+
+    std::vector<std::uint8_t> compressed{};
+    GzipCompressor compressor([&compressed](std::span<const std::uint8_t> data) {
+        compressed.insert(compressed.end(), data.begin(), data.end());
+        return true;
+    });
+
+    // Uneven pieces
+    for (std::size_t offset = 0u; offset < original.size(); offset += 7919u)
+    {
+        ASSERT_TRUE(compressor.push(std::span<const std::uint8_t>(original).subspan(offset, std::min<std::size_t>(7919u, original.size() - offset))));
+    }
+    ASSERT_TRUE(compressor.finish());
+    EXPECT_FALSE(compressor.push(original));
+
+    EXPECT_EQ(gzipDecompress(compressed), original);
+
+    // Two concatenated members, pushed byte by byte
+    std::vector<std::uint8_t> members = compressed;
+    members.insert(members.end(), compressed.begin(), compressed.end());
+
+    std::vector<std::uint8_t> decompressed{};
+    GzipDecompressor decompressor([&decompressed](std::span<const std::uint8_t> data) {
+        decompressed.insert(decompressed.end(), data.begin(), data.end());
+        return true;
+    });
+
+    for (std::uint8_t value : members)
+    {
+        ASSERT_TRUE(decompressor.push({ &value, 1u }));
+    }
+    EXPECT_TRUE(decompressor.isFinished());
+
+    std::vector<std::uint8_t> expected = original;
+    expected.insert(expected.end(), original.begin(), original.end());
+    EXPECT_EQ(decompressed, expected);
+
+    // Corrupt data is reported
+    GzipDecompressor invalid([](std::span<const std::uint8_t>) { return true; });
+    std::vector<std::uint8_t> garbage(100u, 0x42u);
+    EXPECT_FALSE(invalid.push(garbage));
+}
+
+TEST(TestUtility, GzipCompressParallel)
+{
+    std::vector<std::uint8_t> original(1000000u);
+    for (std::size_t i = 0u; i < original.size(); i++)
+    {
+        original[i] = static_cast<std::uint8_t>((i % 251u) ^ (i >> 12));
+    }
+
+    ThreadPool single_thread_pool(1u);
+    ThreadPool thread_pool(4u);
+
+    std::vector<std::uint8_t> compressed = gzipCompressParallel(original.data(), original.size(), 6, 65536u, thread_pool);
+    ASSERT_FALSE(compressed.empty());
+    EXPECT_EQ(gzipDecompress(compressed), original);
+
+    // Independent of the number of threads
+    EXPECT_EQ(gzipCompressParallel(original.data(), original.size(), 6, 65536u, single_thread_pool), compressed);
+
+    // Priming with the preceding input keeps the ratio close to a single stream
+    EXPECT_LT(compressed.size(), gzipCompress(original, 6).size() * 11u / 10u);
+
+    // Smaller than one block
+    std::vector<std::uint8_t> small(1000u, 7u);
+    EXPECT_EQ(gzipDecompress(gzipCompressParallel(small.data(), small.size())), small);
+}
+
+TEST(TestUtility, GzipDecompressInto)
+{
+    std::vector<std::uint8_t> original(200000u);
+    for (std::size_t i = 0u; i < original.size(); i++)
+    {
+        original[i] = static_cast<std::uint8_t>(i / 100u);
+    }
+
+    std::vector<std::uint8_t> compressed = gzipCompress(original);
+    ASSERT_EQ(gzipDecompressedSize(compressed), original.size());
+
+    std::vector<std::uint8_t> destination(original.size());
+    EXPECT_EQ(gzipDecompressInto(compressed, destination), original.size());
+    EXPECT_EQ(destination, original);
+
+    // Too small a destination
+    std::vector<std::uint8_t> small(original.size() - 1u);
+    EXPECT_FALSE(gzipDecompressInto(compressed, small).has_value());
+
+    // Truncated input
+    EXPECT_FALSE(gzipDecompressInto(std::span<const std::uint8_t>(compressed).first(compressed.size() / 2u), destination).has_value());
+
+    // ISIZE not matching the content
+    std::vector<std::uint8_t> wrong_size = compressed;
+    wrong_size[wrong_size.size() - 4u] ^= 0x01u;
+    EXPECT_FALSE(gzipDecompressInto(wrong_size, destination).has_value());
+    EXPECT_TRUE(gzipDecompress(wrong_size).empty());
+
+    // Two members, the trailer only describes the last one
+    std::vector<std::uint8_t> members = compressed;
+    members.insert(members.end(), compressed.begin(), compressed.end());
+
+    std::vector<std::uint8_t> expected = original;
+    expected.insert(expected.end(), original.begin(), original.end());
+
+    std::vector<std::uint8_t> large_destination(expected.size());
+    EXPECT_EQ(gzipDecompressInto(members, large_destination), expected.size());
+    EXPECT_EQ(large_destination, expected);
+    EXPECT_EQ(gzipDecompress(members), expected);
+
+    // Trailing data is ignored
+    members.push_back(0x00u);
+    EXPECT_EQ(gzipDecompressInto(members, large_destination), expected.size());
+    EXPECT_EQ(large_destination, expected);
+
+    // A valid member without content
+    std::vector<std::uint8_t> empty_member{};
+    GzipCompressor compressor([&empty_member](std::span<const std::uint8_t> data) {
+        empty_member.insert(empty_member.end(), data.begin(), data.end());
+        return true;
+    });
+    ASSERT_TRUE(compressor.finish());
+    EXPECT_EQ(gzipDecompressInto(empty_member, std::span<std::uint8_t>{}), 0u);
+}
+
+TEST(TestUtility, ThreadPoolSubmit)
+{
+    ThreadPool thread_pool(2u);
+
+    std::future<int> future = thread_pool.submit([]() { return 6 * 7; });
+
+    EXPECT_EQ(future.get(), 42);
+}
+
+TEST(TestUtility, ThreadPoolParallelFor)
+{
+    ThreadPool thread_pool(4u);
+
+    std::vector<uint32_t> values(1000u, 0u);
+    thread_pool.parallelFor(values.size(), 7u, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            values[i] += (uint32_t)i;
+        }
+    });
+
+    for (std::size_t i = 0u; i < values.size(); i++)
+    {
+        EXPECT_EQ(values[i], (uint32_t)i);
+    }
+}
+
+TEST(TestUtility, ThreadPoolNestedParallelFor)
+{
+    ThreadPool thread_pool(2u);
+
+    std::atomic<uint32_t> counter{ 0u };
+    thread_pool.parallelFor(8u, 1u, [&](std::size_t, std::size_t) {
+        thread_pool.parallelFor(100u, 10u, [&](std::size_t inner_begin, std::size_t inner_end) {
+            counter += (uint32_t)(inner_end - inner_begin);
+        });
+    });
+
+    EXPECT_EQ(counter.load(), 800u);
+}
+
+TEST(TestUtility, ThreadPoolParallelForException)
+{
+    ThreadPool thread_pool(2u);
+
+    // Every chunk throws, on the workers and on the calling thread.
+    for (std::uint32_t i = 0u; i < 10u; i++)
+    {
+        EXPECT_THROW(thread_pool.parallelFor(64u, 1u, [](std::size_t, std::size_t) { throw std::runtime_error("chunk failed"); }), std::runtime_error);
+    }
+
+    // Only the last chunk throws, the others still finish.
+    std::atomic<uint32_t> counter{ 0u };
+    EXPECT_THROW(thread_pool.parallelFor(64u, 1u, [&counter](std::size_t begin, std::size_t) {
+        if (begin == 63u)
+        {
+            throw std::runtime_error("chunk failed");
+        }
+        counter++;
+    }), std::runtime_error);
+    EXPECT_LE(counter.load(), 63u);
+
+    // The pool stays usable.
+    counter = 0u;
+    thread_pool.parallelFor(100u, 10u, [&counter](std::size_t begin, std::size_t end) {
+        counter += (uint32_t)(end - begin);
+    });
+    EXPECT_EQ(counter.load(), 100u);
+}
+
+TEST(TestUtility, ThreadPoolParallelReduce)
+{
+    std::vector<float> values(100000u);
+    for (std::size_t i = 0u; i < values.size(); i++)
+    {
+        values[i] = 1.0f / (float)(i + 1u);
+    }
+
+    auto sum = [&values](ThreadPool& thread_pool) {
+        return thread_pool.parallelReduce(
+            values.size(), 1000u, 0.0f,
+            [&values](std::size_t begin, std::size_t end) {
+                float partial{ 0.0f };
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    partial += values[i];
+                }
+                return partial;
+            },
+            [](float a, float b) { return a + b; });
+    };
+
+    ThreadPool single_thread_pool(1u);
+    ThreadPool thread_pool(4u);
+
+    // Bitwise identical, independent of the number of threads.
+    const float expected = sum(single_thread_pool);
+    EXPECT_EQ(sum(thread_pool), expected);
+
+    thread_pool.setDeterministic(true);
+    EXPECT_EQ(sum(thread_pool), expected);
+
+    EXPECT_NEAR(expected, 12.09f, 0.01f);
+}
+
+TEST(TestUtility, ThreadPoolDeterministic)
+{
+    ThreadPool thread_pool(4u);
+    thread_pool.setDeterministic(true);
+
+    std::vector<std::size_t> order{};
+    for (std::size_t i = 0u; i < 10u; i++)
+    {
+        thread_pool.post([&order, i]() { order.push_back(i); });
+    }
+    thread_pool.parallelFor(30u, 3u, [&order](std::size_t begin, std::size_t) { order.push_back(10u + begin / 3u); });
+
+    ASSERT_EQ(order.size(), 20u);
+    for (std::size_t i = 0u; i < order.size(); i++)
+    {
+        EXPECT_EQ(order[i], i);
+    }
+
+    std::future<int> future = thread_pool.submit([]() { return 7; });
+    EXPECT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+}
+
+TEST(TestUtility, ThreadPoolWaitOnWorker)
+{
+    // Every worker waits for a task queued behind it, which only works if waiting helps.
+    ThreadPool thread_pool(2u);
+
+    std::vector<std::future<int>> outer{};
+    for (int i = 0; i < 8; i++)
+    {
+        outer.push_back(thread_pool.submit([&thread_pool, i]() {
+            std::future<int> inner = thread_pool.submit([i]() { return i * i; });
+            thread_pool.wait(inner);
+            return inner.get();
+        }));
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        thread_pool.wait(outer[i]);
+        EXPECT_EQ(outer[i].get(), i * i);
+    }
+}
+
+TEST(TestUtility, ThreadPoolWorkerStatistics)
+{
+    ThreadPool thread_pool(2u);
+
+    std::vector<std::future<void>> futures{};
+    for (std::size_t i = 0u; i < 16u; i++)
+    {
+        futures.push_back(thread_pool.submit([]() {}));
+    }
+    for (auto& future : futures)
+    {
+        future.get();
+    }
+
+    std::vector<ThreadPoolWorkerStatistics> statistics = thread_pool.getWorkerStatistics();
+    ASSERT_EQ(statistics.size(), 2u);
+
+    std::uint64_t executed_tasks{ 0u };
+    for (const ThreadPoolWorkerStatistics& worker : statistics)
+    {
+        executed_tasks += worker.executed_tasks;
+        EXPECT_LE(worker.utilisation, 1.0);
+    }
+    EXPECT_EQ(executed_tasks, 16u);
+
+    thread_pool.resetWorkerStatistics();
+    for (const ThreadPoolWorkerStatistics& worker : thread_pool.getWorkerStatistics())
+    {
+        EXPECT_EQ(worker.executed_tasks, 0u);
+    }
+
+    // Tasks a worker runs while waiting count as well.
+    ThreadPool single_thread_pool(1u);
+
+    std::future<void> outer = single_thread_pool.submit([&single_thread_pool]() {
+        std::vector<std::future<void>> inner{};
+        for (std::size_t i = 0u; i < 4u; i++)
+        {
+            inner.push_back(single_thread_pool.submit([]() {}));
+        }
+        for (auto& future : inner)
+        {
+            single_thread_pool.wait(future);
+        }
+    });
+    outer.get();
+
+    EXPECT_EQ(single_thread_pool.getWorkerStatistics()[0].executed_tasks, 5u);
+}
+
+TEST(TestUtility, TaskGroupDependencies)
+{
+    ThreadPool thread_pool(4u);
+
+    for (bool deterministic : { false, true })
+    {
+        thread_pool.setDeterministic(deterministic);
+
+        std::mutex mutex{};
+        std::vector<char> order{};
+        auto record = [&mutex, &order](char name) {
+            return [&mutex, &order, name]() {
+                std::unique_lock<std::mutex> lock(mutex);
+                order.push_back(name);
+            };
+        };
+
+        {
+            // Diamond: a before b and c, both before d.
+            TaskGroup task_group(thread_pool);
+
+            TaskGroup::TaskId a = task_group.add(record('a'));
+            TaskGroup::TaskId b = task_group.add(record('b'), { a });
+            TaskGroup::TaskId c = task_group.add(record('c'), { a });
+            task_group.add(record('d'), { b, c });
+
+            task_group.wait();
+        }
+
+        ASSERT_EQ(order.size(), 4u);
+        EXPECT_EQ(order.front(), 'a');
+        EXPECT_EQ(order.back(), 'd');
+
+        if (deterministic)
+        {
+            EXPECT_EQ(order, (std::vector<char>{ 'a', 'b', 'c', 'd' }));
+        }
+    }
+}
+
+TEST(TestUtility, TaskGroupException)
+{
+    ThreadPool thread_pool(2u);
+
+    for (bool deterministic : { false, true })
+    {
+        thread_pool.setDeterministic(deterministic);
+
+        std::atomic<std::uint32_t> counter{ 0u };
+
+        TaskGroup task_group(thread_pool);
+
+        TaskGroup::TaskId a = task_group.add([]() { throw std::runtime_error("task failed"); });
+        task_group.add([&counter]() { counter++; }, { a });
+
+        EXPECT_THROW(task_group.wait(), std::runtime_error);
+        EXPECT_EQ(counter.load(), 0u);
+
+        // The exception is rethrown once and the group stays usable.
+        task_group.add([&counter]() { counter++; });
+        task_group.wait();
+        EXPECT_EQ(counter.load(), 1u);
+    }
+}
+
+TEST(TestUtility, ProfilerFrames)
+{
+    Profiler profiler{};
+    ThreadPool thread_pool(2u);
+
+    for (std::uint32_t i = 0u; i < 3u; i++)
+    {
+        profiler.beginFrame();
+        {
+            ProfilerZone zone("Update", profiler);
+
+            thread_pool.parallelFor(8u, 1u, [&profiler](std::size_t, std::size_t) {
+                ProfilerZone worker_zone("Job", profiler);
+            });
+        }
+        profiler.endFrame();
+    }
+
+    auto frames = profiler.getFrames();
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(profiler.getFrameIndex(), 3u);
+
+    for (std::size_t i = 0u; i < frames.size(); i++)
+    {
+        EXPECT_EQ(frames[i].index, i);
+        EXPECT_GE(frames[i].cpu_ms, 0.0);
+
+        ASSERT_EQ(frames[i].zones.size(), 2u);
+        for (const ProfilerZoneStatistics& zone : frames[i].zones)
+        {
+            EXPECT_FALSE(zone.gpu);
+            EXPECT_EQ(zone.count, std::string(zone.name) == "Job" ? 8u : 1u);
+            EXPECT_LE(zone.max_ms, zone.total_ms);
+        }
+    }
+
+    // GPU zones arrive later and are added to their frame.
+    std::uint32_t track = profiler.addTrack("GPU");
+    EXPECT_EQ(profiler.addTrack("GPU"), track);
+    profiler.addGpuZone(1u, track, "Draw", 0, 2000000);
+
+    frames = profiler.getFrames();
+    ASSERT_EQ(frames[1].zones.size(), 3u);
+    EXPECT_TRUE(frames[1].zones[2].gpu);
+    EXPECT_DOUBLE_EQ(frames[1].zones[2].total_ms, 2.0);
+
+    profiler.setEnabled(false);
+    profiler.beginFrame();
+    {
+        ProfilerZone zone("Disabled", profiler);
+    }
+    profiler.endFrame();
+
+    EXPECT_TRUE(profiler.getFrames().back().zones.empty());
+}
+
+TEST(TestUtility, ProfilerSwitching)
+{
+    // A thread recording into two profilers in turn keeps one buffer and track in each
+    Profiler first{};
+    Profiler second{};
+
+    first.beginCapture();
+    first.beginFrame();
+    second.beginFrame();
+    for (std::uint32_t i = 0u; i < 4u; i++)
+    {
+        ProfilerZone first_zone("First", first);
+        ProfilerZone second_zone("Second", second);
+    }
+    second.endFrame();
+    first.endFrame();
+    first.endCapture();
+
+    for (Profiler* profiler : { &first, &second })
+    {
+        auto frames = profiler->getFrames();
+        ASSERT_EQ(frames.size(), 1u);
+        ASSERT_EQ(frames[0].zones.size(), 1u);
+        EXPECT_EQ(frames[0].zones[0].count, 4u);
+    }
+
+    std::string trace = first.getChromeTrace();
+    EXPECT_NE(trace.find("\"CPU thread 0\""), std::string::npos);
+    EXPECT_EQ(trace.find("\"CPU thread 1\""), std::string::npos);
+}
+
+TEST(TestUtility, ProfilerChromeTrace)
+{
+    Profiler profiler{};
+
+    // Only zones between beginCapture() and endCapture() are exported.
+    profiler.beginFrame();
+    {
+        ProfilerZone zone("Ignored", profiler);
+    }
+    profiler.endFrame();
+
+    profiler.beginCapture();
+    profiler.beginFrame();
+    {
+        ProfilerZone zone("Captured", profiler);
+    }
+    profiler.endFrame();
+    profiler.endCapture();
+
+    std::string trace = profiler.getChromeTrace();
+    EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(trace.find("\"Captured\""), std::string::npos);
+    EXPECT_NE(trace.find("\"Frame\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_EQ(trace.find("\"Ignored\""), std::string::npos);
+
+    EXPECT_TRUE(profiler.saveChromeTrace("../bin/profiler_trace.json"));
+}
+
+TEST(TestUtility, HalfFloatConversion)
+{
+    EXPECT_EQ(floatToHalf(0.0f), 0x0000u);
+    EXPECT_EQ(floatToHalf(-0.0f), 0x8000u);
+    EXPECT_EQ(floatToHalf(1.0f), 0x3C00u);
+    EXPECT_EQ(floatToHalf(-2.0f), 0xC000u);
+    EXPECT_EQ(floatToHalf(65504.0f), 0x7BFFu);
+    EXPECT_EQ(floatToHalf(1.0e6f), 0x7C00u);
+    EXPECT_EQ(floatToHalf(5.9604645e-8f), 0x0001u);
+
+    EXPECT_EQ(halfToFloat(0x3C00u), 1.0f);
+    EXPECT_EQ(halfToFloat(0x3555u), 0.333251953125f);
+    EXPECT_EQ(halfToFloat(0x0001u), 5.9604645e-8f);
+    EXPECT_TRUE(std::isinf(halfToFloat(0x7C00u)));
+    EXPECT_TRUE(std::isnan(halfToFloat(0x7E00u)));
+
+    // Every finite half survives a round trip
+    for (uint32_t value = 0u; value < 0x10000u; value++)
+    {
+        if ((value & 0x7C00u) != 0x7C00u)
+        {
+            EXPECT_EQ(floatToHalf(halfToFloat((uint16_t)value)), value);
+        }
+    }
+}
+
+TEST(TestUtility, AlignedBuffer)
+{
+    AlignedBuffer<float> buffer{};
+    EXPECT_TRUE(buffer.empty());
+
+    buffer.resize(3u, 1.5f);
+    ASSERT_EQ(buffer.size(), 3u);
+    EXPECT_EQ((std::uintptr_t)buffer.data() % ALIGNED_MEMORY_ALIGNMENT, 0u);
+    for (float value : buffer)
+    {
+        EXPECT_EQ(value, 1.5f);
+    }
+
+    // Growing keeps the existing elements
+    buffer.resize(1000u);
+    EXPECT_EQ((std::uintptr_t)buffer.data() % ALIGNED_MEMORY_ALIGNMENT, 0u);
+    EXPECT_EQ(buffer[2], 1.5f);
+
+    // The new elements are uninitialised and may compare unequal, e.g. as NaN
+    std::fill(buffer.begin() + 3, buffer.end(), 2.5f);
+
+    AlignedBuffer<float> copy = buffer;
+    EXPECT_EQ(copy, buffer);
+    EXPECT_NE(copy.data(), buffer.data());
+
+    const float* data = buffer.data();
+    AlignedBuffer<float> moved = std::move(buffer);
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(buffer.empty());
+
+    AlignedBuffer<uint8_t> bytes = { 1u, 2u, 3u };
+    ASSERT_EQ(bytes.size(), 3u);
+    EXPECT_EQ(bytes.back(), 3u);
+}
+
+TEST(TestUtility, AlignedMemoryPool)
+{
+    EXPECT_EQ(getAlignedAllocationSize(1u), 64u);
+    EXPECT_EQ(getAlignedAllocationSize(65u), 128u);
+    EXPECT_EQ(getAlignedAllocationSize(1024u * 1024u), 1024u * 1024u);
+    EXPECT_EQ(getAlignedAllocationSize(1024u * 1024u + 1u), 1280u * 1024u);
+
+    setAlignedMemoryPoolLimit(4u * 1024u * 1024u);
+
+    const uint8_t* data{ nullptr };
+    {
+        AlignedBuffer<uint8_t> buffer(1024u * 1024u);
+        data = buffer.data();
+    }
+    EXPECT_EQ(getAlignedMemoryPoolSize(), 1024u * 1024u);
+
+    // Same size class, so the block is reused
+    AlignedBuffer<uint8_t> buffer(1000u * 1024u);
+    EXPECT_EQ(buffer.data(), data);
+    EXPECT_EQ(getAlignedMemoryPoolSize(), 0u);
+
+    setAlignedMemoryPoolLimit(0u);
+}
+
+TEST(TestUtility, FrameArena)
+{
+    FrameArena frame_arena(1024u);
+
+    void* first = frame_arena.allocate(16u, 4u);
+    void* aligned = frame_arena.allocate(8u, 64u);
+    EXPECT_EQ((std::uintptr_t)aligned % 64u, 0u);
+    EXPECT_GE(frame_arena.getUsedBytes(), 24u);
+
+    // Larger than a block, so it gets its own one
+    void* large = frame_arena.allocate(4096u, 16u);
+    ASSERT_NE(large, nullptr);
+    std::memset(large, 0, 4096u);
+    EXPECT_GE(frame_arena.getCapacity(), 1024u + 4096u);
+
+    // After a reset the same memory is handed out again
+    frame_arena.reset();
+    EXPECT_EQ(frame_arena.getUsedBytes(), 0u);
+    EXPECT_EQ(frame_arena.allocate(16u, 4u), first);
+
+    // Once the arena has grown, repeating the same work needs no new blocks
+    std::size_t capacity{ 0u };
+    for (uint32_t frame = 0u; frame < 3u; frame++)
+    {
+        frame_arena.reset();
+
+        std::pmr::vector<uint32_t> values(&frame_arena);
+        for (uint32_t i = 0u; i < 1000u; i++)
+        {
+            values.push_back(i);
+        }
+        EXPECT_EQ(values[999], 999u);
+
+        if (frame > 0u)
+        {
+            EXPECT_EQ(frame_arena.getCapacity(), capacity);
+        }
+        capacity = frame_arena.getCapacity();
+    }
+    EXPECT_GE(frame_arena.getPeakBytes(), 4000u);
+
+    frame_arena.release();
+    EXPECT_EQ(frame_arena.getCapacity(), 0u);
+}
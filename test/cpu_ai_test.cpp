@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -60,3 +62,523 @@ TEST(AI, XOR)
 
     EXPECT_EQ(correct, static_cast<std::int32_t>(inputs.size()));
 }
+
+TEST(AI, XORBatch)
+{
+    ActivationFunction activation_function{ sigmoid, sigmoidDerivative };
+
+    // XOR dataset, one sample per row
+    std::vector<float> inputs = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f };
+    std::vector<float> targets = { 0.0f, 1.0f, 1.0f, 0.0f };
+
+    MultiLayerPerceptron mlp(2u, true);
+    mlp.addLayer(2u, activation_function);
+    mlp.addLayer(1u, activation_function);
+
+    ASSERT_TRUE(mlp.reset(InitializationMethod::NORMAL_XAVIER, 0.0f, 123u));
+
+    // Whole dataset as one mini-batch
+    const float learning_rate{ 2.0f };
+
+    for (std::uint32_t epoch = 0u; epoch < 50000u; epoch++)
+    {
+        auto error = mlp.trainEpoch(inputs, targets, 4u, learning_rate, epoch);
+        ASSERT_TRUE(error.has_value());
+        if (*error < 0.00025f)
+        {
+            break;
+        }
+    }
+
+    for (std::size_t i = 0u; i < targets.size(); i++)
+    {
+        auto out = mlp.forwardPropagation(std::vector<float>{ inputs[i * 2u], inputs[i * 2u + 1u] });
+        ASSERT_FALSE(out.empty());
+        EXPECT_EQ(out[0] > 0.5f, targets[i] > 0.5f);
+    }
+
+    // Sizes, which do not fit the network
+    EXPECT_FALSE(mlp.trainBatch(std::vector<float>(3u), targets, learning_rate).has_value());
+    EXPECT_FALSE(mlp.trainBatch(inputs, std::vector<float>(3u), learning_rate).has_value());
+    EXPECT_FALSE(mlp.trainEpoch(inputs, targets, 0u, learning_rate, 0u).has_value());
+}
+
+TEST(AI, TrainBatch)
+{
+    // A mini-batch of one sample takes the same step as backwardPropagation
+    const ActivationFunction tanh_function{ hyperbolicTangent, hyperbolicTangentDerivative };
+    const ActivationFunction linear{ identity, identityDerivative };
+
+    MultiLayerPerceptron single(19u, true);
+    MultiLayerPerceptron batched(19u, true);
+    for (MultiLayerPerceptron* mlp : { &single, &batched })
+    {
+        mlp->addLayer(21u, tanh_function);
+        mlp->addLayer(3u, linear);
+        ASSERT_TRUE(mlp->reset(InitializationMethod::UNIFORM_XAVIER, 0.1f, 5u));
+    }
+
+    std::vector<float> inputs(19u);
+    std::vector<float> targets(3u);
+    for (std::size_t step = 0u; step < 20u; step++)
+    {
+        for (std::size_t i = 0u; i < inputs.size(); i++)
+        {
+            inputs[i] = (float)((step * 5u + i * 3u) % 13u) / 13.0f - 0.5f;
+        }
+        for (std::size_t i = 0u; i < targets.size(); i++)
+        {
+            targets[i] = (float)((step + i) % 3u) - 1.0f;
+        }
+
+        auto single_error = single.backwardPropagation(inputs, targets, 0.05f);
+        auto batched_error = batched.trainBatch(inputs, targets, 0.05f);
+        ASSERT_TRUE(single_error.has_value());
+        ASSERT_TRUE(batched_error.has_value());
+        EXPECT_NEAR(*single_error, *batched_error, 1e-4f);
+    }
+
+    std::vector<float> single_outputs = single.forwardPropagation(inputs);
+    std::vector<float> batched_outputs = batched.forwardPropagation(inputs);
+    ASSERT_EQ(single_outputs.size(), batched_outputs.size());
+    for (std::size_t i = 0u; i < single_outputs.size(); i++)
+    {
+        EXPECT_NEAR(single_outputs[i], batched_outputs[i], 1e-4f);
+    }
+}
+
+TEST(AI, TrainBatchThreads)
+{
+    // Bitwise the same weights for any number of threads, also with a last shard that is not full
+    const std::size_t number_inputs{ 12u };
+    const std::size_t number_outputs{ 3u };
+    const std::size_t number_samples{ 200u };
+
+    std::vector<float> inputs(number_samples * number_inputs);
+    std::vector<float> targets(number_samples * number_outputs);
+    for (std::size_t i = 0u; i < inputs.size(); i++)
+    {
+        inputs[i] = (float)((i * 37u) % 101u) / 101.0f - 0.5f;
+    }
+    for (std::size_t i = 0u; i < targets.size(); i++)
+    {
+        targets[i] = (float)((i * 11u) % 23u) / 23.0f;
+    }
+
+    std::vector<std::vector<float>> results;
+    for (std::size_t number_threads : { 1u, 2u, 3u, 8u, 0u })
+    {
+        MultiLayerPerceptron mlp(number_inputs, true);
+        mlp.addLayer(17u, createActivationFunction(Activation::SWISH));
+        mlp.addLayer(number_outputs, createActivationFunction(Activation::SIGMOID));
+        ASSERT_TRUE(mlp.reset(InitializationMethod::KAIMING, 0.0f, 42u));
+
+        mlp.setNumberThreads(number_threads);
+        EXPECT_GE(mlp.getNumberThreads(), 1u);
+
+        // The errors of the epochs and the outputs of some samples afterwards
+        std::vector<float> result;
+        for (std::uint32_t epoch = 0u; epoch < 5u; epoch++)
+        {
+            auto error = mlp.trainEpoch(inputs, targets, 150u, 0.5f, epoch);
+            ASSERT_TRUE(error.has_value());
+            result.push_back(*error);
+        }
+        for (std::size_t sample_index = 0u; sample_index < 8u; sample_index++)
+        {
+            const auto first = inputs.begin() + sample_index * number_inputs;
+            std::vector<float> outputs = mlp.forwardPropagation(std::vector<float>(first, first + number_inputs));
+            ASSERT_EQ(outputs.size(), number_outputs);
+            result.insert(result.end(), outputs.begin(), outputs.end());
+        }
+
+        results.push_back(result);
+    }
+
+    for (const std::vector<float>& result : results)
+    {
+        for (std::size_t i = 0u; i < result.size(); i++)
+        {
+            EXPECT_EQ(result[i], results.front()[i]);
+        }
+    }
+}
+
+TEST(AI, ActivationSpans)
+{
+    // Against the scalar functions, also the tail and the large magnitudes where exp and tanh are clamped
+    std::vector<float> inputs;
+    for (float x = -20.0f; x <= 20.0f; x += 0.0137f)
+    {
+        inputs.push_back(x);
+    }
+    inputs.push_back(1e-6f);
+    inputs.push_back(-1e-6f);
+    inputs.push_back(100.0f);
+    inputs.push_back(-100.0f);
+
+    for (Activation activation : { Activation::IDENTITY, Activation::BINARY_STEP, Activation::SIGMOID, Activation::HYPERBOLIC_TANGENT, Activation::RECTIFIED_LINEAR_UNIT, Activation::LEAKY_RECTIFIED_LINEAR_UNIT, Activation::EXPONENTIAL_LINEAR_UNIT, Activation::SWISH, Activation::GAUSSIAN_ERROR_LINEAR_UNIT })
+    {
+        const ActivationFunction activation_function = createActivationFunction(activation);
+        ASSERT_EQ(activation_function.activation, activation);
+
+        std::vector<float> values = inputs;
+        ASSERT_TRUE(activate(activation, values));
+
+        std::vector<float> deltas(inputs.size(), 2.0f);
+        ASSERT_TRUE(multiplyDerivative(activation, inputs, deltas));
+
+        for (std::size_t i = 0u; i < inputs.size(); i++)
+        {
+            const float expected = activation_function.function(inputs[i]);
+            EXPECT_NEAR(values[i], expected, 5e-7f * std::max(1.0f, std::abs(expected))) << "activation " << (int)activation << " at " << inputs[i];
+
+            const float expected_delta = 2.0f * activation_function.derivative(inputs[i]);
+            EXPECT_NEAR(deltas[i], expected_delta, 5e-7f * std::max(1.0f, std::abs(expected_delta))) << "activation " << (int)activation << " at " << inputs[i];
+        }
+    }
+
+    std::vector<float> values(3u);
+    EXPECT_FALSE(activate(Activation::CUSTOM, values));
+    EXPECT_FALSE(multiplyDerivative(Activation::SIGMOID, std::vector<float>(2u), values));
+    EXPECT_FALSE(createActivationFunction(Activation::CUSTOM).function);
+}
+
+TEST(AI, CustomActivation)
+{
+    // Lambdas are called per neuron, and give the same results as the library function they wrap
+    const ActivationFunction custom{ [](float x) { return hyperbolicTangent(x); }, [](float x) { return hyperbolicTangentDerivative(x); } };
+    const ActivationFunction library = createActivationFunction(Activation::HYPERBOLIC_TANGENT);
+
+    MultiLayerPerceptron custom_mlp(5u, true);
+    MultiLayerPerceptron library_mlp(5u, true);
+    ASSERT_TRUE(custom_mlp.addLayer(7u, custom));
+    ASSERT_TRUE(custom_mlp.addLayer(2u, custom));
+    ASSERT_TRUE(library_mlp.addLayer(7u, library));
+    ASSERT_TRUE(library_mlp.addLayer(2u, library));
+    ASSERT_TRUE(custom_mlp.reset(InitializationMethod::NORMAL_XAVIER, 0.1f, 3u));
+    ASSERT_TRUE(library_mlp.reset(InitializationMethod::NORMAL_XAVIER, 0.1f, 3u));
+
+    const std::vector<float> inputs{ 0.5f, -0.25f, 1.0f, 0.0f, -1.0f };
+    const std::vector<float> targets{ 0.3f, -0.6f };
+    for (std::size_t step = 0u; step < 10u; step++)
+    {
+        ASSERT_TRUE(custom_mlp.backwardPropagation(inputs, targets, 0.1f).has_value());
+        ASSERT_TRUE(library_mlp.backwardPropagation(inputs, targets, 0.1f).has_value());
+    }
+
+    const std::vector<float> custom_outputs = custom_mlp.forwardPropagation(inputs);
+    const std::vector<float> library_outputs = library_mlp.forwardPropagation(inputs);
+    ASSERT_EQ(custom_outputs.size(), 2u);
+    ASSERT_EQ(library_outputs.size(), 2u);
+    EXPECT_NEAR(custom_outputs[0], library_outputs[0], 1e-5f);
+    EXPECT_NEAR(custom_outputs[1], library_outputs[1], 1e-5f);
+
+    // Neither a library activation nor functions
+    EXPECT_FALSE(custom_mlp.addLayer(2u, ActivationFunction{}));
+}
+
+TEST(AI, MatrixKernels)
+{
+    // Odd sizes, so both the vector loops and the scalar tails are used
+    const std::size_t rows{ 13u };
+    const std::size_t columns{ 27u };
+    const std::size_t stride{ 32u };
+
+    std::vector<float> a(rows * stride, 0.0f);
+    std::vector<float> x(rows);
+    std::vector<float> y(columns);
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        for (std::size_t c = 0u; c < columns; c++)
+        {
+            a[r * stride + c] = (float)((r * 7u + c * 3u) % 11u) * 0.25f - 1.0f;
+        }
+        x[r] = (float)(r % 5u) * 0.5f - 1.0f;
+    }
+    for (std::size_t c = 0u; c < columns; c++)
+    {
+        y[c] = (float)(c % 7u) * 0.3f - 0.9f;
+    }
+
+    std::vector<float> result(rows);
+    gemv(a.data(), rows, columns, stride, y.data(), result.data());
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        float expected{ 0.0f };
+        for (std::size_t c = 0u; c < columns; c++)
+        {
+            expected += a[r * stride + c] * y[c];
+        }
+        EXPECT_NEAR(result[r], expected, 1e-4f);
+    }
+
+    std::vector<float> transposed(columns, 1.0f);
+    gemvTransposed(a.data(), rows, columns, stride, x.data(), transposed.data());
+    for (std::size_t c = 0u; c < columns; c++)
+    {
+        float expected{ 0.0f };
+        for (std::size_t r = 0u; r < rows; r++)
+        {
+            expected += a[r * stride + c] * x[r];
+        }
+        EXPECT_NEAR(transposed[c], expected, 1e-4f);
+    }
+
+    std::vector<float> updated = a;
+    ger(updated.data(), rows, columns, stride, 0.5f, x.data(), y.data());
+    for (std::size_t r = 0u; r < rows; r++)
+    {
+        for (std::size_t c = 0u; c < stride; c++)
+        {
+            // The padding is left untouched
+            const float expected = c < columns ? a[r * stride + c] + 0.5f * x[r] * y[c] : 0.0f;
+            EXPECT_NEAR(updated[r * stride + c], expected, 1e-5f);
+        }
+    }
+
+    // Matrix products against the naive triple loop
+    const std::size_t m{ 11u };
+    const std::size_t n{ 37u };
+    const std::size_t k{ 300u };
+
+    auto value = [](std::size_t i, std::size_t j) { return (float)((i * 13u + j * 7u) % 17u) / 17.0f - 0.5f; };
+
+    std::vector<float> a_mk(m * k);
+    std::vector<float> a_km(k * m);
+    std::vector<float> b_kn(k * n);
+    std::vector<float> b_nk(n * k);
+    for (std::size_t i = 0u; i < m; i++)
+    {
+        for (std::size_t p = 0u; p < k; p++)
+        {
+            a_mk[i * k + p] = value(i, p);
+            a_km[p * m + i] = value(i, p);
+        }
+    }
+    for (std::size_t p = 0u; p < k; p++)
+    {
+        for (std::size_t j = 0u; j < n; j++)
+        {
+            b_kn[p * n + j] = value(p + 3u, j);
+            b_nk[j * k + p] = value(p + 3u, j);
+        }
+    }
+
+    std::vector<float> expected_product(m * n, 0.0f);
+    for (std::size_t i = 0u; i < m; i++)
+    {
+        for (std::size_t j = 0u; j < n; j++)
+        {
+            for (std::size_t p = 0u; p < k; p++)
+            {
+                expected_product[i * n + j] += a_mk[i * k + p] * b_kn[p * n + j];
+            }
+        }
+    }
+
+    // Padded rows of C, which must stay untouched
+    const std::size_t stride_c{ 40u };
+    for (int variant = 0; variant < 3; variant++)
+    {
+        std::vector<float> product(m * stride_c, 7.0f);
+        if (variant == 0)
+        {
+            gemm(m, n, k, a_mk.data(), k, b_kn.data(), n, product.data(), stride_c);
+        }
+        else if (variant == 1)
+        {
+            gemmTransposedA(m, n, k, a_km.data(), m, b_kn.data(), n, product.data(), stride_c);
+        }
+        else
+        {
+            gemmTransposedB(m, n, k, a_mk.data(), k, b_nk.data(), k, product.data(), stride_c);
+        }
+
+        for (std::size_t i = 0u; i < m; i++)
+        {
+            for (std::size_t j = 0u; j < stride_c; j++)
+            {
+                const float expected = j < n ? expected_product[i * n + j] : 7.0f;
+                EXPECT_NEAR(product[i * stride_c + j], expected, 1e-3f) << "variant " << variant;
+            }
+        }
+    }
+}
+
+TEST(AI, Optimizers)
+{
+    // Odd size, so the vector loops and the masked tails are used
+    const std::size_t size{ 37u };
+    const float scale{ -0.25f };
+    const float learning_rate{ 0.01f };
+
+    std::vector<float> gradients(size);
+
+    const auto check = [&](AOptimizer& optimizer, auto&& reference) {
+        std::vector<float> parameters(size);
+        std::vector<double> expected(size);
+        for (std::size_t i = 0u; i < size; i++)
+        {
+            parameters[i] = 0.5f - 0.03f * (float)i;
+            expected[i] = parameters[i];
+        }
+
+        OptimizerState state{};
+        for (std::uint64_t step = 1u; step <= 5u; step++)
+        {
+            for (std::size_t i = 0u; i < size; i++)
+            {
+                gradients[i] = std::sin((float)(i * 7u + step * 3u)) * (float)step;
+            }
+
+            optimizer.beginStep();
+            const float rate = optimizer.getLearningRate(learning_rate);
+            optimizer.update(parameters, gradients, scale, rate, state);
+            reference(expected, (double)rate, step);
+
+            for (std::size_t i = 0u; i < size; i++)
+            {
+                ASSERT_NEAR(parameters[i], expected[i], 1e-5 * (1.0 + std::abs(expected[i]))) << "step " << step << ", index " << i;
+            }
+        }
+    };
+
+    // Plain gradient descent, with a step decay halving the rate every second step
+    SgdOptimizer sgd{};
+    sgd.setSchedule(createStepDecaySchedule(0.5f, 2u));
+    check(sgd, [&](std::vector<double>& p, double rate, std::uint64_t step) {
+        EXPECT_DOUBLE_EQ(rate, (double)learning_rate * std::pow(0.5, (double)((step - 1u) / 2u)));
+        for (std::size_t i = 0u; i < size; i++)
+        {
+            p[i] -= rate * scale * gradients[i];
+        }
+    });
+
+    std::vector<double> first(size);
+    std::vector<double> second(size);
+
+    SgdOptimizer momentum{ 0.9f };
+    check(momentum, [&](std::vector<double>& p, double rate, std::uint64_t) {
+        for (std::size_t i = 0u; i < size; i++)
+        {
+            first[i] = 0.9 * first[i] + scale * gradients[i];
+            p[i] -= rate * first[i];
+        }
+    });
+
+    std::fill(second.begin(), second.end(), 0.0);
+    RmsPropOptimizer rms_prop{ 0.9f, 1e-7f };
+    check(rms_prop, [&](std::vector<double>& p, double rate, std::uint64_t) {
+        for (std::size_t i = 0u; i < size; i++)
+        {
+            const double g = scale * gradients[i];
+            second[i] = 0.9 * second[i] + 0.1 * g * g;
+            p[i] -= rate * g / (std::sqrt(second[i]) + 1e-7);
+        }
+    });
+
+    // Adam and AdamW as in the papers, with explicit bias correction
+    for (float weight_decay : { 0.0f, 0.1f })
+    {
+        std::fill(first.begin(), first.end(), 0.0);
+        std::fill(second.begin(), second.end(), 0.0);
+
+        AdamWOptimizer adam{ 0.9f, 0.999f, 1e-7f, weight_decay };
+        check(adam, [&](std::vector<double>& p, double rate, std::uint64_t step) {
+            for (std::size_t i = 0u; i < size; i++)
+            {
+                const double g = scale * gradients[i];
+                first[i] = 0.9 * first[i] + 0.1 * g;
+                second[i] = 0.999 * second[i] + 0.001 * g * g;
+
+                const double first_corrected = first[i] / (1.0 - std::pow(0.9, (double)step));
+                const double second_corrected = second[i] / (1.0 - std::pow(0.999, (double)step));
+                p[i] -= rate * weight_decay * p[i] + rate * first_corrected / (std::sqrt(second_corrected) + 1e-7);
+            }
+        });
+    }
+
+    // Sizes, which do not match
+    OptimizerState state{};
+    std::vector<float> parameters(size, 1.0f);
+    AdamOptimizer adam{};
+    adam.beginStep();
+    adam.update(parameters, std::vector<float>(size - 1u), 1.0f, learning_rate, state);
+    EXPECT_EQ(parameters, std::vector<float>(size, 1.0f));
+}
+
+TEST(AI, LearningRateSchedules)
+{
+    const auto exponential = createExponentialDecaySchedule(0.5f);
+    EXPECT_FLOAT_EQ(exponential(0u), 1.0f);
+    EXPECT_FLOAT_EQ(exponential(3u), 0.125f);
+
+    // Warmup of 4 steps, cosine down to 0.1 until step 14
+    const auto cosine = createCosineSchedule(4u, 14u, 0.1f);
+    EXPECT_FLOAT_EQ(cosine(0u), 0.25f);
+    EXPECT_FLOAT_EQ(cosine(3u), 1.0f);
+    EXPECT_FLOAT_EQ(cosine(4u), 1.0f);
+    EXPECT_FLOAT_EQ(cosine(9u), 0.55f);
+    EXPECT_NEAR(cosine(13u), 0.1f + 0.45f * (1.0f + std::cos(0.9f * 3.14159265f)), 1e-6f);
+    EXPECT_FLOAT_EQ(cosine(14u), 0.1f);
+    EXPECT_FLOAT_EQ(cosine(100u), 0.1f);
+
+    // Without a schedule, the rate stays
+    AdamOptimizer adam{};
+    adam.beginStep();
+    EXPECT_FLOAT_EQ(adam.getLearningRate(0.01f), 0.01f);
+    adam.setSchedule(createStepDecaySchedule(0.1f, 1u));
+    adam.beginStep();
+    EXPECT_FLOAT_EQ(adam.getLearningRate(0.01f), 0.001f);
+    EXPECT_EQ(adam.getStep(), 2u);
+}
+
+TEST(AI, XOROptimizers)
+{
+    ActivationFunction activation_function{ sigmoid, sigmoidDerivative };
+
+    std::vector<float> inputs = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f };
+    std::vector<float> targets = { 0.0f, 1.0f, 1.0f, 0.0f };
+
+    const auto train = [&](std::shared_ptr<AOptimizer> optimizer, float learning_rate) {
+        MultiLayerPerceptron mlp(2u, true);
+        mlp.addLayer(4u, activation_function);
+        mlp.addLayer(1u, activation_function);
+        mlp.setOptimizer(std::move(optimizer));
+        EXPECT_TRUE(mlp.reset(InitializationMethod::NORMAL_XAVIER, 0.0f, 123u));
+
+        std::uint32_t epoch = 0u;
+        for (; epoch < 50000u; epoch++)
+        {
+            auto error = mlp.trainEpoch(inputs, targets, 4u, learning_rate, epoch);
+            EXPECT_TRUE(error.has_value());
+            if (!error || *error < 0.00025f)
+            {
+                break;
+            }
+        }
+
+        for (std::size_t i = 0u; i < targets.size(); i++)
+        {
+            auto out = mlp.forwardPropagation(std::vector<float>{ inputs[i * 2u], inputs[i * 2u + 1u] });
+            EXPECT_EQ(out.size(), 1u);
+            EXPECT_EQ(!out.empty() && out[0] > 0.5f, targets[i] > 0.5f);
+        }
+
+        return epoch;
+    };
+
+    const std::uint32_t sgd_epochs = train(nullptr, 2.0f);
+    const std::uint32_t momentum_epochs = train(std::make_shared<SgdOptimizer>(0.9f), 2.0f);
+    const std::uint32_t rms_prop_epochs = train(std::make_shared<RmsPropOptimizer>(), 0.02f);
+    const std::uint32_t adam_epochs = train(std::make_shared<AdamOptimizer>(), 0.05f);
+    const std::uint32_t adam_w_epochs = train(std::make_shared<AdamWOptimizer>(0.001f), 0.05f);
+
+    // Plain gradient descent needs thousands of epochs here
+    EXPECT_LT(momentum_epochs * 4u, sgd_epochs);
+    EXPECT_LT(rms_prop_epochs * 4u, sgd_epochs);
+    EXPECT_LT(adam_epochs * 4u, sgd_epochs);
+    EXPECT_LT(adam_w_epochs * 4u, sgd_epochs);
+    EXPECT_LT(adam_epochs, 1000u);
+}
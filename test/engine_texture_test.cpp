@@ -168,6 +168,46 @@ TEST(TestTextureCube, CreateMultiMip)
     vulkan_setup.terminate();
 }
 
+TEST(TestTextureCube, UploadFromEquirectangular)
+{
+    VulkanSetup vulkan_setup{};
+    ASSERT_TRUE(vulkan_setup.init());
+
+    VulkanHandles handles{};
+    ASSERT_TRUE(initVulkan(handles));
+
+    ImageData equirectangular{};
+    equirectangular.width = 64u;
+    equirectangular.height = 32u;
+    equirectangular.channels = 4u;
+    equirectangular.channel_format = ChannelFormat::SFLOAT;
+    equirectangular.primaries = ColorPrimaries::REC709;
+    equirectangular.transfer = TransferFunction::LINEAR;
+    equirectangular.image_state = ImageState::SCENE;
+    equirectangular.pixels.resize(64u * 32u * 4u * sizeof(float), 0u);
+
+    auto faces = convertEquirectangularToCube(16u, ResampleFilter::BILINEAR, equirectangular);
+    ASSERT_TRUE(faces.has_value());
+
+    TextureCube cube(handles.physical_device, handles.device);
+    cube.setSize(16u);
+    cube.setFormat(VK_FORMAT_R32G32B32A32_SFLOAT);
+    cube.setUsage(VK_IMAGE_USAGE_SAMPLED_BIT);
+
+    ASSERT_TRUE(cube.create());
+    EXPECT_TRUE(cube.upload(*faces));
+
+    // A single face is rejected
+    ImageData face = *faces;
+    face.height = 16u;
+    face.pixels.resize(16u * 16u * 4u * sizeof(float));
+    EXPECT_FALSE(cube.upload(face));
+
+    cube.destroy();
+    terminateVulkan(handles);
+    vulkan_setup.terminate();
+}
+
 TEST(TestTexture2D, CreateOnly)
 {
     VulkanSetup vulkan_setup{};
@@ -236,7 +276,7 @@ TEST(TestTexture2D, UploadImageData)
 
     // Cleanup test resources
     vkDestroyImageView(handles.device, test_image_view, nullptr);
-    vkFreeMemory(handles.device, test_memory, nullptr);
+    freeDeviceMemory(handles.device, test_memory);
     vkDestroyImage(handles.device, test_image, nullptr);
 
     // Create test image data
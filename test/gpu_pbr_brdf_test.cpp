@@ -308,7 +308,7 @@ TEST(TestBRDF, GenerateLUT)
     EXPECT_TRUE(result) << "Failed to save BRDF LUT test output";
 
     // Cleanup
-    vkFreeMemory(handles.device, staging_buffer.device_memory, nullptr);
+    freeDeviceMemory(handles.device, staging_buffer.device_memory);
     vkDestroyBuffer(handles.device, staging_buffer.buffer, nullptr);
     output_texture.destroy();
     vkDestroyDescriptorPool(handles.device, descriptor_pool, nullptr);
@@ -391,7 +391,7 @@ TEST(TestIBL, GenerateDiffuseIrradiance)
     EXPECT_TRUE(saveImageData("ibl_diffuse_face0.exr", out_image));
 
     // Cleanup
-    vkFreeMemory(handles.device, staging.device_memory, nullptr);
+    freeDeviceMemory(handles.device, staging.device_memory);
     vkDestroyBuffer(handles.device, staging.buffer, nullptr);
     vkDestroyDescriptorPool(handles.device, descriptor_pool, nullptr);
     vkDestroyPipeline(handles.device, pipeline, nullptr);
@@ -616,7 +616,7 @@ TEST(TestIBL, GenerateSpecularPrefilter)
     EXPECT_TRUE(saveImageData("ibl_specular_face0.exr", out_image));
 
     // Cleanup
-    vkFreeMemory(handles.device, staging.device_memory, nullptr);
+    freeDeviceMemory(handles.device, staging.device_memory);
     vkDestroyBuffer(handles.device, staging.buffer, nullptr);
     vkDestroyDescriptorPool(handles.device, descriptor_pool, nullptr);
     vkDestroyPipeline(handles.device, pipeline, nullptr);
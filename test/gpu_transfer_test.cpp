@@ -164,7 +164,7 @@ TEST(TestTransfer, BufferToImageToBufferRoundTrip)
     EXPECT_TRUE(staging_buffer_download.has_value());
     if (!staging_buffer_download.has_value())
     {
-        vkFreeMemory(handles.device, image_memory, nullptr);
+        freeDeviceMemory(handles.device, image_memory);
         vkDestroyImage(handles.device, image, nullptr);
         destroyResource(handles.device, *staging_buffer_upload);
         terminateVulkan(handles);
@@ -215,7 +215,7 @@ TEST(TestTransfer, BufferToImageToBufferRoundTrip)
     }
 
     destroyResource(handles.device, *staging_buffer_download);
-    vkFreeMemory(handles.device, image_memory, nullptr);
+    freeDeviceMemory(handles.device, image_memory);
     vkDestroyImage(handles.device, image, nullptr);
     destroyResource(handles.device, *staging_buffer_upload);
 
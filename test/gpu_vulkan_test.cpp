@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -115,3 +116,138 @@ TEST(TestVulkan, InitTerminate)
 
     vulkan_setup.terminate();
 }
+
+TEST(TestVulkan, TimestampProfiler)
+{
+    VulkanSetup vulkan_setup{};
+
+    auto result = vulkan_setup.init();
+    ASSERT_TRUE(result);
+
+    VulkanHandles handles{};
+
+    result = initVulkan(handles);
+    EXPECT_TRUE(result);
+    if (result)
+    {
+        Profiler profiler{};
+
+        VulkanTimestampProfiler timestamp_profiler{ handles.physical_device, handles.device, handles.queue_family_index, 2u, 4u, profiler };
+        if (timestamp_profiler.init())
+        {
+            VulkanCommandPoolFactory command_pool_factory{ handles.device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, handles.queue_family_index };
+            VkCommandPool command_pool = command_pool_factory.create();
+            ASSERT_NE(command_pool, VK_NULL_HANDLE);
+
+            VulkanCommandBufferFactory command_buffer_factory{ handles.device, command_pool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1u };
+            VkCommandBuffer command_buffer = command_buffer_factory.create().front();
+
+            // More frames than ranges, so ranges are reused.
+            for (uint32_t i = 0u; i < 3u; i++)
+            {
+                profiler.beginFrame();
+                timestamp_profiler.beginFrame();
+
+                VkCommandBufferBeginInfo command_buffer_begin_info{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+                EXPECT_EQ(vkBeginCommandBuffer(command_buffer, &command_buffer_begin_info), VK_SUCCESS);
+                {
+                    VulkanTimestampZone zone{ timestamp_profiler, command_buffer, "Empty" };
+                }
+                EXPECT_EQ(vkEndCommandBuffer(command_buffer), VK_SUCCESS);
+
+                VkCommandBufferSubmitInfo command_buffer_info{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO };
+                command_buffer_info.commandBuffer = command_buffer;
+
+                VkSubmitInfo2 submit_info2{ VK_STRUCTURE_TYPE_SUBMIT_INFO_2 };
+                submit_info2.commandBufferInfoCount = 1u;
+                submit_info2.pCommandBufferInfos = &command_buffer_info;
+
+                EXPECT_EQ(vkQueueSubmit2(handles.queue, 1u, &submit_info2, VK_NULL_HANDLE), VK_SUCCESS);
+                EXPECT_EQ(vkQueueWaitIdle(handles.queue), VK_SUCCESS);
+
+                timestamp_profiler.endFrame();
+                profiler.endFrame();
+
+                timestamp_profiler.resolve();
+            }
+
+            auto frames = profiler.getFrames();
+            ASSERT_EQ(frames.size(), 3u);
+            for (const ProfilerFrame& frame : frames)
+            {
+                auto it = std::find_if(frame.zones.begin(), frame.zones.end(), [](const ProfilerZoneStatistics& zone) { return zone.gpu; });
+                ASSERT_NE(it, frame.zones.end());
+                EXPECT_STREQ(it->name, "Empty");
+                EXPECT_EQ(it->count, 1u);
+                EXPECT_GE(it->total_ms, 0.0);
+            }
+
+            timestamp_profiler.terminate();
+
+            vkFreeCommandBuffers(handles.device, command_pool, 1u, &command_buffer);
+            vkDestroyCommandPool(handles.device, command_pool, nullptr);
+        }
+    }
+
+    terminateVulkan(handles);
+
+    vulkan_setup.terminate();
+}
+
+TEST(TestVulkan, MemoryTracker)
+{
+    VulkanSetup vulkan_setup{};
+
+    auto result = vulkan_setup.init();
+    ASSERT_TRUE(result);
+
+    VulkanHandles handles{};
+
+    result = initVulkan(handles);
+    EXPECT_TRUE(result);
+    if (result)
+    {
+        VulkanMemoryTracker& memory_tracker = getVulkanMemoryTracker();
+        memory_tracker.init(handles.physical_device, false);
+
+        uint32_t warnings{ 0u };
+        memory_tracker.setWarningCallback([&](const VulkanMemoryWarning&) { warnings++; });
+
+        const VulkanMemoryCounter staging_before = memory_tracker.getTagCounter(VulkanMemoryTag::STAGING);
+        const VulkanMemoryCounter total_before = memory_tracker.getTotal();
+
+        auto staging_buffer = createStagingBuffer(handles.physical_device, handles.device, 64u * 1024u);
+        ASSERT_TRUE(staging_buffer.has_value());
+
+        const VulkanMemoryCounter staging = memory_tracker.getTagCounter(VulkanMemoryTag::STAGING);
+        EXPECT_EQ(staging.live_count, staging_before.live_count + 1u);
+        EXPECT_GE(staging.live_bytes, staging_before.live_bytes + 64u * 1024u);
+        EXPECT_GE(staging.peak_bytes, staging.live_bytes);
+        EXPECT_EQ(memory_tracker.getTotal().total_count, total_before.total_count + 1u);
+
+        EXPECT_GT(memory_tracker.getMaxAllocationCount(), 0u);
+
+        auto heap_budgets = memory_tracker.getHeapBudgets();
+        ASSERT_FALSE(heap_budgets.empty());
+        for (const VulkanMemoryHeapBudget& heap_budget : heap_budgets)
+        {
+            EXPECT_EQ(heap_budget.budget, heap_budget.heap_size);
+            EXPECT_EQ(heap_budget.projected_usage, heap_budget.usage);
+        }
+        EXPECT_EQ(warnings, 0u);
+
+        EXPECT_NE(memory_tracker.getJson().find("\"Staging\""), std::string::npos);
+
+        destroyResource(handles.device, *staging_buffer);
+
+        EXPECT_EQ(memory_tracker.getTagCounter(VulkanMemoryTag::STAGING).live_bytes, staging_before.live_bytes);
+        EXPECT_EQ(memory_tracker.getTotal().live_count, total_before.live_count);
+
+        memory_tracker.setWarningCallback({});
+        memory_tracker.terminate();
+    }
+
+    terminateVulkan(handles);
+
+    vulkan_setup.terminate();
+}